@@ -90,6 +90,7 @@ namespace Avida {
       // Data::Provider
       Data::ConstDataSetPtr Provides() const;
       void UpdateProvidedValues(Update current_update);
+      bool SupportsParallelUpdate() const;
       Data::PackagePtr GetProvidedValue(const Data::DataID& data_id) const;
       Apto::String DescribeProvidedValue(const Data::DataID& data_id) const;
 
@@ -67,6 +67,7 @@ namespace Avida {
       
       bool m_threshold;
       bool m_active;
+      unsigned int m_genome_hash; // genome digest, maintained by GenotypeArbiter
       
       int m_generation_born;
       int m_update_born;
@@ -126,6 +127,7 @@ namespace Avida {
       
       bool Serialize(ArchivePtr ar) const;
       bool LegacySave(void* df) const;
+      bool LegacySaveProperties(void* props) const;
 
       void RemoveActiveReference() const;
       
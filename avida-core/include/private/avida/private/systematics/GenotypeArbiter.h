@@ -47,7 +47,7 @@ namespace Avida {
         EVENT_REMOVE_THRESHOLD
       };
       
-      static const int HASH_SIZE = 3203;
+      static const int INITIAL_HASH_SIZE = 4096; // must be a power of two
       
     private:
       // Config Settings
@@ -55,7 +55,9 @@ namespace Avida {
       bool m_disable_class;
       
       // Internal Data Structures
-      Apto::List<GenotypePtr, Apto::SparseVector> m_active_hash[HASH_SIZE];
+      Apto::Array<Apto::List<GenotypePtr, Apto::SparseVector>, Apto::ManagedPointer> m_active_hash;
+      int m_active_hash_count;
+      Apto::Map<GroupID, GenotypePtr> m_id_map;
       Apto::Array<Apto::List<GenotypePtr, Apto::SparseVector>, Apto::ManagedPointer> m_active_sz;
       Apto::List<GenotypePtr, Apto::SparseVector> m_historic;
       GenotypePtr m_coalescent;
@@ -129,6 +131,7 @@ namespace Avida {
       
       bool Serialize(ArchivePtr ar) const;
       bool LegacySave(void* df) const;
+      bool LegacySaveProperties(void* props_list) const;
       GroupPtr LegacyLoad(void* props);
       
       IteratorPtr Begin();
@@ -137,6 +140,7 @@ namespace Avida {
       // Data::Provider
       Data::ConstDataSetPtr Provides() const;
       void UpdateProvidedValues(Update current_update);
+      bool SupportsParallelUpdate() const;
       Data::PackagePtr GetProvidedValue(const Data::DataID& data_id) const;
       Apto::String DescribeProvidedValue(const Data::DataID& data_id) const;
       
@@ -158,6 +162,9 @@ namespace Avida {
       Data::ProviderPtr activateProvider(World*);
       
       unsigned int hashGenome(const InstructionSequence& genome) const;
+      void addActiveHash(GenotypePtr genotype);
+      void removeActiveHash(GenotypePtr genotype);
+      void resizeActiveHash(int size);
       Apto::String nameGenotype(int size);
       
       void removeGenotype(GenotypePtr genotype);
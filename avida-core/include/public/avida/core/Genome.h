@@ -103,6 +103,7 @@ namespace Avida {
     LIB_EXPORT bool Serialize(ArchivePtr ar) const;
     LIB_EXPORT static GenomePtr Deserialize(ArchivePtr ar);
     LIB_EXPORT bool LegacySave(void* df) const;
+    LIB_EXPORT bool LegacySaveProperties(void* props) const;
     
   private:
     class InstSetPropertyMap : public PropertyMap
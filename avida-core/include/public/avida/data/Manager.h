@@ -43,6 +43,8 @@ namespace Avida {
       typedef Apto::Set<Apto::String, Apto::DefaultHashBTree, Apto::Multi> ArgMultiSet;
       typedef Apto::SmartPtr<ArgMultiSet> ArgMultiSetPtr;
       
+      class UpdatePipeline;
+      
     private:
       World* m_world;
       
@@ -64,6 +66,8 @@ namespace Avida {
       mutable Apto::Mutex m_current_value_mutex;
       mutable Apto::Map<DataID, PackagePtr> m_current_values;
       
+      UpdatePipeline* m_pipeline;
+      
       static bool s_registered_with_facet_factory;
       
     public:
@@ -78,6 +82,7 @@ namespace Avida {
       
       LIB_EXPORT bool AttachRecorder(RecorderPtr recorder, bool concurrent_update = false);
       LIB_EXPORT bool DetachRecorder(RecorderPtr recorder);
+      LIB_EXPORT void FlushRecorders();
       
       LIB_EXPORT bool Register(const DataID& data_id, ProviderActivateFunctor functor);
       LIB_EXPORT bool Register(const DataID& data_id, ArgumentedProviderActivateFunctor functor);
@@ -48,6 +48,7 @@ namespace Avida {
       LIB_EXPORT virtual Apto::String DescribeProvidedValue(const DataID& data_id) const = 0;
       
       LIB_EXPORT virtual bool SupportsConcurrentUpdate() const;
+      LIB_EXPORT virtual bool SupportsParallelUpdate() const;
     };
     
     
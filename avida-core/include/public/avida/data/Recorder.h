@@ -44,6 +44,8 @@ namespace Avida {
       LIB_EXPORT virtual ConstDataSetPtr RequestedData() const = 0;
       
       LIB_EXPORT virtual void NotifyData(Update current_update, DataRetrievalFunctor retrieve_data) = 0; 
+      
+      LIB_EXPORT virtual bool SupportsAsynchronousNotify() const;
     };
     
   };
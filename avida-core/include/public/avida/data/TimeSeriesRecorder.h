@@ -26,6 +26,7 @@
 #define AvidaDataTimeSeriesRecorder_h
 
 #include "apto/core/Array.h"
+#include "apto/platform.h"
 #include "avida/core/Types.h"
 #include "avida/data/Recorder.h"
 
@@ -44,6 +45,7 @@ namespace Avida {
       
       struct DataEntry;
       Apto::Array<DataEntry, Apto::Smart> m_data;
+      mutable Apto::Mutex m_mutex;  // Guards m_data, which may be appended to from the asynchronous notify thread
       
     public:
       LIB_EXPORT TimeSeriesRecorder(const DataID& data_id);
@@ -53,12 +55,16 @@ namespace Avida {
       LIB_EXPORT inline ConstDataSetPtr RequestedData() const { return m_requested; }
       LIB_EXPORT void NotifyData(Update current_update, DataRetrievalFunctor retrieve_data);
       
+      // Recorded values are guarded, so notification may be delivered from the data manager's notify thread.  Note
+      // that shouldRecordValue and didRecordValue are called from that thread as well.
+      LIB_EXPORT inline bool SupportsAsynchronousNotify() const { return true; }
+      
       // Value Access
       LIB_EXPORT inline const DataID& RecordedDataID() const { return m_data_id; }
       
-      LIB_EXPORT inline int NumPoints() const { return m_data.GetSize(); }
-      LIB_EXPORT inline T DataPoint(int idx) const { return m_data[idx].data; }
-      LIB_EXPORT inline Update DataTime(int idx) const { return m_data[idx].update; }
+      LIB_EXPORT inline int NumPoints() const { Apto::MutexAutoLock lock(m_mutex); return m_data.GetSize(); }
+      LIB_EXPORT inline T DataPoint(int idx) const { Apto::MutexAutoLock lock(m_mutex); return m_data[idx].data; }
+      LIB_EXPORT inline Update DataTime(int idx) const { Apto::MutexAutoLock lock(m_mutex); return m_data[idx].update; }
       
       LIB_EXPORT Apto::String AsString() const;
       
@@ -76,6 +82,12 @@ namespace Avida {
         LIB_LOCAL inline DataEntry() : update(-1) { ; }
         LIB_LOCAL inline DataEntry(Update in_update, const T& in_data) : data(in_data), update(in_update) { ; }
       };
+      
+      LIB_LOCAL inline void recordValue(Update update, const T& data)
+      {
+        Apto::MutexAutoLock lock(m_mutex);
+        m_data.Push(DataEntry(update, data));
+      }
     };
     
   };
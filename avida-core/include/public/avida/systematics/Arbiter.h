@@ -69,6 +69,7 @@ namespace Avida {
       // Serialization
       LIB_EXPORT virtual bool Serialize(ArchivePtr ar) const;
       LIB_EXPORT virtual bool LegacySave(void* df) const;
+      LIB_EXPORT virtual bool LegacySaveProperties(void* props_list) const;
       LIB_EXPORT virtual GroupPtr LegacyLoad(void* props);
       
       
@@ -76,6 +76,7 @@ namespace Avida {
       
       LIB_EXPORT virtual bool Serialize(ArchivePtr ar) const;
       LIB_EXPORT virtual bool LegacySave(void* df) const;
+      LIB_EXPORT virtual bool LegacySaveProperties(void* props) const;
       
       
       // Reference Management (Active for currently living units, Passive for all other group usage)
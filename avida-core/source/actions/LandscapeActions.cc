@@ -254,15 +254,17 @@ public:
 
       cAnalyzeJobQueue& jobqueue = m_world->GetAnalyze().GetJobQueue();
       
+      // Landscapes are run one at a time with their sites spread across the job queue, so that even a batch holding
+      // a single large genome keeps every worker busy
       tListIterator<cAnalyzeGenotype> batch_it(m_world->GetAnalyze().GetCurrentBatch().List());
       cAnalyzeGenotype* genotype = NULL;
       while ((genotype = batch_it.Next())) {
         land = new cLandscape(m_world, genotype->GetGenome());
         land->SetDistance(m_dist);
+        land->SetJobQueue(&jobqueue);
         m_batch.PushRear(land);
-        jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::Process));
+        land->Process(ctx);
       }
-      jobqueue.Execute();
 
       Avida::Output::FilePtr sf = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)m_sfilename);
       Avida::Output::FilePtr ef;
@@ -374,10 +376,10 @@ public:
       while ((genotype = batch_it.Next())) {
         land = new cLandscape(m_world, genotype->GetGenome());
         land->SetDistance(m_dist);
+        land->SetJobQueue(&jobqueue);
         m_batch.PushRear(land);
-        jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::ProcessDelete));
+        land->ProcessDelete(ctx);
       }
-      jobqueue.Execute();
 
       Avida::Output::FilePtr sf = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)m_sfilename);
       Avida::Output::FilePtr cf;
@@ -437,10 +439,10 @@ public:
       while ((genotype = batch_it.Next())) {
         land = new cLandscape(m_world, genotype->GetGenome());
         land->SetDistance(m_dist);
+        land->SetJobQueue(&jobqueue);
         m_batch.PushRear(land);
-        jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::ProcessInsert));
+        land->ProcessInsert(ctx);
       }
-      jobqueue.Execute();
     
       Avida::Output::FilePtr sf = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)m_sfilename);
       Avida::Output::FilePtr cf;
@@ -657,7 +659,7 @@ public:
 };
 
 
-class cActionHillClimb : public cAction  // @not_parallelized
+class cActionHillClimb : public cAction  // @parallelized
 {
 private:
   cString m_filename;
@@ -691,6 +693,7 @@ public:
       cAnalyzeGenotype* genotype = NULL;
       while ((genotype = batch_it.Next())) {
         cLandscape land(m_world, genotype->GetGenome());
+        land.SetJobQueue(&m_world->GetAnalyze().GetJobQueue());
         land.HillClimb(ctx, *df);
       }
     }
@@ -704,6 +707,8 @@ class cActionMutationalNeighborhood : public cAction  // @parallelized
 private:
   cString m_filename;
   int m_target;
+  int m_sample_size;
+  double m_tolerance;
   
   struct sBatchEntry {
     cMutationalNeighborhood* mutn;
@@ -716,16 +721,20 @@ private:
   
 public:
   cActionMutationalNeighborhood(cWorld* world, const cString& args, Feedback&)
-    : cAction(world, args), m_filename("mut-neighborhood.dat"), m_target(-1)
+    : cAction(world, args), m_filename("mut-neighborhood.dat"), m_target(-1), m_sample_size(0), m_tolerance(0.0)
   {
       cString largs(args);
       if (largs.GetSize()) m_filename = largs.PopWord();
       if (largs.GetSize()) m_target = largs.PopWord().AsInt();
+      if (largs.GetSize()) m_sample_size = largs.PopWord().AsInt();
+      if (largs.GetSize()) m_tolerance = largs.PopWord().AsDouble();
   }
   
   static const cString GetDescription()
   {
-    return "Arguments: [string fname='mut-neighborhood.dat'] [int target=-1]";
+    // A sample_size of 0 enumerates every two step mutant, otherwise two step statistics are estimated from a uniform
+    // sample that stops early once every 95% confidence half-width falls below tolerance (when tolerance > 0)
+    return "Arguments: [string fname='mut-neighborhood.dat'] [int target=-1] [int sample_size=0] [double tolerance=0.0]";
   }
   
   void Process(cAvidaContext& ctx)
@@ -745,7 +754,7 @@ public:
       tListIterator<cAnalyzeGenotype> batch_it(m_world->GetAnalyze().GetCurrentBatch().List());
       cAnalyzeGenotype* genotype = NULL;
       while ((genotype = batch_it.Next())) {
-        mutn = new cMutationalNeighborhood(m_world, genotype->GetGenome(), m_target);
+        mutn = new cMutationalNeighborhood(m_world, genotype->GetGenome(), m_target, m_sample_size, m_tolerance);
         m_batch.PushRear(new sBatchEntry(mutn, genotype->GetDepth()));
         jobqueue.AddJob(new tAnalyzeJob<cMutationalNeighborhood>(mutn, &cMutationalNeighborhood::Process));
       }
@@ -814,7 +823,8 @@ public:
           land->SetTrials(m_sample_size);
           jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::TestPairs));
         } else {
-          jobqueue.AddJob(new tAnalyzeJob<cLandscape>(land, &cLandscape::TestAllPairs));
+          land->SetJobQueue(&jobqueue);
+          land->TestAllPairs(ctx);
         }
         m_batch.PushRear(land);
       }
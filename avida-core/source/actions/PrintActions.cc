@@ -28,6 +28,7 @@
 #include "avida/data/Package.h"
 #include "avida/data/Recorder.h"
 #include "avida/output/File.h"
+#include "avida/output/Manager.h"
 #include "avida/systematics/Arbiter.h"
 #include "avida/systematics/Group.h"
 #include "avida/systematics/Manager.h"
@@ -41,7 +42,10 @@
 #include "cAnalyze.h"
 #include "cAnalyzeGenotype.h"
 #include "cCPUTestInfo.h"
+#include "cEditDistance.h"
 #include "cEnvironment.h"
+#include "cGenomeUtil.h"
+#include "cGridStream.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cHistogram.h"
@@ -3256,6 +3260,7 @@ protected:
 		}
 		
 		cDoubleSum edit_distance;
+		cEditDistance workspace;
 		for(unsigned int i=0; i<sample_pairs; ++i) {
 			cOrganism* a = organisms.back();
 			organisms.pop_back();
@@ -3265,7 +3270,7 @@ protected:
       ConstInstructionSequencePtr a_seq, b_seq;
       a_seq.DynamicCastFrom(a->GetGenome().Representation());
       b_seq.DynamicCastFrom(b->GetGenome().Representation());
-			edit_distance.Add(InstructionSequence::FindEditDistance(*a_seq, *b_seq));
+			edit_distance.Add(cGenomeUtil::EditDistance(workspace, *a_seq, *b_seq));
 		}
 		
 		return edit_distance.Average();
@@ -3367,67 +3372,179 @@ public:
   }
 };
 
-class cActionDumpFitnessGrid : public cAction
+/* A grid stream kept by the output manager, so that every dump action given the same path appends to one file rather
+   than each replacing it with its own. */
+class cGridStreamSocket : public Output::Socket
 {
+public:
+  typedef Apto::SmartPtr<cGridStreamSocket, Apto::InternalRCObject> Ptr;
+  
 private:
+  cGridStreamWriter m_writer;
+  bool m_failed;
+  
+  cGridStreamSocket(World* world, const Output::OutputID& output_id) : Output::Socket(world, output_id), m_failed(false) { ; }
+  
+public:
+  // The stream for path, opened by whichever action dumps to it first; NULL if the path is in use by other output
+  static Ptr StaticWithPath(World* world, const Apto::String& path)
+  {
+    Output::ManagerPtr mgr = Output::Manager::Of(world);
+    Output::OutputID oid = mgr->OutputIDFromPath(path);
+    if (oid.GetSize() == 0) return Ptr(NULL);
+    
+    Ptr rtn;
+    Output::SocketPtr socket = RetrieveStatic(mgr, oid);
+    rtn.DynamicCastFrom(socket);
+    if (!rtn && !socket && !mgr->IsOpen(oid)) {
+      rtn = Ptr(new cGridStreamSocket(world, oid));
+      if (!rtn->registerAsStatic()) return Ptr(NULL);
+    }
+    return rtn;
+  }
+  
+  const Output::OutputID& Name() const { return m_output_id; }
+  cGridStreamWriter& Writer() { return m_writer; }
+  bool Failed() const { return m_failed; }
+  void SetFailed() { m_failed = true; }
+  
+  void Flush() { m_writer.Flush(); }
+};
+
+/* Base for the grid dumps that can also write a grid stream.  Given a file name ending in ".gstream", every dump is
+   appended as one frame of that single binary file (see cGridStream.h, and the grid_stream utility for reading it back)
+   rather than written as a new text file named for the update.  Dumps given the same stream share it, and must dump
+   the same kind of value. */
+class cActionDumpGrid : public cAction
+{
+protected:
   cString m_filename;
   
+private:
+  cGridStreamSocket::Ptr m_stream;
+  bool m_stream_failed;
+  
+  static cGridStream::eCellType cellType(const int*) { return cGridStream::CELL_INT; }
+  static cGridStream::eCellType cellType(const double*) { return cGridStream::CELL_DOUBLE; }
+  
+protected:
+  cActionDumpGrid(cWorld* world, const cString& args) : cAction(world, args), m_filename(""), m_stream_failed(false) { ; }
+  
+  bool IsStream() const
+  {
+    const int ext_size = 8;  // ".gstream"
+    return m_filename.GetSize() > ext_size && m_filename.IsSubstring(".gstream", m_filename.GetSize() - ext_size);
+  }
+  
+  // Writes values, given row by row for the whole world, to the stream or to the text file named filename
+  template <typename T> void DumpGrid(cAvidaContext& ctx, const cString& filename, const Apto::Array<T>& values)
+  {
+    const int world_x = m_world->GetPopulation().GetWorldX();
+    const int world_y = m_world->GetPopulation().GetWorldY();
+    
+    if (IsStream()) {
+      if (m_stream_failed) return;
+      if (!m_stream) {
+        m_stream = cGridStreamSocket::StaticWithPath(m_world->GetNewWorld(), Apto::String((const char*)m_filename));
+        if (!m_stream) {
+          ctx.Driver().Feedback().Error("unable to open grid stream '%s': invalid path, or already in use by other output", (const char*)m_filename);
+          m_stream_failed = true;
+          return;
+        }
+      }
+      
+      // Another action may have opened the stream, or found it unusable, already
+      if (m_stream->Failed()) return;
+      cGridStreamWriter& writer = m_stream->Writer();
+      if (!writer.IsOpen()) {
+        cString error;
+        if (!writer.Open((const char*)m_stream->Name(), world_x, world_y, cellType(&values[0]), 32, true, &error)) {
+          ctx.Driver().Feedback().Error("unable to open grid stream '%s': %s", (const char*)m_filename, (const char*)error);
+          m_stream->SetFailed();
+          return;
+        }
+      }
+      if (writer.GetCellType() != cellType(&values[0])) {
+        ctx.Driver().Feedback().Error("unable to write to grid stream '%s': another dump writes a different kind of value",
+                                      (const char*)m_filename);
+        m_stream_failed = true;
+        return;
+      }
+      if (!writer.WriteFrame(m_world->GetStats().GetUpdate(), &values[0])) {
+        ctx.Driver().Feedback().Error("unable to write to grid stream '%s'", (const char*)m_filename);
+        m_stream->SetFailed();
+      }
+      return;
+    }
+    
+    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
+    ofstream& fp = df->OFStream();
+    for (int j = 0; j < world_y; j++) {
+      for (int i = 0; i < world_x; i++) fp << values[j * world_x + i] << " ";
+      fp << "\n";
+    }
+    fp.flush();
+  }
+};
+
+
+class cActionDumpFitnessGrid : public cActionDumpGrid
+{
+private:
+  Apto::Array<double> m_values;
+  
 public:
-  cActionDumpFitnessGrid(cWorld* world, const cString& args, Feedback&) : cAction(world, args), m_filename("")
+  cActionDumpFitnessGrid(cWorld* world, const cString& args, Feedback&) : cActionDumpGrid(world, args)
   {
     cString largs(args);
     if (largs.GetSize()) m_filename = largs.PopWord();
   }
-  static const cString GetDescription() { return "Arguments: [string fname='']"; }
-  void Process(cAvidaContext&)
+  static const cString GetDescription() { return "Arguments: [string fname=''] (a name ending in .gstream writes a grid stream)"; }
+  void Process(cAvidaContext& ctx)
   {
     cString filename(m_filename);
     if (filename == "") filename.Set("grid_fitness-%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
     
-      for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
-      for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
-        cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
-        double fitness = (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().GetFitness() : 0.0;
-        fp << fitness << " ";
-      }
-      fp << endl;
+    cPopulation& pop = m_world->GetPopulation();
+    m_values.ResizeClear(pop.GetSize());
+    for (int cell_id = 0; cell_id < pop.GetSize(); cell_id++) {
+      cPopulationCell& cell = pop.GetCell(cell_id);
+      m_values[cell_id] = (cell.IsOccupied()) ? cell.GetOrganism()->GetPhenotype().GetFitness() : 0.0;
     }
+    DumpGrid(ctx, filename, m_values);
   }
 };
 
 
-class cActionDumpClassificationIDGrid : public cAction
+class cActionDumpClassificationIDGrid : public cActionDumpGrid
 {
 private:
-  cString m_filename;
   cString m_role;
+  Apto::Array<int> m_values;
   
 public:
-  cActionDumpClassificationIDGrid(cWorld* world, const cString& args, Feedback&) : cAction(world, args), m_filename(""), m_role("genotype")
+  cActionDumpClassificationIDGrid(cWorld* world, const cString& args, Feedback&) : cActionDumpGrid(world, args), m_role("genotype")
   {
     cString largs(args);
     if (largs.GetSize()) m_filename = largs.PopWord();
     if (largs.GetSize()) m_role = largs.PopWord();
   }
-  static const cString GetDescription() { return "Arguments: [string fname_prefix='']"; }
-  void Process(cAvidaContext&)
+  static const cString GetDescription() { return "Arguments: [string fname_prefix=''] [string role='genotype'] (a name ending in .gstream writes a grid stream)"; }
+  void Process(cAvidaContext& ctx)
   {
     cString filename(m_filename);
     if (filename == "") filename = "grid_class_id";
     filename.Set("%s-%d.dat", (const char*)filename, m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
     
-    for (int j = 0; j < m_world->GetPopulation().GetWorldY(); j++) {
-      for (int i = 0; i < m_world->GetPopulation().GetWorldX(); i++) {
-        cPopulationCell& cell = m_world->GetPopulation().GetCell(j * m_world->GetPopulation().GetWorldX() + i);
-        int id = (cell.IsOccupied() && cell.GetOrganism()->SystematicsGroup((const char*)m_role)) ? cell.GetOrganism()->SystematicsGroup((const char*)m_role)->ID() : -1;
-        fp << id << " ";
-      }
-      fp << endl;
+    cPopulation& pop = m_world->GetPopulation();
+    m_values.ResizeClear(pop.GetSize());
+    for (int cell_id = 0; cell_id < pop.GetSize(); cell_id++) {
+      cPopulationCell& cell = pop.GetCell(cell_id);
+      Systematics::GroupPtr group;
+      if (cell.IsOccupied()) group = cell.GetOrganism()->SystematicsGroup((const char*)m_role);
+      m_values[cell_id] = (group) ? group->ID() : -1;
     }
+    DumpGrid(ctx, filename, m_values);
   }
 };
 
@@ -3787,50 +3904,47 @@ public:
 };
 
 
-class cActionDumpTaskGrid : public cAction
+class cActionDumpTaskGrid : public cActionDumpGrid
 {
 private:
-  cString m_filename;
+  Apto::Array<int> m_values;
   
 public:
-  cActionDumpTaskGrid(cWorld* world, const cString& args, Feedback&) : cAction(world, args), m_filename("")
+  cActionDumpTaskGrid(cWorld* world, const cString& args, Feedback&) : cActionDumpGrid(world, args)
   {
     cString largs(args);
     if (largs.GetSize()) m_filename = largs.PopWord();
   }
-  static const cString GetDescription() { return "Arguments: [string fname='']"; }
+  static const cString GetDescription() { return "Arguments: [string fname=''] (a name ending in .gstream writes a grid stream)"; }
   void Process(cAvidaContext& ctx)
   {
     cString filename(m_filename);
     if (filename == "") filename.Set("grid_task.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
     
     cPopulation* pop = &m_world->GetPopulation();
     cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
     
     const int num_tasks = m_world->GetEnvironment().GetNumTasks();
     
-    for (int i = 0; i < pop->GetWorldY(); i++) {
-      for (int j = 0; j < pop->GetWorldX(); j++) {
-        int task_sum = -1;
-        int cell_num = i * pop->GetWorldX() + j;
-        if (pop->GetCell(cell_num).IsOccupied() == true) {
-	  task_sum = 0;
-          cOrganism* organism = pop->GetCell(cell_num).GetOrganism();
-          cCPUTestInfo test_info;
-          testcpu->TestGenome(ctx, test_info, organism->GetGenome());
-          cPhenotype& test_phenotype = test_info.GetTestPhenotype();
-          for (int k = 0; k < num_tasks; k++) {
-            if (test_phenotype.GetLastTaskCount()[k] > 0) task_sum += static_cast<int>(pow(2.0, k));
-          }
+    m_values.ResizeClear(pop->GetSize());
+    for (int cell_num = 0; cell_num < pop->GetSize(); cell_num++) {
+      int task_sum = -1;
+      if (pop->GetCell(cell_num).IsOccupied() == true) {
+        task_sum = 0;
+        cOrganism* organism = pop->GetCell(cell_num).GetOrganism();
+        cCPUTestInfo test_info;
+        testcpu->TestGenome(ctx, test_info, organism->GetGenome());
+        cPhenotype& test_phenotype = test_info.GetTestPhenotype();
+        for (int k = 0; k < num_tasks; k++) {
+          if (test_phenotype.GetLastTaskCount()[k] > 0) task_sum += static_cast<int>(pow(2.0, k));
         }
-        fp << task_sum << " ";
       }
-      fp << endl;
+      m_values[cell_num] = task_sum;
     }
     
     delete testcpu;
+    
+    DumpGrid(ctx, filename, m_values);
   }
 };
 
@@ -4187,46 +4301,40 @@ public:
 
 //Dump the reaction grid from the last gestation cycle, so skip the
 //test cpu, and just use what the phenotype has.
-class cActionDumpReactionGrid : public cAction
+class cActionDumpReactionGrid : public cActionDumpGrid
 {
 private:
-  cString m_filename;
+  Apto::Array<int> m_values;
   
 public:
-  cActionDumpReactionGrid(cWorld* world, const cString& args, Feedback&) : cAction(world, args), m_filename("")
+  cActionDumpReactionGrid(cWorld* world, const cString& args, Feedback&) : cActionDumpGrid(world, args)
   {
     cString largs(args);
     if (largs.GetSize()) m_filename = largs.PopWord();
   }
-  static const cString GetDescription() { return "Arguments: [string fname='']"; }
-  void Process(cAvidaContext&)
+  static const cString GetDescription() { return "Arguments: [string fname=''] (a name ending in .gstream writes a grid stream)"; }
+  void Process(cAvidaContext& ctx)
   {
     cString filename(m_filename);
     if (filename == "") filename.Set("grid_reactions.%d.dat", m_world->GetStats().GetUpdate());
-    Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), (const char*)filename);
-    ofstream& fp = df->OFStream();
     
     cPopulation* pop = &m_world->GetPopulation();
     
     const int num_tasks = m_world->GetEnvironment().GetNumTasks();
     
-      for (int j = 0; j < pop->GetWorldY(); j++) {
-      for (int i = 0; i < pop->GetWorldX(); i++) {
-        int task_sum = 0;
-        int cell_num = j * pop->GetWorldX() + i;
-        if (pop->GetCell(cell_num).IsOccupied() == true) {
-          cOrganism* organism = pop->GetCell(cell_num).GetOrganism();
-          
-          cPhenotype& test_phenotype = organism->GetPhenotype();
-          for (int k = 0; k < num_tasks; k++) {
-            if (test_phenotype.GetLastReactionCount()[k] > 0) task_sum += static_cast<int>(pow(2.0, k));
-          }
+    m_values.ResizeClear(pop->GetSize());
+    for (int cell_num = 0; cell_num < pop->GetSize(); cell_num++) {
+      int task_sum = -1;
+      if (pop->GetCell(cell_num).IsOccupied() == true) {
+        task_sum = 0;
+        cPhenotype& test_phenotype = pop->GetCell(cell_num).GetOrganism()->GetPhenotype();
+        for (int k = 0; k < num_tasks; k++) {
+          if (test_phenotype.GetLastReactionCount()[k] > 0) task_sum += static_cast<int>(pow(2.0, k));
         }
-        else {task_sum = -1;}
-        fp << task_sum << " ";
       }
-      fp << endl;
+      m_values[cell_num] = task_sum;
     }
+    DumpGrid(ctx, filename, m_values);
   }
 };
 
@@ -166,11 +166,12 @@ private:
     bool m_save_avatars;
     bool m_save_rebirth;
     bool m_plain_name;
+    bool m_binary;
 
 public:
     cActionSavePopulation(cWorld *world, const cString &args, Feedback &feedback)
             : cAction(world, args), m_filename(""), m_save_historic(true), m_save_group_info(false),
-              m_save_avatars(false), m_save_rebirth(false), m_plain_name(false) {
+              m_save_avatars(false), m_save_rebirth(false), m_plain_name(false), m_binary(false) {
         cArgSchema schema(':', '=');
 
         // String Entries
@@ -182,6 +183,7 @@ public:
         schema.AddEntry("save_avatars", 2, 0, 1, 0);
         schema.AddEntry("save_rebirth", 3, 0, 1, 0);
         schema.AddEntry("plain_name", 4, 0, 1, 0);
+        schema.AddEntry("binary", 5, 0, 1, 0);
 
         cArgContainer *argc = cArgContainer::Load(args, schema, feedback);
 
@@ -192,24 +194,27 @@ public:
             m_save_avatars = argc->GetInt(2);
             m_save_rebirth = argc->GetInt(3);
             m_plain_name = argc->GetInt(4);
+            m_binary = argc->GetInt(5);
         }
 
         delete argc;
     }
 
     static const cString
-    GetDescription() { return "Arguments: [string filename='detail'] [boolean save_historic=1] [boolean save_groups=0] [boolean save_avatars=0] [boolean save_rebirth=0] [boolean plain_name=0]"; }
+    GetDescription() { return "Arguments: [string filename='detail'] [boolean save_historic=1] [boolean save_groups=0] [boolean save_avatars=0] [boolean save_rebirth=0] [boolean plain_name=0] [boolean binary=0]"; }
 
     void Process(cAvidaContext &) {
+        // Binary checkpoints are detected by LoadPopulation from their header, the extension is only a hint
+        const char *ext = (m_binary) ? "bpop" : "spop";
         int update = m_world->GetStats().GetUpdate();
-        cString filename = cStringUtil::Stringf("%s-%d.spop", (const char *) m_filename, update);
+        cString filename = cStringUtil::Stringf("%s-%d.%s", (const char *) m_filename, update, ext);
 
         if (m_plain_name) {
-            filename = cStringUtil::Stringf("%s.spop", (const char *) m_filename);
+            filename = cStringUtil::Stringf("%s.%s", (const char *) m_filename, ext);
         }
 
         m_world->GetPopulation().SavePopulation(filename, m_save_historic, m_save_group_info, m_save_avatars,
-                                                m_save_rebirth);
+                                                m_save_rebirth, m_binary);
     }
 };
 
@@ -314,6 +319,58 @@ public:
     }
 };
 
+class cActionSaveSnapshot : public cAction {
+private:
+    cString m_filename;
+
+public:
+    cActionSaveSnapshot(cWorld *world, const cString &args, Feedback &feedback) : cAction(world, args),
+                                                                                  m_filename("snapshot") {
+        cArgSchema schema(':', '=');
+
+        // String Entries
+        schema.AddEntry("filename", 0, "snapshot");
+
+        cArgContainer *argc = cArgContainer::Load(args, schema, feedback);
+
+        if (argc) {
+            m_filename = argc->GetString(0);
+        }
+
+        delete argc;
+    }
+
+    static const cString GetDescription() { return "Arguments: [string filename='snapshot']"; }
+
+    void Process(cAvidaContext &) {
+        int update = m_world->GetStats().GetUpdate();
+        cString filename = cStringUtil::Stringf("%s-%d.snap", (const char *) m_filename, update);
+        if (!m_world->GetPopulation().SaveSnapshot(filename)) {
+            m_world->GetDriver().Feedback().Error("failed to save snapshot");
+        }
+    }
+};
+
+class cActionLoadSnapshot : public cAction {
+private:
+    cString m_filename;
+
+public:
+    cActionLoadSnapshot(cWorld *world, const cString &args, Feedback &) : cAction(world, args), m_filename("") {
+        cString largs(args);
+        if (largs.GetSize()) m_filename = largs.PopWord();
+    }
+
+    static const cString GetDescription() { return "Arguments: <cString fname>"; }
+
+    void Process(cAvidaContext &ctx) {
+        if (!m_world->GetPopulation().LoadSnapshot(m_filename, ctx)) {
+            m_world->GetDriver().Feedback().Error("failed to load snapshot");
+            m_world->GetDriver().Abort(Avida::INVALID_CONFIG);
+        }
+    }
+};
+
 void RegisterSaveLoadActions(cActionLibrary *action_lib) {
     action_lib->Register<cActionLoadParasiteGenotypeList>("LoadParasiteGenotypeList");
     action_lib->Register<cActionLoadHostGenotypeList>("LoadHostGenotypeList");
@@ -323,4 +380,6 @@ void RegisterSaveLoadActions(cActionLibrary *action_lib) {
     action_lib->Register<cActionLoadStructuredSystematicsGroup>("LoadStructuredSystematicsGroup");
     action_lib->Register<cActionSaveStructuredSystematicsGroup>("SaveStructuredSystematicsGroup");
     action_lib->Register<cActionSaveFlameData>("SaveFlameData");
+    action_lib->Register<cActionSaveSnapshot>("SaveSnapshot");
+    action_lib->Register<cActionLoadSnapshot>("LoadSnapshot");
 }
@@ -31,6 +31,7 @@
 
 #include "avida/private/util/GenomeLoader.h"
 
+#include "apto/core/FileSystem.h"
 #include "apto/rng.h"
 #include "apto/scheduler.h"
 
@@ -47,13 +48,16 @@
 #include "cAnalyzeTreeStats_Gamma.h"
 #include "cAvidaContext.h"
 #include "cCPUTestInfo.h"
+#include "cEditDistance.h"
 #include "cEnvironment.h"
+#include "cGenomeUtil.h"
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cHardwareStatusPrinter.h"
 #include "cInitFile.h"
 #include "cInstSet.h"
 #include "cLandscape.h"
+#include "cLineReader.h"
 #include "cModularityAnalysis.h"
 #include "cPhenotype.h"
 #include "cPhenPlastGenotype.h"
@@ -73,6 +77,7 @@
 #include "tDataEntryCommand.h"
 #include "tMatrix.h"
 
+#include <climits>
 #include <iomanip>
 #include <fstream>
 #include <sstream>
@@ -318,32 +323,93 @@ void cAnalyze::LoadResources(cString cur_string) {
 }
 
 void cAnalyze::LoadFile(cString cur_string) {
-    // LOAD
+    // LOAD <filename> [min_update=N] [max_update=N] [min_abundance=N] [min_id=N] [max_id=N]
+    //
+    // The file is streamed rather than read into memory, and may be gzip compressed.  Rows outside of the given
+    // ranges (of update_born, num_cpus and id respectively) are rejected from those columns alone, before any
+    // genotype is built for them.
 
     cString filename = cur_string.PopWord();
 
+    struct sRowFilter {
+        const char* column;
+        int min_value;
+        int max_value;
+        int word;
+    };
+    sRowFilter filters[] = {
+        { "update_born", INT_MIN, INT_MAX, -1 },
+        { "num_cpus", INT_MIN, INT_MAX, -1 },
+        { "id", INT_MIN, INT_MAX, -1 }
+    };
+    const int num_filters = sizeof(filters) / sizeof(sRowFilter);
+
+    while (cur_string.GetSize() > 0) {
+        cString value = cur_string.PopWord();
+        cString arg = value.Pop('=');
+        if (arg == "min_update") filters[0].min_value = value.AsInt();
+        else if (arg == "max_update") filters[0].max_value = value.AsInt();
+        else if (arg == "min_abundance") filters[1].min_value = value.AsInt();
+        else if (arg == "min_id") filters[2].min_value = value.AsInt();
+        else if (arg == "max_id") filters[2].max_value = value.AsInt();
+        else {
+            cerr << "error: unknown LOAD filter '" << arg << "'." << endl;
+            if (exit_on_error) exit(1);
+            return;
+        }
+    }
+
     cout << "Loading: " << filename << endl;
 
-    cInitFile input_file(filename, m_world->GetWorkingDir());
-    if (!input_file.WasOpened()) {
-        const cUserFeedback &feedback = input_file.GetFeedback();
-        for (int i = 0; i < feedback.GetNumMessages(); i++) {
-            switch (feedback.GetMessageType(i)) {
-                case cUserFeedback::UF_ERROR:
-                    cerr << "error: ";
-                    break;
-                case cUserFeedback::UF_WARNING:
-                    cerr << "warning: ";
-                    break;
-                default:
-                    break;
-            };
-            cerr << feedback.GetMessage(i) << endl;
+    cLineReader input_file;
+    cString error;
+    cString path(Apto::FileSystem::GetAbsolutePath(Apto::String(filename), Apto::String(m_world->GetWorkingDir())));
+    if (!input_file.Open(path, &error)) {
+        cerr << "error: " << error << "." << endl;
+        if (exit_on_error) exit(1);
+        return;
+    }
+
+    // Process the directives that precede the data, stopping at the first row
+    cString filetype("unknown");
+    cStringList format;
+    Apto::Array<cLineReader::sWord> words;
+    int num_words = 0;
+    bool have_row = false;
+    while (input_file.ReadLine()) {
+        if (input_file.GetLineSize() > 0 && input_file.GetLine()[0] == '#') {
+            cString directive(input_file.GetLine(), input_file.GetLineSize());
+            cString cmd = directive.PopWord();
+            if (cmd == "#filetype") {
+                filetype = directive.PopWord();
+            } else if (cmd == "#format") {
+                if (format.GetSize() != 0) {
+                    cerr << "error: " << filename << ":" << input_file.GetLineNum() << ": duplicate format directive" << endl;
+                    if (exit_on_error) exit(1);
+                    return;
+                }
+                format.Load(directive);
+            } else if (cmd == "#include" || cmd == "#import") {
+                cerr << "error: " << filename << ":" << input_file.GetLineNum() << ": " << cmd
+                     << " is not supported in genotype files" << endl;
+                if (exit_on_error) exit(1);
+                return;
+            }
+            continue;
         }
+        num_words = input_file.SplitLine(words);
+        if (num_words > 0) {
+            have_row = true;
+            break;
+        }
+    }
+
+    if (input_file.HasError()) {
+        cerr << "error: " << input_file.GetError() << "." << endl;
         if (exit_on_error) exit(1);
+        return;
     }
 
-    const cString filetype = input_file.GetFiletype();
     if (filetype != "population_data" &&  // Deprecated
         filetype != "genotype_data") {
         cerr << "error: cannot load files of type \"" << filetype << "\"." << endl;
@@ -359,7 +425,7 @@ void cAnalyze::LoadFile(cString cur_string) {
     tList<tDataEntryCommand<cAnalyzeGenotype> > output_list;
     tListIterator<tDataEntryCommand<cAnalyzeGenotype> > output_it(output_list);
     cUserFeedback feedback;
-    cAnalyzeGenotype::GetDataCommandManager().LoadCommandList(input_file.GetFormat(), output_list, &feedback);
+    cAnalyzeGenotype::GetDataCommandManager().LoadCommandList(format, output_list, &feedback);
 
     for (int i = 0; i < feedback.GetNumMessages(); i++) {
         switch (feedback.GetMessageType(i)) {
@@ -375,9 +441,31 @@ void cAnalyze::LoadFile(cString cur_string) {
         cerr << feedback.GetMessage(i) << endl;
     }
 
-    if (feedback.GetNumErrors()) return;
+    if (feedback.GetNumErrors()) {
+        while (output_list.GetSize()) delete output_list.Pop();
+        return;
+    }
+
+    // Columns map one to one onto the format, locate those needed by active filters
+    Apto::Array<tDataEntryCommand<cAnalyzeGenotype>*> columns(output_list.GetSize());
+    tDataEntryCommand<cAnalyzeGenotype> *data_command = NULL;
+    for (int i = 0; (data_command = output_it.Next()) != NULL; i++) columns[i] = data_command;
+
+    int num_active_filters = 0;
+    for (int f = 0; f < num_filters; f++) {
+        if (filters[f].min_value == INT_MIN && filters[f].max_value == INT_MAX) continue;
+        for (int i = 0; i < columns.GetSize(); i++) if (columns[i]->GetName() == filters[f].column) filters[f].word = i;
+        if (filters[f].word < 0) {
+            cerr << "error: cannot filter on '" << filters[f].column << "', the column is not in the file." << endl;
+            while (output_list.GetSize()) delete output_list.Pop();
+            if (exit_on_error) exit(1);
+            return;
+        }
+        // Compact the active filters to the front
+        filters[num_active_filters++] = filters[f];
+    }
 
-    bool id_inc = input_file.GetFormat().HasString("id");
+    bool id_inc = format.HasString("id");
 
     // Setup the genome...
     const cInstSet &is = m_world->GetHardwareManager().GetDefaultInstSet();
@@ -385,29 +473,61 @@ void cAnalyze::LoadFile(cString cur_string) {
     cHardwareManager::SetupPropertyMap(props, (const char *) is.GetInstSetName());
     Genome default_genome(is.GetHardwareType(), props, GeneticRepresentationPtr(new InstructionSequence(1)));
     int load_count = 0;
+    int num_filtered = 0;
 
-    for (int line_id = 0; line_id < input_file.GetNumLines(); line_id++) {
-        cString cur_line = input_file.GetLine(line_id);
+    while (have_row) {
+        bool keep = true;
+        for (int f = 0; f < num_active_filters && keep; f++) {
+            int value = 0;
+            keep = (filters[f].word < num_words && cLineReader::ParseInt(words[filters[f].word], value) &&
+                    value >= filters[f].min_value && value <= filters[f].max_value);
+        }
 
-        cAnalyzeGenotype *genotype = new cAnalyzeGenotype(m_world, default_genome);
+        if (keep) {
+            cAnalyzeGenotype *genotype = new cAnalyzeGenotype(m_world, default_genome);
 
-        output_it.Reset();
-        tDataEntryCommand<cAnalyzeGenotype> *data_command = NULL;
-        while ((data_command = output_it.Next()) != NULL) {
-            data_command->SetValue(genotype, cur_line.PopWord());
-        }
+            for (int i = 0; i < columns.GetSize(); i++) {
+                if (i < num_words) columns[i]->SetValue(genotype, cString(words[i].start, words[i].size));
+                else columns[i]->SetValue(genotype, "");
+            }
 
-        // Give this genotype a name.  Base it on the ID if possible.
-        if (id_inc == false) {
-            cString name = cStringUtil::Stringf("org-%d", load_count++);
-            genotype->SetName(name);
+            // Give this genotype a name.  Base it on the ID if possible.
+            if (id_inc == false) {
+                cString name = cStringUtil::Stringf("org-%d", load_count);
+                genotype->SetName(name);
+            } else {
+                cString name = cStringUtil::Stringf("org-%d", genotype->GetID());
+                genotype->SetName(name);
+            }
+            load_count++;
+
+            // Add this genotype to the proper batch.
+            batch[cur_batch].List().PushRear(genotype);
         } else {
-            cString name = cStringUtil::Stringf("org-%d", genotype->GetID());
-            genotype->SetName(name);
+            num_filtered++;
         }
 
-        // Add this genotype to the proper batch.
-        batch[cur_batch].List().PushRear(genotype);
+        // Advance to the next row; directives within the data cannot change its layout and are skipped
+        have_row = false;
+        while (input_file.ReadLine()) {
+            if (input_file.GetLineSize() > 0 && input_file.GetLine()[0] == '#') continue;
+            num_words = input_file.SplitLine(words);
+            if (num_words > 0) {
+                have_row = true;
+                break;
+            }
+        }
+    }
+
+    while (output_list.GetSize()) delete output_list.Pop();
+
+    if (input_file.HasError()) {
+        cerr << "error: " << input_file.GetError() << " (after loading " << load_count << " genotypes)." << endl;
+        if (exit_on_error) exit(1);
+    }
+
+    if (num_active_filters > 0 || m_world->GetVerbosity() >= VERBOSE_ON) {
+        cout << "Loaded " << load_count << " genotypes, " << num_filtered << " rows filtered out." << endl;
     }
 
     // Adjust the flags on this batch
@@ -3313,6 +3433,7 @@ void cAnalyze::CommandPrintDistances(cString cur_string) {
     tListIterator<cAnalyzeGenotype> batch_it1(batch[cur_batch].List());
 
     int watermark = 0;
+    cEditDistance edit_distance;
 
     while ((genotype1 = batch_it1.Next()) != NULL) {
         count++;
@@ -3339,7 +3460,7 @@ void cAnalyze::CommandPrintDistances(cString cur_string) {
             genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
             const InstructionSequence &genotype2_seq = *genotype2_seq_p;
 
-            const int cur_dist = InstructionSequence::FindEditDistance(genotype1_seq, genotype2_seq);
+            const int cur_dist = cGenomeUtil::EditDistance(edit_distance, genotype1_seq, genotype2_seq);
             dist_total += cur_pairs * cur_dist;
             if (cur_dist > dist_max) dist_max = cur_dist;
             pair_count += cur_pairs;
@@ -7851,6 +7972,7 @@ void cAnalyze::CommandLevenstein(cString cur_string) {
     cAnalyzeGenotype *genotype2 = NULL;
     double total_dist = 0;
     double total_count = 0;
+    cEditDistance edit_distance;
 
     tListIterator<cAnalyzeGenotype> list1_it(batch[batch1].List());
     tListIterator<cAnalyzeGenotype> list2_it(batch[batch2].List());
@@ -7879,7 +8001,7 @@ void cAnalyze::CommandLevenstein(cString cur_string) {
             genotype2_seq_p.DynamicCastFrom(genotype2_rep_p);
             const InstructionSequence &genotype2_seq = *genotype2_seq_p;
 
-            const int dist = InstructionSequence::FindEditDistance(genotype1_seq, genotype2_seq);
+            const int dist = cGenomeUtil::EditDistance(edit_distance, genotype1_seq, genotype2_seq);
             total_dist += dist * num_pairs;
             total_count += num_pairs;
         }
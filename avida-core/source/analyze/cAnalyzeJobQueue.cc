@@ -38,7 +38,8 @@ using namespace Avida;
 
 
 cAnalyzeJobQueue::cAnalyzeJobQueue(cWorld* world)
-: m_world(world), m_last_jobid(0), m_jobs(0), m_pending(0), m_workers(Apto::Platform::AvailableCPUs())
+: m_world(world), m_last_jobid(0), m_outstanding(0), m_generation(0), m_shutdown(false)
+, m_workers(Apto::Platform::AvailableCPUs())
 {
   const int max_workers = world->GetConfig().MAX_CONCURRENCY.Get();
   if (max_workers > 0 && max_workers < m_workers.GetSize()) m_workers.Resize(max_workers);
@@ -46,8 +47,10 @@ cAnalyzeJobQueue::cAnalyzeJobQueue(cWorld* world)
   m_job_seed_rng = new Apto::RNG::AvidaRNG(world->GetRandom().GetInt(world->GetRandom().MaxSeed()));
   
   if (m_workers.GetSize() > 1) {
+    m_deques.Resize(m_workers.GetSize());
+    for (int i = 0; i < m_deques.GetSize(); i++) m_deques[i] = new sJobDeque;
     for (int i = 0; i < m_workers.GetSize(); i++) {
-      m_workers[i] = new cAnalyzeJobWorker(this);
+      m_workers[i] = new cAnalyzeJobWorker(this, i);
       m_workers[i]->Start();
     }
   } else {
@@ -63,46 +66,78 @@ cAnalyzeJobQueue::~cAnalyzeJobQueue()
   
   // Clean out any waiting jobs
   cAnalyzeJob* job;
-  while ((job = m_queue.Pop())) delete job;
+  while ((job = m_submitted.Pop())) delete job;
+  for (int i = 0; i < m_deques.GetSize(); i++) {
+    Apto::MutexAutoLock lock(m_deques[i]->mutex);
+    while ((job = m_deques[i]->jobs.Pop())) delete job;
+  }
   
-  // Set job count so that all workers receive NULL jobs
-  m_jobs = num_workers;
+  m_shutdown = true;
   
   m_mutex.Unlock();
   
-  // Signal all workers to check job queue
+  // Signal all workers to shut down
   m_cond.Broadcast();
   
   for (int i = 0; i < num_workers; i++) {
     m_workers[i]->Join();
     delete m_workers[i];
   }
+  for (int i = 0; i < m_deques.GetSize(); i++) delete m_deques[i];
   
   delete m_job_seed_rng;
 }
 
 inline void cAnalyzeJobQueue::queueJob(cAnalyzeJob* job)
 {
-  if (m_workers.GetSize()) m_queue.PushRear(job);
-  else singleThreadedJobExecution(job);
+  job->SetID(m_last_jobid++);
+  job->SetSeed(m_job_seed_rng->GetInt(m_job_seed_rng->MaxSeed()));
+  
+  if (m_workers.GetSize()) {
+    m_submitted.PushRear(job);
+    m_outstanding++;
+    if (m_submitted.GetSize() >= SUBMIT_BATCH_SIZE) distributeJobs();
+  }
+}
+
+void cAnalyzeJobQueue::distributeJobs()
+{
+  // Must be called with m_mutex held
+  const int num_jobs = m_submitted.GetSize();
+  if (!num_jobs) return;
+  
+  // Hand out contiguous blocks, so that neighboring jobs tend to be run by the same worker
+  const int num_deques = m_deques.GetSize();
+  for (int i = 0; i < num_deques; i++) {
+    const int block_end = (num_jobs * (i + 1)) / num_deques;
+    const int block_start = (num_jobs * i) / num_deques;
+    if (block_start == block_end) continue;
+    
+    Apto::MutexAutoLock lock(m_deques[i]->mutex);
+    for (int j = block_start; j < block_end; j++) m_deques[i]->jobs.PushRear(m_submitted.Pop());
+  }
+  
+  m_generation++;
+  m_cond.Broadcast();
 }
 
 void cAnalyzeJobQueue::AddJob(cAnalyzeJob* job)
 {
-  Apto::MutexAutoLock lock(m_mutex);
-  job->SetID(m_last_jobid++);
+  m_mutex.Lock();
   queueJob(job);
-  m_jobs++;
+  m_mutex.Unlock();
+  
+  if (!m_workers.GetSize()) singleThreadedJobExecution(job);
 }
 
 void cAnalyzeJobQueue::AddJobImmediate(cAnalyzeJob* job)
 {
   m_mutex.Lock();
-  job->SetID(m_last_jobid++);
   queueJob(job);
-  m_jobs++;
-  m_mutex.Unlock(); // should unlock prior to signaling condition variable
-  m_cond.Signal();
+  distributeJobs();
+  m_mutex.Unlock();
+  
+  if (!m_workers.GetSize()) singleThreadedJobExecution(job);
 }
 
 
@@ -111,7 +146,8 @@ void cAnalyzeJobQueue::Start()
   if (m_world->GetVerbosity() >= VERBOSE_DETAILS)
     m_world->GetDriver().Feedback().Notify("waking worker threads...");
 
-  m_cond.Broadcast();
+  Apto::MutexAutoLock lock(m_mutex);
+  distributeJobs();
 }
 
 
@@ -120,11 +156,11 @@ void cAnalyzeJobQueue::Execute()
   if (m_world->GetVerbosity() >= VERBOSE_DETAILS)
     m_world->GetDriver().Feedback().Notify("waking worker threads...");
 
-  m_cond.Broadcast();
+  m_mutex.Lock();
+  distributeJobs();
   
   // Wait for term signal
-  m_mutex.Lock();
-  while (m_jobs > 0 || m_pending > 0) {
+  while (m_outstanding > 0) {
     m_term_cond.Wait(m_mutex);
   }
   m_mutex.Unlock();
@@ -133,11 +169,42 @@ void cAnalyzeJobQueue::Execute()
     m_world->GetDriver().Feedback().Notify("job queue complete");
 }
 
+
+cAnalyzeJob* cAnalyzeJobQueue::takeJob(int worker_id)
+{
+  cAnalyzeJob* job = NULL;
+  
+  // Take from the front of our own deque first...
+  sJobDeque* own = m_deques[worker_id];
+  own->mutex.Lock();
+  job = own->jobs.Pop();
+  own->mutex.Unlock();
+  if (job) return job;
+  
+  // ...otherwise attempt to steal from the rear of another worker's deque
+  const int num_deques = m_deques.GetSize();
+  for (int i = 1; i < num_deques && !job; i++) {
+    sJobDeque* victim = m_deques[(worker_id + i) % num_deques];
+    victim->mutex.Lock();
+    job = victim->jobs.PopRear();
+    victim->mutex.Unlock();
+  }
+  
+  return job;
+}
+
+void cAnalyzeJobQueue::reportCompleted(int num_jobs)
+{
+  // Must be called with m_mutex held
+  m_outstanding -= num_jobs;
+  if (num_jobs && !m_outstanding) m_term_cond.Broadcast();
+}
+
+
 void cAnalyzeJobQueue::singleThreadedJobExecution(cAnalyzeJob* job)
 {
-  Apto::RNG::AvidaRNG rng(GetSeedForJob(job->GetID()));
+  Apto::RNG::AvidaRNG rng(job->GetSeed());
   cAvidaContext ctx(&m_world->GetDriver(), rng);
   job->Run(ctx);
   delete job;
 }
-
@@ -26,6 +26,7 @@
 #include "apto/platform.h"
 
 #include "cAnalyzeJob.h"
+#include "tAnalyzeJobRange.h"
 #include "tList.h"
 
 class cAnalyzeJobWorker;
@@ -39,27 +40,51 @@ class cWorld;
 const int MT_RANDOM_INDEX_MASK = 0x7F;
 
 
+// Jobs are handed out through a work-stealing scheduler.  Each worker owns a deque of jobs, protected by its own lock.
+// Workers take jobs from the front of their own deque, and when it runs dry steal from the rear of the other workers'
+// deques.  Submitted jobs are collected and distributed across the deques in contiguous blocks, either once a batch
+// fills up or when the queue is started.  The shared queue lock is only taken on submission and when a worker runs
+// out of work, at which point it reports its completed jobs.
+//
+// Every job is assigned a random seed at submission, drawn serially in job ID order, so results do not depend on the
+// number of workers or on which worker ends up running a given job.
+
 class cAnalyzeJobQueue
 {
   friend class cAnalyzeJobWorker;
   
 private:
+  static const int SUBMIT_BATCH_SIZE = 256;
+  
+  struct sJobDeque
+  {
+    Apto::Mutex mutex;
+    tList<cAnalyzeJob> jobs;
+  };
+  
   cWorld* m_world;
-  tList<cAnalyzeJob> m_queue;
+  tList<cAnalyzeJob> m_submitted;   // jobs that have not yet been distributed to the workers
   int m_last_jobid;
   Apto::Random* m_job_seed_rng;
   Apto::Mutex m_mutex;
   Apto::ConditionVariable m_cond;
   Apto::ConditionVariable m_term_cond;
   
-  volatile int m_jobs;      // count of waiting jobs, used in condition variable constructs
-  volatile int m_pending;   // count of currently executing jobs
+  volatile int m_outstanding;   // count of jobs that have been submitted, but not yet reported complete
+  volatile int m_generation;    // incremented each time jobs are distributed, wakes idle workers
+  volatile bool m_shutdown;
   
   Apto::Array<cAnalyzeJobWorker*> m_workers;
+  Apto::Array<sJobDeque*> m_deques;
 
 
   void singleThreadedJobExecution(cAnalyzeJob* job);
   inline void queueJob(cAnalyzeJob* job);
+  void distributeJobs();
+  
+  // Called by workers
+  cAnalyzeJob* takeJob(int worker_id);
+  void reportCompleted(int num_jobs);
 
   
   cAnalyzeJobQueue(); // @not_implemented
@@ -77,7 +102,25 @@ public:
   void Start();
   void Execute();
   
+  // Call (target->*fun)(ctx, i) for every i in [0, count) across the workers, returning once all have completed.
+  // Indices are grouped into jobs of grain_size each.  The grouping does not depend on the number of workers, so each
+  // group is run with the same random seed regardless of concurrency.
+  template <class T> void ParallelFor(T* target, void (T::*fun)(cAvidaContext&, int), int count, int grain_size = 16);
+  
+  int GetNumWorkers() const { return m_workers.GetSize(); }
   int GetSeedForJob(int jobid) { Apto::MutexAutoLock lock(m_mutex); return m_job_seed_rng->GetInt(m_job_seed_rng->MaxSeed()); }
 };
 
+
+template <class T> void cAnalyzeJobQueue::ParallelFor(T* target, void (T::*fun)(cAvidaContext&, int), int count,
+                                                      int grain_size)
+{
+  if (grain_size < 1) grain_size = 1;
+  for (int begin = 0; begin < count; begin += grain_size) {
+    const int end = (begin + grain_size < count) ? begin + grain_size : count;
+    AddJob(new tAnalyzeJobRange<T>(target, fun, begin, end));
+  }
+  Execute();
+}
+
 #endif
@@ -32,34 +32,35 @@ void cAnalyzeJobWorker::Run()
   cAvidaContext ctx(&m_queue->m_world->GetDriver(), rng);
   ctx.SetAnalyzeMode();
   
-  cAnalyzeJob* job = NULL;
+  int completed = 0;
+  int last_generation = 0;
   
   while (1) {
-    m_queue->m_mutex.Lock();
-    while (m_queue->m_jobs == 0) {
-      m_queue->m_cond.Wait(m_queue->m_mutex);
-    }
-    job = m_queue->m_queue.Pop();
-    m_queue->m_jobs--;
-    m_queue->m_pending++; 
-    m_queue->m_mutex.Unlock();
+    cAnalyzeJob* job = m_queue->takeJob(m_id);
     
     if (job) {
-      // Set RNG from the waiting pool and execute the job
-      rng.ResetSeed(m_queue->GetSeedForJob(job->GetID()));
+      // Set RNG from the seed assigned at submission and execute the job
+      rng.ResetSeed(job->GetSeed());
       job->Run(ctx);
       delete job;
-      m_queue->m_mutex.Lock();
-      int pending = --m_queue->m_pending;
-      m_queue->m_mutex.Unlock();
-      if (!pending) m_queue->m_term_cond.Signal();
-    } else {
-      // Terminate worker on NULL job receipt
-      m_queue->m_mutex.Lock();
-      int pending = --m_queue->m_pending;
-      m_queue->m_mutex.Unlock();
-      if (!pending) m_queue->m_term_cond.Signal();
-      break;
+      completed++;
+      continue;
     }
+    
+    // Out of work, report completed jobs and pick up anything that was submitted from within a job
+    m_queue->m_mutex.Lock();
+    m_queue->reportCompleted(completed);
+    completed = 0;
+    m_queue->distributeJobs();
+    
+    // Sleep until more jobs are distributed
+    while (m_queue->m_generation == last_generation && !m_queue->m_shutdown) {
+      m_queue->m_cond.Wait(m_queue->m_mutex);
+    }
+    last_generation = m_queue->m_generation;
+    const bool shutdown = m_queue->m_shutdown;
+    m_queue->m_mutex.Unlock();
+    
+    if (shutdown) break;
   }
 }
@@ -21,6 +21,7 @@
 
 #include "cMutationalNeighborhood.h"
 
+#include "apto/rng.h"
 #include "avida/output/File.h"
 
 #include "cAnalyze.h"
@@ -39,11 +40,34 @@
 using namespace std;
 
 
-cMutationalNeighborhood::cMutationalNeighborhood(cWorld* world, const Genome& genome, int target)
+// Half-width of the 95% Wilson score interval for the probability count / total
+static double wilsonHalfWidth(int count, int total)
+{
+  const double z = 1.96;
+  const double n = total;
+  const double p = count / n;
+  return z * sqrt(p * (1.0 - p) / n + z * z / (4.0 * n * n)) / (1.0 + z * z / n);
+}
+
+static double maxHalfWidth(int total, int pos, int neg, int neut, int dead)
+{
+  if (total == 0) return 1.0;
+  double width = wilsonHalfWidth(pos, total);
+  width = max(width, wilsonHalfWidth(neg, total));
+  width = max(width, wilsonHalfWidth(neut, total));
+  width = max(width, wilsonHalfWidth(dead, total));
+  return width;
+}
+
+
+cMutationalNeighborhood::cMutationalNeighborhood(cWorld* world, const Genome& genome, int target, int sample_size,
+                                                 double sample_tolerance)
   : m_world(world), m_initialized(false)
   , m_inst_set(m_world->GetHardwareManager().GetInstSet(genome.Properties().Get("instset").StringValue()))
-  , m_target(target), m_base_genome(genome)
+  , m_target(target), m_base_genome(genome), m_sample_size(sample_size), m_sample_tolerance(sample_tolerance)
+  , m_twostep_space_total(0.0), m_merged_batches(0), m_sample_converged(false)
 {
+  if (m_sample_size < 0) m_sample_size = 0;
   InstructionSequencePtr seq;
   seq.DynamicCastFrom(m_base_genome.Representation());
   m_base_genome_size = seq->GetSize();
@@ -56,62 +80,34 @@ void cMutationalNeighborhood::Process(cAvidaContext& ctx)
 {
   m_mutex.Lock();
   if (m_initialized) {
-    int cur_site = m_cur_site++;
+    const int job_id = m_cur_site++;
     m_mutex.Unlock();
 
-    if (cur_site < m_base_genome_size) {
+    sTwoStepBatch* batch = NULL;
+    if (job_id < m_base_genome_size) {
+      int cur_site = job_id;
+      
       // Create test infrastructure
       cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
       cCPUTestInfo test_info;
+      test_info.UseResultCache();
       
-      // Setup One Step Data
+      // Setup One Step Data (peak genomes are only stored once a mutant exceeds the base fitness)
       sStep& opdata = m_onestep_point[cur_site];
       opdata.peak_fitness = m_base_fitness;
-      opdata.peak_genome = m_base_genome;
       opdata.site_count.Resize(m_base_genome_size, 0);
 
       sStep& oidata = m_onestep_insert[cur_site];
       oidata.peak_fitness = m_base_fitness;
-      oidata.peak_genome = m_base_genome;
       oidata.site_count.Resize(m_base_genome_size + 1, 0);
 
       sStep& oddata = m_onestep_delete[cur_site];
       oddata.peak_fitness = m_base_fitness;
-      oddata.peak_genome = m_base_genome;
       oddata.site_count.Resize(m_base_genome_size, 0);
       
       
       // Setup Data Used in Two Step
-      sStep& tpdata = m_twostep_point[cur_site];
-      tpdata.peak_fitness = m_base_fitness;
-      tpdata.peak_genome = m_base_genome;
-      tpdata.site_count.Resize(m_base_genome_size, 0);
-
-      sStep& tidata = m_twostep_insert[cur_site];
-      tidata.peak_fitness = m_base_fitness;
-      tidata.peak_genome = m_base_genome;
-      tidata.site_count.Resize(m_base_genome_size + 2, 0);
-
-      sStep& tddata = m_twostep_delete[cur_site];
-      tddata.peak_fitness = m_base_fitness;
-      tddata.peak_genome = m_base_genome;
-      tddata.site_count.Resize(m_base_genome_size, 0);
-
-      
-      sStep& tipdata = m_insert_point[cur_site];
-      tipdata.peak_fitness = m_base_fitness;
-      tipdata.peak_genome = m_base_genome;
-      tipdata.site_count.Resize(m_base_genome_size + 1, 0);
-      
-      sStep& tiddata = m_insert_delete[cur_site];
-      tiddata.peak_fitness = m_base_fitness;
-      tiddata.peak_genome = m_base_genome;
-      tiddata.site_count.Resize(m_base_genome_size + 1, 0);
-      
-      sStep& tdpdata = m_delete_point[cur_site];
-      tdpdata.peak_fitness = m_base_fitness;
-      tdpdata.peak_genome = m_base_genome;
-      tdpdata.site_count.Resize(m_base_genome_size, 0);
+      if (!m_sample_size) m_site_batches[cur_site] = NewTwoStepBatch();
       
       
       // Do the processing, starting with One Step
@@ -125,38 +121,32 @@ void cMutationalNeighborhood::Process(cAvidaContext& ctx)
         
         sStep& oidata2 = m_onestep_insert[cur_site];
         oidata2.peak_fitness = m_base_fitness;
-        oidata2.peak_genome = m_base_genome;
         oidata2.site_count.Resize(m_base_genome_size + 1, 0);
         
-        sStep& tidata2 = m_twostep_insert[cur_site];
-        tidata2.peak_fitness = m_base_fitness;
-        tidata2.peak_genome = m_base_genome;
-        tidata2.site_count.Resize(m_base_genome_size + 2, 0);
-        
-        sStep& tipdata2 = m_insert_point[cur_site];
-        tipdata2.peak_fitness = m_base_fitness;
-        tipdata2.peak_genome = m_base_genome;
-        tipdata2.site_count.Resize(m_base_genome_size + 1, 0);
-        
-        sStep& tiddata2 = m_insert_delete[cur_site];
-        tiddata2.peak_fitness = m_base_fitness;
-        tiddata2.peak_genome = m_base_genome;
-        tiddata2.site_count.Resize(m_base_genome_size + 1, 0);
+        if (!m_sample_size) m_site_batches[cur_site] = NewTwoStepBatch();
         
         ProcessOneStepInsert(ctx, testcpu, test_info, cur_site); 
       }
 
       // Cleanup
       delete testcpu;
+    } else if (job_id < m_num_jobs) {
+      batch = ProcessSampleBatch(ctx, job_id - m_base_genome_size);
     }
+    
+    m_mutex.Lock();
+    if (job_id < m_base_genome_size) {
+      m_site_done[job_id] = true;
+      MergeCompletedSites();
+    } else if (job_id < m_num_jobs) {
+      m_sample_batches[job_id - m_base_genome_size] = batch;
+      MergeCompletedBatches();
+    }
+    if (++m_completed == m_num_jobs) ProcessComplete(ctx); 
+    m_mutex.Unlock();
   } else {
     ProcessInitialize(ctx);
-    return;
   }
-  
-  m_mutex.Lock();
-  if (++m_completed == m_base_genome_size) ProcessComplete(ctx); 
-  m_mutex.Unlock();
 }
 
 
@@ -167,11 +157,10 @@ void cMutationalNeighborhood::ProcessInitialize(cAvidaContext& ctx)
   cCPUTestInfo test_info;
   testcpu->TestGenome(ctx, test_info, m_base_genome);
   
-  cPhenotype& phenotype = test_info.GetColonyOrganism()->GetPhenotype();
   m_base_fitness = test_info.GetColonyFitness();
-  m_base_merit = phenotype.GetMerit().GetDouble();
-  m_base_gestation = phenotype.GetGestationTime();
-  m_base_tasks = phenotype.GetLastTaskCount();
+  m_base_merit = test_info.GetColonyMerit();
+  m_base_gestation = test_info.GetColonyGestationTime();
+  m_base_tasks = test_info.GetColonyTaskCount();
   
   m_neut_min = m_base_fitness * nHardware::FITNESS_NEUTRAL_MIN;
   m_neut_max = m_base_fitness * nHardware::FITNESS_NEUTRAL_MAX;
@@ -186,18 +175,58 @@ void cMutationalNeighborhood::ProcessInitialize(cAvidaContext& ctx)
   m_onestep_insert.ResizeClear(m_base_genome_size + 1);
   m_onestep_delete.ResizeClear(m_base_genome_size);
   
-  m_twostep_point.ResizeClear(m_base_genome_size);
-  m_twostep_insert.ResizeClear(m_base_genome_size + 1);
-  m_twostep_delete.ResizeClear(m_base_genome_size);
-  
-  m_insert_point.ResizeClear(m_base_genome_size + 1);
-  m_insert_delete.ResizeClear(m_base_genome_size + 1);
-  m_delete_point.ResizeClear(m_base_genome_size);
+  if (!m_sample_size) {
+    m_site_batches.Resize(m_base_genome_size + 1);
+    m_site_batches.SetAll(NULL);
+  }
   
   m_fitness_point.ResizeClear(m_base_genome_size, m_inst_set.GetSize());
   m_fitness_insert.ResizeClear(m_base_genome_size + 1, m_inst_set.GetSize());
   m_fitness_delete.ResizeClear(m_base_genome_size, 1);
   
+  // Per-site results are merged into the aggregates as the sites complete
+  m_op.peak_fitness = m_base_fitness;
+  m_op.peak_genome = m_base_genome;
+  m_op.site_count.Resize(m_base_genome_size, 0);
+  m_oi.peak_fitness = m_base_fitness;
+  m_oi.peak_genome = m_base_genome;
+  m_oi.site_count.Resize(m_base_genome_size + 1, 0);
+  m_od.peak_fitness = m_base_fitness;
+  m_od.peak_genome = m_base_genome;
+  m_od.site_count.Resize(m_base_genome_size, 0);
+  
+  for (int cls = 0; cls < NUM_TWO_STEP_CLASSES; cls++) {
+    sTwoStepAggregate& tsa = GetTwoStepAggregate(cls);
+    tsa.peak_fitness = m_base_fitness;
+    tsa.peak_genome = m_base_genome;
+    tsa.site_count.Resize(GetTwoStepSiteCountSize(cls), 0);
+  }
+  
+  m_site_done.Resize(m_base_genome_size);
+  m_site_done.SetAll(false);
+  m_merged_sites = 0;
+  
+  // Size of each class of two step mutants, as enumerated by the exhaustive processing
+  const double sites = m_base_genome_size;
+  const double insts = m_inst_set.GetSize();
+  m_twostep_space[TWO_STEP_POINT] = sites * (sites - 1.0) / 2.0 * (insts - 1.0) * (insts - 1.0);
+  m_twostep_space[TWO_STEP_INSERT] = (sites + 1.0) * (sites + 2.0) / 2.0 * insts * insts;
+  m_twostep_space[TWO_STEP_DELETE] = sites * (sites - 1.0) / 2.0;
+  m_twostep_space[TWO_STEP_INSERT_POINT] = (sites + 1.0) * insts * sites * (insts - 1.0);
+  m_twostep_space[TWO_STEP_INSERT_DELETE] = (sites + 1.0) * insts * sites;
+  m_twostep_space[TWO_STEP_DELETE_POINT] = sites * (sites - 1.0) * (insts - 1.0);
+  m_twostep_space_total = 0.0;
+  for (int cls = 0; cls < NUM_TWO_STEP_CLASSES; cls++) m_twostep_space_total += m_twostep_space[cls];
+  
+  // Each sample batch gets its own seed, drawn up front so that the samples do not depend on job scheduling
+  int num_batches = 0;
+  if (m_sample_size && m_twostep_space_total > 0.0) num_batches = (m_sample_size + SAMPLE_BATCH_SIZE - 1) / SAMPLE_BATCH_SIZE;
+  m_sample_seeds.Resize(num_batches);
+  for (int i = 0; i < num_batches; i++) m_sample_seeds[i] = ctx.GetRandom().GetInt(ctx.GetRandom().MaxSeed());
+  m_sample_batches.Resize(num_batches);
+  m_sample_batches.SetAll(NULL);
+  
+  m_num_jobs = m_base_genome_size + num_batches;
   m_cur_site = 0;
   m_completed = 0;
   m_initialized = true;
@@ -206,9 +235,9 @@ void cMutationalNeighborhood::ProcessInitialize(cAvidaContext& ctx)
   //  - will allow workers to begin processing if job queue already active
   m_mutex.Unlock();
   
-  // Load enough jobs to process all sites
+  // Load enough jobs to process all sites and sample batches
   cAnalyzeJobQueue& jobqueue = m_world->GetAnalyze().GetJobQueue();
-  for (int i = 0; i < m_base_genome_size; i++)
+  for (int i = 0; i < m_num_jobs; i++)
     jobqueue.AddJob(new tAnalyzeJob<cMutationalNeighborhood>(this, &cMutationalNeighborhood::Process));
   
   jobqueue.Start();
@@ -241,7 +270,7 @@ void cMutationalNeighborhood::ProcessOneStepPoint(cAvidaContext& ctx, cTestCPU*
     seq[cur_site].SetOp(inst_num);
     m_fitness_point[cur_site][inst_num] = ProcessOneStepGenome(ctx, testcpu, test_info, mod_genome, odata, cur_site);
 
-    ProcessTwoStepPoint(ctx, testcpu, test_info, cur_site, mod_genome);
+    if (!m_sample_size) ProcessTwoStepPoint(ctx, testcpu, test_info, cur_site, mod_genome);
   }
 }
 
@@ -264,9 +293,11 @@ void cMutationalNeighborhood::ProcessOneStepInsert(cAvidaContext& ctx, cTestCPU*
     seq[cur_site].SetOp(inst_num);
     m_fitness_insert[cur_site][inst_num] = ProcessOneStepGenome(ctx, testcpu, test_info, mod_genome, odata, cur_site);
     
-    ProcessTwoStepInsert(ctx, testcpu, test_info, cur_site, mod_genome);
-    ProcessInsertPointCombo(ctx, testcpu, test_info, cur_site, mod_genome);
-    ProcessInsertDeleteCombo(ctx, testcpu, test_info, cur_site, mod_genome);
+    if (!m_sample_size) {
+      ProcessTwoStepInsert(ctx, testcpu, test_info, cur_site, mod_genome);
+      ProcessInsertPointCombo(ctx, testcpu, test_info, cur_site, mod_genome);
+      ProcessInsertDeleteCombo(ctx, testcpu, test_info, cur_site, mod_genome);
+    }
   }  
 }
 
@@ -285,8 +316,10 @@ void cMutationalNeighborhood::ProcessOneStepDelete(cAvidaContext& ctx, cTestCPU*
   seq.Remove(cur_site);
 
   m_fitness_delete[cur_site][0] = ProcessOneStepGenome(ctx, testcpu, test_info, mod_genome, odata, cur_site);
-  ProcessTwoStepDelete(ctx, testcpu, test_info, cur_site, mod_genome);
-  ProcessDeletePointCombo(ctx, testcpu, test_info, cur_site, mod_genome);
+  if (!m_sample_size) {
+    ProcessTwoStepDelete(ctx, testcpu, test_info, cur_site, mod_genome);
+    ProcessDeletePointCombo(ctx, testcpu, test_info, cur_site, mod_genome);
+  }
 }
 
 
@@ -322,7 +355,7 @@ double cMutationalNeighborhood::ProcessOneStepGenome(cAvidaContext& ctx, cTestCP
   if (test_fitness >= m_neut_min) odata.site_count[cur_site]++;
   
   if (test_fitness != 0.0) { // Only count tasks if the organism is alive
-    const Apto::Array<int>& cur_tasks = test_info.GetColonyOrganism()->GetPhenotype().GetLastTaskCount();
+    const Apto::Array<int>& cur_tasks = test_info.GetColonyTaskCount();
     bool knockout = false;
     bool anytask = false;
     for (int i = 0; i < m_base_tasks.GetSize(); i++) {
@@ -355,7 +388,7 @@ void cMutationalNeighborhood::ProcessTwoStepPoint(cAvidaContext& ctx, cTestCPU*
   InstructionSequencePtr seq_p;
   seq_p.DynamicCastFrom(mod_genome.Representation());
   InstructionSequence& seq = *seq_p;
-  sTwoStep& tdata = m_twostep_point[cur_site];
+  sTwoStep& tdata = m_site_batches[cur_site]->steps[TWO_STEP_POINT];
   sPendFit cur(m_fitness_point, cur_site, seq[cur_site].GetOp());
 
   // Loop through remaining lines of genome, testing trying all combinations.
@@ -383,7 +416,7 @@ void cMutationalNeighborhood::ProcessTwoStepInsert(cAvidaContext& ctx, cTestCPU*
   seq_p.DynamicCastFrom(mod_genome.Representation());
   InstructionSequence& seq = *seq_p;
   const int mod_size = seq.GetSize();
-  sTwoStep& tdata = m_twostep_insert[cur_site];
+  sTwoStep& tdata = m_site_batches[cur_site]->steps[TWO_STEP_INSERT];
   sPendFit cur(m_fitness_insert, cur_site, seq[cur_site].GetOp());
   
   // Loop through all instructions...
@@ -406,7 +439,7 @@ void cMutationalNeighborhood::ProcessTwoStepDelete(cAvidaContext& ctx, cTestCPU*
   seq_p.DynamicCastFrom(mod_genome.Representation());
   InstructionSequence& seq = *seq_p;
   const int mod_size = seq.GetSize();
-  sTwoStep& tdata = m_twostep_delete[cur_site];
+  sTwoStep& tdata = m_site_batches[cur_site]->steps[TWO_STEP_DELETE];
   sPendFit cur(m_fitness_delete, cur_site, 0); // Delete 'inst' is always 0
   
   // Loop through all instructions...
@@ -426,7 +459,7 @@ void cMutationalNeighborhood::ProcessInsertPointCombo(cAvidaContext& ctx, cTestC
   InstructionSequencePtr seq_p;
   seq_p.DynamicCastFrom(mod_genome.Representation());
   InstructionSequence& seq = *seq_p;
-  sTwoStep& tdata = m_insert_point[cur_site];
+  sTwoStep& tdata = m_site_batches[cur_site]->steps[TWO_STEP_INSERT_POINT];
   sPendFit cur(m_fitness_insert, cur_site, seq[cur_site].GetOp());
   
   // Loop through all lines of genome, testing trying all combinations.
@@ -455,7 +488,7 @@ void cMutationalNeighborhood::ProcessInsertDeleteCombo(cAvidaContext& ctx, cTest
   InstructionSequencePtr seq_p;
   seq_p.DynamicCastFrom(mod_genome.Representation());
   InstructionSequence& seq = *seq_p;
-  sTwoStep& tdata = m_insert_delete[cur_site];
+  sTwoStep& tdata = m_site_batches[cur_site]->steps[TWO_STEP_INSERT_DELETE];
   sPendFit cur(m_fitness_insert, cur_site, seq[cur_site].GetOp());
 
   // Loop through all lines of genome, testing trying all combinations.
@@ -478,7 +511,7 @@ void cMutationalNeighborhood::ProcessDeletePointCombo(cAvidaContext& ctx, cTestC
   InstructionSequencePtr seq_p;
   seq_p.DynamicCastFrom(mod_genome.Representation());
   InstructionSequence& seq = *seq_p;
-  sTwoStep& tdata = m_delete_point[cur_site];
+  sTwoStep& tdata = m_site_batches[cur_site]->steps[TWO_STEP_DELETE_POINT];
   sPendFit cur(m_fitness_delete, cur_site, 0); // Delete 'inst' is always 0
   
   // Loop through all lines of genome, testing trying all combinations.
@@ -531,7 +564,7 @@ double cMutationalNeighborhood::ProcessTwoStepGenome(cAvidaContext& ctx, cTestCP
   if (test_fitness >= m_neut_min) tdata.site_count[cur.site]++;
   
   if (test_fitness != 0.0) { // Only count tasks if the organism is alive
-    const Apto::Array<int>& cur_tasks = test_info.GetColonyOrganism()->GetPhenotype().GetLastTaskCount();
+    const Apto::Array<int>& cur_tasks = test_info.GetColonyTaskCount();
     bool knockout = false;
     bool anytask = false;
     for (int i = 0; i < m_base_tasks.GetSize(); i++) {
@@ -561,20 +594,10 @@ double cMutationalNeighborhood::ProcessTwoStepGenome(cAvidaContext& ctx, cTestCP
 
 void cMutationalNeighborhood::ProcessComplete(cAvidaContext&)
 {
-  m_op.peak_fitness = m_base_fitness;
-  m_op.peak_genome = m_base_genome;
-  m_op.site_count.Resize(m_base_genome_size, 0);
-  AggregateOneStep(m_onestep_point, m_op);
-
-  m_oi.peak_fitness = m_base_fitness;
-  m_oi.peak_genome = m_base_genome;
-  m_oi.site_count.Resize(m_base_genome_size + 1, 0);
-  AggregateOneStep(m_onestep_insert, m_oi);
-
-  m_od.peak_fitness = m_base_fitness;
-  m_od.peak_genome = m_base_genome;
-  m_od.site_count.Resize(m_base_genome_size, 0);
-  AggregateOneStep(m_onestep_delete, m_od);
+  // All sites have been merged, only the complexity calculations remain
+  FinishOneStep(m_op);
+  FinishOneStep(m_oi);
+  FinishOneStep(m_od);
   
   
   // Collect totals across all one step mutants
@@ -611,36 +634,13 @@ void cMutationalNeighborhood::ProcessComplete(cAvidaContext&)
 
   
   
-  m_tp.peak_fitness = m_base_fitness;
-  m_tp.peak_genome = m_base_genome;
-  m_tp.site_count.Resize(m_base_genome_size, 0);
-  AggregateTwoStep(m_twostep_point, m_tp);
-  
-  m_ti.peak_fitness = m_base_fitness;
-  m_ti.peak_genome = m_base_genome;
-  m_ti.site_count.Resize(m_base_genome_size + 2, 0);
-  AggregateTwoStep(m_twostep_insert, m_ti);
-  
-  m_td.peak_fitness = m_base_fitness;
-  m_td.peak_genome = m_base_genome;
-  m_td.site_count.Resize(m_base_genome_size, 0);
-  AggregateTwoStep(m_twostep_delete, m_td);
-
-
-  m_tip.peak_fitness = m_base_fitness;
-  m_tip.peak_genome = m_base_genome;
-  m_tip.site_count.Resize(m_base_genome_size + 1, 0);
-  AggregateTwoStep(m_insert_point, m_tip);
-  
-  m_tid.peak_fitness = m_base_fitness;
-  m_tid.peak_genome = m_base_genome;
-  m_tid.site_count.Resize(m_base_genome_size + 1, 0);
-  AggregateTwoStep(m_insert_delete, m_tid);
-  
-  m_tdp.peak_fitness = m_base_fitness;
-  m_tdp.peak_genome = m_base_genome;
-  m_tdp.site_count.Resize(m_base_genome_size, 0);
-  AggregateTwoStep(m_delete_point, m_tdp);
+  // Pending first step fitness values can only be resolved now that every one step mutant has been tested
+  FinishTwoStep(m_tp);
+  FinishTwoStep(m_ti);
+  FinishTwoStep(m_td);
+  FinishTwoStep(m_tip);
+  FinishTwoStep(m_tid);
+  FinishTwoStep(m_tdp);
   
   
   // Collect totals across all two step mutants
@@ -718,52 +718,57 @@ void cMutationalNeighborhood::ProcessComplete(cAvidaContext&)
   m_onestep_insert.Resize(0);
   m_onestep_delete.Resize(0);
   
-  m_twostep_point.Resize(0);
-  m_twostep_insert.Resize(0);
-  m_twostep_delete.Resize(0);
-  
-  m_insert_point.Resize(0);
-  m_insert_delete.Resize(0);
-  m_delete_point.Resize(0);
+  m_site_batches.Resize(0);
   
   m_fitness_point.Resize(0, 0);
   m_fitness_insert.Resize(0, 0);
   m_fitness_delete.Resize(0, 0);
+  
+  m_site_done.Resize(0);
+  
+  // Batches completed after sampling converged were never merged
+  for (int i = 0; i < m_sample_batches.GetSize(); i++) delete m_sample_batches[i];
+  m_sample_batches.Resize(0);
+  m_sample_seeds.Resize(0);
 }
 
-void cMutationalNeighborhood::AggregateOneStep(Apto::Array<sStep>& steps, sOneStepAggregate& osa)
+void cMutationalNeighborhood::MergeOneStep(sStep& odata, sOneStepAggregate& osa)
 {
-  for (int i = 0; i < steps.GetSize(); i++) {
-    sStep& odata = steps[i];
-    osa.total += odata.total;
-    osa.total_fitness += odata.total_fitness;
-    osa.total_sqr_fitness += odata.total_sqr_fitness;
-    osa.pos += odata.pos;
-    osa.neg += odata.neg;
-    osa.neut += odata.neut;
-    osa.dead += odata.dead;
-    osa.size_pos += odata.size_pos; 
-    osa.size_neg += odata.size_neg; 
-    
-    if (odata.peak_fitness > osa.peak_fitness) {
-      osa.peak_genome = odata.peak_genome;
-      osa.peak_fitness = odata.peak_fitness;
-    }
-    
-    
-    for (int j = 0; j < osa.site_count.GetSize(); j++) {
-      osa.site_count[j] += odata.site_count[j];
-    }
-    
-    osa.task_target += odata.task_target;
-    osa.task_total += odata.task_total;
-    osa.task_knockout += odata.task_knockout;
-    
-    osa.task_size_target += odata.task_size_target;
-    osa.task_size_total += odata.task_size_total;
-    osa.task_size_knockout += odata.task_size_knockout;
+  osa.total += odata.total;
+  osa.total_fitness += odata.total_fitness;
+  osa.total_sqr_fitness += odata.total_sqr_fitness;
+  osa.pos += odata.pos;
+  osa.neg += odata.neg;
+  osa.neut += odata.neut;
+  osa.dead += odata.dead;
+  osa.size_pos += odata.size_pos; 
+  osa.size_neg += odata.size_neg; 
+  
+  if (odata.peak_fitness > osa.peak_fitness) {
+    osa.peak_genome = odata.peak_genome;
+    osa.peak_fitness = odata.peak_fitness;
   }
   
+  
+  for (int j = 0; j < osa.site_count.GetSize(); j++) {
+    osa.site_count[j] += odata.site_count[j];
+  }
+  
+  osa.task_target += odata.task_target;
+  osa.task_total += odata.task_total;
+  osa.task_knockout += odata.task_knockout;
+  
+  osa.task_size_target += odata.task_size_target;
+  osa.task_size_total += odata.task_size_total;
+  osa.task_size_knockout += odata.task_size_knockout;
+  
+  // Release the per-site counts, which are the bulk of the step data
+  odata.site_count.Resize(0);
+}
+
+
+void cMutationalNeighborhood::FinishOneStep(sOneStepAggregate& osa)
+{
   const double max_ent = log(static_cast<double>(m_inst_set.GetSize()));
   for (int i = 0; i < m_base_genome_size; i++) {
     // Per-site entropy is the log of the number of legal states for that
@@ -774,67 +779,281 @@ void cMutationalNeighborhood::AggregateOneStep(Apto::Array<sStep>& steps, sOneSt
 }
 
 
-void cMutationalNeighborhood::AggregateTwoStep(Apto::Array<sTwoStep>& steps, sTwoStepAggregate& tsa)
+void cMutationalNeighborhood::MergeTwoStep(sTwoStep& tdata, sTwoStepAggregate& tsa)
 {
+  MergeOneStep(tdata, tsa);
+  
   sPendFit* pend = NULL;
+  while ((pend = tdata.pending.Pop())) tsa.pending.PushRear(pend);
+}
 
-  for (int i = 0; i < steps.GetSize(); i++) {
-    sTwoStep& tdata = steps[i];
-    tsa.total += tdata.total;
-    tsa.total_fitness += tdata.total_fitness;
-    tsa.total_sqr_fitness += tdata.total_sqr_fitness;
-    tsa.pos += tdata.pos;
-    tsa.neg += tdata.neg;
-    tsa.neut += tdata.neut;
-    tsa.dead += tdata.dead;
-    tsa.size_pos += tdata.size_pos; 
-    tsa.size_neg += tdata.size_neg; 
+
+void cMutationalNeighborhood::FinishTwoStep(sTwoStepAggregate& tsa)
+{
+  sPendFit* pend = NULL;
+  while ((pend = tsa.pending.Pop())) {
+    double fitness = pend->GetFitness();
     
-    if (tdata.peak_fitness > tsa.peak_fitness) {
-      tsa.peak_genome = tdata.peak_genome;
-      tsa.peak_fitness = tdata.peak_fitness;
+    if (fitness == 0.0) {
+      tsa.task_target_dead++;
+    } else if (fitness < m_neut_min) {
+      tsa.task_target_neg++;
+      tsa.task_size_target_neg += fitness;
+    } else if (fitness <= m_neut_max) {
+      tsa.task_target_neut++;
+    } else {
+      tsa.task_target_pos++;
+      tsa.task_size_target_pos += fitness;
     }
     
+    delete pend;
+  }
+  
+  FinishOneStep(tsa);
+}
+
+
+void cMutationalNeighborhood::MergeCompletedSites()
+{
+  // Must be called with m_mutex held.  Sites are merged in order, so the aggregates do not depend on which worker
+  // completed first, and each site's data is released as soon as it has been merged.
+  while (m_merged_sites < m_base_genome_size && m_site_done[m_merged_sites]) {
+    const int site = m_merged_sites++;
     
-    for (int j = 0; j < tsa.site_count.GetSize(); j++) {
-      tsa.site_count[j] += tdata.site_count[j];
+    MergeOneStep(m_onestep_point[site], m_op);
+    MergeOneStep(m_onestep_insert[site], m_oi);
+    MergeOneStep(m_onestep_delete[site], m_od);
+    if (!m_sample_size) {
+      MergeTwoStepBatch(m_site_batches[site]);
+      m_site_batches[site] = NULL;
+    }
+  }
+  
+  // The hanging insertion is processed along with the first site, but merged last
+  if (m_merged_sites == m_base_genome_size) {
+    m_merged_sites++;
+    MergeOneStep(m_onestep_insert[m_base_genome_size], m_oi);
+    if (!m_sample_size) {
+      MergeTwoStepBatch(m_site_batches[m_base_genome_size]);
+      m_site_batches[m_base_genome_size] = NULL;
+    }
+  }
+}
+
+
+cMutationalNeighborhood::sTwoStepBatch* cMutationalNeighborhood::NewTwoStepBatch() const
+{
+  sTwoStepBatch* batch = new sTwoStepBatch;
+  for (int cls = 0; cls < NUM_TWO_STEP_CLASSES; cls++) {
+    batch->steps[cls].peak_fitness = m_base_fitness;
+    batch->steps[cls].site_count.Resize(GetTwoStepSiteCountSize(cls), 0);
+  }
+  return batch;
+}
+
+
+void cMutationalNeighborhood::MergeTwoStepBatch(sTwoStepBatch* batch)
+{
+  for (int cls = 0; cls < NUM_TWO_STEP_CLASSES; cls++) MergeTwoStep(batch->steps[cls], GetTwoStepAggregate(cls));
+  delete batch;
+}
+
+
+cMutationalNeighborhood::sTwoStepBatch* cMutationalNeighborhood::ProcessSampleBatch(cAvidaContext& ctx, int batch_id)
+{
+  m_mutex.Lock();
+  if (m_sample_converged) {
+    m_mutex.Unlock();
+    return NULL;
+  }
+  Genome mod_genome(m_base_genome);
+  m_mutex.Unlock();
+  
+  InstructionSequencePtr seq_p;
+  seq_p.DynamicCastFrom(mod_genome.Representation());
+  InstructionSequence& seq = *seq_p;
+  const InstructionSequence base_seq(seq);
+  
+  cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
+  cCPUTestInfo test_info;
+  test_info.UseResultCache();
+  
+  sTwoStepBatch* batch = NewTwoStepBatch();
+  
+  // Draw from the batch's own generator, so the samples do not depend on the job that ran it
+  Apto::RNG::AvidaRNG rng(m_sample_seeds[batch_id]);
+  const int num_samples = min(SAMPLE_BATCH_SIZE, m_sample_size - batch_id * SAMPLE_BATCH_SIZE);
+  for (int i = 0; i < num_samples; i++) {
+    // Choose the class of two step mutant in proportion to its share of the two step space
+    double draw = rng.GetDouble(m_twostep_space_total);
+    int cls = 0;
+    for (int c = 0; c < NUM_TWO_STEP_CLASSES; c++) {
+      if (m_twostep_space[c] <= 0.0) continue;
+      cls = c;
+      if (draw < m_twostep_space[c]) break;
+      draw -= m_twostep_space[c];
     }
     
-    tsa.task_target += tdata.task_target;
-    tsa.task_total += tdata.task_total;
-    tsa.task_knockout += tdata.task_knockout;
-    
-    tsa.task_size_target += tdata.task_size_target;
-    tsa.task_size_total += tdata.task_size_total;
-    tsa.task_size_knockout += tdata.task_size_knockout;
-    
-    while ((pend = tdata.pending.Pop())) {
-      double fitness = pend->GetFitness();
+    seq = base_seq;
+    ProcessTwoStepSample(ctx, testcpu, test_info, rng, cls, mod_genome, batch->steps[cls]);
+  }
+  
+  delete testcpu;
+  
+  return batch;
+}
+
+
+void cMutationalNeighborhood::ProcessTwoStepSample(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info,
+                                                   Apto::Random& rng, int cls, Genome& mod_genome, sTwoStep& tdata)
+{
+  const int inst_size = m_inst_set.GetSize();
+  InstructionSequencePtr seq_p;
+  seq_p.DynamicCastFrom(mod_genome.Representation());
+  InstructionSequence& seq = *seq_p;
+  
+  // Each case draws uniformly from the same set of mutants that the exhaustive processing enumerates for the class,
+  // and records the pending first step fitness values the same way.
+  switch (cls) {
+    case TWO_STEP_POINT:
+    case TWO_STEP_DELETE:
+    {
+      int line1 = rng.GetUInt(m_base_genome_size);
+      int line2 = rng.GetUInt(m_base_genome_size - 1);
+      if (line2 >= line1) line2++;
+      if (line2 < line1) { const int tmp = line1; line1 = line2; line2 = tmp; }
       
-      if (fitness == 0.0) {
-        tsa.task_target_dead++;
-      } else if (fitness < m_neut_min) {
-        tsa.task_target_neg++;
-        tsa.task_size_target_neg += fitness;
-      } else if (fitness <= m_neut_max) {
-        tsa.task_target_neut++;
-      } else {
-        tsa.task_target_pos++;
-        tsa.task_size_target_pos += fitness;
+      if (cls == TWO_STEP_DELETE) {
+        seq.Remove(line2);
+        seq.Remove(line1);
+        ProcessTwoStepGenome(ctx, testcpu, test_info, mod_genome, tdata, sPendFit(m_fitness_delete, line2, 0),
+                             sPendFit(m_fitness_delete, line1, 0));
+        break;
       }
       
-      delete pend;
+      int inst1 = rng.GetUInt(inst_size - 1);
+      if (inst1 >= seq[line1].GetOp()) inst1++;
+      int inst2 = rng.GetUInt(inst_size - 1);
+      if (inst2 >= seq[line2].GetOp()) inst2++;
+      seq[line1].SetOp(inst1);
+      seq[line2].SetOp(inst2);
+      ProcessTwoStepGenome(ctx, testcpu, test_info, mod_genome, tdata, sPendFit(m_fitness_point, line2, inst2),
+                           sPendFit(m_fitness_point, line1, inst1));
+    }
+      break;
+      
+    case TWO_STEP_INSERT:
+    {
+      int pos1 = rng.GetUInt(m_base_genome_size + 2);
+      int pos2 = rng.GetUInt(m_base_genome_size + 1);
+      if (pos2 >= pos1) pos2++;
+      if (pos2 < pos1) { const int tmp = pos1; pos1 = pos2; pos2 = tmp; }
+      
+      const int inst1 = rng.GetUInt(inst_size);
+      const int inst2 = rng.GetUInt(inst_size);
+      seq.Insert(pos1, Instruction(inst1));
+      seq.Insert(pos2, Instruction(inst2));
+      ProcessTwoStepGenome(ctx, testcpu, test_info, mod_genome, tdata, sPendFit(m_fitness_insert, pos2 - 1, inst2),
+                           sPendFit(m_fitness_insert, pos1, inst1));
+    }
+      break;
+      
+    case TWO_STEP_INSERT_POINT:
+    case TWO_STEP_INSERT_DELETE:
+    {
+      const int ins_site = rng.GetUInt(m_base_genome_size + 1);
+      const int ins_inst = rng.GetUInt(inst_size);
+      seq.Insert(ins_site, Instruction(ins_inst));
+      
+      int line_num = rng.GetUInt(m_base_genome_size);
+      if (line_num >= ins_site) line_num++; // skip the site of the insertion
+      const int actual = (line_num < ins_site) ? line_num : (line_num - 1);
+      
+      if (cls == TWO_STEP_INSERT_DELETE) {
+        seq.Remove(line_num);
+        ProcessTwoStepGenome(ctx, testcpu, test_info, mod_genome, tdata, sPendFit(m_fitness_delete, actual, 0),
+                             sPendFit(m_fitness_insert, ins_site, ins_inst));
+        break;
+      }
+      
+      int inst_num = rng.GetUInt(inst_size - 1);
+      if (inst_num >= seq[line_num].GetOp()) inst_num++;
+      seq[line_num].SetOp(inst_num);
+      ProcessTwoStepGenome(ctx, testcpu, test_info, mod_genome, tdata, sPendFit(m_fitness_point, actual, inst_num),
+                           sPendFit(m_fitness_insert, ins_site, ins_inst));
+    }
+      break;
+      
+    case TWO_STEP_DELETE_POINT:
+    {
+      const int del_site = rng.GetUInt(m_base_genome_size);
+      seq.Remove(del_site);
+      
+      const int line_num = rng.GetUInt(m_base_genome_size - 1);
+      const int actual = (line_num < del_site) ? line_num : (line_num + 1);
+      int inst_num = rng.GetUInt(inst_size - 1);
+      if (inst_num >= seq[line_num].GetOp()) inst_num++;
+      seq[line_num].SetOp(inst_num);
+      ProcessTwoStepGenome(ctx, testcpu, test_info, mod_genome, tdata, sPendFit(m_fitness_point, actual, inst_num),
+                           sPendFit(m_fitness_delete, del_site, 0));
     }
+      break;
   }
-  
-  const double max_ent = log(static_cast<double>(m_inst_set.GetSize()));
-  for (int i = 0; i < m_base_genome_size; i++) {
-    // Per-site entropy is the log of the number of legal states for that
-    // site.  Add one to account for the unmutated state.
-    tsa.total_entropy += log(static_cast<double>(tsa.site_count[i] + 1)) / max_ent;
+}
+
+
+void cMutationalNeighborhood::MergeCompletedBatches()
+{
+  // Must be called with m_mutex held.  Batches are merged in order and convergence is checked after each one, so the
+  // set of batches included in the results is the same no matter how the jobs were scheduled.
+  while (!m_sample_converged && m_merged_batches < m_sample_batches.GetSize() && m_sample_batches[m_merged_batches]) {
+    sTwoStepBatch* batch = m_sample_batches[m_merged_batches];
+    m_sample_batches[m_merged_batches++] = NULL;
+    MergeTwoStepBatch(batch);
+    
+    if (m_sample_tolerance > 0.0) {
+      int total = 0, pos = 0, neg = 0, neut = 0, dead = 0;
+      for (int cls = 0; cls < NUM_TWO_STEP_CLASSES; cls++) {
+        const sTwoStepAggregate& tsa = GetTwoStepAggregate(cls);
+        total += tsa.total;
+        pos += tsa.pos;
+        neg += tsa.neg;
+        neut += tsa.neut;
+        dead += tsa.dead;
+      }
+      if (maxHalfWidth(total, pos, neg, neut, dead) <= m_sample_tolerance) m_sample_converged = true;
+    }
+  }
+}
+
+
+cMutationalNeighborhood::sTwoStepAggregate& cMutationalNeighborhood::GetTwoStepAggregate(int cls)
+{
+  switch (cls) {
+    case TWO_STEP_INSERT:         return m_ti;
+    case TWO_STEP_DELETE:         return m_td;
+    case TWO_STEP_INSERT_POINT:   return m_tip;
+    case TWO_STEP_INSERT_DELETE:  return m_tid;
+    case TWO_STEP_DELETE_POINT:   return m_tdp;
+    default:                      return m_tp;
   }
-  tsa.complexity = m_base_genome_size - tsa.total_entropy;
-  
+}
+
+
+int cMutationalNeighborhood::GetTwoStepSiteCountSize(int cls) const
+{
+  switch (cls) {
+    case TWO_STEP_INSERT:         return m_base_genome_size + 2;
+    case TWO_STEP_INSERT_POINT:
+    case TWO_STEP_INSERT_DELETE:  return m_base_genome_size + 1;
+    default:                      return m_base_genome_size;
+  }
+}
+
+
+double cMutationalNeighborhood::Get2SSampleHalfWidth() const
+{
+  return maxHalfWidth(m_tt.total, m_tt.pos, m_tt.neg, m_tt.neut, m_tt.dead);
 }
 
 
@@ -969,6 +1188,10 @@ void cMutationalNeighborhood::PrintStats(Avida::Output::File& df, int update) co
   df.Write(Get2SAggregateKnockout(), "2-Step Knockout Task");
   df.Write(Get2SAggregateProbKnockout(), "2-Step Probability Knockout Task");
   df.Write(Get2SAggregateAverageSizeKnockout(), "2-Step Average Size of Task Knockout");
+  if (Get2SIsSampled()) {
+    df.Write(Get2SMutantSpaceSize(), "2-Step Mutant Space Size");
+    df.Write(Get2SSampleHalfWidth(), "2-Step Sample 95% Confidence Half-Width");
+  }
   
   df.Write(Get2SPointTotal(), "Total 2-Step Point Mutants");
   df.Write(Get2SPointProbBeneficial(), "2-Step Point Probability Beneficial");
@@ -54,6 +54,10 @@ private:
   bool m_initialized;
   int m_cur_site;
   int m_completed;
+  int m_num_jobs;
+  
+  Apto::Array<bool> m_site_done;
+  int m_merged_sites;
   
   const cInstSet& m_inst_set;  
   int m_target;
@@ -114,6 +118,16 @@ private:
   // Two Step Per-Site Data
   // -----------------------------------------------------------------------------------------------------------------------
   
+  enum eTwoStepClass {
+    TWO_STEP_POINT = 0,
+    TWO_STEP_INSERT,
+    TWO_STEP_DELETE,
+    TWO_STEP_INSERT_POINT,
+    TWO_STEP_INSERT_DELETE,
+    TWO_STEP_DELETE_POINT,
+    NUM_TWO_STEP_CLASSES
+  };
+  
   // Based on sStep, the sTwoStep data structure adds a pending list to calculate fitness effects based single step
   // fitness values that may not have been calculated yet.  A pending list must be maintained for each site, as a
   // list in the main class would be subject to a race condition should two separate threads try to write to it
@@ -135,13 +149,14 @@ private:
     
     sTwoStep() : sStep() { ; }
   };  
-  Apto::Array<sTwoStep> m_twostep_point;
-  Apto::Array<sTwoStep> m_twostep_insert;
-  Apto::Array<sTwoStep> m_twostep_delete;
-
-  Apto::Array<sTwoStep> m_insert_point;
-  Apto::Array<sTwoStep> m_insert_delete;
-  Apto::Array<sTwoStep> m_delete_point;
+  
+  // The two step data for a site (or a sample batch) is allocated by the worker that processes it and released as soon
+  // as it has been merged, so only the sites that are in flight or waiting on an earlier site hold two step data.
+  struct sTwoStepBatch
+  {
+    sTwoStep steps[NUM_TWO_STEP_CLASSES];
+  };
+  Apto::Array<sTwoStepBatch*> m_site_batches;
 
 
   // One Step Fitness Data
@@ -208,6 +223,8 @@ private:
     double task_size_target_pos;
     double task_size_target_neg;
     
+    tList<sPendFit> pending;   // merged from the completed steps, resolved once all one step fitness values are known
+    
     sTwoStepAggregate() : sOneStepAggregate(), task_target_pos(0), task_target_neg(0), task_target_neut(0),
       task_target_dead(0), task_size_target_pos(0.0), task_size_target_neg(0.0) { ; }
   };
@@ -224,6 +241,24 @@ private:
 
   
   
+  // Two Step Sampling
+  // -----------------------------------------------------------------------------------------------------------------------
+  // When a sample size is given, two step mutants are drawn uniformly at random from the full two step space (rather
+  // than enumerated) in batches of SAMPLE_BATCH_SIZE.  Batches are merged in order and sampling stops early once the
+  // 95% confidence interval of each aggregate outcome probability is within the sample tolerance.
+  static const int SAMPLE_BATCH_SIZE = 256;
+  
+  int m_sample_size;
+  double m_sample_tolerance;
+  double m_twostep_space[NUM_TWO_STEP_CLASSES];
+  double m_twostep_space_total;
+  Apto::Array<int> m_sample_seeds;
+  Apto::Array<sTwoStepBatch*> m_sample_batches;
+  int m_merged_batches;
+  bool m_sample_converged;
+
+  
+  
   cMutationalNeighborhood(); // @not_implemented
   cMutationalNeighborhood(const cMutationalNeighborhood&); // @not_implemented
   cMutationalNeighborhood& operator=(const cMutationalNeighborhood&); // @not_implemented
@@ -231,7 +266,8 @@ private:
 public:
   // Public Methods - Instantiate and Process Only.   All results must be read with a cMutationalNeighborhood object.
   // -----------------------------------------------------------------------------------------------------------------------
-  cMutationalNeighborhood(cWorld* world, const Genome& genome, int target);
+  cMutationalNeighborhood(cWorld* world, const Genome& genome, int target, int sample_size = 0,
+                          double sample_tolerance = 0.0);
   ~cMutationalNeighborhood() { ; }
   
   void Process(cAvidaContext& ctx);
@@ -247,7 +283,8 @@ private:
   void ProcessOneStepDelete(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site);
   double ProcessOneStepGenome(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, const Genome& mod_genome,
                               sStep& odata, int cur_site);
-  void AggregateOneStep(Apto::Array<sStep>& steps, sOneStepAggregate& osa);
+  void MergeOneStep(sStep& odata, sOneStepAggregate& osa);
+  void FinishOneStep(sOneStepAggregate& osa);
 
   void ProcessTwoStepPoint(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, Genome& mod_genome);
   void ProcessTwoStepInsert(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, Genome& mod_genome);
@@ -257,7 +294,18 @@ private:
   void ProcessDeletePointCombo(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, int cur_site, Genome& mod_genome);
   double ProcessTwoStepGenome(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, const Genome& mod_genome,
                               sTwoStep& tdata, const sPendFit& cur, const sPendFit& oth);
-  void AggregateTwoStep(Apto::Array<sTwoStep>& steps, sTwoStepAggregate& osa);
+  void MergeTwoStep(sTwoStep& tdata, sTwoStepAggregate& tsa);
+  void FinishTwoStep(sTwoStepAggregate& tsa);
+  void MergeCompletedSites();
+  
+  sTwoStepBatch* NewTwoStepBatch() const;
+  void MergeTwoStepBatch(sTwoStepBatch* batch);
+  sTwoStepBatch* ProcessSampleBatch(cAvidaContext& ctx, int batch_id);
+  void ProcessTwoStepSample(cAvidaContext& ctx, cTestCPU* testcpu, cCPUTestInfo& test_info, Apto::Random& rng, int cls,
+                            Genome& mod_genome, sTwoStep& tdata);
+  void MergeCompletedBatches();
+  sTwoStepAggregate& GetTwoStepAggregate(int cls);
+  int GetTwoStepSiteCountSize(int cls) const;
   
   void ProcessComplete(cAvidaContext& ctx);
   
@@ -438,6 +486,9 @@ private:
   
   
   inline int Get2SAggregateTotal() const { return m_tt.total; }
+  inline bool Get2SIsSampled() const { return m_sample_size > 0; }
+  inline double Get2SMutantSpaceSize() const { return m_twostep_space_total; }
+  double Get2SSampleHalfWidth() const;
   
   inline double Get2SAggregateAverageFitness() const { return m_tt.total_fitness / m_tt.total; }
   inline double Get2SAggregateAverageSqrFitness() const { return m_tt.total_sqr_fitness / m_tt.total; }
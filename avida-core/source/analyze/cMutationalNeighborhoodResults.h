@@ -189,6 +189,9 @@ public:
   
   
   inline int Get2SAggregateTotal() const { return m_src.Get2SAggregateTotal(); }
+  inline bool Get2SIsSampled() const { return m_src.Get2SIsSampled(); }
+  inline double Get2SMutantSpaceSize() const { return m_src.Get2SMutantSpaceSize(); }
+  inline double Get2SSampleHalfWidth() const { return m_src.Get2SSampleHalfWidth(); }
   
   inline double Get2SAggregateAverageFitness() const { return m_src.Get2SAggregateAverageFitness(); }
   inline double Get2SAggregateAverageSqrFitness() const { return m_src.Get2SAggregateAverageSqrFitness(); }
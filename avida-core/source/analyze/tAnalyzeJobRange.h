@@ -0,0 +1,47 @@
+/*
+ *  tAnalyzeJobRange.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef tAnalyzeJobRange_h
+#define tAnalyzeJobRange_h
+
+#ifndef cAnalyzeJob_h
+#include "cAnalyzeJob.h"
+#endif
+
+// Runs JobTask for each index in [begin, end), used by cAnalyzeJobQueue::ParallelFor
+template <class T> class tAnalyzeJobRange : public cAnalyzeJob
+{
+protected:
+  T* m_target;
+  void (T::*JobTask)(cAvidaContext&, int);
+  int m_begin;
+  int m_end;
+
+public:
+  tAnalyzeJobRange(T* target, void (T::*funJ)(cAvidaContext&, int), int begin, int end)
+    : cAnalyzeJob(), m_target(target), JobTask(funJ), m_begin(begin), m_end(end) { ; }
+  
+  void Run(cAvidaContext& ctx)
+  {
+    for (int i = m_begin; i < m_end; i++) (m_target->*JobTask)(ctx, i);
+  }
+};
+
+#endif
@@ -131,6 +131,15 @@ bool Avida::Genome::LegacySave(void* dfp) const
   return false;
 }
 
+bool Avida::Genome::LegacySaveProperties(void* prop_p) const
+{
+  Apto::Map<Apto::String, Apto::String>& props = *static_cast<Apto::Map<Apto::String, Apto::String>*>(prop_p);
+  props.Set("hw_type", Apto::AsStr(m_hw_type));
+  props.Set("inst_set", m_props.Get(s_prop_id_instset).StringValue());
+  props.Set("sequence", m_representation->AsString());
+  return false;
+}
+
 
 
 Avida::Genome::InstSetPropertyMap::InstSetPropertyMap() : m_inst_set(s_prop_id_instset, s_prop_desc_map, Apto::String("")) { ; }
@@ -25,6 +25,7 @@
 #include "avida/core/InstructionSequence.h"
 
 #include "AvidaTools.h"
+#include "cEditDistance.h"
 
 using namespace AvidaTools;
 
@@ -548,66 +549,16 @@ int Avida::InstructionSequence::FindEditDistance(const InstructionSequence& seq1
 {
   const int size1 = seq1.GetSize();
   const int size2 = seq2.GetSize();
-  const int min_size = (size1 < size2) ? size1 : size2;
   
   // If either size is zero, return the other one!
-  if (!min_size) return (size1 > size2) ? size1 : size2;
+  if (!size1 || !size2) return (size1 > size2) ? size1 : size2;
   
-  // Count how many direct matches we have at the front and end.
-  int match_front = 0, match_end = 0;
-  while (match_front < min_size && seq1[match_front] == seq2[match_front]) match_front++;
-  while (match_end < min_size && seq1[size1 - match_end - 1] == seq2[size2 - match_end - 1]) match_end++;
+  // Instructions are single bytes, hand them to the bit-parallel edit distance as such
+  cEditDistance edit_distance;
+  unsigned char* ops1 = edit_distance.GetBuffer(0, size1);
+  unsigned char* ops2 = edit_distance.GetBuffer(1, size2);
+  for (int i = 0; i < size1; i++) ops1[i] = seq1[i].GetOp();
+  for (int i = 0; i < size2; i++) ops2[i] = seq2[i].GetOp();
   
-  // We can ignore the last match_end sites since we know they have distance zero.
-  const int test_size1 = size1 - match_front - match_end;
-  const int test_size2 = size2 - match_front - match_end;
-  
-  if (test_size1 <= 0 || test_size2 <=0) return abs(test_size1 - test_size2);
-  
-  // Now match everything else...
-  int* cur_row  = new int[test_size1];  // The row we are calculating
-  int* prev_row = new int[test_size1];  // The last row we calculated
-  
-  // Initialize the previous row to record the differece from nothing.
-  for (int i = 0; i < test_size1; i++)  prev_row[i] = i + 1;
-  
-  // Loop through each subsequent character in the test code
-  for (int i = 0; i < test_size2; i++) {
-    // Initialize the first entry in cur_row.
-    if (seq1[match_front] == seq2[match_front + i]) cur_row[0] = i;
-    else cur_row[0] = (i < prev_row[0]) ? (i+1) : (prev_row[0] + 1);
-    
-    // Move down the cur_row and fill it out.
-    for (int j = 1; j < test_size1; j++) {
-      // If the values are equal, keep the value in the upper left.
-      if (seq1[match_front + j] == seq2[match_front + i]) {
-        cur_row[j] = prev_row[j-1];
-      }
-      
-      // Otherwise, set the current position the the minimal of the three
-      // numbers above (insertion), to the left (deletion), or upper left
-      // (mutation) in the chart, plus one.
-      else {
-        cur_row[j] = (prev_row[j] < prev_row[j-1]) ? prev_row[j] : prev_row[j-1];
-        if (cur_row[j-1] < cur_row[j]) cur_row[j] = cur_row[j-1];
-        cur_row[j]++;
-      }
-    }
-    
-    // Swap cur_row and prev_row. (we only really need to move the cur row
-    // over to prev, but this saves us from having to keep re-allocating
-    // new rows.  We recycle!
-    int* temp_row = cur_row;
-    cur_row = prev_row;
-    prev_row = temp_row;
-  }
-  
-  // Now that we are done, return the bottom-right corner of the chart.
-  
-  const int value = prev_row[test_size1 - 1];
-  
-  delete [] cur_row;
-  delete [] prev_row;
-  
-  return value;
+  return edit_distance.Distance(ops1, size1, ops2, size2);
 }
@@ -33,6 +33,7 @@ cCPUMemory::cCPUMemory(const cCPUMemory& in_memory) : InstructionSequence(in_mem
 
 void cCPUMemory::adjustCapacity(int new_size)
 {
+  m_label_index.Invalidate();
   InstructionSequence::adjustCapacity(new_size);
   if (m_seq.GetSize() != m_flag_array.GetSize()) m_flag_array.Resize(m_seq.GetSize()); 
 }
@@ -97,6 +98,7 @@ void cCPUMemory::Copy(int to, int from)
   
   m_seq[to] = m_seq[from];
   m_flag_array[to] = m_flag_array[from];
+  m_label_index.MarkModified(to);
 }
 
 
@@ -148,7 +150,9 @@ void cCPUMemory::Replace(int pos, int num_sites, const InstructionSequence& geno
   if (size_change > 0) prepareInsert(pos, size_change);
   else if (size_change < 0) Remove(pos, -size_change);
   
-  // Now just copy everything over!
+  // Now just copy everything over!  A replacement of the same size never adjusts the capacity, so the label index must
+  // be told here.
+  m_label_index.Invalidate();
   for (int i = 0; i < genome.GetSize(); i++) {
     m_seq[i + pos] = genome[i];
     m_flag_array[i + pos] = 0;
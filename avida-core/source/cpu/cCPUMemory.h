@@ -25,6 +25,8 @@
 
 #include "avida/core/InstructionSequence.h"
 
+#include "cLabelIndex.h"
+
 
 class cCPUMemory : public Avida::InstructionSequence
 {
@@ -39,6 +41,7 @@ private:
 	static const unsigned char MASK_UNUSED2  = 0x80; // unused bit
   
   Apto::Array<unsigned char> m_flag_array;
+  mutable cLabelIndex m_label_index;
 
   void adjustCapacity(int new_size);
   void prepareInsert(int pos, int num_sites);
@@ -50,6 +53,14 @@ public:
   cCPUMemory(const Apto::String& in_string) : InstructionSequence(in_string), m_flag_array(in_string.GetSize()) { ; }
   ~cCPUMemory() { ; }
 
+  // Writes through the non-const accessor are reported to the label index.  Writes made through a plain
+  // InstructionSequence reference bypass it, and must be followed by a change of size or an InvalidateLabelIndex().
+  inline Avida::Instruction& operator[](int idx) { m_label_index.MarkModified(idx); return InstructionSequence::operator[](idx); }
+  inline const Avida::Instruction& operator[](int idx) const { return InstructionSequence::operator[](idx); }
+
+  inline cLabelIndex& GetLabelIndex() const { return m_label_index; }
+  inline void InvalidateLabelIndex() { m_label_index.Invalidate(); }
+
   inline bool FlagCopied(int pos) const     { return (MASK_COPIED   & m_flag_array[pos]) != 0; }
   inline bool FlagMutated(int pos) const    { return (MASK_MUTATED  & m_flag_array[pos]) != 0; }
   inline bool FlagExecuted(int pos) const   { return (MASK_EXECUTED & m_flag_array[pos]) != 0; }
@@ -74,6 +85,7 @@ public:
   
   void Clear()
 	{
+		m_label_index.Invalidate();
 		for (int i = 0; i < m_active_size; i++) {
 			m_seq[i].SetOp(0);
 			m_flag_array[i] = 0;
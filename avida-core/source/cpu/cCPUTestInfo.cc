@@ -38,6 +38,7 @@ cCPUTestInfo::cCPUTestInfo(int max_tests)
   , use_random_inputs(false)
   , use_manual_inputs(false)
   , m_tracer(NULL)
+  , m_use_result_cache(false)
   , m_cur_sg(0)
   , org_array(max_tests)
   , m_res_method(RES_INITIAL)
@@ -64,6 +65,7 @@ cCPUTestInfo& cCPUTestInfo::operator=(const cCPUTestInfo& test_info)
   manual_inputs = test_info.manual_inputs; 
   if (test_info.m_tracer) { m_tracer = test_info.m_tracer; }
   m_mut_rates = test_info.m_mut_rates;
+  m_use_result_cache = test_info.m_use_result_cache;
   m_cur_sg = test_info.m_cur_sg;
   is_viable = test_info.is_viable;
   max_depth = test_info.max_depth;
@@ -71,6 +73,12 @@ cCPUTestInfo& cCPUTestInfo::operator=(const cCPUTestInfo& test_info)
   max_cycle = test_info.max_cycle;
   cycle_to = test_info.cycle_to;
   used_inputs = test_info.used_inputs; 
+  m_from_cache = test_info.m_from_cache;
+  m_genotype_fitness = test_info.m_genotype_fitness;
+  m_colony_fitness = test_info.m_colony_fitness;
+  m_colony_merit = test_info.m_colony_merit;
+  m_colony_gestation = test_info.m_colony_gestation;
+  m_colony_tasks = test_info.m_colony_tasks;
   org_array = test_info.org_array;
   m_res_method = test_info.m_res_method;
   m_res = NULL;  //Beware -- Resource history is NOT COPIED.
@@ -96,6 +104,13 @@ void cCPUTestInfo::Clear()
   max_cycle = 0;
   cycle_to = -1;
 
+  m_from_cache = false;
+  m_genotype_fitness = 0.0;
+  m_colony_fitness = 0.0;
+  m_colony_merit = 0.0;
+  m_colony_gestation = 0;
+  m_colony_tasks.Resize(0);
+
   for (int i = 0; i < generation_tests; i++) {
     if (org_array[i] == NULL) break;
     delete org_array[i];
@@ -104,19 +119,6 @@ void cCPUTestInfo::Clear()
 }
  
 
-double cCPUTestInfo::GetGenotypeFitness()
-{
-  if (org_array[0] != NULL) return org_array[0]->GetPhenotype().GetFitness();
-  return 0.0;
-}
-
-
-double cCPUTestInfo::GetColonyFitness()
-{
-  if (IsViable()) return GetColonyOrganism()->GetPhenotype().GetFitness();
-  return 0.0;
-}
-
 cPhenotype& cCPUTestInfo::GetTestPhenotype(int level)
 {
   assert(org_array[level] != NULL);
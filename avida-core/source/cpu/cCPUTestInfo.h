@@ -55,6 +55,7 @@ private:
   Apto::Array<int> manual_inputs;  //   if so, use these.
   HardwareTracerPtr m_tracer;
   cMutationRates m_mut_rates;
+  bool m_use_result_cache;    // May the results be served from (and stored in) the test CPU result cache?
   
   int m_cur_sg;
 
@@ -66,6 +67,14 @@ private:
   int cycle_to;           // Cycle path of the last genotype.
 	Apto::Array<int> used_inputs; //Depth 0 inputs
 
+  // Summary of the colony organism, valid whether or not the test was served from the result cache
+  bool m_from_cache;
+  double m_genotype_fitness;
+  double m_colony_fitness;
+  double m_colony_merit;
+  int m_colony_gestation;
+  Apto::Array<int> m_colony_tasks;
+
   Apto::Array<cOrganism*> org_array;
   
   // Information about how to handle resources
@@ -89,6 +98,7 @@ public:
   void UseManualInputs(Apto::Array<int> inputs) {use_manual_inputs = true; use_random_inputs = false; manual_inputs = inputs;}
   void ResetInputMode() {use_manual_inputs = false; use_random_inputs = false;}
   void SetTraceExecution(HardwareTracerPtr tracer) { m_tracer = tracer; }
+  void UseResultCache(bool use_cache = true) { m_use_result_cache = use_cache; }
   void SetResourceOptions(int res_method = RES_INITIAL, cResourceHistory* res = NULL, int update = 0, int cpu_cycle_offset = 0)
     { m_res_method = (eTestCPUResourceMethod)res_method; m_res = res; m_res_update = update; m_res_cpu_cycle_offset = cpu_cycle_offset; }
   
@@ -102,6 +112,7 @@ public:
 	bool GetUseManualInputs() const { return use_manual_inputs; }
 	const Apto::Array<int>& GetTestCPUInputs() const { return used_inputs; }
   HardwareTracerPtr GetTracer() { return m_tracer; }
+  bool GetUseResultCache() const { return m_use_result_cache; }
 
 
   // Output Accessors
@@ -110,15 +121,19 @@ public:
   int GetDepthFound() const { return depth_found; }
   int GetMaxCycle() const { return max_cycle; }
   int GetCycleTo() const { return cycle_to; }
+  bool IsCachedResult() const { return m_from_cache; }
 
-  // Genotype Stats...
+  // Genotype Stats...  (test organisms are not available when IsCachedResult() is true)
   inline cOrganism* GetTestOrganism(int level = 0);
   cPhenotype& GetTestPhenotype(int level = 0);
   inline cOrganism* GetColonyOrganism();
 
   // And just because these are so commonly used...
-  double GetGenotypeFitness();
-  double GetColonyFitness();
+  double GetGenotypeFitness() const { return m_genotype_fitness; }
+  double GetColonyFitness() const { return m_colony_fitness; }
+  double GetColonyMerit() const { return m_colony_merit; }
+  int GetColonyGestationTime() const { return m_colony_gestation; }
+  const Apto::Array<int>& GetColonyTaskCount() const { return m_colony_tasks; }
   
   int GetStateGridID() const { return m_cur_sg; }
 };
@@ -829,38 +829,20 @@ void cHardwareBCR::FindLabelStart(Head& head, Head& default_pos, bool mark_execu
   }
   
   cCPUMemory& memory = head.GetMemory();
-  int pos = 0;
   
-  while (pos < memory.GetSize()) {
-    if (m_inst_set->IsLabel(memory[pos])) { // starting label found
-      pos++;
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
-        if (!m_inst_set->IsNop(memory[pos]) || search_label[size_matched] != m_inst_set->GetNopMod(memory[pos])) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        // Return Head pointed at last NOP of label sequence
-        if (mark_executed) {
-          size_matched++; // Increment size matched so that it includes the label instruction
-          const int start = pos - size_matched;
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
-          for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
-        }
-        head.SetPosition(pos - 1);
-        return;
-      }
-      
-      continue; 
+  // Check for direct matched label pattern, can be substring of 'label'ed target
+  // - must match all NOPs in search_label
+  // - extra NOPs in 'label'ed target are ignored
+  const int label_start = memory.GetLabelIndex().FindLabelInstStart(memory, *m_inst_set, search_label);
+  if (label_start >= 0) {
+    // Return Head pointed at last NOP of label sequence
+    const int size_matched = search_label.GetSize() + 1; // includes the label instruction
+    if (mark_executed) {
+      const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
+      for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(label_start + i);
     }
-    pos++;
+    head.SetPosition(label_start + size_matched - 1);
+    return;
   }
   
   // Return start point if not found
@@ -925,43 +907,26 @@ void cHardwareBCR::FindLabelForward(Head& head, Head& default_pos, bool mark_exe
   
   head.Adjust();
   
-  Head pos(head);
-  pos++;
-  
-  while (pos.Position() != head.Position()) {
-    if (m_inst_set->IsLabel(pos.GetInst())) { // starting label found
-      const int label_start = pos.Position();
-      pos++;
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos.Position() != head.Position()) {
-        if (!m_inst_set->IsNop(pos.GetInst()) || search_label[size_matched] != m_inst_set->GetNopMod(pos.GetInst())) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        pos--;
-        const int found_pos = pos.Position();
-        
-        if (mark_executed) {
-          pos.SetPosition(label_start);
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
-          for (int i = 0; i < size_matched && i < max; i++, pos++) pos.SetFlagExecuted();
-        }
-        
-        // Return Head pointed at last NOP of label sequence
-        head.SetPosition(found_pos);
-        return;
-      }
-      
-      continue; 
+  // Check for direct matched label pattern, can be substring of 'label'ed target, searching around the memory from
+  // just after the head and stopping once back at it
+  // - must match all NOPs in search_label
+  // - extra NOPs in 'label'ed target are ignored
+  cCPUMemory& memory = head.GetMemory();
+  const int label_start = memory.GetLabelIndex().FindLabelInstForward(memory, *m_inst_set, search_label, head.Position());
+  if (label_start >= 0) {
+    Head pos(head);
+    pos.SetPosition(label_start + search_label.GetSize());
+    const int found_pos = pos.Position();
+    
+    if (mark_executed) {
+      pos.SetPosition(label_start);
+      const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
+      for (int i = 0; i < search_label.GetSize() && i < max; i++, pos++) pos.SetFlagExecuted();
     }
-    pos++;
+    
+    // Return Head pointed at last NOP of label sequence
+    head.SetPosition(found_pos);
+    return;
   }
   
   // Return start point if not found
@@ -68,6 +68,37 @@ cHardwareBase::cHardwareBase(cWorld* world, cOrganism* in_organism, cInstSet* in
 }
 
 
+// Execute up to num_inst cycles back to back, stopping early if the organism is flagged for deletion or the priority
+// of any cell in the population schedule changes.  Returns the number of cycles actually consumed.
+int cHardwareBase::ProcessSlice(cAvidaContext& ctx, int num_inst)
+{
+  const cPhenotype& phenotype = m_organism->GetPhenotype();
+  const cPopulation& population = m_world->GetPopulation();
+  const int schedule_changes = population.GetScheduleChanges();
+  int executed = 0;
+  while (executed < num_inst) {
+    SingleProcess(ctx);
+    executed++;
+    if (phenotype.GetToDelete() || population.GetScheduleChanges() != schedule_changes) break;
+  }
+  return executed;
+}
+
+
+// Clears the state that is otherwise only set up by the constructor, ahead of hardware specific recycling
+void cHardwareBase::recycleBase(cOrganism* org)
+{
+  assert(org != NULL);
+  m_organism = org;
+  m_tracer = HardwareTracerPtr(NULL);
+  m_minitrace = false;
+  m_microtrace = false;
+  m_topnavtrace = false;
+  m_reprotrace = false;
+  m_task_switching_cost = 0;
+  m_ext_mem.Resize(0);
+}
+
 void cHardwareBase::Reset(cAvidaContext& ctx)
 {
   m_organism->HardwareReset(ctx);
@@ -1168,17 +1199,28 @@ int cHardwareBase::PointMutate(cAvidaContext& ctx, double override_mut_rate)
   // Point Substitution Mutations (per site)
   if (m_organism->GetPointMutProb() > 0.0 || override_mut_rate > 0.0) {
     double mut_rate = (override_mut_rate > 0.0) ? override_mut_rate : m_organism->GetPointMutProb();
-    int num_mut = ctx.GetRandom().GetRandBinomial(memory.GetSize(), mut_rate);
-
-    //cout << "Doing Point Mut " << mut_rate << " " << num_mut << endl;
 
-    // If we have lines to mutate...m_organism->IncPointMutations(num_mut);
-    if (num_mut > 0) {
-      for (int i = 0; i < num_mut; i++) {
-        int site = ctx.GetRandom().GetUInt(memory.GetSize());
+    if (override_mut_rate <= 0.0 && m_organism->UsesMutationSkipAhead()) {
+      // Each site is one trial of the organism's sampler, whose count of sites to skip carries over between updates
+      cGeometricSampler& sampler = m_organism->GetPointMutSampler();
+      int site = -1;
+      while ((site = sampler.NextSuccess(ctx.GetRandom(), mut_rate, site + 1, memory.GetSize())) >= 0) {
         memory[site] = m_inst_set->GetRandomInst(ctx);
         totalMutations++;
       }
+    } else {
+      int num_mut = ctx.GetRandom().GetRandBinomial(memory.GetSize(), mut_rate);
+
+      //cout << "Doing Point Mut " << mut_rate << " " << num_mut << endl;
+
+      // If we have lines to mutate...m_organism->IncPointMutations(num_mut);
+      if (num_mut > 0) {
+        for (int i = 0; i < num_mut; i++) {
+          int site = ctx.GetRandom().GetUInt(memory.GetSize());
+          memory[site] = m_inst_set->GetRandomInst(ctx);
+          totalMutations++;
+        }
+      }
     }
   }
   
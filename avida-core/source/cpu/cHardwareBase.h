@@ -134,6 +134,7 @@ public:
   // --------  Core Functionality  --------
   void Reset(cAvidaContext& ctx);
   virtual bool SingleProcess(cAvidaContext& ctx, bool speculative = false) = 0;
+  int ProcessSlice(cAvidaContext& ctx, int num_inst);
   virtual void ProcessBonusInst(cAvidaContext& ctx, const Instruction& inst) = 0;
 
   int Divide_DoMutations(cAvidaContext& ctx, double mut_multiplier = 1.0, const int maxmut = INT_MAX);
@@ -228,6 +229,13 @@ public:
   virtual void InheritState(cHardwareBase&) { ; }
   
   
+  // --------  Recycling  --------
+  // Hardware that supports recycling can be handed to a new organism with the same instruction set (see cTestCPU),
+  // rather than being destroyed and reallocated.  Recycle leaves the hardware as if it had just been constructed.
+  virtual bool SupportsRecycle() const { return false; }
+  virtual void Recycle(cAvidaContext&, cOrganism*) { assert(false); }
+  
+  
   // --------  Alarm  --------
   virtual bool Jump_To_Alarm_Label(int) { return false; }
   
@@ -244,6 +252,7 @@ public:
   
 protected:
   void ResizeCostArrays(int new_size);
+  void recycleBase(cOrganism* org);
 
   // --------  Core Execution Methods  --------
   bool SingleProcess_PayPreCosts(cAvidaContext& ctx, const Instruction& cur_inst, const int thread_id);
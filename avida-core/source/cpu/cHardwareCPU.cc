@@ -772,7 +772,18 @@ cHardwareCPU::cHardwareCPU(cAvidaContext& ctx, cWorld* world, cOrganism* in_orga
 , m_last_cell_data(false, 0)
 {
   m_functions = s_inst_slib->GetFunctions();
-  
+  setupOrganism(ctx);
+}
+
+void cHardwareCPU::Recycle(cAvidaContext& ctx, cOrganism* org)
+{
+  recycleBase(org);
+  m_last_cell_data = std::make_pair(false, 0);
+  setupOrganism(ctx);
+}
+
+void cHardwareCPU::setupOrganism(cAvidaContext& ctx)
+{
   m_spec_die = false;
   m_epigenetic_state = false;
   
@@ -785,7 +796,7 @@ cHardwareCPU::cHardwareCPU(cAvidaContext& ctx, cWorld* world, cOrganism* in_orga
   m_slip_read_head = !m_world->GetConfig().SLIP_COPY_MODE.Get();
   
   // Initialize memory...
-  const Genome& in_genome = in_organism->GetGenome();
+  const Genome& in_genome = m_organism->GetGenome();
   ConstInstructionSequencePtr in_seq_p;
   in_seq_p.DynamicCastFrom(in_genome.Representation());
   m_memory = *in_seq_p;
@@ -957,8 +968,9 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
     
     // Find the instruction to be executed
     const Instruction cur_inst = ip.GetInst();
+    const cInstSet::sInstDecode& decoded = m_inst_set->GetDecoded(cur_inst);
     
-    if (speculative && (m_spec_die || m_inst_set->ShouldStall(cur_inst))) {
+    if (speculative && (m_spec_die || (decoded.flags & nInstFlag::STALL))) {
       // Speculative instruction reject, flush and return
       m_cur_thread = last_thread;
       phenotype.DecCPUCyclesUsed();
@@ -982,11 +994,12 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
       // NOTE: This call based on the cur_inst must occur prior to instruction
       //       execution, because this instruction reference may be invalid after
       //       certain classes of instructions (namely divide instructions) @DMB
-      const int time_cost = m_inst_set->GetAddlTimeCost(cur_inst);
+      const int time_cost = decoded.addl_time_cost;
+      const int lib_fun_id = decoded.lib_fun_id;
       
       // Prob of exec (moved from SingleProcess_PayCosts so that we advance IP after a fail)
-      if (m_inst_set->GetProbFail(cur_inst) > 0.0) {
-        exec = !( ctx.GetRandom().P(m_inst_set->GetProbFail(cur_inst)) );
+      if (decoded.prob_fail > 0.0) {
+        exec = !( ctx.GetRandom().P(decoded.prob_fail) );
       }
       
       // Flag instruction as executed even if it failed (moved from SingleProcess_ExecuteInst)
@@ -999,7 +1012,7 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
       if (m_promoters_enabled) m_threads[m_cur_thread].IncPromoterInstExecuted();
       
       if (exec == true) {
-        if (SingleProcess_ExecuteInst(ctx, cur_inst)) { 
+        if (SingleProcess_ExecuteInst(ctx, cur_inst, lib_fun_id)) { 
           SingleProcess_PayPostResCosts(ctx, cur_inst); 
           SingleProcess_SetPostCPUCosts(ctx, cur_inst, m_cur_thread); 
         }
@@ -1059,14 +1072,11 @@ bool cHardwareCPU::SingleProcess(cAvidaContext& ctx, bool speculative)
 
 // This method will handle the actual execution of an instruction
 // within a single process, once that function has been finalized.
-bool cHardwareCPU::SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst) 
+bool cHardwareCPU::SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst, int inst_idx) 
 {
   // Copy Instruction locally to handle stochastic effects
   Instruction actual_inst = cur_inst;
   
-  // Get a pointer to the corresponding method...
-  int inst_idx = m_inst_set->GetLibFunctionIndex(actual_inst);
-  
   // instruction execution count incremented
   m_organism->GetPhenotype().IncCurInstCount(actual_inst.GetOp());
 	
@@ -1215,197 +1225,38 @@ cHeadCPU cHardwareCPU::FindLabel(int direction)
 // Search forwards for search_label from _after_ position pos in the
 // memory.  Return the first line _after_ the the found label.  It is okay
 // to find search label's match inside another label.
+// The memory's label index answers the search (see cLabelIndex).
 
-int cHardwareCPU::FindLabel_Forward(const cCodeLabel & search_label,
-                                    const InstructionSequence & search_genome, int pos)
+int cHardwareCPU::FindLabel_Forward(const cCodeLabel& search_label, const cCPUMemory& search_genome, int pos)
 {
   assert (pos < search_genome.GetSize() && pos >= 0);
   
-  int search_start = pos;
-  int label_size = search_label.GetSize();
-  bool found_label = false;
-  
-  // Move off the template we are on.
-  pos += label_size;
-  
-  // Search until we find the complement or exit the memory.
-  while (pos < search_genome.GetSize()) {
-    
-    // If we are within a label, rewind to the beginning of it and see if
-    // it has the proper sub-label that we're looking for.
-    
-    if (m_inst_set->IsNop(search_genome[pos])) {
-      // Find the start and end of the label we're in the middle of.
-      
-      int start_pos = pos;
-      int end_pos = pos + 1;
-      while (start_pos > search_start &&
-             m_inst_set->IsNop( search_genome[start_pos - 1] )) {
-        start_pos--;
-      }
-      while (end_pos < search_genome.GetSize() &&
-             m_inst_set->IsNop( search_genome[end_pos] )) {
-        end_pos++;
-      }
-      int test_size = end_pos - start_pos;
-      
-      // See if this label has the proper sub-label within it.
-      int max_offset = test_size - label_size + 1;
-      int offset = start_pos;
-      for (offset = start_pos; offset < start_pos + max_offset; offset++) {
-        
-        // Test the number of matches for this offset.
-        int matches;
-        for (matches = 0; matches < label_size; matches++) {
-          if (search_label[matches] !=
-              m_inst_set->GetNopMod( search_genome[offset + matches] )) {
-            break;
-          }
-        }
-        
-        // If we have found it, break out of this loop!
-        if (matches == label_size) {
-          found_label = true;
-          break;
-        }
-      }
-      
-      // If we've found the complement label, set the position to the end of
-      // the label we found it in, and break out.
-      
-      if (found_label == true) {
-        // pos = end_pos;
-        pos = label_size + offset;
-        break;
-      }
-      
-      // We haven't found it; jump pos to just after the current label being
-      // checked.
-      pos = end_pos;
-    }
-    
-    // Jump up a block to the next possible point to find a label,
-    pos += label_size;
-  }
-  
-  // If the label was not found return a -1.
-  if (found_label == false) pos = -1;
-  
-  return pos;
+  return search_genome.GetLabelIndex().FindSublabelForward(search_genome, *m_inst_set, search_label, pos);
 }
 
 // Search backwards for search_label from _before_ position pos in the
 // memory.  Return the first line _after_ the the found label.  It is okay
 // to find search label's match inside another label.
 
-int cHardwareCPU::FindLabel_Backward(const cCodeLabel & search_label,
-                                     const InstructionSequence & search_genome, int pos)
+int cHardwareCPU::FindLabel_Backward(const cCodeLabel& search_label, const cCPUMemory& search_genome, int pos)
 {
   assert (pos < search_genome.GetSize());
   
-  int search_start = pos;
-  int label_size = search_label.GetSize();
-  bool found_label = false;
-  
-  // Move off the template we are on.
-  pos -= label_size;
-  
-  // Search until we find the complement or exit the memory.
-  while (pos >= 0) {
-    // If we are within a label, rewind to the beginning of it and see if
-    // it has the proper sub-label that we're looking for.
-    
-    if (m_inst_set->IsNop( search_genome[pos] )) {
-      // Find the start and end of the label we're in the middle of.
-      
-      int start_pos = pos;
-      int end_pos = pos + 1;
-      while (start_pos > 0 && m_inst_set->IsNop(search_genome[start_pos - 1])) {
-        start_pos--;
-      }
-      while (end_pos < search_start &&
-             m_inst_set->IsNop(search_genome[end_pos])) {
-        end_pos++;
-      }
-      int test_size = end_pos - start_pos;
-      
-      // See if this label has the proper sub-label within it.
-      int max_offset = test_size - label_size + 1;
-      for (int offset = start_pos; offset < start_pos + max_offset; offset++) {
-        
-        // Test the number of matches for this offset.
-        int matches;
-        for (matches = 0; matches < label_size; matches++) {
-          if (search_label[matches] !=
-              m_inst_set->GetNopMod(search_genome[offset + matches])) {
-            break;
-          }
-        }
-        
-        // If we have found it, break out of this loop!
-        if (matches == label_size) {
-          found_label = true;
-          break;
-        }
-      }
-      
-      // If we've found the complement label, set the position to the end of
-      // the label we found it in, and break out.
-      
-      if (found_label == true) {
-        pos = end_pos;
-        break;
-      }
-      
-      // We haven't found it; jump pos to just before the current label
-      // being checked.
-      pos = start_pos - 1;
-    }
-    
-    // Jump up a block to the next possible point to find a label,
-    pos -= label_size;
-  }
-  
-  // If the label was not found return a -1.
-  if (found_label == false) pos = -1;
-  
-  return pos;
+  return search_genome.GetLabelIndex().FindSublabelBackward(search_genome, *m_inst_set, search_label, pos);
 }
 
-// Search for 'in_label' anywhere in the hardware.
-cHeadCPU cHardwareCPU::FindLabel(const cCodeLabel & in_label, int direction)
+// Search for 'in_label' anywhere in the hardware, from the front of the memory
+// (or from its end when direction is negative).  Return a head on the last
+// line of the label, or at position -1 if it does not appear.
+cHeadCPU cHardwareCPU::FindLabel(const cCodeLabel& in_label, int direction)
 {
   assert (in_label.GetSize() > 0);
   
-  // IDEALY:
-  // Keep making jumps (in the proper direction) equal to the label
-  // length.  If we are inside of a label, check its size, and see if
-  // any of the sub-labels match properly.
-  // FOR NOW:
-  // Get something which works, no matter how inefficient!!!
-  
   cHeadCPU temp_head(this);
+  const cCPUMemory& memory = temp_head.GetMemory();
+  const int found_pos = memory.GetLabelIndex().FindSublabel(memory, *m_inst_set, in_label, direction < 0);
   
-  while (temp_head.InMemory()) {
-    // IDEALY: Analyze the label we are in; see if the one we are looking
-    // for could be a sub-label of it.  Skip past it if not.
-    
-    int i;
-    for (i = 0; i < in_label.GetSize(); i++) {
-      if (!m_inst_set->IsNop(temp_head.GetInst()) ||
-          in_label[i] != m_inst_set->GetNopMod(temp_head.GetInst())) {
-        break;
-      }
-    }
-    if (i == GetLabel().GetSize()) {
-      temp_head.AbsJump(i - 1);
-      return temp_head;
-    }
-    
-    temp_head.AbsJump(direction);     // IDEALY: MAKE LARGER JUMPS
-  }
-  
-  temp_head.AbsSet(-1);
+  temp_head.AbsSet((found_pos >= 0) ? found_pos + in_label.GetSize() - 1 : -1);
   return temp_head;
 }
 
@@ -91,6 +91,7 @@ protected:
     void SetID(int in_id) { m_id = in_id; }
     int GetPromoterInstExecuted() { return m_promoter_inst_executed; }
     void IncPromoterInstExecuted() { m_promoter_inst_executed++; }
+    void SetPromoterInstExecuted(int value) { m_promoter_inst_executed = value; }
     void ResetPromoterInstExecuted() { m_promoter_inst_executed = 0; }
     void setMessageTriggerType(int value) { m_messageTriggerType = value; }
     int getMessageTriggerType() { return m_messageTriggerType; }
@@ -153,7 +154,9 @@ protected:
   // Epigenetic State -->
 
 
-  bool SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst);
+  bool SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst, int inst_idx);
+  inline bool SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst)
+    { return SingleProcess_ExecuteInst(ctx, cur_inst, m_inst_set->GetLibFunctionIndex(cur_inst)); }
   
   // --------  Stack Manipulation...  --------
   inline void StackPush(int value);
@@ -173,8 +176,8 @@ protected:
   cCodeLabel& GetLabel() { return m_threads[m_cur_thread].next_label; }
   void ReadLabel(int max_size=cCodeLabel::MAX_LENGTH);
   cHeadCPU FindLabel(int direction);
-  int FindLabel_Forward(const cCodeLabel & search_label, const InstructionSequence& search_genome, int pos);
-  int FindLabel_Backward(const cCodeLabel & search_label, const InstructionSequence& search_genome, int pos);
+  int FindLabel_Forward(const cCodeLabel& search_label, const cCPUMemory& search_genome, int pos);
+  int FindLabel_Backward(const cCodeLabel& search_label, const cCPUMemory& search_genome, int pos);
   cHeadCPU FindLabel(const cCodeLabel & in_label, int direction);
   void FindLabelInMemory(const cCodeLabel& label, cHeadCPU& search_head);
 
@@ -211,6 +214,7 @@ protected:
   bool Allocate_Main(cAvidaContext& ctx, const int allocated_size);
 
 
+  void setupOrganism(cAvidaContext& ctx);
   void internalReset();
 
   void internalResetOnFailedDivide();
@@ -249,6 +253,8 @@ public:
   int GetType() const { return HARDWARE_TYPE_CPU_ORIGINAL; }  
   bool SupportsSpeculative() const { return true; }
   void PrintStatus(std::ostream& fp);
+  bool SupportsRecycle() const { return true; }
+  void Recycle(cAvidaContext& ctx, cOrganism* org);
   void SetupMiniTraceFileHeader(Avida::Output::File& df, const int gen_id, const Apto::String& genotype);
   void PrintMiniTraceStatus(cAvidaContext& ctx, std::ostream& fp) { (void)ctx, (void)fp; }
   void PrintMiniTraceSuccess(std::ostream& fp, const int exec_success) { (void)fp, (void)exec_success; }
@@ -618,8 +618,9 @@ bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
     
     // Find the instruction to be executed
     const Instruction cur_inst = ip.GetInst();
+    const cInstSet::sInstDecode& decoded = m_inst_set->GetDecoded(cur_inst);
     
-    if (speculative && (m_spec_die || m_inst_set->ShouldStall(cur_inst))) {
+    if (speculative && (m_spec_die || (decoded.flags & nInstFlag::STALL))) {
       // Speculative instruction reject, flush and return
       m_cur_thread = last_thread;
       phenotype.DecCPUCyclesUsed();
@@ -655,11 +656,12 @@ bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
       // NOTE: This call based on the cur_inst must occur prior to instruction
       //       execution, because this instruction reference may be invalid after
       //       certain classes of instructions (namely divide instructions) @DMB
-      const int addl_time_cost = m_inst_set->GetAddlTimeCost(cur_inst);
+      const int addl_time_cost = decoded.addl_time_cost;
+      const int lib_fun_id = decoded.lib_fun_id;
       
       // Prob of exec (moved from SingleProcess_PayCosts so that we advance IP after a fail)
-      if ( m_inst_set->GetProbFail(cur_inst) > 0.0 ) {
-        exec = !( ctx.GetRandom().P(m_inst_set->GetProbFail(cur_inst)) );
+      if ( decoded.prob_fail > 0.0 ) {
+        exec = !( ctx.GetRandom().P(decoded.prob_fail) );
         rand_fail = !exec;
       }
       
@@ -667,7 +669,7 @@ bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
       if (m_promoters_enabled) m_threads[m_cur_thread].IncPromoterInstExecuted();
       
       if (exec == true) {
-        if (SingleProcess_ExecuteInst(ctx, cur_inst)) {
+        if (SingleProcess_ExecuteInst(ctx, cur_inst, lib_fun_id)) {
           SingleProcess_PayPostResCosts(ctx, cur_inst); 
           SingleProcess_SetPostCPUCosts(ctx, cur_inst, m_cur_thread); 
           // record execution success
@@ -736,14 +738,11 @@ bool cHardwareExperimental::SingleProcess(cAvidaContext& ctx, bool speculative)
 
 // This method will handle the actuall execution of an instruction
 // within single process, once that function has been finalized.
-bool cHardwareExperimental::SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst) 
+bool cHardwareExperimental::SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst, int inst_idx) 
 {
   // Copy Instruction locally to handle stochastic effects
   Instruction actual_inst = cur_inst;
   
-  // Get a pointer to the corrisponding method...
-  int inst_idx = m_inst_set->GetLibFunctionIndex(actual_inst);
-  
   // Mark the instruction as executed
   getIP().SetFlagExecuted();
 	
@@ -973,37 +972,19 @@ cHeadCPU cHardwareExperimental::FindLabelStart(bool mark_executed)
   if (search_label.GetSize() == 0) return ip;
   
   cCPUMemory& memory = m_memory;
-  int pos = 0;
   
-  while (pos < memory.GetSize()) {
-    if (m_inst_set->IsLabel(memory[pos])) { // starting label found
-      pos++;
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos < memory.GetSize()) {
-        if (!m_inst_set->IsNop(memory[pos]) || search_label[size_matched] != m_inst_set->GetNopMod(memory[pos])) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        // Return Head pointed at last NOP of label sequence
-        if (mark_executed) {
-          size_matched++; // Increment size matched so that it includes the label instruction
-          const int start = pos - size_matched;
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
-          for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(start + i);
-        }
-        return cHeadCPU(this, pos - 1, ip.GetMemSpace());
-      }
-      
-      continue; 
+  // Check for direct matched label pattern, can be substring of 'label'ed target
+  // - must match all NOPs in search_label
+  // - extra NOPs in 'label'ed target are ignored
+  const int label_start = memory.GetLabelIndex().FindLabelInstStart(memory, *m_inst_set, search_label);
+  if (label_start >= 0) {
+    // Return Head pointed at last NOP of label sequence
+    const int size_matched = search_label.GetSize() + 1; // includes the label instruction
+    if (mark_executed) {
+      const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
+      for (int i = 0; i < size_matched && i < max; i++) memory.SetFlagExecuted(label_start + i);
     }
-    pos++;
+    return cHeadCPU(this, label_start + size_matched - 1, ip.GetMemSpace());
   }
   
   // Return start point if not found
@@ -1061,42 +1042,25 @@ cHeadCPU cHardwareExperimental::FindLabelForward(bool mark_executed)
   // Make sure the label is of size > 0.
   if (search_label.GetSize() == 0) return ip;
   
-  cHeadCPU pos(ip);
-  pos++;
-  
-  while (pos.GetPosition() != ip.GetPosition()) {
-    if (m_inst_set->IsLabel(pos.GetInst())) { // starting label found
-      const int label_start = pos.GetPosition();
-      pos++;
-      
-      // Check for direct matched label pattern, can be substring of 'label'ed target
-      // - must match all NOPs in search_label
-      // - extra NOPs in 'label'ed target are ignored
-      int size_matched = 0;
-      while (size_matched < search_label.GetSize() && pos.GetPosition() != ip.GetPosition()) {
-        if (!m_inst_set->IsNop(pos.GetInst()) || search_label[size_matched] != m_inst_set->GetNopMod(pos.GetInst())) break;
-        size_matched++;
-        pos++;
-      }
-      
-      // Check that the label matches and has examined the full sequence of nops following the 'label' instruction
-      if (size_matched == search_label.GetSize()) {
-        pos--;
-        const int found_pos = pos.GetPosition();
-        
-        if (mark_executed) {
-          pos.Set(label_start);
-          const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
-          for (int i = 0; i < size_matched && i < max; i++, pos++) pos.SetFlagExecuted();
-        }
-        
-        // Return Head pointed at last NOP of label sequence
-        return cHeadCPU(this, found_pos, ip.GetMemSpace());
-      }
-      
-      continue; 
+  // Check for direct matched label pattern, can be substring of 'label'ed target, searching around the memory from
+  // just after the IP and stopping once back at it
+  // - must match all NOPs in search_label
+  // - extra NOPs in 'label'ed target are ignored
+  cCPUMemory& memory = ip.GetMemory();
+  const int label_start = memory.GetLabelIndex().FindLabelInstForward(memory, *m_inst_set, search_label, ip.GetPosition());
+  if (label_start >= 0) {
+    cHeadCPU pos(ip);
+    pos.Set(label_start + search_label.GetSize(), ip.GetMemSpace());
+    const int found_pos = pos.GetPosition();
+    
+    if (mark_executed) {
+      pos.Set(label_start, ip.GetMemSpace());
+      const int max = m_world->GetConfig().MAX_LABEL_EXE_SIZE.Get() + 1; // Max label + 1 for the label instruction itself
+      for (int i = 0; i < search_label.GetSize() && i < max; i++, pos++) pos.SetFlagExecuted();
     }
-    pos++;
+    
+    // Return Head pointed at last NOP of label sequence
+    return cHeadCPU(this, found_pos, ip.GetMemSpace());
   }
   
   // Return start point if not found
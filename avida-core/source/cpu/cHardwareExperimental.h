@@ -307,7 +307,9 @@ public:
 private:
   
   // --------  Core Execution Methods  --------
-  bool SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst);
+  bool SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst, int inst_idx);
+  inline bool SingleProcess_ExecuteInst(cAvidaContext& ctx, const Instruction& cur_inst)
+    { return SingleProcess_ExecuteInst(ctx, cur_inst, m_inst_set->GetLibFunctionIndex(cur_inst)); }
   void internalReset();
   void internalResetOnFailedDivide();
   
@@ -237,7 +237,7 @@ bool cHardwareManager::ConvertLegacyInstSetFile(cString filename, cStringList& s
 }
 
 
-cHardwareBase* cHardwareManager::Create(cAvidaContext& ctx, cOrganism* org, const Genome& mg)
+cHardwareBase* cHardwareManager::Create(cAvidaContext& ctx, cOrganism* org, const Genome& mg, Apto::Array<cHardwareBase*, Apto::Smart>* hw_pool)
 {
   assert(org != NULL);
 	
@@ -255,6 +255,19 @@ cHardwareBase* cHardwareManager::Create(cAvidaContext& ctx, cOrganism* org, cons
     return NULL; // inst_set/hw_type mismatch
   }
   
+  // Reuse pooled hardware built for the same instruction set, if available
+  if (hw_pool) {
+    for (int i = hw_pool->GetSize() - 1; i >= 0; i--) {
+      cHardwareBase* hw = (*hw_pool)[i];
+      if (&hw->GetInstSet() != inst_set) continue;
+      
+      (*hw_pool)[i] = (*hw_pool)[hw_pool->GetSize() - 1];
+      hw_pool->Resize(hw_pool->GetSize() - 1);
+      hw->Recycle(ctx, org);
+      return hw;
+    }
+  }
+  
   cHardwareBase* hw = 0;
   switch (inst_set->GetHardwareType()) {
     case HARDWARE_TYPE_CPU_ORIGINAL:
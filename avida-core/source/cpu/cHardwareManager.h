@@ -23,6 +23,7 @@
 #define cHardwareManager_h
 
 #include "cTestCPU.h"
+#include "cTestCPUResultCache.h"
 
 namespace Avida {
   class Genome;
@@ -46,6 +47,7 @@ private:
   cWorld* m_world;
   Apto::Array<cInstSet*> m_inst_sets;
   Apto::Map<Apto::String, int> m_is_name_map;
+  cTestCPUResultCache m_test_cache;
 
   
   cHardwareManager(); // @not_implemented
@@ -64,8 +66,9 @@ public:
   bool LoadInstSets(cUserFeedback* feedback = NULL);
   bool ConvertLegacyInstSetFile(cString filename, cStringList& str_list, cUserFeedback* feedback = NULL);
   
-  cHardwareBase* Create(cAvidaContext& ctx, cOrganism* org, const Genome& mg);
+  cHardwareBase* Create(cAvidaContext& ctx, cOrganism* org, const Genome& mg, Apto::Array<cHardwareBase*, Apto::Smart>* hw_pool = NULL);
   inline cTestCPU* CreateTestCPU(cAvidaContext& ctx) { return new cTestCPU(ctx, m_world); }
+  cTestCPUResultCache& GetTestCPUResultCache() { return m_test_cache; }
 
   inline bool IsInstSet(const Apto::String& name) const { return m_is_name_map.Has(name); }
   
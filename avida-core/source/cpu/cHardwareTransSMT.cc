@@ -451,195 +451,36 @@ cHeadCPU cHardwareTransSMT::FindLabel(int direction)
 // Search forwards for search_label from _after_ position pos in the
 // memory.  Return the first line _after_ the the found label.  It is okay
 // to find search label's match inside another label.
-int cHardwareTransSMT::FindLabel_Forward(const cCodeLabel& search_label,
-                                         const InstructionSequence& search_genome, int pos)
+// The memory's label index answers the search (see cLabelIndex).
+int cHardwareTransSMT::FindLabel_Forward(const cCodeLabel& search_label, const cCPUMemory& search_genome, int pos)
 {
   assert (pos < search_genome.GetSize() && pos >= 0);
-	
-  int search_start = pos;
-  int label_size = search_label.GetSize();
-  bool found_label = false;
-	
-  // Move off the template we are on.
-  pos += label_size;
-	
-  // Search until we find the complement or exit the memory.
-  while (pos < search_genome.GetSize()) {
-		
-    // If we are within a label, rewind to the beginning of it and see if
-    // it has the proper sub-label that we're looking for.
-		
-    if (m_inst_set->IsNop(search_genome[pos])) {
-      // Find the start and end of the label we're in the middle of.
-			
-      int start_pos = pos;
-      int end_pos = pos + 1;
-      while (start_pos > search_start &&
-						 m_inst_set->IsNop( search_genome[start_pos - 1] )) {
-				start_pos--;
-      }
-      while (end_pos < search_genome.GetSize() &&
-						 m_inst_set->IsNop( search_genome[end_pos] )) {
-				end_pos++;
-      }
-      int test_size = end_pos - start_pos;
-			
-      // See if this label has the proper sub-label within it.
-      int max_offset = test_size - label_size + 1;
-      int offset = start_pos;
-      for (offset = start_pos; offset < start_pos + max_offset; offset++) {
-				
-				// Test the number of matches for this offset.
-				int matches;
-				for (matches = 0; matches < label_size; matches++) {
-					if (search_label[matches] !=
-							m_inst_set->GetNopMod( search_genome[offset + matches] )) {
-						break;
-					}
-				}
-				
-				// If we have found it, break out of this loop!
-				if (matches == label_size) {
-					found_label = true;
-					break;
-				}
-      }
-			
-      // If we've found the complement label, set the position to the end of
-      // the label we found it in, and break out.
-			
-      if (found_label == true) {
-				// pos = end_pos;
-				pos = label_size + offset;
-				break;
-      }
-			
-      // We haven't found it; jump pos to just after the current label being
-      // checked.
-      pos = end_pos;
-    }
-		
-    // Jump up a block to the next possible point to find a label,
-    pos += label_size;
-  }
-	
-  // If the label was not found return a -1.
-  if (found_label == false) pos = -1;
-	
-  return pos;
+  
+  return search_genome.GetLabelIndex().FindSublabelForward(search_genome, *m_inst_set, search_label, pos);
 }
 
 // Search backwards for search_label from _before_ position pos in the
 // memory.  Return the first line _after_ the the found label.  It is okay
 // to find search label's match inside another label.
-int cHardwareTransSMT::FindLabel_Backward(const cCodeLabel & search_label,
-                                          const InstructionSequence & search_genome, int pos)
+int cHardwareTransSMT::FindLabel_Backward(const cCodeLabel& search_label, const cCPUMemory& search_genome, int pos)
 {
   assert (pos < search_genome.GetSize());
-	
-  int search_start = pos;
-  int label_size = search_label.GetSize();
-  bool found_label = false;
-	
-  // Move off the template we are on.
-  pos -= label_size;
-	
-  // Search until we find the complement or exit the memory.
-  while (pos >= 0) {
-    // If we are within a label, rewind to the beginning of it and see if
-    // it has the proper sub-label that we're looking for.
-		
-    if (m_inst_set->IsNop( search_genome[pos] )) {
-      // Find the start and end of the label we're in the middle of.
-			
-      int start_pos = pos;
-      int end_pos = pos + 1;
-      while (start_pos > 0 && m_inst_set->IsNop(search_genome[start_pos - 1])) {
-				start_pos--;
-      }
-      while (end_pos < search_start &&
-						 m_inst_set->IsNop(search_genome[end_pos])) {
-				end_pos++;
-      }
-      int test_size = end_pos - start_pos;
-			
-      // See if this label has the proper sub-label within it.
-      int max_offset = test_size - label_size + 1;
-      for (int offset = start_pos; offset < start_pos + max_offset; offset++) {
-				
-				// Test the number of matches for this offset.
-				int matches;
-				for (matches = 0; matches < label_size; matches++) {
-					if (search_label[matches] !=
-							m_inst_set->GetNopMod(search_genome[offset + matches])) {
-						break;
-					}
-				}
-				
-				// If we have found it, break out of this loop!
-				if (matches == label_size) {
-					found_label = true;
-					break;
-				}
-      }
-			
-      // If we've found the complement label, set the position to the end of
-      // the label we found it in, and break out.
-			
-      if (found_label == true) {
-				pos = end_pos;
-				break;
-      }
-			
-      // We haven't found it; jump pos to just before the current label
-      // being checked.
-      pos = start_pos - 1;
-    }
-		
-    // Jump up a block to the next possible point to find a label,
-    pos -= label_size;
-  }
-	
-  // If the label was not found return a -1.
-  if (found_label == false) pos = -1;
-	
-  return pos;
+  
+  return search_genome.GetLabelIndex().FindSublabelBackward(search_genome, *m_inst_set, search_label, pos);
 }
 
-// Search for 'in_label' anywhere in the hardware.
+// Search for 'in_label' anywhere in the hardware, from the front of the memory
+// (or from its end when direction is negative).  Return a head on the last
+// line of the label, or at position -1 if it does not appear.
 cHeadCPU cHardwareTransSMT::FindLabel(const cCodeLabel& in_label, int direction)
 {
   assert (in_label.GetSize() > 0);
-	
-  // IDEALY:
-  // Keep making jumps (in the proper direction) equal to the label
-  // length.  If we are inside of a label, check its size, and see if
-  // any of the sub-labels match properly.
-  // FOR NOW:
-  // Get something which works, no matter how inefficient!!!
-	
+  
   cHeadCPU temp_head(this);
-	
-  while (temp_head.InMemory()) {
-    // IDEALY: Analyze the label we are in; see if the one we are looking
-    // for could be a sub-label of it.  Skip past it if not.
-		
-    int i;
-    for (i = 0; i < in_label.GetSize(); i++) {
-      if (!m_inst_set->IsNop(temp_head.GetInst()) ||
-					in_label[i] != m_inst_set->GetNopMod(temp_head.GetInst())) {
-				break;
-      }
-    }
-    if (i == GetLabel().GetSize()) {
-      temp_head.AbsJump(i - 1);
-      return temp_head;
-    }
-		
-    temp_head.AbsJump(direction);     // IDEALY: MAKE LARGER JUMPS
-  }
-	
-  temp_head.AbsSet(-1);
+  const cCPUMemory& memory = temp_head.GetMemory();
+  const int found_pos = memory.GetLabelIndex().FindSublabel(memory, *m_inst_set, in_label, direction < 0);
+  
+  temp_head.AbsSet((found_pos >= 0) ? found_pos + in_label.GetSize() - 1 : -1);
   return temp_head;
 }
 
@@ -43,6 +43,8 @@ cInstSet::cInstSet(const cInstSet& _in)
   , m_hw_type(_in.m_hw_type)
   , m_inst_lib(_in.m_inst_lib)
   , m_lib_name_map(_in.m_lib_name_map)
+  , m_lib_nopmod_map(_in.m_lib_nopmod_map)
+  , m_decode_map(_in.m_decode_map)
   , m_mutation_index(NULL)
   , m_has_costs(_in.m_has_costs)
   , m_has_ft_costs(_in.m_has_ft_costs)
@@ -64,6 +66,8 @@ cInstSet& cInstSet::operator=(const cInstSet& _in)
   m_hw_type = _in.m_hw_type;
   m_inst_lib = _in.m_inst_lib;
   m_lib_name_map = _in.m_lib_name_map;
+  m_lib_nopmod_map = _in.m_lib_nopmod_map;
+  m_decode_map = _in.m_decode_map;
   m_mutation_index = NULL;
   m_has_costs = _in.m_has_costs;
   m_has_ft_costs = _in.m_has_ft_costs;
@@ -116,10 +120,26 @@ Instruction cInstSet::ActivateNullInst()
   m_lib_name_map[inst_id].post_cost = 0;
   m_lib_name_map[inst_id].bonus_cost = 0.0;
   
+  rebuildDecodeMap();
+  
   return Instruction(inst_id);
 }
 
 
+void cInstSet::rebuildDecodeMap()
+{
+  m_decode_map.Resize(m_lib_name_map.GetSize());
+  for (int i = 0; i < m_lib_name_map.GetSize(); i++) {
+    const int fun_id = m_lib_name_map[i].lib_fun_id;
+    m_decode_map[i].lib_fun_id = fun_id;
+    m_decode_map[i].addl_time_cost = m_lib_name_map[i].addl_time_cost;
+    m_decode_map[i].prob_fail = m_lib_name_map[i].prob_fail;
+    m_decode_map[i].flags = (*m_inst_lib)[fun_id].GetFlags();
+    m_decode_map[i].nop_mod = (i < m_lib_nopmod_map.GetSize()) ? m_inst_lib->GetNopMod(m_lib_nopmod_map[i]) : -1;
+  }
+}
+
+
 cString cInstSet::FindBestMatch(const cString& in_name) const
 {
   int best_dist = 1024;
@@ -309,6 +329,9 @@ bool cInstSet::LoadWithStringList(const cStringList& sl, cUserFeedback* feedback
      }
      m_mutation_index->SetWeight(id, m_lib_name_map[id].redundancy);
   }
+  
+  rebuildDecodeMap();
+  
   return success;
 }
 
@@ -77,6 +77,16 @@ public:
   
   Apto::Array<int> m_lib_nopmod_map;
   
+  // Compact per-opcode view of the entries consulted by the hardware on every executed instruction
+  struct sInstDecode {
+    int lib_fun_id;
+    int addl_time_cost;
+    double prob_fail;
+    unsigned int flags;       // instruction library flags (nInstFlag)
+    int nop_mod;              // modifier of nop instructions, -1 for all other instructions
+  };
+  Apto::Array<sInstDecode, Apto::Smart> m_decode_map;
+  
   cOrderedWeightedIndex* m_mutation_index;     // Weighted index for instructions 
   
   bool m_has_costs;
@@ -126,12 +136,9 @@ public:
   double GetBonusCost(const Instruction& inst) const { return m_lib_name_map[inst.GetOp()].bonus_cost; }
   
   int GetLibFunctionIndex(const Instruction& inst) const { return m_lib_name_map[inst.GetOp()].lib_fun_id; }
+  const sInstDecode& GetDecoded(const Instruction& inst) const { return m_decode_map[inst.GetOp()]; }
 
-  int GetNopMod(const Instruction& inst) const
-  {
-    int nopmod = m_lib_nopmod_map[inst.GetOp()];
-    return m_inst_lib->GetNopMod(nopmod);
-  }
+  int GetNopMod(const Instruction& inst) const { return m_decode_map[inst.GetOp()].nop_mod; }
 
   Instruction GetRandomInst(cAvidaContext& ctx) const;
   int GetRandFunctionIndex(cAvidaContext& ctx) const { return m_lib_name_map[ GetRandomInst(ctx).GetOp() ].lib_fun_id; }
@@ -157,7 +164,7 @@ public:
   bool IsLabel(const Instruction& inst) const { return m_inst_lib->Get(GetLibFunctionIndex(inst)).IsLabel(); }
   bool IsPromoter(const Instruction& inst) const { return m_inst_lib->Get(GetLibFunctionIndex(inst)).IsPromoter(); }
   bool IsTerminator(const Instruction& inst) const { return m_inst_lib->Get(GetLibFunctionIndex(inst)).IsTerminator(); }
-  bool ShouldStall(const Instruction& inst) const { return m_inst_lib->Get(GetLibFunctionIndex(inst)).ShouldStall(); }
+  bool ShouldStall(const Instruction& inst) const { return (m_decode_map[inst.GetOp()].flags & nInstFlag::STALL) != 0; }
   bool ShouldSleep(const Instruction& inst) const { return m_inst_lib->Get(GetLibFunctionIndex(inst)).ShouldSleep(); }
   bool IsImmediateValue(const Instruction& inst) const { return (inst != GetInstError() && m_inst_lib->Get(GetLibFunctionIndex(inst)).IsImmediateValue()); }
   
@@ -168,7 +175,8 @@ public:
   Instruction ActivateNullInst();
   
   // Modification of instructions during run.
-  void SetProbFail(const Instruction& inst, double _prob_fail) { m_lib_name_map[inst.GetOp()].prob_fail = _prob_fail; }
+  void SetProbFail(const Instruction& inst, double _prob_fail)
+    { m_lib_name_map[inst.GetOp()].prob_fail = _prob_fail; m_decode_map[inst.GetOp()].prob_fail = _prob_fail; }
   void SetRedundancy(const Instruction& inst, int _redundancy) { m_lib_name_map[inst.GetOp()].redundancy = _redundancy; m_mutation_index->SetWeight(inst.GetOp(), _redundancy);}
 
   // accessors for instruction library
@@ -185,6 +193,9 @@ public:
   bool LoadWithStringList(const cStringList& sl, cUserFeedback* errors = NULL);
   
   void SaveInstructionSequence(ofstream& of, const InstructionSequence& seq) const;
+
+private:
+  void rebuildDecodeMap();
 };
 
 
@@ -0,0 +1,201 @@
+/*
+ *  cLabelIndex.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cLabelIndex.h"
+
+#include "cInstSet.h"
+
+using namespace Avida;
+
+
+// The index of the first entry of a sorted array that is greater than value
+static int upperBound(const Apto::Array<int>& positions, int value)
+{
+  int low = 0;
+  int high = positions.GetSize();
+  while (low < high) {
+    const int mid = (low + high) / 2;
+    if (positions[mid] <= value) low = mid + 1;
+    else high = mid;
+  }
+  return low;
+}
+
+
+int cLabelIndex::FindSublabelForward(const InstructionSequence& memory, const cInstSet& inst_set,
+                                     const cCodeLabel& label, int pos)
+{
+  update(memory, inst_set, false);
+  const Apto::Array<int>& positions = occurrences(label, false);
+  const int label_size = label.GetSize();
+
+  // Matches in nop runs that end within the label size of pos are skipped over; there are at most a few of them
+  for (int i = upperBound(positions, pos - 1); i < positions.GetSize(); i++) {
+    if (m_run_end[positions[i]] > pos + label_size) return positions[i] + label_size;
+  }
+  return -1;
+}
+
+
+int cLabelIndex::FindSublabelBackward(const InstructionSequence& memory, const cInstSet& inst_set,
+                                      const cCodeLabel& label, int pos)
+{
+  update(memory, inst_set, false);
+  const Apto::Array<int>& positions = occurrences(label, false);
+
+  const int i = upperBound(positions, pos - label.GetSize()) - 1;
+  if (i < 0) return -1;
+  const int run_end = m_run_end[positions[i]];
+  return (run_end < pos) ? run_end : pos;
+}
+
+
+int cLabelIndex::FindSublabel(const InstructionSequence& memory, const cInstSet& inst_set, const cCodeLabel& label,
+                              bool from_end)
+{
+  update(memory, inst_set, false);
+  const Apto::Array<int>& positions = occurrences(label, false);
+  if (positions.GetSize() == 0) return -1;
+  return (from_end) ? positions[positions.GetSize() - 1] : positions[0];
+}
+
+
+int cLabelIndex::FindLabelInstStart(const InstructionSequence& memory, const cInstSet& inst_set,
+                                    const cCodeLabel& label)
+{
+  update(memory, inst_set, true);
+  const Apto::Array<int>& positions = occurrences(label, true);
+
+  // Occurrences are matched circularly, the first one is only usable if its nops do not wrap around
+  if (positions.GetSize() == 0 || positions[0] + label.GetSize() >= m_size) return -1;
+  return positions[0];
+}
+
+
+int cLabelIndex::FindLabelInstForward(const InstructionSequence& memory, const cInstSet& inst_set,
+                                      const cCodeLabel& label, int pos)
+{
+  update(memory, inst_set, true);
+  const Apto::Array<int>& positions = occurrences(label, true);
+  if (positions.GetSize() == 0) return -1;
+
+  // The closest occurrence after pos, wrapping around, is the only candidate; if its nops reach pos, so would those
+  // of every later one
+  const int i = upperBound(positions, pos);
+  const int found = (i < positions.GetSize()) ? positions[i] : positions[0];
+  int distance = found - pos;
+  if (distance <= 0) distance += m_size;
+  if (distance + label.GetSize() >= m_size) return -1;
+  return found;
+}
+
+
+void cLabelIndex::update(const InstructionSequence& memory, const cInstSet& inst_set, bool need_label_flags)
+{
+  if (m_valid && (m_inst_set != &inst_set || m_size != memory.GetSize())) m_valid = false;
+
+  // Writes that leave every nop (and label instruction) in place do not change any search result
+  if (m_valid && m_dirty_start < m_dirty_end) {
+    const int end = (m_dirty_end < m_size) ? m_dirty_end : m_size;
+    for (int i = m_dirty_start; i < end; i++) {
+      const int nop_mod = (inst_set.IsNop(memory[i])) ? inst_set.GetNopMod(memory[i]) : -1;
+      if (nop_mod != m_nop_mod[i] || (m_has_label_flags && inst_set.IsLabel(memory[i]) != m_is_label[i])) {
+        m_valid = false;
+        break;
+      }
+    }
+  }
+  m_dirty_start = 0;
+  m_dirty_end = 0;
+
+  if (!m_valid) rebuild(memory, inst_set);
+
+  if (need_label_flags && !m_has_label_flags) {
+    m_is_label.ResizeClear(m_size);
+    for (int i = 0; i < m_size; i++) m_is_label[i] = inst_set.IsLabel(memory[i]);
+    m_has_label_flags = true;
+  }
+}
+
+
+void cLabelIndex::rebuild(const InstructionSequence& memory, const cInstSet& inst_set)
+{
+  m_inst_set = &inst_set;
+  m_size = memory.GetSize();
+
+  m_nop_mod.ResizeClear(m_size);
+  for (int i = 0; i < m_size; i++) m_nop_mod[i] = (inst_set.IsNop(memory[i])) ? inst_set.GetNopMod(memory[i]) : -1;
+
+  m_run_end.ResizeClear(m_size);
+  for (int i = m_size - 1, run_end = m_size; i >= 0; i--) {
+    if (m_nop_mod[i] < 0) run_end = i;
+    m_run_end[i] = run_end;
+  }
+
+  m_has_label_flags = false;
+  m_num_labels = 0;
+  m_valid = true;
+}
+
+
+const Apto::Array<int>& cLabelIndex::occurrences(const cCodeLabel& label, bool after_label_inst)
+{
+  for (int i = 0; i < m_num_labels; i++) {
+    if (m_labels[i].after_label_inst == after_label_inst && m_labels[i].label == label) return m_labels[i].positions;
+  }
+
+  // Searches usually come from a handful of templates, just start over if a genome uses unusually many
+  if (m_labels.GetSize() == 0) m_labels.Resize(MAX_CACHED_LABELS);
+  if (m_num_labels == MAX_CACHED_LABELS) m_num_labels = 0;
+
+  sLabelEntry& entry = m_labels[m_num_labels++];
+  entry.label = label;
+  entry.after_label_inst = after_label_inst;
+  entry.positions.Resize(0);
+
+  const int label_size = label.GetSize();
+  if (label_size == 0) return entry.positions;
+
+  if (after_label_inst) {
+    for (int pos = 0; pos < m_size; pos++) {
+      if (!m_is_label[pos]) continue;
+      int matched = 0;
+      for (int check = pos + 1; matched < label_size; matched++, check++) {
+        if (check >= m_size) check -= m_size;
+        if (m_nop_mod[check] != label[matched]) break;
+      }
+      if (matched == label_size) entry.positions.Push(pos);
+    }
+  } else {
+    for (int pos = 0; pos + label_size <= m_size; pos++) {
+      if (m_nop_mod[pos] < 0) continue;
+      if (m_run_end[pos] - pos < label_size) {
+        pos = m_run_end[pos];  // the rest of this run is too short
+        continue;
+      }
+      int matched = 0;
+      while (matched < label_size && m_nop_mod[pos + matched] == label[matched]) matched++;
+      if (matched == label_size) entry.positions.Push(pos);
+    }
+  }
+
+  return entry.positions;
+}
@@ -0,0 +1,115 @@
+/*
+ *  cLabelIndex.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cLabelIndex_h
+#define cLabelIndex_h
+
+#include "avida/core/InstructionSequence.h"
+
+#include "cCodeLabel.h"
+
+class cInstSet;
+
+
+// cLabelIndex answers the label searches of the hardware types without walking the memory on every jump.  On first
+// use it records the nop modifier of every position and the extent of every run of nops; each label searched for then
+// gets a sorted list of the places it occurs, so that a search becomes a binary search over those places.  The owning
+// cCPUMemory reports every modification.  Writes that leave the nops as they were (the common case while copying)
+// keep the index, anything else rebuilds it on the next search.
+//
+// Two kinds of occurrence are kept: a label anywhere inside a run of nops (the templates of cHardwareCPU and
+// cHardwareTransSMT), and a label that immediately follows a 'label' instruction (cHardwareExperimental and the
+// hardware types derived from it), matched circularly around the end of the memory.  Label instructions are assumed
+// not to be nops, as in every instruction library.
+
+class cLabelIndex
+{
+private:
+  static const int MAX_CACHED_LABELS = 32;
+
+  struct sLabelEntry
+  {
+    cCodeLabel label;
+    bool after_label_inst;
+    Apto::Array<int> positions;
+  };
+
+  const cInstSet* m_inst_set;
+  bool m_valid;
+  int m_size;
+  int m_dirty_start;
+  int m_dirty_end;
+
+  Apto::Array<int> m_nop_mod;  // nop modifier at each position, -1 for other instructions
+  Apto::Array<int> m_run_end;  // end (exclusive) of the run of nops holding each position
+  bool m_has_label_flags;
+  Apto::Array<bool> m_is_label;
+
+  Apto::Array<sLabelEntry> m_labels;
+  int m_num_labels;
+
+
+  cLabelIndex(const cLabelIndex&); // @not_implemented
+  cLabelIndex& operator=(const cLabelIndex&); // @not_implemented
+
+public:
+  cLabelIndex()
+    : m_inst_set(NULL), m_valid(false), m_size(0), m_dirty_start(0), m_dirty_end(0), m_has_label_flags(false)
+    , m_num_labels(0) { ; }
+
+  inline void Invalidate() { m_valid = false; }
+  inline void MarkModified(int pos)
+  {
+    if (!m_valid) return;
+    if (m_dirty_start == m_dirty_end) { m_dirty_start = pos; m_dirty_end = pos + 1; }
+    else if (pos < m_dirty_start) m_dirty_start = pos;
+    else if (pos >= m_dirty_end) m_dirty_end = pos + 1;
+  }
+
+  // As cHardwareCPU::FindLabel_Forward: the position after the first match at or after pos whose nop run extends
+  // past pos + the label size, or -1
+  int FindSublabelForward(const Avida::InstructionSequence& memory, const cInstSet& inst_set, const cCodeLabel& label,
+                          int pos);
+
+  // As cHardwareCPU::FindLabel_Backward: for the last match ending at or before pos, the end of its nop run (but no
+  // further than pos), or -1
+  int FindSublabelBackward(const Avida::InstructionSequence& memory, const cInstSet& inst_set, const cCodeLabel& label,
+                           int pos);
+
+  // The first or last match of label anywhere in the memory, given as the position of its first nop, or -1
+  int FindSublabel(const Avida::InstructionSequence& memory, const cInstSet& inst_set, const cCodeLabel& label,
+                   bool from_end);
+
+  // The position of the first label instruction followed by the nops of label, without wrapping around, or -1
+  int FindLabelInstStart(const Avida::InstructionSequence& memory, const cInstSet& inst_set, const cCodeLabel& label);
+
+  // The position of the first label instruction after pos (wrapping around) followed by the nops of label, the last
+  // of which comes before pos is reached again, or -1
+  int FindLabelInstForward(const Avida::InstructionSequence& memory, const cInstSet& inst_set, const cCodeLabel& label,
+                           int pos);
+
+private:
+  void update(const Avida::InstructionSequence& memory, const cInstSet& inst_set, bool need_label_flags);
+  void rebuild(const Avida::InstructionSequence& memory, const cInstSet& inst_set);
+  const Apto::Array<int>& occurrences(const cCodeLabel& label, bool after_label_inst);
+};
+
+#endif
@@ -33,6 +33,10 @@
 #include "cInstSet.h"
 #include "cOrganism.h"
 #include "cPhenotype.h"
+#include "cReaction.h"
+#include "cReactionLib.h"
+#include "cReactionProcess.h"
+#include "cReactionRequisite.h"
 #include "cResource.h"
 #include "cResourceCount.h"
 #include "cResourceHistory.h"
@@ -57,11 +61,16 @@ cTestCPU::cTestCPU(cAvidaContext& ctx, cWorld* world)
   InitResources(ctx);
 }  
 
+cTestCPU::~cTestCPU()
+{
+  for (int i = 0; i < m_hw_pool.GetSize(); i++) delete m_hw_pool[i];
+}
+
  
 void cTestCPU::InitResources(cAvidaContext& ctx, int res_method, cResourceHistory* res, int update, int cpu_cycle_offset)
 {  
   //FOR DEMES
-  m_deme_resource_count.SetSize(0);
+  if (m_deme_resource_count.GetSize()) m_deme_resource_count.SetSize(0);
 
   m_res_method = (eTestCPUResourceMethod)res_method;
   // Make sure it's valid
@@ -94,10 +103,12 @@ void cTestCPU::InitResources(cAvidaContext& ctx, int res_method, cResourceHistor
   const cResourceLib& resource_lib = m_world->GetEnvironment().GetResourceLib();
   assert(resource_lib.GetSize() >= 0);
   
-  // Set the resource count to zero by default
-  m_resource_count.SetSize(resource_lib.GetSize());
-  m_faced_cell_resource_count.SetSize(resource_lib.GetSize());
-  m_cell_resource_count.SetSize(resource_lib.GetSize());
+  // Set the resource count to zero by default (only reallocating when the number of resources has changed)
+  if (m_resource_count.GetSize() != resource_lib.GetSize()) {
+    m_resource_count.SetSize(resource_lib.GetSize());
+    m_faced_cell_resource_count.SetSize(resource_lib.GetSize());
+    m_cell_resource_count.SetSize(resource_lib.GetSize());
+  }
   for (int i = 0; i < resource_lib.GetSize(); i++) {
     m_resource_count.Set(ctx, i, 0.0);
     m_faced_cell_resource_count.Set(ctx, i, 0.0);
@@ -190,8 +201,9 @@ bool cTestCPU::ProcessGestation(cAvidaContext& ctx, cCPUTestInfo& test_info, int
 bool cTestCPU::TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome)
 {
   ctx.SetTestMode();
+  recycleOrganisms(test_info);
   test_info.Clear();
-  TestGenome_Body(ctx, test_info, genome, 0);
+  runTest(ctx, test_info, genome);
   ctx.ClearTestMode();
   
   return test_info.is_viable;
@@ -200,8 +212,9 @@ bool cTestCPU::TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Gen
 bool cTestCPU::TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, ofstream& out_fp)
 {
   ctx.SetTestMode();
+  recycleOrganisms(test_info);
   test_info.Clear();
-  TestGenome_Body(ctx, test_info, genome, 0);
+  runTest(ctx, test_info, genome);
 
   ////////////////////////////////////////////////////////////////
   // IsViable() == false
@@ -230,6 +243,133 @@ bool cTestCPU::TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Gen
   return test_info.is_viable;
 }
 
+void cTestCPU::runTest(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome)
+{
+  cTestCPUResultCache& cache = m_world->GetHardwareManager().GetTestCPUResultCache();
+  
+  Apto::String key;
+  if (test_info.m_use_result_cache) {
+    cache.SetMaxSize(m_world->GetConfig().TEST_CPU_CACHE_SIZE.Get());
+    if (cache.GetMaxSize() > 0) key = resultCacheKey(test_info, genome);
+  }
+  const bool use_cache = (key.GetSize() > 0);
+  
+  cTestCPUResultCache::sResult result;
+  if (use_cache && cache.Get(key, result)) {
+    test_info.is_viable = result.is_viable;
+    test_info.max_depth = result.max_depth;
+    test_info.depth_found = result.depth_found;
+    test_info.max_cycle = result.max_cycle;
+    test_info.cycle_to = result.cycle_to;
+    test_info.used_inputs = result.used_inputs;
+    test_info.m_genotype_fitness = result.genotype_fitness;
+    test_info.m_colony_fitness = result.colony_fitness;
+    test_info.m_colony_merit = result.colony_merit;
+    test_info.m_colony_gestation = result.colony_gestation;
+    test_info.m_colony_tasks = result.colony_tasks;
+    test_info.m_from_cache = true;
+    return;
+  }
+  
+  TestGenome_Body(ctx, test_info, genome, 0);
+  recordSummary(test_info);
+  
+  if (use_cache) {
+    result.is_viable = test_info.is_viable;
+    result.max_depth = test_info.max_depth;
+    result.depth_found = test_info.depth_found;
+    result.max_cycle = test_info.max_cycle;
+    result.cycle_to = test_info.cycle_to;
+    result.used_inputs = test_info.used_inputs;
+    result.genotype_fitness = test_info.m_genotype_fitness;
+    result.colony_fitness = test_info.m_colony_fitness;
+    result.colony_merit = test_info.m_colony_merit;
+    result.colony_gestation = test_info.m_colony_gestation;
+    result.colony_tasks = test_info.m_colony_tasks;
+    cache.Set(key, result);
+  }
+}
+
+// Takes the hardware of the organisms left over from the last test run with test_info, to be reused by this one
+void cTestCPU::recycleOrganisms(cCPUTestInfo& test_info)
+{
+  for (int i = 0; i < test_info.generation_tests; i++) {
+    cOrganism* organism = test_info.org_array[i];
+    if (organism == NULL) break;
+    
+    cHardwareBase* hw = organism->DetachHardware();
+    if (hw->SupportsRecycle() && m_hw_pool.GetSize() < nHardware::TEST_CPU_GENERATIONS) m_hw_pool.Push(hw);
+    else delete hw;
+    
+    delete organism;
+    test_info.org_array[i] = NULL;
+  }
+}
+
+void cTestCPU::recordSummary(cCPUTestInfo& test_info)
+{
+  if (test_info.org_array[0] == NULL) return;
+  
+  test_info.m_genotype_fitness = test_info.org_array[0]->GetPhenotype().GetFitness();
+  
+  cPhenotype& phenotype = test_info.GetColonyOrganism()->GetPhenotype();
+  if (test_info.is_viable) test_info.m_colony_fitness = phenotype.GetFitness();
+  test_info.m_colony_merit = phenotype.GetMerit().GetDouble();
+  test_info.m_colony_gestation = phenotype.GetGestationTime();
+  test_info.m_colony_tasks = phenotype.GetLastTaskCount();
+}
+
+// Returns an empty key when the outcome of the test is not reproducible (random inputs, any mutation rate above zero)
+// or the caller wants the side effects of actually running it (tracing).
+Apto::String cTestCPU::resultCacheKey(const cCPUTestInfo& test_info, const Genome& genome) const
+{
+  if (test_info.use_random_inputs || test_info.trace_task_order || test_info.m_tracer) return "";
+  if (test_info.m_mut_rates.HasNonZeroRates()) return "";
+  
+  // Resources are identified by the contents of the history they are drawn from, as InitResources selects it
+  const cResourceHistory* res = test_info.m_res;
+  if (test_info.m_res_method < 0 || test_info.m_res_method >= RES_LAST || test_info.m_res_method == RES_INITIAL) {
+    res = &m_world->GetEnvironment().GetResourceLib().GetInitialResourceLevels();
+  }
+  const Apto::String res_fingerprint = (res) ? res->GetFingerprint() : Apto::String("none");
+  
+  Apto::String key = Apto::FormatStr("%d,%d,%d,%d,%s,%d,%d,%d,%.17g|",
+                                     test_info.generation_tests, test_info.m_cur_sg,
+                                     m_world->GetConfig().TEST_CPU_TIME_MOD.Get(), test_info.m_res_method,
+                                     (const char*)res_fingerprint, test_info.m_res_update,
+                                     test_info.m_res_cpu_cycle_offset, m_test_solo_res, m_test_solo_res_lev);
+  
+  if (test_info.use_manual_inputs) {
+    for (int i = 0; i < test_info.manual_inputs.GetSize(); i++) key += Apto::FormatStr("%d,", test_info.manual_inputs[i]);
+    key += "|";
+  }
+  
+  // Reaction values and requisites may be altered by events during a run
+  const cReactionLib& reaction_lib = m_world->GetEnvironment().GetReactionLib();
+  for (int i = 0; i < reaction_lib.GetSize(); i++) {
+    cReaction* reaction = reaction_lib.GetReaction(i);
+    key += Apto::FormatStr("%d,%p", reaction->GetActive(), static_cast<const void*>(reaction->GetTask()));
+    const tList<cReactionProcess>& processes = reaction->GetProcesses();
+    for (int p = 0; p < processes.GetSize(); p++) {
+      const cReactionProcess* process = processes.GetPos(p);
+      key += Apto::FormatStr(",%.17g,%d,%.17g,%.17g,%.17g,%s", process->GetValue(), process->GetType(),
+                             process->GetMaxNumber(), process->GetMinNumber(), process->GetMaxFraction(),
+                             (const char*)process->GetInst());
+    }
+    const tList<cReactionRequisite>& requisites = reaction->GetRequisites();
+    for (int r = 0; r < requisites.GetSize(); r++) {
+      const cReactionRequisite* requisite = requisites.GetPos(r);
+      key += Apto::FormatStr(",%d,%d,%d,%d", requisite->GetMinTaskCount(), requisite->GetMaxTaskCount(),
+                             requisite->GetMinReactionCount(), requisite->GetMaxReactionCount());
+    }
+    key += ";";
+  }
+  
+  key += "|";
+  key += genome.AsString();
+  return key;
+}
+
 bool cTestCPU::TestGenome_Body(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, int cur_depth)
 {
   assert(cur_depth < test_info.generation_tests);
@@ -260,7 +400,7 @@ bool cTestCPU::TestGenome_Body(cAvidaContext& ctx, cCPUTestInfo& test_info, cons
   if (test_info.org_array[cur_depth] != NULL) {
     delete test_info.org_array[cur_depth];
   }
-  cOrganism* organism = new cOrganism(m_world, ctx, genome, -1, Systematics::Source(Systematics::DIVISION, "", true));
+  cOrganism* organism = new cOrganism(m_world, ctx, genome, -1, Systematics::Source(Systematics::DIVISION, "", true), &m_hw_pool);
   
   // Copy the test mutation rates
   organism->MutationRates().Copy(test_info.MutationRates());
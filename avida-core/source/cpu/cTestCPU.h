@@ -33,6 +33,7 @@
 
 class cAvidaContext;
 class cBioGroup;
+class cHardwareBase;
 class cInstSet;
 class cResourceCount;
 class cResourceHistory;
@@ -66,11 +67,20 @@ private:
   cResourceCount m_faced_cell_resource_count;
   cResourceCount m_deme_resource_count;
   cResourceCount m_cell_resource_count;
+  
+  // Hardware released by previously tested organisms, reused by the next ones
+  Apto::Array<cHardwareBase*, Apto::Smart> m_hw_pool;
     
 
   bool ProcessGestation(cAvidaContext& ctx, cCPUTestInfo& test_info, int cur_depth);
   bool TestGenome_Body(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, int cur_depth);
 
+  // Result cache support
+  void runTest(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome);
+  void recycleOrganisms(cCPUTestInfo& test_info);
+  void recordSummary(cCPUTestInfo& test_info);
+  Apto::String resultCacheKey(const cCPUTestInfo& test_info, const Genome& genome) const;
+
   
   cTestCPU(); // @not_implemented
   cTestCPU(const cTestCPU&); // @not_implemented
@@ -85,7 +95,7 @@ private:
   
 public:
   cTestCPU(cAvidaContext& ctx, cWorld* world);
-  ~cTestCPU() { }
+  ~cTestCPU();
   
   bool TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome);
   bool TestGenome(cAvidaContext& ctx, cCPUTestInfo& test_info, const Genome& genome, std::ofstream& out_fp);
@@ -0,0 +1,78 @@
+/*
+ *  cTestCPUResultCache.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cTestCPUResultCache.h"
+
+
+void cTestCPUResultCache::SetMaxSize(int max_size)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+
+  if (max_size < 0) max_size = 0;
+  if (max_size == m_max_size) return;
+
+  m_max_size = max_size;
+  m_results.Clear();
+  m_order.Resize(0);
+  m_next = 0;
+}
+
+
+bool cTestCPUResultCache::Get(const Apto::String& key, sResult& result)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+
+  if (!m_results.Get(key, result)) {
+    m_misses++;
+    return false;
+  }
+
+  m_hits++;
+  return true;
+}
+
+
+void cTestCPUResultCache::Set(const Apto::String& key, const sResult& result)
+{
+  Apto::MutexAutoLock lock(m_mutex);
+
+  if (m_max_size == 0 || m_results.Has(key)) return;
+
+  if (m_order.GetSize() < m_max_size) {
+    m_order.Push(key);
+  } else {
+    // Full, replace the oldest entry
+    m_results.Remove(m_order[m_next]);
+    m_order[m_next] = key;
+    m_next = (m_next + 1) % m_max_size;
+  }
+  m_results.Set(key, result);
+}
+
+
+void cTestCPUResultCache::Clear()
+{
+  Apto::MutexAutoLock lock(m_mutex);
+
+  m_results.Clear();
+  m_order.Resize(0);
+  m_next = 0;
+}
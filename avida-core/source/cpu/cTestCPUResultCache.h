@@ -0,0 +1,83 @@
+/*
+ *  cTestCPUResultCache.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cTestCPUResultCache_h
+#define cTestCPUResultCache_h
+
+#include "apto/core.h"
+#include "apto/core/Mutex.h"
+
+
+// cTestCPUResultCache memoizes the outcome of test CPU runs, so that analyses which repeatedly test the same genomes
+// (landscapes, mutational neighborhoods) do not re-execute them.  The cache is shared by all test CPUs of a world and
+// may be used concurrently from analyze jobs.  Keys are built by cTestCPU and capture everything that determines the
+// outcome of a test; only the summary outputs held in sResult are stored, not the test organisms themselves.  When full,
+// the oldest entries are evicted first.
+
+class cTestCPUResultCache
+{
+public:
+  struct sResult
+  {
+    bool is_viable;
+    int max_depth;
+    int depth_found;
+    int max_cycle;
+    int cycle_to;
+    Apto::Array<int> used_inputs;
+
+    double genotype_fitness;
+    double colony_fitness;
+    double colony_merit;
+    int colony_gestation;
+    Apto::Array<int> colony_tasks;
+  };
+
+private:
+  Apto::Mutex m_mutex;
+  int m_max_size;
+  Apto::Map<Apto::String, sResult> m_results;
+  Apto::Array<Apto::String> m_order;    // ring of keys in insertion order, used for eviction
+  int m_next;
+  int m_hits;
+  int m_misses;
+
+
+  cTestCPUResultCache(const cTestCPUResultCache&); // @not_implemented
+  cTestCPUResultCache& operator=(const cTestCPUResultCache&); // @not_implemented
+
+public:
+  cTestCPUResultCache() : m_max_size(0), m_next(0), m_hits(0), m_misses(0) { ; }
+  ~cTestCPUResultCache() { ; }
+
+  // Changing the size discards all cached results, a size of zero disables the cache
+  void SetMaxSize(int max_size);
+  int GetMaxSize() const { return m_max_size; }
+
+  bool Get(const Apto::String& key, sResult& result);
+  void Set(const Apto::String& key, const sResult& result);
+  void Clear();
+
+  int GetNumHits() const { return m_hits; }
+  int GetNumMisses() const { return m_misses; }
+};
+
+#endif
@@ -29,6 +29,8 @@
 #include "avida/data/Provider.h"
 #include "avida/data/Recorder.h"
 
+#include "apto/core/Thread.h"
+
 #include <cassert>
 
 
@@ -42,13 +44,278 @@ bool Avida::Data::Manager::s_registered_with_facet_factory =
   Avida::WorldFacet::RegisterFacetType(Avida::Reserved::DataManagerFacetID, DeserializeDataManager);
 
 
-Avida::Data::Manager::Manager() : m_world(NULL), m_available(new DataSet)
+// Data::Manager::UpdatePipeline - Parallel provider refresh and asynchronous recorder notification
+// --------------------------------------------------------------------------------------------------------------
+//
+// Providers that support parallel update are refreshed by a small pool of worker threads, alongside the calling
+// thread which handles the remaining providers.  Recorders that support asynchronous notification are handed a
+// snapshot of their requested values, which is delivered in update order by a background thread so that any output
+// they generate overlaps with the following update.
+
+class Avida::Data::Manager::UpdatePipeline
+{
+private:
+  static const int MAX_UPDATE_WORKERS = 4;
+  static const int MAX_PENDING_NOTIFY = 64;
+  
+  class UpdateWorker : public Apto::Thread
+  {
+  private:
+    UpdatePipeline* m_pipeline;
+    void Run();
+  public:
+    UpdateWorker(UpdatePipeline* pipeline) : m_pipeline(pipeline) { ; }
+  };
+  
+  class NotifyWorker : public Apto::Thread
+  {
+  private:
+    UpdatePipeline* m_pipeline;
+    void Run();
+  public:
+    NotifyWorker(UpdatePipeline* pipeline) : m_pipeline(pipeline) { ; }
+  };
+  
+  struct PendingNotify
+  {
+    RecorderPtr recorder;
+    Update update;
+    Apto::Map<DataID, PackagePtr> values;
+    
+    PackagePtr GetValue(const DataID& data_id) const { return values.GetWithDefault(data_id, PackagePtr(NULL)); }
+  };
+  
+  
+  // Parallel provider refresh
+  Apto::Array<UpdateWorker*> m_update_workers;
+  Apto::Array<ProviderPtr, Apto::Smart> m_parallel_providers;
+  Update m_current_update;
+  Apto::Mutex m_update_mutex;
+  Apto::ConditionVariable m_update_cond;
+  Apto::ConditionVariable m_update_done_cond;
+  volatile int m_next_provider;
+  volatile int m_pending_providers;
+  volatile int m_generation;
+  
+  // Asynchronous notification
+  NotifyWorker* m_notify_worker;
+  Apto::List<PendingNotify*> m_notify_queue;
+  Apto::Mutex m_notify_mutex;
+  Apto::ConditionVariable m_notify_cond;
+  Apto::ConditionVariable m_notify_done_cond;
+  volatile bool m_notify_busy;
+  
+  volatile bool m_shutdown;
+  
+  
+  void updateParallelProviders();
+  
+public:
+  UpdatePipeline();
+  ~UpdatePipeline();
+  
+  void UpdateProviders(const Apto::Array<ProviderPtr>& providers, Update current_update);
+  void QueueNotify(RecorderPtr recorder, Update current_update, const Manager* manager);
+  void Flush();
+};
+
+
+Avida::Data::Manager::UpdatePipeline::UpdatePipeline()
+  : m_current_update(-1), m_next_provider(0), m_pending_providers(0), m_generation(0), m_notify_worker(NULL)
+  , m_notify_busy(false), m_shutdown(false)
+{
+}
+
+Avida::Data::Manager::UpdatePipeline::~UpdatePipeline()
+{
+  Flush();
+  
+  m_update_mutex.Lock();
+  m_notify_mutex.Lock();
+  m_shutdown = true;
+  m_notify_mutex.Unlock();
+  m_update_mutex.Unlock();
+  m_update_cond.Broadcast();
+  m_notify_cond.Broadcast();
+  
+  for (int i = 0; i < m_update_workers.GetSize(); i++) {
+    m_update_workers[i]->Join();
+    delete m_update_workers[i];
+  }
+  if (m_notify_worker) {
+    m_notify_worker->Join();
+    delete m_notify_worker;
+  }
+}
+
+
+void Avida::Data::Manager::UpdatePipeline::UpdateProviders(const Apto::Array<ProviderPtr>& providers,
+                                                           Update current_update)
+{
+  // Collect the parallel providers, holding back all entries until the update is published below
+  m_update_mutex.Lock();
+  m_parallel_providers.Resize(0);
+  for (int i = 0; i < providers.GetSize(); i++) {
+    if (providers[i]->SupportsParallelUpdate()) m_parallel_providers.Push(providers[i]);
+  }
+  m_next_provider = m_parallel_providers.GetSize();
+  m_update_mutex.Unlock();
+  
+  // Start up workers the first time there is more than one provider to share between threads
+  if (m_update_workers.GetSize() == 0 && m_parallel_providers.GetSize() > 1) {
+    int num_workers = Apto::Platform::AvailableCPUs() - 1;
+    if (num_workers > MAX_UPDATE_WORKERS) num_workers = MAX_UPDATE_WORKERS;
+    if (num_workers > 0) {
+      m_update_workers.Resize(num_workers);
+      for (int i = 0; i < num_workers; i++) {
+        m_update_workers[i] = new UpdateWorker(this);
+        m_update_workers[i]->Start();
+      }
+    }
+  }
+  
+  if (m_parallel_providers.GetSize() > 1 && m_update_workers.GetSize()) {
+    m_update_mutex.Lock();
+    m_current_update = current_update;
+    m_next_provider = 0;
+    m_pending_providers = m_parallel_providers.GetSize();
+    m_generation++;
+    m_update_mutex.Unlock();
+    m_update_cond.Broadcast();
+  } else {
+    m_update_mutex.Lock();
+    m_parallel_providers.Resize(0);
+    m_next_provider = 0;
+    m_update_mutex.Unlock();
+  }
+  
+  // Update the remaining providers on this thread, in order
+  for (int i = 0; i < providers.GetSize(); i++) {
+    if (!m_parallel_providers.GetSize() || !providers[i]->SupportsParallelUpdate()) {
+      providers[i]->UpdateProvidedValues(current_update);
+    }
+  }
+  
+  if (m_parallel_providers.GetSize()) {
+    // Help out with the parallel providers, then wait for any still being updated by workers
+    updateParallelProviders();
+    
+    m_update_mutex.Lock();
+    while (m_pending_providers > 0) m_update_done_cond.Wait(m_update_mutex);
+    m_update_mutex.Unlock();
+  }
+}
+
+void Avida::Data::Manager::UpdatePipeline::updateParallelProviders()
+{
+  while (true) {
+    m_update_mutex.Lock();
+    if (m_next_provider >= m_parallel_providers.GetSize()) {
+      m_update_mutex.Unlock();
+      return;
+    }
+    ProviderPtr provider = m_parallel_providers[m_next_provider++];
+    const Update update = m_current_update;
+    m_update_mutex.Unlock();
+    
+    provider->UpdateProvidedValues(update);
+    
+    m_update_mutex.Lock();
+    const int pending = --m_pending_providers;
+    m_update_mutex.Unlock();
+    if (!pending) m_update_done_cond.Signal();
+  }
+}
+
+void Avida::Data::Manager::UpdatePipeline::UpdateWorker::Run()
+{
+  int last_generation = 0;
+  while (true) {
+    m_pipeline->m_update_mutex.Lock();
+    while (m_pipeline->m_generation == last_generation && !m_pipeline->m_shutdown) {
+      m_pipeline->m_update_cond.Wait(m_pipeline->m_update_mutex);
+    }
+    const bool shutdown = m_pipeline->m_shutdown;
+    last_generation = m_pipeline->m_generation;
+    m_pipeline->m_update_mutex.Unlock();
+    
+    if (shutdown) break;
+    m_pipeline->updateParallelProviders();
+  }
+}
+
+
+void Avida::Data::Manager::UpdatePipeline::QueueNotify(RecorderPtr recorder, Update current_update,
+                                                       const Manager* manager)
+{
+  // Snapshot the requested values now, so that the notification does not depend on the state of the world at the
+  // time it is delivered
+  PendingNotify* entry = new PendingNotify;
+  entry->recorder = recorder;
+  entry->update = current_update;
+  ConstDataSetPtr requested = recorder->RequestedData();
+  for (ConstDataSetIterator it = requested->Begin(); it.Next();) {
+    PackagePtr value = manager->GetCurrentValue(*it.Get());
+    if (value) entry->values.Set(*it.Get(), value);
+  }
+  
+  if (!m_notify_worker) {
+    m_notify_worker = new NotifyWorker(this);
+    m_notify_worker->Start();
+  }
+  
+  m_notify_mutex.Lock();
+  // Keep the pipeline from running arbitrarily far behind
+  while (m_notify_queue.GetSize() >= MAX_PENDING_NOTIFY) m_notify_done_cond.Wait(m_notify_mutex);
+  m_notify_queue.PushRear(entry);
+  m_notify_mutex.Unlock();
+  m_notify_cond.Signal();
+}
+
+void Avida::Data::Manager::UpdatePipeline::Flush()
+{
+  m_notify_mutex.Lock();
+  while (m_notify_queue.GetSize() || m_notify_busy) m_notify_done_cond.Wait(m_notify_mutex);
+  m_notify_mutex.Unlock();
+}
+
+void Avida::Data::Manager::UpdatePipeline::NotifyWorker::Run()
+{
+  while (true) {
+    m_pipeline->m_notify_mutex.Lock();
+    while (m_pipeline->m_notify_queue.GetSize() == 0 && !m_pipeline->m_shutdown) {
+      m_pipeline->m_notify_cond.Wait(m_pipeline->m_notify_mutex);
+    }
+    if (m_pipeline->m_notify_queue.GetSize() == 0) {
+      // Shutting down with nothing left to deliver
+      m_pipeline->m_notify_mutex.Unlock();
+      break;
+    }
+    PendingNotify* entry = m_pipeline->m_notify_queue.Pop();
+    m_pipeline->m_notify_busy = true;
+    m_pipeline->m_notify_mutex.Unlock();
+    
+    DataRetrievalFunctor drf(entry, &PendingNotify::GetValue);
+    entry->recorder->NotifyData(entry->update, drf);
+    delete entry;
+    
+    m_pipeline->m_notify_mutex.Lock();
+    m_pipeline->m_notify_busy = false;
+    m_pipeline->m_notify_mutex.Unlock();
+    m_pipeline->m_notify_done_cond.Broadcast();
+  }
+}
+
+
+
+Avida::Data::Manager::Manager() : m_world(NULL), m_available(new DataSet), m_pipeline(new UpdatePipeline)
 {
   
 }
 
 Avida::Data::Manager::~Manager()
 {
+  delete m_pipeline;
 }
 
 
@@ -332,6 +599,12 @@ bool Avida::Data::Manager::DetachRecorder(RecorderPtr recorder)
   return success;
 }
 
+void Avida::Data::Manager::FlushRecorders()
+{
+  // Wait for all pending asynchronous recorder notifications to be delivered
+  m_pipeline->Flush();
+}
+
 
 bool Avida::Data::Manager::Register(const DataID& data_id, ProviderActivateFunctor functor)
 {
@@ -426,8 +699,8 @@ void Avida::Data::Manager::PerformUpdate(Context&, Update current_update)
   
   m_rwlock.ReadLock();
   
-  // Update all of the active providers
-  for (int i = 0; i < m_active_providers.GetSize(); i++) m_active_providers[i]->UpdateProvidedValues(current_update);
+  // Update all of the active providers, sharing those that support it across threads
+  m_pipeline->UpdateProviders(m_active_providers, current_update);
   
   // Notify recorders that new data is available
   DataRetrievalFunctor drf(this, &Manager::GetCurrentValue);
@@ -439,7 +712,8 @@ void Avida::Data::Manager::PerformUpdate(Context&, Update current_update)
   m_rwlock.ReadUnlock();
   
   for (Apto::Set<RecorderPtr>::Iterator it = m_recorders.Begin(); it.Next();) {
-    (*it.Get())->NotifyData(current_update, drf);
+    if ((*it.Get())->SupportsAsynchronousNotify()) m_pipeline->QueueNotify(*it.Get(), current_update, this);
+    else (*it.Get())->NotifyData(current_update, drf);
   }
   m_recorder_mutex.Unlock();
 }
@@ -33,6 +33,12 @@ bool Avida::Data::Provider::SupportsConcurrentUpdate() const
   return false;
 }
 
+bool Avida::Data::Provider::SupportsParallelUpdate() const
+{
+  // Providers that can be updated concurrently with the running world can also be updated alongside other providers
+  return SupportsConcurrentUpdate();
+}
+
 
 Avida::Data::PackagePtr Avida::Data::ArgumentedProvider::GetProvidedValuesForArguments(const DataID& data_id,
                                                                                        ConstArgumentSetPtr args) const
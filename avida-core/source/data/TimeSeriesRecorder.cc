@@ -151,7 +151,7 @@ namespace Avida {
     void TimeSeriesRecorder<PackagePtr>::NotifyData(Update update, DataRetrievalFunctor retrieve_data)
     {
       if (shouldRecordValue(update)) {
-        m_data.Push(DataEntry(update, retrieve_data(m_data_id)));
+        recordValue(update, retrieve_data(m_data_id));
         didRecordValue();
       }
     }
@@ -161,7 +161,7 @@ namespace Avida {
     void TimeSeriesRecorder<bool>::NotifyData(Update update, DataRetrievalFunctor retrieve_data)
     {
       if (shouldRecordValue(update)) {
-        m_data.Push(DataEntry(update, retrieve_data(m_data_id)->BoolValue()));
+        recordValue(update, retrieve_data(m_data_id)->BoolValue());
         didRecordValue();
       }
     }
@@ -170,7 +170,7 @@ namespace Avida {
     void TimeSeriesRecorder<int>::NotifyData(Update update, DataRetrievalFunctor retrieve_data)
     {
       if (shouldRecordValue(update)) {
-        m_data.Push(DataEntry(update, retrieve_data(m_data_id)->IntValue()));
+        recordValue(update, retrieve_data(m_data_id)->IntValue());
         didRecordValue();
       }
     }
@@ -179,7 +179,7 @@ namespace Avida {
     void TimeSeriesRecorder<double>::NotifyData(Update update, DataRetrievalFunctor retrieve_data)
     {
       if (shouldRecordValue(update)) {
-        m_data.Push(DataEntry(update, retrieve_data(m_data_id)->DoubleValue()));
+        recordValue(update, retrieve_data(m_data_id)->DoubleValue());
         didRecordValue();
       }
     }
@@ -188,7 +188,7 @@ namespace Avida {
     void TimeSeriesRecorder<Apto::String>::NotifyData(Update update, DataRetrievalFunctor retrieve_data)
     {
       if (shouldRecordValue(update)) {
-        m_data.Push(DataEntry(update, retrieve_data(m_data_id)->StringValue()));
+        recordValue(update, retrieve_data(m_data_id)->StringValue());
         didRecordValue();
       }
     }
@@ -197,6 +197,8 @@ namespace Avida {
     template <>
     Apto::String TimeSeriesRecorder<PackagePtr>::AsString() const
     {
+      Apto::MutexAutoLock lock(m_mutex);
+      
       if (m_data.GetSize() == 0) return "";
       
       Apto::String rtn = Apto::FormatStr("%d:%s", m_data[0].update, (const char*)m_data[0].data->StringValue());
@@ -209,6 +211,8 @@ namespace Avida {
     template <>
     Apto::String TimeSeriesRecorder<bool>::AsString() const
     {
+      Apto::MutexAutoLock lock(m_mutex);
+      
       if (m_data.GetSize() == 0) return "";
       
       Apto::String rtn = Apto::FormatStr("%d:%d", m_data[0].update, m_data[0].data);
@@ -221,6 +225,8 @@ namespace Avida {
     template <>
     Apto::String TimeSeriesRecorder<int>::AsString() const
     {
+      Apto::MutexAutoLock lock(m_mutex);
+      
       if (m_data.GetSize() == 0) return "";
       
       Apto::String rtn = Apto::FormatStr("%d:%d", m_data[0].update, m_data[0].data);
@@ -233,6 +239,8 @@ namespace Avida {
     template <>
     Apto::String TimeSeriesRecorder<double>::AsString() const
     {
+      Apto::MutexAutoLock lock(m_mutex);
+      
       if (m_data.GetSize() == 0) return "";
       
       Apto::String rtn = Apto::FormatStr("%d:%f", m_data[0].update, m_data[0].data);
@@ -245,6 +253,8 @@ namespace Avida {
     template <>
     Apto::String TimeSeriesRecorder<Apto::String>::AsString() const
     {
+      Apto::MutexAutoLock lock(m_mutex);
+      
       if (m_data.GetSize() == 0) return "";
       
       Apto::String rtn = Apto::FormatStr("%d:%s", m_data[0].update, (const char*)m_data[0].data);
@@ -282,6 +282,11 @@ public:
   CONFIG_ADD_VAR(VERBOSITY, int, 1, "0 = No output at all\n1 = Normal output\n2 = Verbose output, detailing progress\n3 = High level of details, as available\n4 = Print Debug Information, as applicable");
   CONFIG_ADD_VAR(RANDOM_SEED, int, -1, "Random number seed (<0 for based on time)");
   CONFIG_ADD_VAR(SPECULATIVE, bool, 1, "Enable speculative execution\n(pre-execute instructions that don't affect other organisms)");
+  CONFIG_ADD_VAR(PARALLEL_UPDATE_THREADS, int, 0, "Number of threads used to pre-execute speculative instructions at the start of each update\n(0 = disabled, -1 = use all available)\nRequires SPECULATIVE and no IMPLICIT_REPRO_* option; results are deterministic regardless of the number of threads");
+  CONFIG_ADD_VAR(PARALLEL_UPDATE_TILE_ROWS, int, 4, "Rows of cells per parallel update tile (each deme is a tile when NUM_DEMES > 1)");
+  CONFIG_ADD_VAR(PARALLEL_UPDATE_DEPTH, int, 32, "Maximum number of instructions each organism may be pre-executed ahead");
+  CONFIG_ADD_VAR(STATS_THREADS, int, 0, "Number of threads used to gather organism statistics each update\n(0 = gather serially, -1 = use all available)\nWhen enabled, sums are gathered in fixed chunks of organisms and are deterministic regardless\nof the number of threads, but may differ from serial sums in the last digits");
+  CONFIG_ADD_VAR(STATS_MESSAGE_INST, bool, 0, "Tally per-instruction execution counts of instructions run on message data each update");
   CONFIG_ADD_VAR(POPULATION_CAP, int, 0, "Carrying capacity in number of organisms (use 0 for no cap)");
   CONFIG_ADD_VAR(POP_CAP_ELDEST, int, 0, "Carrying capacity in number of organisms (use 0 for no cap). Will kill oldest organism in population, but still use birth method to place new offspring."); 
   
@@ -319,6 +324,7 @@ public:
   CONFIG_ADD_VAR(INST_POINT_MUT_SLOPE, double, 0.0, "Slope for point mutation rate");
   CONFIG_ADD_VAR(INST_POINT_REPAIR_COST, int, 0, "The cost, in cycles, of avoiding mutations when the point-mut instruction is executed");
   CONFIG_ADD_VAR(POINT_MUT_REPAIR_START, int, 0, "The starting condition for repairs (on=1; off=0)");
+  CONFIG_ADD_VAR(MUTATION_SKIP_AHEAD, bool, 0, "Draw the number of copies and locations until the next copy or point substitution,\nconsulting the random number generator only when a mutation occurs\n- Same mutation distribution, different random sequence");
 
   
   CONFIG_ADD_VAR(DIV_MUT_PROB, double, 0.0, "Substitution rate (per site, applied on divide)");
@@ -541,7 +547,8 @@ public:
   // -------- Time Slicing config options --------
   CONFIG_ADD_GROUP(TIME_GROUP, "Time Slicing");
   CONFIG_ADD_VAR(AVE_TIME_SLICE, int, 30, "Average number of CPU-cycles per org per update");
-  CONFIG_ADD_VAR(SLICING_METHOD, int, 1, "0 = CONSTANT: all organisms receive equal number of CPU cycles\n1 = PROBABILISTIC: CPU cycles distributed randomly, proportional to merit.\n2 = INTEGRATED: CPU cycles given out deterministicly, proportional to merit\n3 = DEME_PROBABALISTIC: Demes receive fixed number of CPU cycles, awarded probabalistically to members\n4 = CROSS_DEME_PROBABALISTIC: Demes receive CPU cycles proportional to living population size, awarded probabalistically to members");
+  CONFIG_ADD_VAR(SLICING_METHOD, int, 1, "0 = CONSTANT: all organisms receive equal number of CPU cycles\n1 = PROBABILISTIC: CPU cycles distributed randomly, proportional to merit.\n2 = INTEGRATED: CPU cycles given out deterministicly, proportional to merit\n3 = DEME_PROBABALISTIC: Demes receive fixed number of CPU cycles, awarded probabalistically to members\n4 = CROSS_DEME_PROBABALISTIC: Demes receive CPU cycles proportional to living population size, awarded probabalistically to members\n5 = PROBABILISTIC_INTEGRATED: Probabilistic within each update, integrated across updates\n6 = SUM_TREE: as PROBABILISTIC, using a sum-tree suited to very large populations");
+  CONFIG_ADD_VAR(BATCH_TIME_SLICES, bool, 0, "Execute all of the CPU cycles awarded to an organism in an update as a single batch\n(resource, deme and stats bookkeeping is performed once per batch rather than once per cycle)\nBirths, deaths and merit changes end the running batch; organisms born during an update only receive\nthe cycles that were drawn for organisms replaced or changed since the start of the update");
   CONFIG_ADD_VAR(BASE_MERIT_METHOD, int, 4, "How should merit be initialized?\n0 = Constant (merit independent of size)\n1 = Merit proportional to copied size\n2 = Merit prop. to executed size\n3 = Merit prop. to full size\n4 = Merit prop. to min of executed or copied size\n5 = Merit prop. to sqrt of the minimum size\n6 = Merit prop. to num times MERIT_BONUS_INST is in genome.");
   CONFIG_ADD_VAR(BASE_CONST_MERIT, int, 100, "Base merit valse for BASE_MERIT_METHOD 0");
   CONFIG_ADD_VAR(MERIT_BONUS_INST, int, 0, "Instruction ID to count for BASE_MERIT_METHOD 6"); 
@@ -592,6 +599,7 @@ public:
   CONFIG_ADD_GROUP(GENEOLOGY_GROUP, "Geneology");
   CONFIG_ADD_VAR(THRESHOLD, int, 3, "Number of organisms in a genotype needed for it\n  to be considered viable.");
   CONFIG_ADD_VAR(TEST_CPU_TIME_MOD, int, 20, "Time allocated in test CPUs (multiple of length)");
+  CONFIG_ADD_VAR(TEST_CPU_CACHE_SIZE, int, 0, "Maximum number of test CPU results to remember, for analyses that repeatedly test\n  the same genomes (landscapes, mutational neighborhoods); 0 = disabled");
   
 
   // -------- Organism Network config options --------
@@ -608,6 +616,7 @@ public:
   CONFIG_ADD_VAR(MESSAGE_RECV_BUFFER_BEHAVIOR, int, 0, "Behavior of message receive buffer; 0=drop oldest (default), 1=drop incoming");
   CONFIG_ADD_VAR(ACTIVE_MESSAGES_ENABLED, int, 0, "Enable active messages. \n0 = off\n2 = message creates parallel thread");
   CONFIG_ADD_VAR(CHECK_TASK_ON_SEND, bool, 1, "0: Don't check tasks on send, 1: Check tasks on send (default)");
+  CONFIG_ADD_VAR(BCAST_MESSAGE_ALL_IN_RANGE, bool, 0, "Message broadcasts of two or more hops reach:\n0 = the cells found by the recursive neighbor walk,\n    which misses some cells in range; these broadcasts\n    are no faster than before (default)\n1 = every cell within the given number of hops, read\n    from the precomputed neighborhood table (faster)");
 
   CONFIG_ADD_VAR(NEURAL_NETWORKING, bool, 0, "Turns neural networking system on/off. \nRequires USE_AVATARS be turned on.");
   CONFIG_ADD_VAR(SELF_COMMUNICATION, bool, 0, "Allows organisms to create self communication loops. \nAn organism's input avatars can receive messages from it's own output avatars.");
@@ -28,6 +28,8 @@
 
 #include "avida/core/Types.h"
 
+#include "cOrgOutputScratch.h"
+
 class cWorld;
 
 
@@ -41,10 +43,16 @@ private:
   bool m_testing;
   bool m_org_faults;
   
+  cOrgOutputScratch* m_output_scratch;
+  
+  
+  cAvidaContext(const cAvidaContext&); // @not_implemented
+  cAvidaContext& operator=(const cAvidaContext&); // @not_implemented
+  
 public:
-  cAvidaContext(Avida::WorldDriver* driver, Apto::Random& rng) : m_driver(driver), m_rng(&rng), m_analyze(false), m_testing(false), m_org_faults(false) { ; }
-  cAvidaContext(Avida::WorldDriver* driver, Apto::Random* rng) : m_driver(driver), m_rng(rng), m_analyze(false), m_testing(false), m_org_faults(false) { ; }
-  ~cAvidaContext() { ; }
+  cAvidaContext(Avida::WorldDriver* driver, Apto::Random& rng) : m_driver(driver), m_rng(&rng), m_analyze(false), m_testing(false), m_org_faults(false), m_output_scratch(NULL) { ; }
+  cAvidaContext(Avida::WorldDriver* driver, Apto::Random* rng) : m_driver(driver), m_rng(rng), m_analyze(false), m_testing(false), m_org_faults(false), m_output_scratch(NULL) { ; }
+  ~cAvidaContext() { delete m_output_scratch; }
   
   Avida::WorldDriver& Driver() { return *m_driver; }
   bool HasDriver() const { return (m_driver != NULL); }
@@ -64,6 +72,13 @@ public:
   void EnableOrgFaultReporting() { m_org_faults = true; }
   void DisableOrgFaultReporting() { m_org_faults = false; }
   bool OrgFaultReporting() { return m_org_faults; }
+  
+  // Working buffers for organism output processing, created on first use
+  cOrgOutputScratch& GetOutputScratch()
+  {
+    if (!m_output_scratch) m_output_scratch = new cOrgOutputScratch;
+    return *m_output_scratch;
+  }
 };
 
 #endif
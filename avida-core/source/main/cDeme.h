@@ -299,6 +299,8 @@ public:
   
   void IncTimeUsed(double merit) 
     { time_used++; cur_normalized_time_used += 1.0/merit/(double)cur_org_count; }
+  void IncTimeUsed(double merit, int steps)
+    { time_used += steps; cur_normalized_time_used += (double)steps/merit/(double)cur_org_count; }
   int GetTimeUsed() { return time_used; }
   int GetGestationTime() { return gestation_time; }
   double GetNormalizedTimeUsed() { return cur_normalized_time_used; }
@@ -1288,6 +1288,7 @@ bool cEnvironment::TestOutput(cAvidaContext& ctx, cReactionResult& result,
 
   // Do setup for reaction tests...
   m_tasklib.SetupTests(taskctx);
+  const int logic_id = taskctx.GetLogicId();
 
   // Loop through all reactions to see if any have been triggered...
   const int num_reactions = reaction_lib.GetSize();
@@ -1335,7 +1336,9 @@ bool cEnvironment::TestOutput(cAvidaContext& ctx, cReactionResult& result,
       }
     }
 
-    const double task_quality = m_tasklib.TestOutput(taskctx);
+    // Logic tasks are resolved with a table lookup on the logic id, everything else is evaluated directly
+    const double task_quality =
+      cur_task->IsLogic() ? m_tasklib.TestLogicTask(logic_id, task_id) : m_tasklib.TestOutput(taskctx);
     assert(task_quality >= 0.0);
 
     // If this task wasn't performed, move on to the next one.
@@ -25,6 +25,7 @@
 #include "avida/core/InstructionSequence.h"
 
 #include "cAvidaContext.h"
+#include "cEditDistance.h"
 #include "cInitFile.h"
 #include "cInstSet.h"
 
@@ -99,6 +100,24 @@ void cGenomeUtil::substring_match::rotate(int r, std::size_t n) {
 }
 
 
+/*! Edit distance between two genomes.
+ 
+ Uses the bit-parallel kernel in cEditDistance, whose storage is kept in the workspace so that
+ callers comparing many pairs (phylogenies, lineages, pairwise distance surveys) do not allocate
+ on every comparison.  When max_dist is non-negative only alignments within that distance are
+ explored, and any larger distance is reported as max_dist + 1.
+ */
+int cGenomeUtil::EditDistance(cEditDistance& workspace, const InstructionSequence& seq1, const InstructionSequence& seq2, int max_dist) {
+	const int size1 = seq1.GetSize();
+	const int size2 = seq2.GetSize();
+	unsigned char* ops1 = workspace.GetBuffer(0, size1);
+	unsigned char* ops2 = workspace.GetBuffer(1, size2);
+	for(int i=0; i<size1; ++i) ops1[i] = seq1[i].GetOp();
+	for(int i=0; i<size2; ++i) ops2[i] = seq2[i].GetOp();
+	return workspace.Distance(ops1, size1, ops2, size2, max_dist);
+}
+
+
 /*! Find (one of) the best substring matches of substring in base.
  
  The algorithm here is based on the well-known dynamic programming approach to
@@ -29,6 +29,7 @@
 #include <deque>
 
 class cAvidaContext;
+class cEditDistance;
 class cInstSet;
 
 using namespace Avida;
@@ -73,6 +74,12 @@ public:
 		std::size_t size; //!< Size of the base string.
 	};
 	
+	//! Edit distance between two genomes, reusing the given workspace; above a non-negative max_dist, max_dist + 1 is returned.
+	static int EditDistance(cEditDistance& workspace, const InstructionSequence& seq1, const InstructionSequence& seq2, int max_dist = -1);
+	//! True if the edit distance between two genomes is at most max_dist; stops as soon as that is ruled out.
+	static bool WithinEditDistance(cEditDistance& workspace, const InstructionSequence& seq1, const InstructionSequence& seq2, int max_dist)
+	{ return EditDistance(workspace, seq1, seq2, max_dist) <= max_dist; }
+	
 	//! Find (one of) the best matches of substring in base.
 	static substring_match FindSubstringMatch(const InstructionSequence& base, const InstructionSequence& substring);	
 	//! Find (one of) the best unbiased matches of substring in base, respecting genome circularity.
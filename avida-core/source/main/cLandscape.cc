@@ -24,6 +24,7 @@
 
 #include "avida/output/File.h"
 
+#include "cAnalyzeJobQueue.h"
 #include "cCPUMemory.h"
 #include "cEnvironment.h"
 #include "cInstSet.h"
@@ -36,14 +37,16 @@
 
 
 cLandscape::cLandscape(cWorld* world, const Genome& in_genome)
-: m_world(world), trials(1), m_min_found(0), m_max_trials(0), site_count(NULL)
+: m_world(world), trials(1), m_min_found(0), m_max_trials(0), site_count(NULL), m_job_queue(NULL), m_inst_size(0)
 {
+  m_cpu_test_info.UseResultCache();
   Reset(in_genome);
 }
 
 cLandscape::~cLandscape()
 {
   if (site_count != NULL) delete [] site_count;
+  destroyTesters();
 }
 
 void cLandscape::Reset(const Genome& in_genome)
@@ -92,6 +95,9 @@ void cLandscape::Reset(const Genome& in_genome)
   neut_max = 0.0;
   
   m_num_found = 0;
+  
+  // Testers hold copies of the old base genome
+  destroyTesters();
 }
 
 double cLandscape::ProcessGenome(cAvidaContext& ctx, cTestCPU* testcpu, Genome& in_genome)
@@ -100,24 +106,11 @@ double cLandscape::ProcessGenome(cAvidaContext& ctx, cTestCPU* testcpu, Genome&
   
   double test_fitness = m_cpu_test_info.GetColonyFitness();
   
-  total_fitness += test_fitness;
-  total_sqr_fitness += test_fitness * test_fitness;
-  total_count++;
-  if (test_fitness == 0) {
-    dead_count++;
-  } else if (test_fitness < neut_min) {
-    neg_count++;
-    neg_size = neg_size + test_fitness  ;
-  } else if (test_fitness <= neut_max) {
-    neut_count++;
-  } else {
-    pos_count++;
-    pos_size = pos_size + test_fitness  ;
-    if (test_fitness > peak_fitness) {
-      peak_fitness = test_fitness;
-      peak_genome = in_genome;
-    }
-  }
+  sSiteStats stats;
+  stats.Clear();
+  stats.peak_fitness = peak_fitness;
+  stats.Record(test_fitness, in_genome, neut_min, neut_max);
+  mergeStats(stats);
   
   return test_fitness;
 }
@@ -128,10 +121,9 @@ void cLandscape::ProcessBase(cAvidaContext& ctx, cTestCPU* testcpu)
   
   testcpu->TestGenome(ctx, m_cpu_test_info, base_genome);
   
-  cPhenotype & phenotype = m_cpu_test_info.GetColonyOrganism()->GetPhenotype();
   base_fitness = m_cpu_test_info.GetColonyFitness();
-  base_merit = phenotype.GetMerit().GetDouble();
-  base_gestation = phenotype.GetGestationTime();
+  base_merit = m_cpu_test_info.GetColonyMerit();
+  base_gestation = m_cpu_test_info.GetColonyGestationTime();
   
   peak_fitness = base_fitness;
   peak_genome = base_genome;
@@ -147,20 +139,20 @@ void cLandscape::Process(cAvidaContext& ctx)
   
   // Get the info about the base creature.
   ProcessBase(ctx, testcpu);
-  
-  // Now Process the new creature at the proper distance.
-  Process_Body(ctx, testcpu, base_genome, distance, 0);
-
   delete testcpu;
   
-  // Calculate the complexity...
-  
-  double max_ent = log((double) m_world->GetHardwareManager().GetInstSet(base_genome.Properties().Get("instset").StringValue()).GetSize());
-  total_entropy = 0;
   ConstInstructionSequencePtr base_seq_p;
   GeneticRepresentationPtr rep_p = base_genome.Representation();
   base_seq_p.DynamicCastFrom(rep_p);
   const InstructionSequence& base_seq = *base_seq_p;
+  
+  // Now Process the new creature at the proper distance, one work unit per first mutated line.
+  runSites(ctx, &cLandscape::pointMutateSite, base_seq.GetSize() - distance + 1);
+  
+  // Calculate the complexity...
+  
+  double max_ent = log((double) m_world->GetHardwareManager().GetInstSet(base_genome.Properties().Get("instset").StringValue()).GetSize());
+  total_entropy = 0;
   for (int i = 0; i < base_seq.GetSize(); i++) {
     // Per-site entropy is the log of the number of legal states for that
     // site.  Add one to account for the unmutated state.
@@ -174,42 +166,34 @@ void cLandscape::Process(cAvidaContext& ctx)
 
 // For distances greater than one, this needs to be called recursively.
 
-void cLandscape::Process_Body(cAvidaContext& ctx, cTestCPU* testcpu, Genome& cur_genome,
-                              int cur_distance, int start_line)
+void cLandscape::Process_Body(cAvidaContext& ctx, sTester& tester, sSiteStats& stats, int cur_distance, int start_line)
 {
-  ConstInstructionSequencePtr base_seq_p;
-  GeneticRepresentationPtr rep_p = base_genome.Representation();
-  base_seq_p.DynamicCastFrom(rep_p);
-  const InstructionSequence& base_seq = *base_seq_p;
-  const int max_line = base_seq.GetSize() - cur_distance + 1;
-  const int inst_size = m_world->GetHardwareManager().GetInstSet(base_genome.Properties().Get("instset").StringValue()).GetSize();
-  
-  Genome mg(cur_genome);
-  InstructionSequencePtr mod_seq_p;
-  GeneticRepresentationPtr mod_rep_p = mg.Representation();
-  mod_seq_p.DynamicCastFrom(mod_rep_p);
-  InstructionSequence& mod_genome = *mod_seq_p;
+  const int max_line = tester.base_seq.GetSize() - cur_distance + 1;
   
   // Loop through all the lines of genome, testing trying all combinations.
   for (int line_num = start_line; line_num < max_line; line_num++) {
-    int cur_inst = base_seq[line_num].GetOp();
+    ProcessLine(ctx, tester, stats, cur_distance, line_num);
+  }
+}
+
+void cLandscape::ProcessLine(cAvidaContext& ctx, sTester& tester, sSiteStats& stats, int cur_distance, int line_num)
+{
+  InstructionSequence& mod_genome = *tester.seq;
+  int cur_inst = tester.base_seq[line_num].GetOp();
+  
+  // Loop through all instructions...
+  for (int inst_num = 0; inst_num < m_inst_size; inst_num++) {
+    if (cur_inst == inst_num) continue;
     
-    // Loop through all instructions...
-    for (int inst_num = 0; inst_num < inst_size; inst_num++) {
-      if (cur_inst == inst_num) continue;
-      
-      mod_genome[line_num].SetOp(inst_num);
-      if (cur_distance <= 1) {
-        ProcessGenome(ctx, testcpu, mg);
-        if (m_cpu_test_info.GetColonyFitness() >= neut_min) site_count[line_num]++;
-      } else {
-        Process_Body(ctx, testcpu, mg, cur_distance - 1, line_num + 1);
-      }
+    mod_genome[line_num].SetOp(inst_num);
+    if (cur_distance <= 1) {
+      if (testSite(ctx, tester, stats) >= neut_min) tester.site_count[line_num]++;
+    } else {
+      Process_Body(ctx, tester, stats, cur_distance - 1, line_num + 1);
     }
-    
-    mod_genome[line_num].SetOp(cur_inst);
   }
   
+  mod_genome[line_num].SetOp(cur_inst);
 }
 
 
@@ -268,30 +252,15 @@ void cLandscape::ProcessDelete(cAvidaContext& ctx)
 
   // Get the info about the base creature.
   ProcessBase(ctx, testcpu);
+  delete testcpu;
+  
   ConstInstructionSequencePtr base_seq_p;
   GeneticRepresentationPtr rep_p = base_genome.Representation();
   base_seq_p.DynamicCastFrom(rep_p);
   const InstructionSequence& base_seq = *base_seq_p;
-  const int max_line = base_seq.GetSize();
 
-  Genome mg(base_genome);
-  InstructionSequencePtr mod_seq_p;
-  GeneticRepresentationPtr mod_rep_p = mg.Representation();
-  mod_seq_p.DynamicCastFrom(mod_rep_p);
-  InstructionSequence& mod_seq = *mod_seq_p;
-  cCPUMemory mod_genome = mod_seq;
-  
-  // Loop through all the lines of genome, testing all deletions.
-  for (int line_num = 0; line_num < max_line; line_num++) {
-    int cur_inst = base_seq[line_num].GetOp();
-    mod_genome.Remove(line_num);
-    mod_seq = mod_genome;
-    ProcessGenome(ctx, testcpu, mg);
-    if (m_cpu_test_info.GetColonyFitness() >= neut_min) site_count[line_num]++;
-    mod_genome.Insert(line_num, Instruction(cur_inst));
-  }
-  
-  delete testcpu;
+  // Test all deletions, one work unit per line.
+  runSites(ctx, &cLandscape::deleteSite, base_seq.GetSize());
 }
 
 void cLandscape::ProcessInsert(cAvidaContext& ctx)
@@ -300,33 +269,15 @@ void cLandscape::ProcessInsert(cAvidaContext& ctx)
 
   // Get the info about the base creature.
   ProcessBase(ctx, testcpu);
+  delete testcpu;
+  
   ConstInstructionSequencePtr base_seq_p;
   GeneticRepresentationPtr rep_p = base_genome.Representation();
   base_seq_p.DynamicCastFrom(rep_p);
   const InstructionSequence& base_seq = *base_seq_p;
-  const int max_line = base_seq.GetSize();
-  const int inst_size = m_world->GetHardwareManager().GetInstSet(base_genome.Properties().Get("instset").StringValue()).GetSize();
-  
-  Genome mg(base_genome);
-  InstructionSequencePtr mod_seq_p;
-  GeneticRepresentationPtr mod_rep_p = mg.Representation();
-  mod_seq_p.DynamicCastFrom(mod_rep_p);
-  InstructionSequence& mod_seq = *mod_seq_p;
-  cCPUMemory mod_genome = mod_seq;
   
-  // Loop through all the lines of genome, testing all insertions.
-  for (int line_num = 0; line_num <= max_line; line_num++) {
-    // Loop through all instructions...
-    for (int inst_num = 0; inst_num < inst_size; inst_num++) {
-      mod_genome.Insert(line_num, Instruction(inst_num));
-      mod_seq = mod_genome;
-      ProcessGenome(ctx, testcpu, mg);
-      if (m_cpu_test_info.GetColonyFitness() >= neut_min) site_count[line_num]++;
-      mod_genome.Remove(line_num);
-    }
-  }
-
-  delete testcpu;
+  // Test all insertions, one work unit per insertion point.
+  runSites(ctx, &cLandscape::insertSite, base_seq.GetSize() + 1);
 }
 
 // Prediction for a landscape where n sites are _randomized_.
@@ -340,7 +291,7 @@ void cLandscape::PredictWProcess(cAvidaContext& ctx, Avida::Output::File& df, in
   ProcessBase(ctx, testcpu);
   if (base_fitness == 0.0) return;
   
-  BuildFitnessChart(ctx, testcpu);
+  BuildFitnessChart(ctx);
   const int genome_size = fitness_chart.GetNumRows();
   const int inst_size = fitness_chart.GetNumCols();
   const double min_neut_fitness = 0.99;
@@ -463,7 +414,7 @@ void cLandscape::PredictNuProcess(cAvidaContext& ctx, Avida::Output::File& df, i
   ProcessBase(ctx, testcpu);
   if (base_fitness == 0.0) return;
   
-  BuildFitnessChart(ctx, testcpu);
+  BuildFitnessChart(ctx);
   const int genome_size = fitness_chart.GetNumRows();
   const int inst_size = fitness_chart.GetNumCols();
   const double min_neut_fitness = 0.99;
@@ -706,7 +657,7 @@ void cLandscape::RandomProcess(cAvidaContext& ctx)
   m_num_found = total_found;
 }
 
-void cLandscape::BuildFitnessChart(cAvidaContext& ctx, cTestCPU* testcpu)
+void cLandscape::BuildFitnessChart(cAvidaContext& ctx)
 {
   // First, resize the fitness_chart.
   ConstInstructionSequencePtr base_seq_p;
@@ -717,29 +668,8 @@ void cLandscape::BuildFitnessChart(cAvidaContext& ctx, cTestCPU* testcpu)
   const int inst_size = m_world->GetHardwareManager().GetInstSet(base_genome.Properties().Get("instset").StringValue()).GetSize();
   fitness_chart.ResizeClear(max_line, inst_size);
   
-  Genome mod_genome(base_genome);
-  InstructionSequencePtr mod_seq_p;
-  mod_seq_p.DynamicCastFrom(mod_genome.Representation());
-  InstructionSequence& mod_seq = *mod_seq_p;
-  
-  // Loop through all the lines of genome, testing trying all combinations.
-  for (int line_num = 0; line_num < max_line; line_num++) {
-    int cur_inst = base_seq[line_num].GetOp();
-    
-    // Loop through all instructions...
-    for (int inst_num = 0; inst_num < inst_size; inst_num++) {
-      if (cur_inst == inst_num) {
-        fitness_chart(line_num, inst_num) = base_fitness;
-        continue;
-      }
-      
-      mod_seq[line_num].SetOp(inst_num);
-      ProcessGenome(ctx, testcpu, mod_genome);
-      fitness_chart(line_num, inst_num) = m_cpu_test_info.GetColonyFitness();
-    }
-    
-    mod_seq[line_num].SetOp(cur_inst);
-  }
+  // Each work unit fills in the row of its own line.
+  runSites(ctx, &cLandscape::chartSite, max_line);
 }
 
 void cLandscape::TestPairs(cAvidaContext& ctx)
@@ -750,7 +680,7 @@ void cLandscape::TestPairs(cAvidaContext& ctx)
   ProcessBase(ctx, testcpu);
   if (base_fitness == 0.0) return;
   
-  BuildFitnessChart(ctx, testcpu);
+  BuildFitnessChart(ctx);
   
   Genome mod_genome(base_genome);
   ConstInstructionSequencePtr base_seq_p;
@@ -790,38 +720,18 @@ void cLandscape::TestAllPairs(cAvidaContext& ctx)
   cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
 
   ProcessBase(ctx, testcpu);
+  delete testcpu;
   if (base_fitness == 0.0) return;
   
-  BuildFitnessChart(ctx, testcpu);
+  BuildFitnessChart(ctx);
   
   ConstInstructionSequencePtr base_seq_p;
   GeneticRepresentationPtr rep_p = base_genome.Representation();
   base_seq_p.DynamicCastFrom(rep_p);
   const InstructionSequence& base_seq = *base_seq_p;
-  const int max_line = base_seq.GetSize();
-  const int inst_size = m_world->GetHardwareManager().GetInstSet(base_genome.Properties().Get("instset").StringValue()).GetSize();
-  Genome mod_genome(base_genome);
-  Instruction inst1, inst2;
-  
-  // Loop through all the lines of genome, testing trying all combinations.
-  for (int line1_num = 0; line1_num < max_line - 1; line1_num++) {
-    for (int line2_num = line1_num + 1; line2_num < max_line; line2_num++) {
-      
-      // Loop through all instructions...
-      for (int inst1_num = 0; inst1_num < inst_size; inst1_num++) {
-        inst1.SetOp(inst1_num);
-        if (inst1 == base_seq[line1_num]) continue;
-        for (int inst2_num = 0; inst2_num < inst_size; inst2_num++) {
-          inst2.SetOp(inst2_num);
-          if (inst2 == base_seq[line2_num]) continue;
-          TestMutPair(ctx, testcpu, mod_genome, line1_num, line2_num, inst1, inst2);
-        } // inst2_num loop
-      } //inst1_num loop;
-      
-    } // line2_num loop
-  } // line1_num loop.
   
-  delete testcpu;
+  // One work unit per first line of the pair, the last line has no partners left.
+  runSites(ctx, &cLandscape::pairSite, base_seq.GetSize() - 1);
 }
 
 
@@ -829,26 +739,18 @@ void cLandscape::HillClimb(cAvidaContext& ctx, Avida::Output::File& df)
 {
   cTestCPU* testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
   Genome cur_genome(base_genome);
-  Genome mg(base_genome);
-  InstructionSequencePtr mg_seq_p;
-  GeneticRepresentationPtr mg_rep_p = mg.Representation();
-  mg_seq_p.DynamicCastFrom(mg_rep_p);
-  InstructionSequence& mg_seq = *mg_seq_p;
-  cCPUMemory mod_genome = mg_seq;
 
   int gen = 0;
   
-  const int inst_size = m_world->GetHardwareManager().GetInstSet(base_genome.Properties().Get("instset").StringValue()).GetSize();
   double pos_frac = 1.0;
   
-  distance = 1;
-  
   bool finished = false;
   while (finished == false) {
     if (pos_frac == 0.0) finished = true;
     
     // Search the landscape for the next best.
     Reset(cur_genome);
+    distance = 1;
     ConstInstructionSequencePtr cur_seq_p;
     GeneticRepresentationPtr cur_rep_p = cur_genome.Representation();
     cur_seq_p.DynamicCastFrom(cur_rep_p);
@@ -859,37 +761,19 @@ void cLandscape::HillClimb(cAvidaContext& ctx, Avida::Output::File& df)
     Process(ctx);
     
     // Try Insertion Mutations.
-    
-    mod_genome = cur_seq;
-    for (int line_num = 0; line_num <= max_line; line_num++) {
-      // Loop through all instructions...
-      for (int inst_num = 0; inst_num < inst_size; inst_num++) {
-        mod_genome.Insert(line_num, Instruction(inst_num));
-        mg_seq = mod_genome;
-        ProcessGenome(ctx, testcpu, mg);
-        mod_genome.Remove(line_num);
-      }
-    }
+    runSites(ctx, &cLandscape::insertSite, max_line + 1);
     
     // Try all deletion mutations.
-    
-    for (int line_num = 0; line_num < max_line; line_num++) {
-      int cur_inst = cur_seq[line_num].GetOp();
-      mod_genome.Remove(line_num);
-      mg_seq = mod_genome;
-      ProcessGenome(ctx, testcpu, mg);
-      mod_genome.Insert(line_num, Instruction(cur_inst));
-    }
+    runSites(ctx, &cLandscape::deleteSite, max_line);
     
     pos_frac = GetProbPos();
     
     // Print the information on the current best.
     testcpu->TestGenome(ctx, m_cpu_test_info, cur_genome);
-    cPhenotype& colony_phenotype = m_cpu_test_info.GetColonyOrganism()->GetPhenotype();
     df.Write(gen, "Generation");
-    df.Write(colony_phenotype.GetMerit().GetDouble(), "Merit");
-    df.Write(colony_phenotype.GetGestationTime(), "Gestation Time");
-    df.Write(colony_phenotype.GetFitness(), "Fitness");
+    df.Write(m_cpu_test_info.GetColonyMerit(), "Merit");
+    df.Write(m_cpu_test_info.GetColonyGestationTime(), "Gestation Time");
+    df.Write(m_cpu_test_info.GetColonyFitness(), "Fitness");
     df.Write(cur_seq.GetSize(), "Genome Length");
     df.Write(GetProbDead(), "Probability Lethal");
     df.Write(GetProbNeg(), "Probability Deleterious");
@@ -929,21 +813,12 @@ double cLandscape::TestMutPair(cAvidaContext& ctx, cTestCPU* testcpu, Genome& mo
   
   double mut1_fitness = fitness_chart(line1, mut1.GetOp()) / base_fitness;
   double mut2_fitness = fitness_chart(line2, mut2.GetOp()) / base_fitness;
-  double mult_combo = mut1_fitness * mut2_fitness;
-    
-  total_epi_count++;
-  if ((mut1_fitness == 0 || mut2_fitness == 0) && (combo_fitness == 0)) {
-    dead_epi_count++;
-  } else if (combo_fitness < mult_combo) {
-    neg_epi_count++;
-    neg_epi_size = neg_epi_size + combo_fitness;
-  } else if (combo_fitness > mult_combo) {
-    pos_epi_count++;
-    pos_epi_size = pos_epi_size + combo_fitness;
-  } else {
-    no_epi_count++;
-    no_epi_size = no_epi_size + combo_fitness;
-  }
+  
+  sSiteStats stats;
+  stats.Clear();
+  stats.peak_fitness = peak_fitness;
+  stats.RecordPair(combo_fitness, mut1_fitness, mut2_fitness);
+  mergeStats(stats);
   
   return combo_fitness;
 }
@@ -1001,3 +876,271 @@ void cLandscape::PrintSiteCount(Avida::Output::File& df)
   for (int j = 0; j < base_seq.GetSize(); j++) df.WriteAnonymous(site_count[j]);
   df.Endl();
 }
+
+
+void cLandscape::pointMutateSite(cAvidaContext& ctx, int line_num)
+{
+  sTester* tester = acquireTester(ctx);
+  ProcessLine(ctx, *tester, m_site_stats[line_num], distance, line_num);
+  releaseTester(tester);
+}
+
+void cLandscape::deleteSite(cAvidaContext& ctx, int line_num)
+{
+  sTester* tester = acquireTester(ctx);
+  InstructionSequence& mod_seq = *tester->seq;
+  cCPUMemory mod_genome = tester->base_seq;
+  
+  mod_genome.Remove(line_num);
+  mod_seq = mod_genome;
+  if (testSite(ctx, *tester, m_site_stats[line_num]) >= neut_min) tester->site_count[line_num]++;
+  
+  mod_seq = tester->base_seq;
+  releaseTester(tester);
+}
+
+void cLandscape::insertSite(cAvidaContext& ctx, int line_num)
+{
+  sTester* tester = acquireTester(ctx);
+  InstructionSequence& mod_seq = *tester->seq;
+  cCPUMemory mod_genome = tester->base_seq;
+  
+  // Loop through all instructions...
+  for (int inst_num = 0; inst_num < m_inst_size; inst_num++) {
+    mod_genome.Insert(line_num, Instruction(inst_num));
+    mod_seq = mod_genome;
+    if (testSite(ctx, *tester, m_site_stats[line_num]) >= neut_min) tester->site_count[line_num]++;
+    mod_genome.Remove(line_num);
+  }
+  
+  mod_seq = tester->base_seq;
+  releaseTester(tester);
+}
+
+void cLandscape::chartSite(cAvidaContext& ctx, int line_num)
+{
+  sTester* tester = acquireTester(ctx);
+  InstructionSequence& mod_seq = *tester->seq;
+  int cur_inst = tester->base_seq[line_num].GetOp();
+  
+  // Loop through all instructions...
+  for (int inst_num = 0; inst_num < m_inst_size; inst_num++) {
+    if (cur_inst == inst_num) {
+      fitness_chart(line_num, inst_num) = base_fitness;
+      continue;
+    }
+    
+    mod_seq[line_num].SetOp(inst_num);
+    fitness_chart(line_num, inst_num) = testSite(ctx, *tester, m_site_stats[line_num]);
+  }
+  
+  mod_seq[line_num].SetOp(cur_inst);
+  releaseTester(tester);
+}
+
+void cLandscape::pairSite(cAvidaContext& ctx, int line1_num)
+{
+  sTester* tester = acquireTester(ctx);
+  sSiteStats& stats = m_site_stats[line1_num];
+  InstructionSequence& mod_seq = *tester->seq;
+  const InstructionSequence& base_seq = tester->base_seq;
+  const int max_line = base_seq.GetSize();
+  
+  for (int line2_num = line1_num + 1; line2_num < max_line; line2_num++) {
+    
+    // Loop through all instructions...
+    for (int inst1_num = 0; inst1_num < m_inst_size; inst1_num++) {
+      if (inst1_num == base_seq[line1_num].GetOp()) continue;
+      mod_seq[line1_num].SetOp(inst1_num);
+      const double mut1_fitness = fitness_chart(line1_num, inst1_num) / base_fitness;
+      
+      for (int inst2_num = 0; inst2_num < m_inst_size; inst2_num++) {
+        if (inst2_num == base_seq[line2_num].GetOp()) continue;
+        mod_seq[line2_num].SetOp(inst2_num);
+        
+        tester->testcpu->TestGenome(ctx, tester->test_info, tester->genome);
+        const double combo_fitness = tester->test_info.GetColonyFitness() / base_fitness;
+        stats.RecordPair(combo_fitness, mut1_fitness, fitness_chart(line2_num, inst2_num) / base_fitness);
+      } // inst2_num loop
+      
+      mod_seq[line2_num] = base_seq[line2_num];
+    } // inst1_num loop
+    
+    mod_seq[line1_num] = base_seq[line1_num];
+  } // line2_num loop
+  
+  releaseTester(tester);
+}
+
+
+// Runs site_fun for every site in [0, num_sites), spread across the job queue when one has been set.  Each site
+// records into its own slot of m_site_stats, which are then merged in site order so that the totals and the peak
+// genome found do not depend on the number of workers or on the order in which the sites completed.
+void cLandscape::runSites(cAvidaContext& ctx, void (cLandscape::*site_fun)(cAvidaContext&, int), int num_sites)
+{
+  if (num_sites <= 0) return;
+  
+  m_inst_size = m_world->GetHardwareManager().GetInstSet(base_genome.Properties().Get("instset").StringValue()).GetSize();
+  
+  // Slots are cleared rather than copied, as a slot whose site found no peak holds a genome without a representation
+  m_site_stats.ResizeClear(num_sites);
+  for (int i = 0; i < num_sites; i++) {
+    m_site_stats[i].Clear();
+    m_site_stats[i].peak_fitness = peak_fitness;
+  }
+  
+  if (m_job_queue) {
+    m_job_queue->ParallelFor(this, site_fun, num_sites, 1);
+  } else {
+    for (int i = 0; i < num_sites; i++) (this->*site_fun)(ctx, i);
+  }
+  
+  for (int i = 0; i < num_sites; i++) mergeStats(m_site_stats[i]);
+  
+  // All testers are idle again once the sites have completed
+  for (int i = 0; i < m_testers.GetSize(); i++) {
+    const Apto::Array<int>& tester_count = m_testers[i]->site_count;
+    for (int j = 0; j < tester_count.GetSize(); j++) site_count[j] += tester_count[j];
+  }
+  destroyTesters();
+}
+
+void cLandscape::mergeStats(const sSiteStats& stats)
+{
+  total_fitness += stats.total_fitness;
+  total_sqr_fitness += stats.total_sqr_fitness;
+  total_count += stats.total_count;
+  dead_count += stats.dead_count;
+  neg_count += stats.neg_count;
+  neut_count += stats.neut_count;
+  pos_count += stats.pos_count;
+  neg_size += stats.neg_size;
+  pos_size += stats.pos_size;
+  if (stats.peak_fitness > peak_fitness) {
+    peak_fitness = stats.peak_fitness;
+    peak_genome = stats.peak_genome;
+  }
+  
+  total_epi_count += stats.total_epi_count;
+  dead_epi_count += stats.dead_epi_count;
+  neg_epi_count += stats.neg_epi_count;
+  pos_epi_count += stats.pos_epi_count;
+  no_epi_count += stats.no_epi_count;
+  neg_epi_size += stats.neg_epi_size;
+  pos_epi_size += stats.pos_epi_size;
+  no_epi_size += stats.no_epi_size;
+}
+
+double cLandscape::testSite(cAvidaContext& ctx, sTester& tester, sSiteStats& stats)
+{
+  tester.testcpu->TestGenome(ctx, tester.test_info, tester.genome);
+  
+  const double test_fitness = tester.test_info.GetColonyFitness();
+  stats.Record(test_fitness, tester.genome, neut_min, neut_max);
+  
+  return test_fitness;
+}
+
+cLandscape::sTester* cLandscape::acquireTester(cAvidaContext& ctx)
+{
+  Apto::MutexAutoLock lock(m_tester_mutex);
+  
+  const int num_idle = m_testers.GetSize();
+  if (num_idle) {
+    sTester* tester = m_testers[num_idle - 1];
+    m_testers.Resize(num_idle - 1);
+    return tester;
+  }
+  
+  // Copies of the shared base genome and test info are only made while holding the lock
+  sTester* tester = new sTester;
+  tester->testcpu = m_world->GetHardwareManager().CreateTestCPU(ctx);
+  tester->test_info = m_cpu_test_info;
+  tester->genome = base_genome;
+  tester->seq.DynamicCastFrom(tester->genome.Representation());
+  tester->base_seq = *tester->seq;
+  tester->site_count.Resize(tester->base_seq.GetSize() + 1);
+  tester->site_count.SetAll(0);
+  
+  return tester;
+}
+
+void cLandscape::releaseTester(sTester* tester)
+{
+  Apto::MutexAutoLock lock(m_tester_mutex);
+  m_testers.Push(tester);
+}
+
+void cLandscape::destroyTesters()
+{
+  for (int i = 0; i < m_testers.GetSize(); i++) {
+    delete m_testers[i]->testcpu;
+    delete m_testers[i];
+  }
+  m_testers.Resize(0);
+}
+
+
+void cLandscape::sSiteStats::Clear()
+{
+  total_count = 0;
+  dead_count = 0;
+  neg_count = 0;
+  neut_count = 0;
+  pos_count = 0;
+  total_fitness = 0.0;
+  total_sqr_fitness = 0.0;
+  pos_size = 0.0;
+  neg_size = 0.0;
+  peak_fitness = 0.0;
+  
+  total_epi_count = 0;
+  pos_epi_count = 0;
+  neg_epi_count = 0;
+  no_epi_count = 0;
+  dead_epi_count = 0;
+  pos_epi_size = 0.0;
+  neg_epi_size = 0.0;
+  no_epi_size = 0.0;
+}
+
+void cLandscape::sSiteStats::Record(double test_fitness, const Genome& genome, double neut_min, double neut_max)
+{
+  total_fitness += test_fitness;
+  total_sqr_fitness += test_fitness * test_fitness;
+  total_count++;
+  if (test_fitness == 0) {
+    dead_count++;
+  } else if (test_fitness < neut_min) {
+    neg_count++;
+    neg_size = neg_size + test_fitness;
+  } else if (test_fitness <= neut_max) {
+    neut_count++;
+  } else {
+    pos_count++;
+    pos_size = pos_size + test_fitness;
+    if (test_fitness > peak_fitness) {
+      peak_fitness = test_fitness;
+      peak_genome = genome;
+    }
+  }
+}
+
+void cLandscape::sSiteStats::RecordPair(double combo_fitness, double mut1_fitness, double mut2_fitness)
+{
+  double mult_combo = mut1_fitness * mut2_fitness;
+  
+  total_epi_count++;
+  if ((mut1_fitness == 0 || mut2_fitness == 0) && (combo_fitness == 0)) {
+    dead_epi_count++;
+  } else if (combo_fitness < mult_combo) {
+    neg_epi_count++;
+    neg_epi_size = neg_epi_size + combo_fitness;
+  } else if (combo_fitness > mult_combo) {
+    pos_epi_count++;
+    pos_epi_size = pos_epi_size + combo_fitness;
+  } else {
+    no_epi_count++;
+    no_epi_size = no_epi_size + combo_fitness;
+  }
+}
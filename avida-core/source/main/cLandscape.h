@@ -23,6 +23,7 @@
 #ifndef cLandscape_h
 #define cLandscape_h
 
+#include "apto/core/Mutex.h"
 #include "avida/core/Genome.h"
 #include "avida/core/InstructionSequence.h"
 #include "avida/output/Types.h"
@@ -30,6 +31,7 @@
 #include "cCPUTestInfo.h"
 #include "tMatrix.h"
 
+class cAnalyzeJobQueue;
 class cAvidaContext;
 class cInstSet;
 class cTestCPU;
@@ -41,6 +43,46 @@ using namespace Avida;
 class cLandscape
 {
 private:
+  // Statistics gathered by a single work unit of a scan, merged into the landscape totals in site order
+  struct sSiteStats
+  {
+    int total_count;
+    int dead_count;
+    int neg_count;
+    int neut_count;
+    int pos_count;
+    double total_fitness;
+    double total_sqr_fitness;
+    double pos_size;
+    double neg_size;
+    double peak_fitness;
+    Genome peak_genome;
+
+    int total_epi_count;
+    int pos_epi_count;
+    int neg_epi_count;
+    int no_epi_count;
+    int dead_epi_count;
+    double pos_epi_size;
+    double neg_epi_size;
+    double no_epi_size;
+
+    void Clear();
+    void Record(double test_fitness, const Genome& genome, double neut_min, double neut_max);
+    void RecordPair(double combo_fitness, double mut1_fitness, double mut2_fitness);
+  };
+
+  // A test CPU and private working copy of the base genome, used by one work unit at a time
+  struct sTester
+  {
+    cTestCPU* testcpu;
+    cCPUTestInfo test_info;
+    Genome genome;
+    InstructionSequencePtr seq;
+    InstructionSequence base_seq;
+    Apto::Array<int> site_count;    // integer counts, so summing them across testers is order independent
+  };
+
   cWorld* m_world;
   cCPUTestInfo m_cpu_test_info;
   Genome base_genome;
@@ -89,6 +131,12 @@ private:
   
   int m_num_found;
 
+  cAnalyzeJobQueue* m_job_queue;
+  int m_inst_size;
+  Apto::Array<sSiteStats> m_site_stats;
+  Apto::Array<sTester*, Apto::Smart> m_testers;   // idle testers
+  Apto::Mutex m_tester_mutex;
+
 
   cLandscape(); // @not_implemented
   cLandscape(const cLandscape&); // @not_implemented
@@ -111,9 +159,14 @@ public:
   inline void SetTrials(int in_trials) { trials = in_trials; }
   inline void SetMinFound(int min_found) { m_min_found = min_found; }
   inline void SetMaxTrials(int max_trials) { m_max_trials = max_trials; }
+  
+  // When set, the exhaustive scans (Process, ProcessDelete, ProcessInsert, TestAllPairs, HillClimb and the fitness
+  // chart) are split into per-site jobs on the given queue.  Landscapes that are themselves run as jobs must not set it.
+  inline void SetJobQueue(cAnalyzeJobQueue* job_queue) { m_job_queue = job_queue; }
   inline void SetCPUTestInfo(const cCPUTestInfo& in_cpu_test_info) 
   { 
       m_cpu_test_info = in_cpu_test_info; 
+      m_cpu_test_info.UseResultCache();
   }
 
   void SampleProcess(cAvidaContext& ctx);
@@ -167,13 +220,28 @@ public:
   
   
 private:
-  void BuildFitnessChart(cAvidaContext& ctx, cTestCPU* testcpu);
+  void BuildFitnessChart(cAvidaContext& ctx);
   double ProcessGenome(cAvidaContext& ctx, cTestCPU* testcpu, Genome& in_genome);
   void ProcessBase(cAvidaContext& ctx, cTestCPU* testcpu);
-  void Process_Body(cAvidaContext& ctx, cTestCPU* testcpu, Genome& cur_genome, int cur_distance, int start_line);
+  void Process_Body(cAvidaContext& ctx, sTester& tester, sSiteStats& stats, int cur_distance, int start_line);
+  void ProcessLine(cAvidaContext& ctx, sTester& tester, sSiteStats& stats, int cur_distance, int line_num);
   
   double TestMutPair(cAvidaContext& ctx, cTestCPU* testcpu, Genome& mod_genome, int line1, int line2,
                      const Instruction& mut1, const Instruction& mut2);  
+  
+  // Site work units, run through runSites
+  void pointMutateSite(cAvidaContext& ctx, int line_num);
+  void deleteSite(cAvidaContext& ctx, int line_num);
+  void insertSite(cAvidaContext& ctx, int line_num);
+  void chartSite(cAvidaContext& ctx, int line_num);
+  void pairSite(cAvidaContext& ctx, int line1_num);
+  
+  void runSites(cAvidaContext& ctx, void (cLandscape::*site_fun)(cAvidaContext&, int), int num_sites);
+  void mergeStats(const sSiteStats& stats);
+  double testSite(cAvidaContext& ctx, sTester& tester, sSiteStats& stats);
+  sTester* acquireTester(cAvidaContext& ctx);
+  void releaseTester(sTester* tester);
+  void destroyTesters();
 };
 
 #endif
@@ -38,12 +38,10 @@
 #include "cPopulationCell.h"
 #include "cMultiProcessWorld.h"
 #include "nGeometry.h"
-#include <map>
 #include <functional>
 #include <iostream>
 #include <sstream>
 #include <cmath>
-#include <boost/optional.hpp>
 
 using namespace Avida;
 
@@ -53,40 +51,26 @@ static const char* UPDATE="mean update time [ut]";
 static const char* POSTUPDATE="mean post-update time [post]";
 static const char* CALCUPDATE="mean calc-update time [calc]";
 
-/*! Message that is sent from one cMultiProcessWorld to another during organism
- migration.
+//! Tag used for all migration batches; MPI delivers messages between a pair of worlds in order.
+static const int MIGRATION_TAG=0;
+
+
+/*! Initializing constructor.
  */
-struct migration_message {
-	//! Default constructor.
-	migration_message() { }
-	
-	//! Initializing constructor.
-	migration_message(cOrganism* org, const cPopulationCell& cell, double merit, int lineage)
-	: _merit(merit), _lineage(lineage) {
-		_genome = org->GetGenome().AsString();
-		cell.GetPosition(_x, _y);
-		_generation = org->GetPhenotype().GetGeneration();
-	}
+migration_message::migration_message(cOrganism* org, const cPopulationCell& cell, double merit, int lineage)
+: _merit(merit), _lineage(lineage) {
+	_genome = org->GetGenome().AsString();
+	cell.GetPosition(_x, _y);
+	_generation = org->GetPhenotype().GetGeneration();
+}
 
-	//! Finish unpacking an organism from this message.
-	void unpack(cOrganism* org) {
-		org->UpdateMerit(cAvidaContext& ctx, _merit);
-		org->GetPhenotype().SetGeneration(_generation);
-	}	
-	
-	//! Serializer, used to (de)marshal organisms for migration.
-	template<class Archive>
-	void serialize(Archive & ar, const unsigned int version) {
-		ar & _genome & _merit & _lineage & _x & _y & _generation;
-	}
-	
-	std::string _genome; //!< Genome of the migrating organism.
-	double _merit; //!< Merit of this organism in its originating population.
-	int _lineage; //!< Lineage label of this organism in its orginating population.
-	int _x; //!< X-coordinate of the cell from which this migrant originated.
-	int _y; //!< Y-coordinate of the cell from which this migrant originated.
-	int _generation; //!< Generation of this organism.
-};
+
+/*! Finish unpacking an organism from this message.
+ */
+void migration_message::unpack(cAvidaContext& ctx, cOrganism* org) {
+	org->UpdateMerit(ctx, _merit);
+	org->GetPhenotype().SetGeneration(_generation);
+}
 
 
 /*! Create and initialize a cMultiProcessWorld.
@@ -114,7 +98,15 @@ cMultiProcessWorld::cMultiProcessWorld(cAvidaConfig* cfg, const cString& cwd, bo
 , m_universe_dim(0)
 , m_universe_x(0)
 , m_universe_y(0)
-, m_universe_popsize(-1) {
+, m_universe_popsize(-1)
+, m_universe_merit(0.0)
+, m_reported_popsize(0)
+, m_reported_merit(0.0)
+, m_local_merit(0.0) {
+	m_outbox.resize(m_mpi_world.size());
+	m_sending.resize(m_mpi_world.size());
+	m_inbox.resize(m_mpi_world.size());
+	
 	if(GetConfig().BIRTH_METHOD.Get() == POSITION_OFFSPRING_RANDOM) {
 		// there are a couple bugs in spatial that still need to be worked out:
 		// specifically, what to do about size(1) universes?
@@ -132,6 +124,16 @@ cMultiProcessWorld::cMultiProcessWorld(cAvidaConfig* cfg, const cString& cwd, bo
 }
 
 
+/*! Destructor.
+ 
+ Every world posts the same sequence of exchanges, so the last one can always be
+ completed here.
+ */
+cMultiProcessWorld::~cMultiProcessWorld() {
+	boost::mpi::wait_all(m_reqs.begin(), m_reqs.end());
+}
+
+
 /*! Migrate this organism to a different world.
  
  If this method is called, it means that this organism is to be migrated to a
@@ -184,9 +186,8 @@ void cMultiProcessWorld::MigrateOrganism(cOrganism* org, const cPopulationCell&
 	assert(dst_world < m_mpi_world.size());
 	assert(dst_world >= 0);
 
-	// the tag is set to the number of messages previously sent; this is to allow
-	// the receiver to sort messages for consistency.
-	m_reqs.push_back(m_mpi_world.isend(dst_world, m_reqs.size(), migration_message(org, cell, merit.GetDouble(), lineage)));
+	// migrants are batched by destination, and sent together at the end of the update:
+	m_outbox[dst_world]._migrants.push_back(migration_message(org, cell, merit.GetDouble(), lineage));
 	
 	// stats tracking:
 	GetStats().OutgoingMigrant(org);
@@ -258,57 +259,59 @@ bool cMultiProcessWorld::IsWorldBoundary(const cPopulationCell& cell) {
 
 /*! Process post-update events.
  
- This method is called after each update of the local population completes.  Here
- we check to see if this world has received any migrants from other worlds, and if
- so, we inject them into the local population.  Note that this is an unconditional
- injection -- that is, migrants are "pushed" to this world.
+ This method is called after each update of the local population completes.  Migration
+ is pipelined so that communication overlaps with computation: the exchange posted at
+ the end of the previous update has been in flight during this update, so here we
+ complete it (usually without waiting), inject the migrants it delivered, and then post
+ this update's exchange.  Migrants therefore arrive one update after they leave.  No
+ barriers are needed; every world sends exactly one batch to every world per update, so
+ each world knows exactly which messages to expect.
  
  Migrants are injected according to BIRTH_METHOD.
  
  \todo What to do about cross-world lineage labels?
- 
- \todo At the moment, this method forces synchronization on update boundaries across
- *all* worlds.  This could slow things down quite a bit, so we may need to consider a
- second mode that relaxes consistency in favor of speed.
  */
 void cMultiProcessWorld::ProcessPostUpdate(cAvidaContext& ctx) {
-	namespace mpi = boost::mpi;
-	using namespace boost;
-	
 	// restart the timer for this method, and get the elapsed time for the past update:
 	m_pf[UPDATE] = m_update_timer.elapsed();
 	m_post_update_timer.restart();
 	
-	// wait until we're sure that this process has sent all its messages:
-	mpi::wait_all(m_reqs.begin(), m_reqs.end());
-	m_reqs.clear();
-	
-	// at this point, we know that *this* process has sent everything.  but, we don't
-	// know if it's *received* everything.  so, we're going to put in a synchronization
-	// barrier, which means that every process must reach the barrier before any are allowed
-	// to proceed.  since we just finished waiting for all communication to complete,
-	// this means that all messages must have been received, too.
-	m_mpi_world.barrier();	
+	CompleteExchange(ctx);
+	PostExchange();
+
+	// record profiling stats:
+	m_pf[POSTUPDATE] = m_post_update_timer.elapsed();
+	GetStats().ProfilingData(m_pf);
+	m_pf.clear();
 	
-	// now, receive all the messages, but store them in order by source and tag:
-	typedef std::map<int,migration_message> rx_tag_t;
-	typedef std::map<int,rx_tag_t> rx_src_t;
-	rx_src_t recvd;
-	optional<mpi::status> s = m_mpi_world.iprobe(mpi::any_source,mpi::any_tag);
-	while(s.is_initialized()) {
-		migration_message msg;
-		m_mpi_world.recv(s->source(), s->tag(), msg);
-		recvd[s->source()][s->tag()] = msg;		
-		// any others?
-		s = m_mpi_world.iprobe(mpi::any_source,mpi::any_tag);		
+	// restart the update timer!
+	m_update_timer.restart();
+}
+
+
+/*! Wait for the posted exchange to complete, and inject the migrants it delivered.
+ 
+ Batches are injected in order of source world, and migrants within a batch in the
+ order they left, so injection is independent of message arrival order.
+ */
+void cMultiProcessWorld::CompleteExchange(cAvidaContext& ctx) {
+	if(m_reqs.empty()) {
+		return;
 	}
 	
-	// iterate over received messages in-order, injecting genomes into our population:
-	for(rx_src_t::iterator i=recvd.begin(); i!=recvd.end(); ++i) {
-		for(rx_tag_t::iterator j=i->second.begin(); j!=i->second.end(); ++j) {
-			//std::cerr << "**********  INJECTING *********** " << i->first << " " << j->first << std::endl;
+	boost::mpi::wait_all(m_reqs.begin(), m_reqs.end());
+	m_reqs.clear();
+	
+	m_universe_popsize = 0;
+	m_universe_merit = 0.0;
+	for(int src=0; src<static_cast<int>(m_inbox.size()); ++src) {
+		migration_batch& batch = m_inbox[src];
+		m_universe_popsize += batch._popsize;
+		m_universe_merit += batch._merit;
+		
+		for(std::size_t i=0; i<batch._migrants.size(); ++i) {
 			// ok, add this migrant to the current population
-			migration_message& migrant = j->second;
+			migration_message& migrant = batch._migrants[i];
 			int target_cell=-1;
 			
 			switch(GetConfig().BIRTH_METHOD.Get()) {
@@ -333,26 +336,61 @@ void cMultiProcessWorld::ProcessPostUpdate(cAvidaContext& ctx) {
 																	 Genome(cString(migrant._genome.c_str())), // genome unpacked from message
 																	 ctx, migrant._lineage); // lineage label
 			// unpack the rest from the message:
-			migrant.unpack(GetPopulation().GetCell(target_cell).GetOrganism());
+			migrant.unpack(ctx, GetPopulation().GetCell(target_cell).GetOrganism());
 			GetStats().IncomingMigrant(GetPopulation().GetCell(target_cell).GetOrganism());
 		}
+		batch._migrants.clear();
 	}
 	
-	// oh, sweet sanity; make sure that we actually processed all messages.
-	assert(!m_mpi_world.iprobe(mpi::any_source,mpi::any_tag).is_initialized());
-	
-	// finally, we need another barrier down here, in the off chance that one of the
-	// processes is really speedy and manages to migrate another org to this world
-	// before we finished the probe-loop.
-	m_mpi_world.barrier();
+	// the batches we sent have been delivered, so their buffers can be reused:
+	for(std::size_t dst=0; dst<m_sending.size(); ++dst) {
+		m_sending[dst]._migrants.clear();
+	}
+}
 
-	// record profiling stats:
-	m_pf[POSTUPDATE] = m_post_update_timer.elapsed();
-	GetStats().ProfilingData(m_pf);
-	m_pf.clear();
+
+/*! Post the exchange of this update's migrants, without waiting for it.
+ 
+ Each batch also reports this world's current size and merit, which is how the
+ universe-wide totals used by CalculateUpdateSize() and AllowsEarlyExit() are kept
+ current without an all_reduce.  The merit reported is the one summed for this
+ update's size calculation, so that it's only summed once per update (and never
+ under MP_SCHEDULING_NULL, which doesn't use it).
+ */
+void cMultiProcessWorld::PostExchange() {
+	m_reported_popsize = GetPopulation().GetNumOrganisms();
+	m_reported_merit = m_local_merit;
 	
-	// restart the update timer!
-	m_update_timer.restart();
+	// swap in the (already delivered) send buffers, so that the next update's migrants
+	// never touch a batch that is still being sent:
+	m_sending.swap(m_outbox);
+	
+	for(int dst=0; dst<static_cast<int>(m_sending.size()); ++dst) {
+		m_sending[dst]._popsize = m_reported_popsize;
+		m_sending[dst]._merit = m_reported_merit;
+		m_reqs.push_back(m_mpi_world.isend(dst, MIGRATION_TAG, m_sending[dst]));
+	}
+	for(int src=0; src<static_cast<int>(m_inbox.size()); ++src) {
+		m_reqs.push_back(m_mpi_world.irecv(src, MIGRATION_TAG, m_inbox[src]));
+	}
+}
+
+
+/*! Sum the merits of the organisms in this world.
+ 
+ There's no clean way to do this across the different schedulers in avida, so we take
+ the O(n) hit and sum them.  This is done at most once per update, by CalculateUpdateSize()
+ under MP_SCHEDULING_INTEGRATED, rather than kept as a running total, so that it is exact.
+ */
+double cMultiProcessWorld::CalculateLocalMerit() {
+	double local_merit=0.0;
+	for(int i=0; i<GetPopulation().GetSize(); ++i) {
+		cPopulationCell& cell=GetPopulation().GetCell(i);
+		if(cell.IsOccupied()) {
+			local_merit += cell.GetOrganism()->GetPhenotype().GetMerit().GetDouble();
+		}
+	}
+	return local_merit;
 }
 
 
@@ -371,7 +409,8 @@ bool cMultiProcessWorld::AllowsEarlyExit() const
  
  This is a little challenging, because we need to scale the number of virtual CPU
  cycles allotted to each world based on the *total* (all populations) number of
- organisms, as well as by the total merit.  We do that here.
+ organisms, as well as by the total merit.  We do that here, using the totals that
+ every world reports with its migration batches (see PostExchange()).
  */
 int cMultiProcessWorld::CalculateUpdateSize()
 {
@@ -386,25 +425,28 @@ int cMultiProcessWorld::CalculateUpdateSize()
 			break;
 		}
 		case MP_SCHEDULING_INTEGRATED: { // MP aware
-			// sum the total number of organisms in all populations, storing that value
-			// so that we know if we have to exit early:
-			all_reduce(m_mpi_world, GetPopulation().GetNumOrganisms(), m_universe_popsize, std::plus<int>());
+			const int local_popsize = GetPopulation().GetNumOrganisms();
+			m_local_merit = CalculateLocalMerit();
+			const double local_merit = m_local_merit;
 			
-			// sum the merits of organisms in all populations.
-			// there's no clean way to do this across the different schedulers in avida,
-			// so we'll take the O(n) hit and sum them (for now):
-			double local_merit=0.0;
-			for(int i=0; i<GetPopulation().GetSize(); ++i) {
-				cPopulationCell& cell=GetPopulation().GetCell(i);
-				if(cell.IsOccupied()) {
-					local_merit += cell.GetOrganism()->GetPhenotype().GetMerit().GetDouble();
-				}
+			if(m_universe_popsize < 0) {
+				// no exchange has completed yet (this is the first update), so fall back to
+				// a blocking reduction to get the universe-wide totals:
+				all_reduce(m_mpi_world, local_popsize, m_universe_popsize, std::plus<int>());
+				all_reduce(m_mpi_world, local_merit, m_universe_merit, std::plus<double>());
+				m_reported_popsize = local_popsize;
+				m_reported_merit = local_merit;
 			}
-			double total_merit;
-			all_reduce(m_mpi_world, local_merit, total_merit, std::plus<double>());
+			
+			// the universe totals are as of the last completed exchange; substitute this
+			// world's current values for the ones it reported then:
+			const int universe_popsize = m_universe_popsize - m_reported_popsize + local_popsize;
+			const double total_merit = m_universe_merit - m_reported_merit + local_merit;
 			
 			// ok, calculate the total CPU cycles allotted to this population:
-			update_size = (local_merit/total_merit) * GetConfig().AVE_TIME_SLICE.Get() * m_universe_popsize;
+			if(total_merit > 0.0) {
+				update_size = (local_merit/total_merit) * GetConfig().AVE_TIME_SLICE.Get() * universe_popsize;
+			}
 			break;
 		}
 		default: {
@@ -26,12 +26,68 @@
 #include <boost/mpi/environment.hpp>
 #include <boost/mpi/communicator.hpp>
 #include <boost/timer.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <string>
 #include <vector>
 
 #include "cWorld.h"
 #include "cAvidaConfig.h"
 #include "cStats.h"
 
+class cAvidaContext;
+class cOrganism;
+class cPopulationCell;
+
+
+/*! Organism that is sent from one cMultiProcessWorld to another during migration.
+ */
+struct migration_message {
+	//! Default constructor.
+	migration_message() { }
+	
+	//! Initializing constructor.
+	migration_message(cOrganism* org, const cPopulationCell& cell, double merit, int lineage);
+	
+	//! Finish unpacking an organism from this message.
+	void unpack(cAvidaContext& ctx, cOrganism* org);
+	
+	//! Serializer, used to (de)marshal organisms for migration.
+	template<class Archive>
+	void serialize(Archive & ar, const unsigned int version) {
+		ar & _genome & _merit & _lineage & _x & _y & _generation;
+	}
+	
+	std::string _genome; //!< Genome of the migrating organism.
+	double _merit; //!< Merit of this organism in its originating population.
+	int _lineage; //!< Lineage label of this organism in its orginating population.
+	int _x; //!< X-coordinate of the cell from which this migrant originated.
+	int _y; //!< Y-coordinate of the cell from which this migrant originated.
+	int _generation; //!< Generation of this organism.
+};
+
+
+/*! All migrants sent from one world to another during a single update, packed into
+ one message.  Every world sends one batch to every world (including itself) after each
+ update, even when it is empty, so each batch also carries the sender's population size
+ and total merit; summing them gives the universe-wide totals without a collective.
+ */
+struct migration_batch {
+	//! Default constructor.
+	migration_batch() : _popsize(0), _merit(0.0) { }
+	
+	//! Serializer.
+	template<class Archive>
+	void serialize(Archive & ar, const unsigned int version) {
+		ar & _popsize & _merit & _migrants;
+	}
+	
+	int _popsize; //!< Number of organisms in the sending world.
+	double _merit; //!< Total merit of the sending world.
+	std::vector<migration_message> _migrants; //!< Migrants, in the order they left the sending world.
+};
+
+
 /*! Multi-process Avida world.
  
  This class enables multi-process Avida, which provides a mechanism for much larger
@@ -50,11 +106,18 @@ class cMultiProcessWorld : public cWorld
 	protected:
 		boost::mpi::environment& m_mpi_env; //!< MPI environment.
 		boost::mpi::communicator& m_mpi_world; //!< World-wide MPI communicator.
-		std::vector<boost::mpi::request> m_reqs; //!< Requests outstanding since the last ProcessPostUpdate.
+		std::vector<boost::mpi::request> m_reqs; //!< Sends and receives of the exchange posted at the end of the last update.
+		std::vector<migration_batch> m_outbox; //!< Migrants leaving during the current update, by destination world.
+		std::vector<migration_batch> m_sending; //!< Batches being sent by the posted exchange, by destination world.
+		std::vector<migration_batch> m_inbox; //!< Batches being received by the posted exchange, by source world.
 		int m_universe_dim; //!< Dimension (x & y) of the universe (number of worlds along the side of a grid of worlds).
 		int m_universe_x; //!< X coordinate of this world.
 		int m_universe_y; //!< Y coordinate of this world.
-		int m_universe_popsize; //!< Total size of the universe, delayed one update.
+		int m_universe_popsize; //!< Total size of the universe, as of the last completed exchange.
+		double m_universe_merit; //!< Total merit of the universe, as of the last completed exchange.
+		int m_reported_popsize; //!< Size of this world, as reported in the last completed exchange.
+		double m_reported_merit; //!< Merit of this world, as reported in the last completed exchange.
+		double m_local_merit; //!< Merit of this world, as of the last update size calculation.
 		
 		boost::timer m_update_timer; //!< Tracks the clock-time of updates.
 		boost::timer m_post_update_timer; //!< Tracks the clock-time of post-update processing.
@@ -63,13 +126,22 @@ class cMultiProcessWorld : public cWorld
 		
 		//! Constructor (prefer Initialize).
 		cMultiProcessWorld(cAvidaConfig* cfg, const cString& cwd, boost::mpi::environment& env, boost::mpi::communicator& worldcomm);
+		
+		//! Wait for the posted exchange to complete, and inject the migrants it delivered.
+		void CompleteExchange(cAvidaContext& ctx);
+		
+		//! Post the exchange of this update's migrants, without waiting for it.
+		void PostExchange();
+		
+		//! Sum the merits of the organisms in this world.
+		double CalculateLocalMerit();
 
 	public:
 		//! Create and initialize a cMultiProcessWorld.
 		static cMultiProcessWorld* Initialize(cAvidaConfig* cfg, const cString& cwd, boost::mpi::environment& env, boost::mpi::communicator& worldcomm);
 		
 		//! Destructor.
-		virtual ~cMultiProcessWorld() { }
+		virtual ~cMultiProcessWorld();
 		
 		//! Migrate this organism to a different world.
 		virtual void MigrateOrganism(cOrganism* org, const cPopulationCell& cell,
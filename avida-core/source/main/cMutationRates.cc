@@ -124,6 +124,24 @@ void cMutationRates::Clear()
   update.death_prob = 0.0;
 }
 
+bool cMutationRates::HasNonZeroRates() const
+{
+  const double rates[] = {
+    copy.mut_prob, copy.ins_prob, copy.del_prob, copy.uniform_prob, copy.slip_prob,
+    divide.ins_prob, divide.del_prob, divide.mut_prob, divide.uniform_prob, divide.slip_prob, divide.trans_prob,
+    divide.lgt_prob, divide.divide_mut_prob, divide.divide_ins_prob, divide.divide_del_prob,
+    divide.divide_uniform_prob, divide.divide_slip_prob, divide.divide_trans_prob, divide.divide_lgt_prob,
+    divide.divide_poisson_mut_mean, divide.divide_poisson_ins_mean, divide.divide_poisson_del_mean,
+    divide.divide_poisson_slip_mean, divide.divide_poisson_trans_mean, divide.divide_poisson_lgt_mean,
+    divide.parent_mut_prob, divide.parent_ins_prob, divide.parent_del_prob,
+    point.ins_prob, point.del_prob, point.mut_prob,
+    inject.ins_prob, inject.del_prob, inject.mut_prob,
+    meta.copy_mut_prob, update.death_prob
+  };
+  for (unsigned int i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) if (rates[i] > 0.0) return true;
+  return false;
+}
+
 void cMutationRates::Copy(const cMutationRates& in_muts)
 {
   copy = in_muts.copy;
@@ -107,6 +107,7 @@ public:
   void Setup(cWorld* world);
   void Clear();
   void Copy(const cMutationRates& in_muts);
+  bool HasNonZeroRates() const;  // Is any mutation or death rate above zero?
 
   // Copy muts should always check if they are 0.0 before consulting the random number generator for performance
   bool TestCopyMut(cAvidaContext& ctx) const { return (copy.mut_prob == 0.0) ? false : ctx.GetRandom().P(copy.mut_prob); }
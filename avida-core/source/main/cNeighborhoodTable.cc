@@ -0,0 +1,175 @@
+/*
+ *  cNeighborhoodTable.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cNeighborhoodTable.h"
+
+#include "cPopulationCell.h"
+
+#include <algorithm>
+#include <climits>
+
+
+cNeighborhoodTable::~cNeighborhoodTable()
+{
+  for (int i = 0; i < m_tables.GetSize(); i++) delete m_tables[i];
+}
+
+
+void cNeighborhoodTable::Setup(Apto::Array<cPopulationCell>& cells, int deme_width, int deme_size)
+{
+  for (int i = 0; i < m_tables.GetSize(); i++) delete m_tables[i];
+  m_tables.Resize(0);
+
+  const int num_cells = cells.GetSize();
+  m_deme_width = (deme_width > 0) ? deme_width : 1;
+  m_deme_size = (deme_size > 0) ? deme_size : num_cells;
+
+  m_visited.ResizeClear(num_cells);
+  m_visited.SetAll(0);
+  m_visit_mark = 0;
+
+  m_conn_begin.ResizeClear(num_cells + 1);
+  m_conn.Resize(0);
+  m_repeats.ResizeClear(num_cells);
+  for (int i = 0; i < num_cells; i++) {
+    m_conn_begin[i] = m_conn.GetSize();
+    m_repeats[i] = false;
+    m_visit_mark++;
+
+    tConstListIterator<cPopulationCell> conn_it(cells[i].ConnectionList());
+    while (conn_it.Next() != NULL) {
+      const int conn_id = conn_it.Get()->GetID();
+      if (m_visited[conn_id] == m_visit_mark) m_repeats[i] = true;
+      m_visited[conn_id] = m_visit_mark;
+      m_conn.Push(conn_id);
+    }
+  }
+  m_conn_begin[num_cells] = m_conn.GetSize();
+}
+
+
+cNeighborhoodTable::cCellRange cNeighborhoodTable::GetCellsWithin(int cell_id, int radius)
+{
+  return lookup(cell_id, (radius > 1) ? radius : 1, false);
+}
+
+
+cNeighborhoodTable::cCellRange cNeighborhoodTable::GetDemeCellsWithin(int cell_id, int radius)
+{
+  return lookup(cell_id, (radius > 0) ? radius : 0, true);
+}
+
+
+cNeighborhoodTable::cCellRange cNeighborhoodTable::lookup(int cell_id, int radius, bool deme_box)
+{
+  if (radius > MAX_TABLE_RADIUS) {
+    findCells(cell_id, radius, deme_box);
+    m_scratch.ResizeClear(m_found.size());
+    for (int i = 0; i < m_scratch.GetSize(); i++) m_scratch[i] = m_found[i];
+    return cCellRange(m_scratch, 0, m_scratch.GetSize());
+  }
+
+  sRadiusTable& table = getTable(radius, deme_box);
+  if (table.begin[cell_id] < 0) {
+    findCells(cell_id, radius, deme_box);
+    table.begin[cell_id] = table.cells.GetSize();
+    table.size[cell_id] = m_found.size();
+    for (unsigned int i = 0; i < m_found.size(); i++) table.cells.Push(m_found[i]);
+  }
+  return cCellRange(table.cells, table.begin[cell_id], table.size[cell_id]);
+}
+
+
+cNeighborhoodTable::sRadiusTable& cNeighborhoodTable::getTable(int radius, bool deme_box)
+{
+  for (int i = 0; i < m_tables.GetSize(); i++) {
+    if (m_tables[i]->radius == radius && m_tables[i]->deme_box == deme_box) return *m_tables[i];
+  }
+
+  sRadiusTable* table = new sRadiusTable;
+  table->radius = radius;
+  table->deme_box = deme_box;
+  table->begin.ResizeClear(m_visited.GetSize());
+  table->begin.SetAll(-1);
+  table->size.ResizeClear(m_visited.GetSize());
+  table->size.SetAll(0);
+  m_tables.Push(table);
+  return *table;
+}
+
+
+void cNeighborhoodTable::findCells(int cell_id, int radius, bool deme_box)
+{
+  m_found.clear();
+  if (deme_box) findDemeCellsWithin(cell_id, radius);
+  else findCellsWithin(cell_id, radius);
+}
+
+
+void cNeighborhoodTable::findCellsWithin(int cell_id, int radius)
+{
+  if (m_visit_mark == INT_MAX) {
+    m_visited.SetAll(0);
+    m_visit_mark = 0;
+  }
+  m_visit_mark++;
+  m_visited[cell_id] = m_visit_mark;
+
+  // Breadth first, so that every cell is reached by its shortest path; each hop expands the cells found by the last
+  int level_begin = 0;
+  for (int hops = 0; hops < radius; hops++) {
+    const int level_end = m_found.size();
+    for (int i = (hops == 0) ? -1 : level_begin; i < level_end; i++) {
+      const int from_id = (i < 0) ? cell_id : m_found[i];
+      for (int j = m_conn_begin[from_id]; j < m_conn_begin[from_id + 1]; j++) {
+        const int to_id = m_conn[j];
+        if (m_visited[to_id] == m_visit_mark) continue;
+        m_visited[to_id] = m_visit_mark;
+        m_found.push_back(to_id);
+      }
+    }
+    if ((int)m_found.size() == level_end) break;
+    level_begin = level_end;
+  }
+
+  std::sort(m_found.begin(), m_found.end());
+}
+
+
+void cNeighborhoodTable::findDemeCellsWithin(int cell_id, int radius)
+{
+  const int deme_base = cell_id - cell_id % m_deme_size;
+  const int deme_height = m_deme_size / m_deme_width;
+  const int x = (cell_id - deme_base) % m_deme_width;
+  const int y = (cell_id - deme_base) / m_deme_width;
+
+  const int x_min = (x - radius > 0) ? x - radius : 0;
+  const int x_max = (x + radius < m_deme_width - 1) ? x + radius : m_deme_width - 1;
+  const int y_min = (y - radius > 0) ? y - radius : 0;
+  const int y_max = (y + radius < deme_height - 1) ? y + radius : deme_height - 1;
+
+  for (int cur_y = y_min; cur_y <= y_max; cur_y++) {
+    for (int cur_x = x_min; cur_x <= x_max; cur_x++) {
+      const int found_id = deme_base + cur_y * m_deme_width + cur_x;
+      if (found_id != cell_id) m_found.push_back(found_id);
+    }
+  }
+}
@@ -0,0 +1,113 @@
+/*
+ *  cNeighborhoodTable.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cNeighborhoodTable_h
+#define cNeighborhoodTable_h
+
+#include "apto/core.h"
+
+#include <vector>
+
+class cPopulationCell;
+
+
+// cNeighborhoodTable holds the cell connections of the population as flat arrays, so that neighborhood queries do not
+// have to walk the linked connection list of each cell.  It is built by cPopulation once the topology has been set up;
+// the connections are kept in the order they were made, before any organism has rotated its cell.
+//
+// Larger neighborhoods come in two kinds, each kept as one table per radius that is filled in one cell at a time, on
+// first request: all cells within a number of hops along the connections (which follows the world geometry, and stays
+// within the deme), and all cells of the deme within a square of the given radius around the cell, without wrapping
+// around the deme edges.  Neighborhoods never include the cell itself and list cell ids in increasing order.
+
+class cNeighborhoodTable
+{
+public:
+  class cCellRange
+  {
+  private:
+    const Apto::Array<int, Apto::Smart>* m_cells;
+    int m_begin;
+    int m_size;
+
+  public:
+    cCellRange(const Apto::Array<int, Apto::Smart>& cells, int begin, int size)
+      : m_cells(&cells), m_begin(begin), m_size(size) { ; }
+
+    int GetSize() const { return m_size; }
+    int operator[](int idx) const { return (*m_cells)[m_begin + idx]; }
+  };
+
+private:
+  // Neighborhoods of larger radii are recomputed on every request rather than stored
+  static const int MAX_TABLE_RADIUS = 8;
+
+  struct sRadiusTable
+  {
+    int radius;
+    bool deme_box;
+    Apto::Array<int> begin;  // offset of each cell's neighborhood in cells, -1 until first requested
+    Apto::Array<int> size;
+    Apto::Array<int, Apto::Smart> cells;
+  };
+
+  int m_deme_width;
+  int m_deme_size;
+
+  Apto::Array<int> m_conn_begin;  // offset of each cell's connections in m_conn, plus the total at the end
+  Apto::Array<int, Apto::Smart> m_conn;
+  Apto::Array<bool> m_repeats;    // cells connected more than once to the same cell, as in very small tori
+
+  Apto::Array<sRadiusTable*> m_tables;
+  Apto::Array<int, Apto::Smart> m_scratch;
+
+  Apto::Array<int> m_visited;     // visit marks for the hop search, compared against m_visit_mark
+  int m_visit_mark;
+  std::vector<int> m_found;
+
+
+  cCellRange lookup(int cell_id, int radius, bool deme_box);
+  sRadiusTable& getTable(int radius, bool deme_box);
+  void findCells(int cell_id, int radius, bool deme_box);
+  void findCellsWithin(int cell_id, int radius);
+  void findDemeCellsWithin(int cell_id, int radius);
+
+  cNeighborhoodTable(const cNeighborhoodTable&); // @not_implemented
+  cNeighborhoodTable& operator=(const cNeighborhoodTable&); // @not_implemented
+
+public:
+  cNeighborhoodTable() : m_deme_width(0), m_deme_size(0), m_visit_mark(0) { ; }
+  ~cNeighborhoodTable();
+
+  void Setup(Apto::Array<cPopulationCell>& cells, int deme_width, int deme_size);
+
+  int GetNumNeighbors(int cell_id) const { return m_conn_begin[cell_id + 1] - m_conn_begin[cell_id]; }
+  cCellRange GetNeighbors(int cell_id) const { return cCellRange(m_conn, m_conn_begin[cell_id], GetNumNeighbors(cell_id)); }
+  bool HasRepeatedNeighbors(int cell_id) const { return m_repeats[cell_id]; }
+
+  // All cells reachable in at most radius hops (at least one)
+  cCellRange GetCellsWithin(int cell_id, int radius);
+
+  // All cells of the deme no more than radius cells away along either axis
+  cCellRange GetDemeCellsWithin(int cell_id, int radius);
+};
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ *  cOrgOutputScratch.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cOrgOutputScratch_h
+#define cOrgOutputScratch_h
+
+#include "apto/core.h"
+
+#include "cString.h"
+#include "tBuffer.h"
+#include "tList.h"
+
+
+// cOrgOutputScratch holds the working buffers of cOrganism::doOutput, so that they are reused from one output to the
+// next rather than reallocated on every IO instruction.  Each cAvidaContext owns one (see GetOutputScratch()), which
+// keeps the buffers private to the thread running that context.  Buffers only change size when the resource layout
+// does, and each such resize is counted (along with any neighbor list nodes) so the allocation rate can be reported through cStats.
+
+class cOrgOutputScratch
+{
+public:
+  Apto::Array<double> resource_count;     // global followed by deme resource counts
+  Apto::Array<double> res_change;         // global followed by deme resource changes
+  Apto::Array<double> global_res_change;
+  Apto::Array<double> deme_res_change;
+  Apto::Array<cString> insts_triggered;
+  tList<tBuffer<int> > other_inputs;
+  tList<tBuffer<int> > other_outputs;
+  
+private:
+  int m_num_allocs;
+  
+  
+  cOrgOutputScratch(const cOrgOutputScratch&); // @not_implemented
+  cOrgOutputScratch& operator=(const cOrgOutputScratch&); // @not_implemented
+  
+public:
+  cOrgOutputScratch() : m_num_allocs(0) { ; }
+  ~cOrgOutputScratch() { ; }
+  
+  // Size a buffer for the current output, only resizing (and possibly allocating) when the size has changed
+  template <class T> inline void Prepare(Apto::Array<T>& buffer, int size)
+  {
+    if (buffer.GetSize() != size) {
+      buffer.Resize(size);
+      m_num_allocs++;
+    }
+  }
+  
+  // Record allocations made outside of Prepare(), such as neighbor buffer list nodes
+  inline void AddAllocs(int num) { m_num_allocs += num; }
+  
+  // Returns the number of allocations since the last call
+  inline int TakeNumAllocs() { const int num = m_num_allocs; m_num_allocs = 0; return num; }
+};
+
+#endif
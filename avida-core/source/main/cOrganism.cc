@@ -145,7 +145,8 @@ void cOrganism::Initialize()
 // Creation Policies
 // --------------------------------------------------------------------------------------------------------------
 
-cOrganism::cOrganism(cWorld* world, cAvidaContext& ctx, const Genome& genome, int parent_generation, Systematics::Source src)
+cOrganism::cOrganism(cWorld* world, cAvidaContext& ctx, const Genome& genome, int parent_generation, Systematics::Source src,
+                     Apto::Array<cHardwareBase*, Apto::Smart>* hw_pool)
   : m_world(world)
   , m_phenotype(world, parent_generation, world->GetHardwareManager().GetInstSet(genome.Properties().Get(s_ext_prop_name_instset).StringValue()).GetNumNops())
   , m_src(src)
@@ -209,7 +210,7 @@ cOrganism::cOrganism(cWorld* world, cAvidaContext& ctx, const Genome& genome, in
 	// initializing this here because it may be needed during hardware creation:
 	m_id = m_world->GetStats().GetTotCreatures();
   
-  m_hardware = m_world->GetHardwareManager().Create(ctx, this, genome);
+  m_hardware = m_world->GetHardwareManager().Create(ctx, this, genome, hw_pool);
   
   initialize(ctx);
 }
@@ -236,6 +237,7 @@ void cOrganism::initialize(cAvidaContext& ctx)
   }
   
   m_repair = (m_world->GetConfig().POINT_MUT_REPAIR_START.Get());
+  m_mut_skip_ahead = m_world->GetConfig().MUTATION_SKIP_AHEAD.Get();
   
 	// randomize the amout of raw materials an organism has at its 
 	// disposal.
@@ -416,8 +418,12 @@ void cOrganism::doOutput(cAvidaContext& ctx,
   const Apto::Array<double> & deme_resource_count = m_interface->GetDemeResources(deme_id, ctx);
   const Apto::Array< Apto::Array<int> > & cell_id_lists = m_interface->GetCellIdLists();
   
-  tList<tBuffer<int> > other_input_list;
-  tList<tBuffer<int> > other_output_list;
+  // All working buffers come from the context, so steady state output processing does not allocate
+  cOrgOutputScratch& scratch = ctx.GetOutputScratch();
+  tList<tBuffer<int> >& other_input_list = scratch.other_inputs;
+  tList<tBuffer<int> >& other_output_list = scratch.other_outputs;
+  other_input_list.Clear();
+  other_output_list.Clear();
   
   // If tasks require us to consider neighbor inputs, collect them...
   if (m_world->GetEnvironment().UseNeighborInput()) {
@@ -442,15 +448,20 @@ void cOrganism::doOutput(cAvidaContext& ctx,
       other_output_list.Push( &(cur_neighbor->m_output_buf) );
     }
   }
+  scratch.AddAllocs(other_input_list.GetSize() + other_output_list.GetSize());
   
   // Do the testing of tasks performed...
   
+  const int num_global_res = global_resource_count.GetSize();
+  const int num_deme_res = deme_resource_count.GetSize();
   
-  Apto::Array<double> global_res_change(global_resource_count.GetSize());
-  global_res_change.SetAll(0.0);
-  Apto::Array<double> deme_res_change(deme_resource_count.GetSize());
-  deme_res_change.SetAll(0.0);
-  Apto::Array<cString> insts_triggered;
+  Apto::Array<double>& global_res_change = scratch.global_res_change;
+  scratch.Prepare(global_res_change, num_global_res);
+  Apto::Array<double>& deme_res_change = scratch.deme_res_change;
+  scratch.Prepare(deme_res_change, num_deme_res);
+  // TestOutput only assigns the triggered instructions when it tests tasks, so clear the last output's list
+  Apto::Array<cString>& insts_triggered = scratch.insts_triggered;
+  insts_triggered.Resize(0);
   
   tBuffer<int>* received_messages_point = &m_received_messages;
   if (!m_world->GetConfig().SAVE_RECEIVED.Get()) received_messages_point = NULL;
@@ -459,8 +470,13 @@ void cOrganism::doOutput(cAvidaContext& ctx,
                        m_hardware->GetExtendedMemory(), on_divide, received_messages_point);
   
   //combine global and deme resource counts
-  Apto::Array<double> globalAndDeme_resource_count = global_resource_count + deme_resource_count;
-  Apto::Array<double> globalAndDeme_res_change = global_res_change + deme_res_change;
+  Apto::Array<double>& globalAndDeme_resource_count = scratch.resource_count;
+  scratch.Prepare(globalAndDeme_resource_count, num_global_res + num_deme_res);
+  for (int i = 0; i < num_global_res; i++) globalAndDeme_resource_count[i] = global_resource_count[i];
+  for (int i = 0; i < num_deme_res; i++) globalAndDeme_resource_count[num_global_res + i] = deme_resource_count[i];
+  Apto::Array<double>& globalAndDeme_res_change = scratch.res_change;
+  scratch.Prepare(globalAndDeme_res_change, num_global_res + num_deme_res);
+  globalAndDeme_res_change.SetAll(0.0);
   
   // set any resource amount to 0 if a cell cannot access this resource
   int cell_id=GetCellID();
@@ -486,6 +502,14 @@ void cOrganism::doOutput(cAvidaContext& ctx,
                                                m_phenotype.GetCurRBinsAvail(), globalAndDeme_res_change, 
                                                insts_triggered, is_parasite, context_phenotype);
   
+  // Test CPUs run on analyze and landscape worker threads, and are not part of the population statistics
+  const int num_allocs = scratch.TakeNumAllocs();
+  if (!ctx.GetTestMode()) {
+    cStats& stats = m_world->GetStats();
+    stats.IncOutputTests();
+    stats.AddOutputAllocs(num_allocs);
+  }
+  
   // Handle merit increases that take the organism above it's current population merit
   if (m_world->GetConfig().MERIT_INC_APPLY_IMMEDIATE.Get()) {
     double cur_merit = m_phenotype.CalcCurrentMerit();
@@ -516,8 +540,14 @@ void cOrganism::doOutput(cAvidaContext& ctx,
   //update deme resources
   m_interface->UpdateDemeResources(ctx, deme_res_change);
 
-  for (int i = 0; i < insts_triggered.GetSize(); i++) 
-    m_hardware->ProcessBonusInst(ctx, m_hardware->GetInstSet().GetInst(insts_triggered[i]));
+  if (insts_triggered.GetSize()) {
+    // Bonus instructions may perform output themselves, reusing the scratch buffers, so work from a copy (which is
+    // an allocation like any other made while checking output)
+    Apto::Array<cString> bonus_insts(insts_triggered);
+    if (!ctx.GetTestMode()) m_world->GetStats().AddOutputAllocs(1);
+    for (int i = 0; i < bonus_insts.GetSize(); i++) 
+      m_hardware->ProcessBonusInst(ctx, m_hardware->GetInstSet().GetInst(bonus_insts[i]));
+  }
 }
 
 void cOrganism::doAVOutput(cAvidaContext& ctx, 
@@ -708,6 +738,13 @@ double cOrganism::CalcMeritRatio()
 }
 
 
+bool cOrganism::TestCopyMut(cAvidaContext& ctx)
+{
+  if (m_mut_skip_ahead) return m_copy_mut_sampler.Test(ctx.GetRandom(), m_mut_rates.GetCopyMutProb());
+  return m_mut_rates.TestCopyMut(ctx);
+}
+
+
 bool cOrganism::GetTestOnDivide() const { return m_interface->TestOnDivide(); }
 int cOrganism::GetSterilizeUnstable() const { return m_world->GetConfig().STERILIZE_UNSTABLE.Get(); }
 
@@ -29,6 +29,7 @@
 #include "avida/private/systematics/GenomeTestMetrics.h"
 
 #include "cCPUMemory.h"
+#include "cGeometricSampler.h"
 #include "cMutationRates.h"
 #include "cPhenotype.h"
 #include "cOrgInterface.h"
@@ -69,6 +70,9 @@ private:
   const Genome m_initial_genome;         // Initial genome; can never be changed!
   Apto::Array<Systematics::UnitPtr> m_parasites;   // List of all parasites associated with this organism.
   cMutationRates m_mut_rates;             // Rate of all possible mutations.
+  bool m_mut_skip_ahead;                  // Sample copy and point substitutions with the samplers below?
+  cGeometricSampler m_copy_mut_sampler;
+  cGeometricSampler m_point_mut_sampler;
   cOrgInterface* m_interface;             // Interface back to the population.
   int m_id;                               // unique id for each org, is just the number it was born
   int m_lineage_label;                    // a lineages tag; inherited unchanged in offspring
@@ -117,7 +121,8 @@ private:
   cOrganism& operator=(const cOrganism&); // @not_implemented
 
 public:
-  cOrganism(cWorld* world, cAvidaContext& ctx, const Genome& genome, int parent_generation, Systematics::Source src);
+  cOrganism(cWorld* world, cAvidaContext& ctx, const Genome& genome, int parent_generation, Systematics::Source src,
+            Apto::Array<cHardwareBase*, Apto::Smart>* hw_pool = NULL);
   ~cOrganism();
   
   static void Initialize();
@@ -221,6 +226,8 @@ public:
   // --------  cOrgInterface Methods  --------
   cHardwareBase& GetHardware() { return *m_hardware; }
   const cHardwareBase& GetHardware() const { return *m_hardware; }
+  // Hands the hardware over to the caller (for recycling), the organism may only be destroyed afterwards
+  cHardwareBase* DetachHardware() { cHardwareBase* hw = m_hardware; m_hardware = NULL; return hw; }
   int GetID() { return m_id; }
 
   int GetCellID() { return m_interface->GetCellID(); }
@@ -309,7 +316,7 @@ public:
   void ClearParasites();
 
   // --------  Mutation Rate Convenience Methods  --------
-  bool TestCopyMut(cAvidaContext& ctx) const { return m_mut_rates.TestCopyMut(ctx); }
+  bool TestCopyMut(cAvidaContext& ctx);
   bool TestCopyIns(cAvidaContext& ctx) const { return m_mut_rates.TestCopyIns(ctx); }
   bool TestCopyDel(cAvidaContext& ctx) const { return m_mut_rates.TestCopyDel(ctx); }
   bool TestCopyUniform(cAvidaContext& ctx) const { return m_mut_rates.TestCopyUniform(ctx); }
@@ -352,6 +359,8 @@ public:
   double GetPointInsProb() const { return m_mut_rates.GetPointInsProb(); }
   double GetPointDelProb() const { return m_mut_rates.GetPointDelProb(); }
   double GetPointMutProb() const { return m_mut_rates.GetPointMutProb(); }
+  bool UsesMutationSkipAhead() const { return m_mut_skip_ahead; }
+  cGeometricSampler& GetPointMutSampler() { return m_point_mut_sampler; }
 
   void SetPointInsProb(double _p) { return m_mut_rates.SetPointInsProb(_p); }
   void SetPointDelProb(double _p) { return m_mut_rates.SetPointDelProb(_p); }
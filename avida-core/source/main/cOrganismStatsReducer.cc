@@ -0,0 +1,320 @@
+/*
+ *  cOrganismStatsReducer.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cOrganismStatsReducer.h"
+
+#include "apto/platform.h"
+
+#include "cEnvironment.h"
+#include "cHardwareBase.h"
+#include "cOrganism.h"
+#include "cPhenotype.h"
+#include "cWorld.h"
+
+#include <cfloat>
+#include <climits>
+#include <cmath>
+
+
+// Tally a single organism into sink, which is either the cStats itself or the cOrganismTallies of a chunk
+template <class Sink> static void tallyOrganism(Sink& sink, cOrganismStatsReducer::sCounts& counts, cOrganism* organism,
+                                                int num_tasks, int num_reactions)
+{
+  const cPhenotype& phenotype = organism->GetPhenotype();
+  const cMerit cur_merit = phenotype.GetMerit();
+  const double cur_fitness = phenotype.GetFitness();
+  const int cur_gestation_time = phenotype.GetGestationTime();
+  const int cur_genome_length = phenotype.GetGenomeLength();
+
+  sink.SumFitness().Add(cur_fitness);
+  sink.SumLogFitness().Add(log(cur_fitness));
+  sink.SumMerit().Add(cur_merit.GetDouble());
+  sink.SumGestation().Add(phenotype.GetGestationTime());
+  sink.SumCreatureAge().Add(phenotype.GetAge());
+  sink.SumGeneration().Add(phenotype.GetGeneration());
+  sink.SumNeutralMetric().Add(phenotype.GetNeutralMetric());
+  sink.SumLineageLabel().Add(organism->GetLineageLabel());
+  sink.SumCopyMutRate().Push(organism->MutationRates().GetCopyMutProb());
+  sink.SumLogCopyMutRate().Push(log(organism->MutationRates().GetCopyMutProb()));
+  sink.SumDivMutRate().Push(organism->MutationRates().GetDivMutProb() / phenotype.GetDivType());
+  sink.SumLogDivMutRate().Push(log(organism->MutationRates().GetDivMutProb() / phenotype.GetDivType()));
+  sink.SumCopySize().Add(phenotype.GetCopiedSize());
+  sink.SumExeSize().Add(phenotype.GetExecutedSize());
+
+  if (cur_merit > counts.max_merit) counts.max_merit = cur_merit;
+  if (cur_fitness > counts.max_fitness) counts.max_fitness = cur_fitness;
+  if (cur_gestation_time > counts.max_gestation_time) counts.max_gestation_time = cur_gestation_time;
+  if (cur_genome_length > counts.max_genome_length) counts.max_genome_length = cur_genome_length;
+
+  if (cur_merit < counts.min_merit) counts.min_merit = cur_merit;
+  if (cur_fitness < counts.min_fitness) counts.min_fitness = cur_fitness;
+  if (cur_gestation_time < counts.min_gestation_time) counts.min_gestation_time = cur_gestation_time;
+  if (cur_genome_length < counts.min_genome_length) counts.min_genome_length = cur_genome_length;
+
+  // Test what tasks this creatures has completed.
+  for (int j = 0; j < num_tasks; j++) {
+    if (phenotype.GetCurTaskCount()[j] > 0) {
+      sink.AddCurTask(j);
+      sink.AddCurTaskQuality(j, phenotype.GetCurTaskQuality()[j]);
+    }
+
+    if (phenotype.GetLastTaskCount()[j] > 0) {
+      sink.AddLastTask(j);
+      sink.AddLastTaskQuality(j, phenotype.GetLastTaskQuality()[j]);
+      sink.IncTaskExeCount(j, phenotype.GetLastTaskCount()[j]);
+    }
+
+    if (phenotype.GetCurHostTaskCount()[j] > 0) sink.AddCurHostTask(j);
+    if (phenotype.GetLastHostTaskCount()[j] > 0) sink.AddLastHostTask(j);
+    if (phenotype.GetCurParasiteTaskCount()[j] > 0) sink.AddCurParasiteTask(j);
+    if (phenotype.GetLastParasiteTaskCount()[j] > 0) sink.AddLastParasiteTask(j);
+
+    if (phenotype.GetCurInternalTaskCount()[j] > 0) {
+      sink.AddCurInternalTask(j);
+      sink.AddCurInternalTaskQuality(j, phenotype.GetCurInternalTaskQuality()[j]);
+    }
+
+    if (phenotype.GetLastInternalTaskCount()[j] > 0) {
+      sink.AddLastInternalTask(j);
+      sink.AddLastInternalTaskQuality(j, phenotype.GetLastInternalTaskQuality()[j]);
+    }
+  }
+
+  // Record what add bonuses this organism garnered for different reactions
+  for (int j = 0; j < num_reactions; j++) {
+    if (phenotype.GetCurReactionCount()[j] > 0) {
+      sink.AddCurReaction(j);
+      sink.AddCurReactionAddReward(j, phenotype.GetCurReactionAddReward()[j]);
+    }
+
+    if (phenotype.GetLastReactionCount()[j] > 0) {
+      sink.AddLastReaction(j);
+      sink.IncReactionExeCount(j, phenotype.GetLastReactionCount()[j]);
+      sink.AddLastReactionAddReward(j, phenotype.GetLastReactionAddReward()[j]);
+    }
+  }
+
+  // Increment the counts for all qualities the organism has...
+  counts.num_parasites += organism->GetNumParasites();
+  if (phenotype.ParentTrue()) counts.num_breed_true++;
+  if (phenotype.GetNumDivides() == 0) counts.num_no_birth++;
+  if (phenotype.IsMultiThread()) counts.num_multi_thread++;
+  else counts.num_single_thread++;
+
+  if (phenotype.IsModified()) counts.num_modified++;
+
+  cHardwareBase& hardware = organism->GetHardware();
+  sink.SumMemSize().Add(hardware.GetMemory().GetSize());
+  counts.num_threads += hardware.GetNumThreads();
+
+  // Increment the age of this organism.
+  organism->GetPhenotype().IncAge();
+}
+
+
+void cOrganismStatsReducer::sCounts::Reset()
+{
+  num_breed_true = 0;
+  num_parasites = 0;
+  num_no_birth = 0;
+  num_multi_thread = 0;
+  num_single_thread = 0;
+  num_threads = 0;
+  num_modified = 0;
+
+  max_merit = 0.0;
+  max_fitness = 0;
+  max_gestation_time = 0;
+  max_genome_length = 0;
+
+  min_merit = FLT_MAX;
+  min_fitness = FLT_MAX;
+  min_gestation_time = INT_MAX;
+  min_genome_length = INT_MAX;
+}
+
+void cOrganismStatsReducer::sCounts::Merge(const sCounts& counts)
+{
+  num_breed_true += counts.num_breed_true;
+  num_parasites += counts.num_parasites;
+  num_no_birth += counts.num_no_birth;
+  num_multi_thread += counts.num_multi_thread;
+  num_single_thread += counts.num_single_thread;
+  num_threads += counts.num_threads;
+  num_modified += counts.num_modified;
+
+  if (counts.max_merit > max_merit) max_merit = counts.max_merit;
+  if (counts.max_fitness > max_fitness) max_fitness = counts.max_fitness;
+  if (counts.max_gestation_time > max_gestation_time) max_gestation_time = counts.max_gestation_time;
+  if (counts.max_genome_length > max_genome_length) max_genome_length = counts.max_genome_length;
+
+  if (counts.min_merit < min_merit) min_merit = counts.min_merit;
+  if (counts.min_fitness < min_fitness) min_fitness = counts.min_fitness;
+  if (counts.min_gestation_time < min_gestation_time) min_gestation_time = counts.min_gestation_time;
+  if (counts.min_genome_length < min_genome_length) min_genome_length = counts.min_genome_length;
+}
+
+
+cOrganismStatsReducer::cOrganismStatsReducer(cWorld* world, int num_threads)
+: m_world(world), m_chunked(num_threads != 0), m_orgs(NULL), m_num_tasks(0), m_num_reactions(0)
+, m_num_chunks(0), m_next_chunk(0), m_pending(0), m_generation(0), m_shutdown(false)
+{
+  if (num_threads < 0) num_threads = Apto::Platform::AvailableCPUs();
+
+  // The calling thread always participates in processing chunks, so only num_threads - 1 workers are needed
+  if (num_threads > 1) {
+    m_workers.Resize(num_threads - 1);
+    for (int i = 0; i < m_workers.GetSize(); i++) {
+      m_workers[i] = new cWorker(this);
+      m_workers[i]->Start();
+    }
+  }
+}
+
+cOrganismStatsReducer::~cOrganismStatsReducer()
+{
+  m_mutex.Lock();
+  m_shutdown = true;
+  m_mutex.Unlock();
+  m_cond.Broadcast();
+
+  for (int i = 0; i < m_workers.GetSize(); i++) {
+    m_workers[i]->Join();
+    delete m_workers[i];
+  }
+}
+
+
+void cOrganismStatsReducer::Reduce(const Apto::Array<cOrganism*, Apto::Smart>& orgs)
+{
+  cStats& stats = m_world->GetStats();
+  m_num_tasks = m_world->GetEnvironment().GetNumTasks();
+  m_num_reactions = m_world->GetEnvironment().GetNumReactions();
+
+  sCounts counts;
+  counts.Reset();
+
+  if (!m_chunked) {
+    for (int i = 0; i < orgs.GetSize(); i++) tallyOrganism(stats, counts, orgs[i], m_num_tasks, m_num_reactions);
+  } else {
+    const int num_chunks = (orgs.GetSize() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    if (m_chunks.GetSize() < num_chunks) m_chunks.Resize(num_chunks);
+    for (int i = 0; i < num_chunks; i++) {
+      m_chunks[i].begin = i * CHUNK_SIZE;
+      m_chunks[i].end = (i + 1 < num_chunks) ? (i + 1) * CHUNK_SIZE : orgs.GetSize();
+    }
+
+    m_mutex.Lock();
+    m_orgs = &orgs;
+    m_num_chunks = num_chunks;
+    m_next_chunk = 0;
+    m_pending = num_chunks;
+    m_generation++;
+    m_mutex.Unlock();
+    m_cond.Broadcast();
+
+    // Process chunks on this thread as well
+    runChunks();
+
+    // Wait for all chunks to be completed
+    m_mutex.Lock();
+    while (m_pending > 0) m_term_cond.Wait(m_mutex);
+    m_orgs = NULL;
+    m_mutex.Unlock();
+
+    // Merge chunk results in list order
+    for (int i = 0; i < num_chunks; i++) {
+      stats.MergeOrganismTallies(m_chunks[i].tallies);
+      counts.Merge(m_chunks[i].counts);
+    }
+  }
+
+  stats.SetBreedTrueCreatures(counts.num_breed_true);
+  stats.SetNumNoBirthCreatures(counts.num_no_birth);
+  stats.SetNumParasites(counts.num_parasites);
+  stats.SetNumSingleThreadCreatures(counts.num_single_thread);
+  stats.SetNumMultiThreadCreatures(counts.num_multi_thread);
+  stats.SetNumThreads(counts.num_threads);
+  stats.SetNumModified(counts.num_modified);
+
+  stats.SetMaxMerit(counts.max_merit.GetDouble());
+  stats.SetMaxFitness(counts.max_fitness);
+  stats.SetMaxGestationTime(counts.max_gestation_time);
+  stats.SetMaxGenomeLength(counts.max_genome_length);
+
+  stats.SetMinMerit(counts.min_merit.GetDouble());
+  stats.SetMinFitness(counts.min_fitness);
+  stats.SetMinGestationTime(counts.min_gestation_time);
+  stats.SetMinGenomeLength(counts.min_genome_length);
+}
+
+
+void cOrganismStatsReducer::runChunks()
+{
+  while (true) {
+    m_mutex.Lock();
+    if (m_next_chunk >= m_num_chunks) {
+      m_mutex.Unlock();
+      return;
+    }
+    const int chunk_id = m_next_chunk++;
+    m_mutex.Unlock();
+
+    processChunk(m_chunks[chunk_id]);
+
+    m_mutex.Lock();
+    const int pending = --m_pending;
+    m_mutex.Unlock();
+    if (!pending) m_term_cond.Signal();
+  }
+}
+
+
+void cOrganismStatsReducer::processChunk(sChunk& chunk)
+{
+  chunk.tallies.Reset(m_num_tasks, m_num_reactions);
+  chunk.counts.Reset();
+
+  const Apto::Array<cOrganism*, Apto::Smart>& orgs = *m_orgs;
+  for (int i = chunk.begin; i < chunk.end; i++) {
+    tallyOrganism(chunk.tallies, chunk.counts, orgs[i], m_num_tasks, m_num_reactions);
+  }
+}
+
+
+void cOrganismStatsReducer::cWorker::Run()
+{
+  int last_generation = 0;
+  while (true) {
+    m_reducer->m_mutex.Lock();
+    while (m_reducer->m_generation == last_generation && !m_reducer->m_shutdown) {
+      m_reducer->m_cond.Wait(m_reducer->m_mutex);
+    }
+    if (m_reducer->m_shutdown) {
+      m_reducer->m_mutex.Unlock();
+      break;
+    }
+    last_generation = m_reducer->m_generation;
+    m_reducer->m_mutex.Unlock();
+
+    m_reducer->runChunks();
+  }
+}
@@ -0,0 +1,129 @@
+/*
+ *  cOrganismStatsReducer.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cOrganismStatsReducer_h
+#define cOrganismStatsReducer_h
+
+#include "apto/core.h"
+#include "apto/core/Thread.h"
+
+#include "cMerit.h"
+#include "cStats.h"
+
+class cOrganism;
+class cWorld;
+
+
+// cOrganismStatsReducer gathers the per-organism sums, task and reaction tallies and population counts that
+// cPopulation::UpdateOrganismStats reports to cStats each update, and ages every organism by one update.  With no
+// threads the organisms are tallied straight into the cStats, in list order.  Otherwise the organism list is split into
+// fixed size chunks that are handed out to a pool of worker threads, each chunk is tallied on its own, and the chunks
+// are merged into the cStats in list order once all workers are done.  Chunk boundaries do not depend on the number of
+// threads, so neither do the results.
+
+class cOrganismStatsReducer
+{
+public:
+  struct sCounts
+  {
+    int num_breed_true;
+    int num_parasites;
+    int num_no_birth;
+    int num_multi_thread;
+    int num_single_thread;
+    int num_threads;
+    int num_modified;
+
+    cMerit max_merit;
+    double max_fitness;
+    int max_gestation_time;
+    int max_genome_length;
+
+    cMerit min_merit;
+    double min_fitness;
+    int min_gestation_time;
+    int min_genome_length;
+
+    void Reset();
+    void Merge(const sCounts& counts);
+  };
+
+private:
+  static const int CHUNK_SIZE = 2048;
+
+  class cWorker : public Apto::Thread
+  {
+  private:
+    cOrganismStatsReducer* m_reducer;
+
+    void Run();
+
+  public:
+    cWorker(cOrganismStatsReducer* reducer) : m_reducer(reducer) { ; }
+  };
+
+  struct sChunk
+  {
+    int begin;
+    int end;
+    cOrganismTallies tallies;
+    sCounts counts;
+  };
+
+
+  cWorld* m_world;
+  bool m_chunked;
+  const Apto::Array<cOrganism*, Apto::Smart>* m_orgs;
+  int m_num_tasks;
+  int m_num_reactions;
+  Apto::Array<sChunk> m_chunks;
+  Apto::Array<cWorker*> m_workers;
+
+  Apto::Mutex m_mutex;
+  Apto::ConditionVariable m_cond;
+  Apto::ConditionVariable m_term_cond;
+
+  volatile int m_num_chunks;  // chunks in use for the current reduction
+  volatile int m_next_chunk;  // next chunk to be handed out to a worker
+  volatile int m_pending;     // count of chunks that have not yet been completed
+  volatile int m_generation;  // incremented for each reduction, wakes the workers
+  volatile bool m_shutdown;
+
+
+  void runChunks();
+  void processChunk(sChunk& chunk);
+
+
+  cOrganismStatsReducer(); // @not_implemented
+  cOrganismStatsReducer(const cOrganismStatsReducer&); // @not_implemented
+  cOrganismStatsReducer& operator=(const cOrganismStatsReducer&); // @not_implemented
+
+public:
+  cOrganismStatsReducer(cWorld* world, int num_threads);
+  ~cOrganismStatsReducer();
+
+  int GetNumThreads() const { return (m_chunked) ? m_workers.GetSize() + 1 : 0; }
+
+  // Tally all of orgs into the cStats, whose organism sums and task and reaction tallies must already be cleared
+  void Reduce(const Apto::Array<cOrganism*, Apto::Smart>& orgs);
+};
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ *  cParallelUpdate.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cParallelUpdate.h"
+
+#include "apto/platform.h"
+
+#include "cAvidaContext.h"
+#include "cHardwareBase.h"
+#include "cPopulation.h"
+#include "cPopulationCell.h"
+#include "cStats.h"
+#include "cWorld.h"
+
+
+cParallelUpdate::cParallelUpdate(cWorld* world, int num_threads)
+: m_world(world), m_spec_depth(world->GetConfig().PARALLEL_UPDATE_DEPTH.Get()), m_num_cells(0)
+, m_next_tile(0), m_pending(0), m_generation(0), m_shutdown(false)
+{
+  if (num_threads < 0) num_threads = Apto::Platform::AvailableCPUs();
+  if (m_spec_depth < 1) m_spec_depth = 1;
+
+  // The calling thread always participates in processing tiles, so only num_threads - 1 workers are needed
+  if (num_threads > 1) {
+    m_workers.Resize(num_threads - 1);
+    for (int i = 0; i < m_workers.GetSize(); i++) {
+      m_workers[i] = new cWorker(this);
+      m_workers[i]->Start();
+    }
+  }
+}
+
+cParallelUpdate::~cParallelUpdate()
+{
+  m_mutex.Lock();
+  m_shutdown = true;
+  m_mutex.Unlock();
+  m_cond.Broadcast();
+
+  for (int i = 0; i < m_workers.GetSize(); i++) {
+    m_workers[i]->Join();
+    delete m_workers[i];
+  }
+}
+
+
+void cParallelUpdate::setupTiles()
+{
+  cPopulation& pop = m_world->GetPopulation();
+  m_num_cells = pop.GetSize();
+
+  // Demes are laid out as contiguous bands of cells, use them directly as tiles when present
+  int tile_size = 0;
+  if (pop.GetNumDemes() > 1) {
+    tile_size = pop.GetDeme(0).GetSize();
+  } else {
+    int tile_rows = m_world->GetConfig().PARALLEL_UPDATE_TILE_ROWS.Get();
+    if (tile_rows < 1) tile_rows = 1;
+    tile_size = tile_rows * pop.GetWorldX();
+  }
+  if (tile_size < 1) tile_size = m_num_cells;
+
+  const int num_tiles = (m_num_cells + tile_size - 1) / tile_size;
+  m_tiles.Resize(num_tiles);
+  for (int i = 0; i < num_tiles; i++) {
+    m_tiles[i].begin = i * tile_size;
+    m_tiles[i].end = (i + 1) * tile_size;
+    if (m_tiles[i].end > m_num_cells) m_tiles[i].end = m_num_cells;
+  }
+}
+
+
+void cParallelUpdate::PreExecute(cAvidaContext& ctx)
+{
+  if (m_tiles.GetSize() == 0 || m_num_cells != m_world->GetPopulation().GetSize()) setupTiles();
+
+  // Tile seeds are drawn serially, so that tile results do not depend on which thread processes them
+  for (int i = 0; i < m_tiles.GetSize(); i++) m_tiles[i].seed = ctx.GetRandom().GetInt(ctx.GetRandom().MaxSeed());
+
+  m_mutex.Lock();
+  m_next_tile = 0;
+  m_pending = m_tiles.GetSize();
+  m_generation++;
+  m_mutex.Unlock();
+  m_cond.Broadcast();
+
+  // Process tiles on this thread as well
+  Apto::RNG::AvidaRNG rng;
+  cAvidaContext tile_ctx(&ctx.Driver(), rng);
+  runTiles(tile_ctx, rng);
+
+  // Wait for all tiles to be completed
+  m_mutex.Lock();
+  while (m_pending > 0) m_term_cond.Wait(m_mutex);
+  m_mutex.Unlock();
+
+  // Merge tile statistics in tile order
+  cStats& stats = m_world->GetStats();
+  for (int i = 0; i < m_tiles.GetSize(); i++) {
+    if (m_tiles[i].spec_num) stats.AddSpeculative(m_tiles[i].spec_total, m_tiles[i].spec_num);
+  }
+}
+
+
+void cParallelUpdate::runTiles(cAvidaContext& ctx, Apto::RNG::AvidaRNG& rng)
+{
+  while (true) {
+    m_mutex.Lock();
+    if (m_next_tile >= m_tiles.GetSize()) {
+      m_mutex.Unlock();
+      return;
+    }
+    const int tile_id = m_next_tile++;
+    m_mutex.Unlock();
+
+    sTile& tile = m_tiles[tile_id];
+    rng.ResetSeed(tile.seed);
+    processTile(tile, ctx);
+
+    m_mutex.Lock();
+    const int pending = --m_pending;
+    m_mutex.Unlock();
+    if (!pending) m_term_cond.Signal();
+  }
+}
+
+
+void cParallelUpdate::processTile(sTile& tile, cAvidaContext& ctx)
+{
+  cPopulation& pop = m_world->GetPopulation();
+
+  tile.spec_total = 0;
+  tile.spec_num = 0;
+
+  for (int cell_id = tile.begin; cell_id < tile.end; cell_id++) {
+    cPopulationCell& cell = pop.GetCell(cell_id);
+    if (!cell.IsOccupied()) continue;
+
+    cHardwareBase* hw = cell.GetHardware();
+    if (!hw->SupportsSpeculative()) continue;
+
+    // Extend any speculation left over from the previous update
+    const int start_count = cell.GetSpeculativeState();
+    int spec_count = start_count;
+    while (spec_count < m_spec_depth && hw->SingleProcess(ctx, true)) spec_count++;
+
+    if (spec_count > start_count) {
+      cell.SetSpeculativeState(spec_count);
+      tile.spec_total += spec_count - start_count;
+      tile.spec_num++;
+    }
+  }
+}
+
+
+void cParallelUpdate::cWorker::Run()
+{
+  Apto::RNG::AvidaRNG rng;
+  cAvidaContext ctx(&m_pu->m_world->GetDriver(), rng);
+
+  int last_generation = 0;
+  while (true) {
+    m_pu->m_mutex.Lock();
+    while (m_pu->m_generation == last_generation && !m_pu->m_shutdown) m_pu->m_cond.Wait(m_pu->m_mutex);
+    if (m_pu->m_shutdown) {
+      m_pu->m_mutex.Unlock();
+      break;
+    }
+    last_generation = m_pu->m_generation;
+    m_pu->m_mutex.Unlock();
+
+    m_pu->runTiles(ctx, rng);
+  }
+}
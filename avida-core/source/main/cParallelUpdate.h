@@ -0,0 +1,100 @@
+/*
+ *  cParallelUpdate.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cParallelUpdate_h
+#define cParallelUpdate_h
+
+#include "apto/core.h"
+#include "apto/core/Thread.h"
+
+class cAvidaContext;
+class cWorld;
+
+
+// cParallelUpdate pre-executes the speculative (organism-local) instructions of every organism in the population at
+// the start of an update, spread across a pool of worker threads.  The cell grid is partitioned into tiles (one per
+// deme, or bands of rows when there is a single deme), each tile is run with its own random number stream seeded
+// serially from the world RNG, and the statistics gathered by each tile are merged in tile order once all workers are
+// done.  Instructions that can affect anything outside of the organism stall speculation, so all births, resource
+// changes and stats updates still happen in schedule order through cPopulation::ProcessStepSpeculative.  Results are
+// therefore deterministic for a given random seed, independent of the number of threads.
+
+class cParallelUpdate
+{
+private:
+  class cWorker : public Apto::Thread
+  {
+  private:
+    cParallelUpdate* m_pu;
+
+    void Run();
+
+  public:
+    cWorker(cParallelUpdate* pu) : m_pu(pu) { ; }
+  };
+
+  struct sTile
+  {
+    int begin;
+    int end;
+    int seed;
+    int spec_total;
+    int spec_num;
+  };
+
+
+  cWorld* m_world;
+  int m_spec_depth;
+  int m_num_cells;
+  Apto::Array<sTile> m_tiles;
+  Apto::Array<cWorker*> m_workers;
+
+  Apto::Mutex m_mutex;
+  Apto::ConditionVariable m_cond;
+  Apto::ConditionVariable m_term_cond;
+
+  volatile int m_next_tile;   // next tile to be handed out to a worker
+  volatile int m_pending;     // count of tiles that have not yet been completed
+  volatile int m_generation;  // incremented for each update, wakes the workers
+  volatile bool m_shutdown;
+
+
+  void setupTiles();
+  void runTiles(cAvidaContext& ctx, Apto::RNG::AvidaRNG& rng);
+  void processTile(sTile& tile, cAvidaContext& ctx);
+
+
+  cParallelUpdate(); // @not_implemented
+  cParallelUpdate(const cParallelUpdate&); // @not_implemented
+  cParallelUpdate& operator=(const cParallelUpdate&); // @not_implemented
+
+public:
+  cParallelUpdate(cWorld* world, int num_threads);
+  ~cParallelUpdate();
+
+  int GetNumThreads() const { return m_workers.GetSize() + 1; }
+
+  // Speculatively execute ahead all organisms in the population.  Must be called between updates, with no other
+  // organism execution in progress.
+  void PreExecute(cAvidaContext& ctx);
+};
+
+#endif
@@ -40,22 +40,11 @@ cPhenotype::cPhenotype(cWorld* world, int parent_generation, int num_nops)
 : m_world(world)
 , initialized(false)
 , energy_store(0.0)
-, cur_task_count(m_world->GetEnvironment().GetNumTasks())
-, cur_para_tasks(m_world->GetEnvironment().GetNumTasks())
-, cur_host_tasks(m_world->GetEnvironment().GetNumTasks())
-, cur_internal_task_count(m_world->GetEnvironment().GetNumTasks())
+, m_cur_counts(0)
 , eff_task_count(m_world->GetEnvironment().GetNumTasks())
-, cur_task_quality(m_world->GetEnvironment().GetNumTasks())  
-, cur_task_value(m_world->GetEnvironment().GetNumTasks())  
-, cur_internal_task_quality(m_world->GetEnvironment().GetNumTasks())
-, cur_rbins_total(m_world->GetEnvironment().GetResourceLib().GetSize())
-, cur_rbins_avail(m_world->GetEnvironment().GetResourceLib().GetSize())
-, cur_reaction_count(m_world->GetEnvironment().GetReactionLib().GetSize())
 , first_reaction_cycles(m_world->GetEnvironment().GetReactionLib().GetSize())
 , first_reaction_execs(m_world->GetEnvironment().GetReactionLib().GetSize())
 , cur_stolen_reaction_count(m_world->GetEnvironment().GetReactionLib().GetSize())
-, cur_reaction_add_reward(m_world->GetEnvironment().GetReactionLib().GetSize())
-, cur_sense_count(m_world->GetStats().GetSenseSize())
 , sensed_resources(m_world->GetEnvironment().GetResourceLib().GetSize())
 , cur_task_time(m_world->GetEnvironment().GetNumTasks())   // Added for tracking time; WRE 03-18-07
 , m_tolerance_immigrants()
@@ -67,19 +56,6 @@ cPhenotype::cPhenotype(cWorld* world, int parent_generation, int num_nops)
 , cur_mating_display_a(0)
 , cur_mating_display_b(0)
 , m_reaction_result(NULL)
-, last_task_count(m_world->GetEnvironment().GetNumTasks())
-, last_para_tasks(m_world->GetEnvironment().GetNumTasks())
-, last_host_tasks(m_world->GetEnvironment().GetNumTasks())
-, last_internal_task_count(m_world->GetEnvironment().GetNumTasks())
-, last_task_quality(m_world->GetEnvironment().GetNumTasks())
-, last_task_value(m_world->GetEnvironment().GetNumTasks())
-, last_internal_task_quality(m_world->GetEnvironment().GetNumTasks())
-, last_rbins_total(m_world->GetEnvironment().GetResourceLib().GetSize())
-, last_rbins_avail(m_world->GetEnvironment().GetResourceLib().GetSize())
-, last_collect_spec_counts()
-, last_reaction_count(m_world->GetEnvironment().GetReactionLib().GetSize())
-, last_reaction_add_reward(m_world->GetEnvironment().GetReactionLib().GetSize())  
-, last_sense_count(m_world->GetStats().GetSenseSize())
 , last_mating_display_a(0)
 , last_mating_display_b(0)
 , generation(0)
@@ -99,10 +75,30 @@ cPhenotype::cPhenotype(cWorld* world, int parent_generation, int num_nops)
     if (m_world->GetConfig().GENERATION_INC_METHOD.Get() != GENERATION_INC_BOTH) generation++;
   }
   
+  const int num_tasks = m_world->GetEnvironment().GetNumTasks();
+  const int num_reactions = m_world->GetEnvironment().GetReactionLib().GetSize();
+  for (int i = 0; i < 2; i++) {
+    sGestationCounts& counts = m_counts[i];
+    counts.task_count.Resize(num_tasks);
+    counts.para_tasks.Resize(num_tasks);
+    counts.host_tasks.Resize(num_tasks);
+    counts.internal_task_count.Resize(num_tasks);
+    counts.task_quality.Resize(num_tasks);
+    counts.task_value.Resize(num_tasks);
+    counts.internal_task_quality.Resize(num_tasks);
+    counts.rbins_total.Resize(m_world->GetEnvironment().GetResourceLib().GetSize());
+    counts.rbins_avail.Resize(m_world->GetEnvironment().GetResourceLib().GetSize());
+    counts.reaction_count.Resize(num_reactions);
+    counts.reaction_add_reward.Resize(num_reactions);
+    counts.sense_count.Resize(m_world->GetStats().GetSenseSize());
+  }
+  
   double num_resources = m_world->GetEnvironment().GetResourceLib().GetSize();
   if (num_resources <= 0 || num_nops <= 0) return;
   double most_nops_needed = ceil(log(num_resources) / log((double)num_nops));
-  cur_collect_spec_counts.Resize(int((pow((double)num_nops, most_nops_needed + 1.0) - 1.0) / ((double)num_nops - 1.0)));
+  const int num_collect_specs = int((pow((double)num_nops, most_nops_needed + 1.0) - 1.0) / ((double)num_nops - 1.0));
+  m_counts[0].collect_spec_counts.Resize(num_collect_specs);
+  m_counts[1].collect_spec_counts.Resize(num_collect_specs);
 }
 
 cPhenotype::~cPhenotype()
@@ -148,29 +144,14 @@ cPhenotype& cPhenotype::operator=(const cPhenotype& in_phen)
   cur_energy_bonus         = in_phen.cur_energy_bonus;                   
   cur_num_errors           = in_phen.cur_num_errors;                         
   cur_num_donates          = in_phen.cur_num_donates;                       
-  cur_task_count           = in_phen.cur_task_count;  
-  cur_para_tasks           = in_phen.cur_para_tasks;
-  cur_host_tasks           = in_phen.cur_host_tasks;
+  m_counts[0]              = in_phen.m_counts[0];
+  m_counts[1]              = in_phen.m_counts[1];
+  m_cur_counts             = in_phen.m_cur_counts;
   eff_task_count           = in_phen.eff_task_count;
-  cur_internal_task_count  = in_phen.cur_internal_task_count;
-  cur_task_quality         = in_phen.cur_task_quality;    
-  cur_internal_task_quality= in_phen.cur_internal_task_quality;       
-  cur_task_value           = in_phen.cur_task_value;			
-  cur_rbins_total          = in_phen.cur_rbins_total;
-  cur_rbins_avail          = in_phen.cur_rbins_avail;
-  cur_collect_spec_counts  = in_phen.cur_collect_spec_counts;
-  cur_reaction_count       = in_phen.cur_reaction_count;            
   first_reaction_cycles    = in_phen.first_reaction_cycles;            
   first_reaction_execs     = first_reaction_execs;            
-  cur_reaction_add_reward  = in_phen.cur_reaction_add_reward;     
-  cur_inst_count           = in_phen.cur_inst_count;                 
-  cur_from_sensor_count    = in_phen.cur_from_sensor_count;
-  cur_group_attack_count    = in_phen.cur_group_attack_count;
-  cur_top_pred_group_attack_count    = in_phen.cur_top_pred_group_attack_count;
-  cur_killed_targets       = in_phen.cur_killed_targets;
   cur_attacks              = in_phen.cur_attacks;
   cur_kills                 = in_phen.cur_kills;
-  cur_sense_count          = in_phen.cur_sense_count;
   sensed_resources         = in_phen.sensed_resources;            
   cur_task_time            = in_phen.cur_task_time;
   m_tolerance_immigrants          = in_phen.m_tolerance_immigrants;
@@ -186,7 +167,6 @@ cPhenotype& cPhenotype::operator=(const cPhenotype& in_phen)
   last_mating_display_a = in_phen.last_mating_display_a;
   last_mating_display_b = in_phen.last_mating_display_b;  
   
-  cur_from_message_count    = in_phen.cur_from_message_count;
 
   // Dynamically allocated m_task_states requires special handling
   for (Apto::Map<void*, cTaskState*>::ConstIterator it = in_phen.m_task_states.Begin(); it.Next();) {
@@ -200,33 +180,14 @@ cPhenotype& cPhenotype::operator=(const cPhenotype& in_phen)
   last_energy_bonus        = in_phen.last_energy_bonus; 
   last_num_errors          = in_phen.last_num_errors; 
   last_num_donates         = in_phen.last_num_donates;
-  last_task_count          = in_phen.last_task_count;
-  last_host_tasks          = in_phen.last_host_tasks;
-  last_para_tasks          = in_phen.last_para_tasks;
-  last_internal_task_count = in_phen.last_internal_task_count;
-  last_task_quality        = in_phen.last_task_quality;
-  last_internal_task_quality=in_phen.last_internal_task_quality;
-  last_task_value          = in_phen.last_task_value;
-  last_rbins_total         = in_phen.last_rbins_total;
-  last_rbins_avail         = in_phen.last_rbins_avail;
-  last_collect_spec_counts = in_phen.last_collect_spec_counts;
-  last_reaction_count      = in_phen.last_reaction_count;
-  last_reaction_add_reward = in_phen.last_reaction_add_reward; 
-  last_inst_count          = in_phen.last_inst_count;	  
-  last_from_sensor_count   = in_phen.last_from_sensor_count;
-  last_group_attack_count   = in_phen.last_group_attack_count;
-  last_top_pred_group_attack_count   = in_phen.last_top_pred_group_attack_count;
-  last_killed_targets      = in_phen.last_killed_targets;
   last_attacks             = in_phen.last_attacks;
   last_kills                = in_phen.last_kills;
-  last_sense_count         = in_phen.last_sense_count;
   last_fitness             = in_phen.last_fitness;            
   last_child_germline_propensity = in_phen.last_child_germline_propensity;
   total_energy_donated     = in_phen.total_energy_donated;
   total_energy_received    = in_phen.total_energy_received;
   total_energy_applied     = in_phen.total_energy_applied;
   
-  last_from_message_count   = in_phen.last_from_message_count;
 
   // 4. Records from this organisms life...
   num_divides              = in_phen.num_divides;   
@@ -380,43 +341,43 @@ void cPhenotype::SetupOffspring(const cPhenotype& parent_phenotype, const Instru
   cur_energy_bonus = 0.0;
   cur_num_errors  = 0;
   cur_num_donates  = 0;
-  cur_task_count.SetAll(0);
-  cur_internal_task_count.SetAll(0);
+  cur().task_count.SetAll(0);
+  cur().internal_task_count.SetAll(0);
   eff_task_count.SetAll(0);
-  cur_host_tasks.SetAll(0);
-  cur_para_tasks.SetAll(0);
-  cur_task_quality.SetAll(0);
-  cur_task_value.SetAll(0);
-  cur_internal_task_quality.SetAll(0);
-  cur_rbins_total.SetAll(0);  // total resources collected in lifetime
+  cur().host_tasks.SetAll(0);
+  cur().para_tasks.SetAll(0);
+  cur().task_quality.SetAll(0);
+  cur().task_value.SetAll(0);
+  cur().internal_task_quality.SetAll(0);
+  cur().rbins_total.SetAll(0);  // total resources collected in lifetime
   // parent's resources have already been halved or reset in DivideReset;
   // offspring gets that value (half or 0) too.
-  cur_rbins_avail.SetAll(0);
+  cur().rbins_avail.SetAll(0);
   if (m_world->GetConfig().SPLIT_ON_DIVIDE.Get()) {
-    for (int i = 0; i < cur_rbins_avail.GetSize(); i++) cur_rbins_avail[i] = parent_phenotype.cur_rbins_avail[i];
+    for (int i = 0; i < cur().rbins_avail.GetSize(); i++) cur().rbins_avail[i] = parent_phenotype.cur().rbins_avail[i];
   }
   if (m_world->GetConfig().RESOURCE_GIVEN_AT_BIRTH.Get() > 0.0) {
     const int resource = m_world->GetConfig().COLLECT_SPECIFIC_RESOURCE.Get();
-    cur_rbins_avail[resource] += m_world->GetConfig().RESOURCE_GIVEN_AT_BIRTH.Get();
+    cur().rbins_avail[resource] += m_world->GetConfig().RESOURCE_GIVEN_AT_BIRTH.Get();
   }
   
-  cur_collect_spec_counts.SetAll(0);
-  cur_reaction_count.SetAll(0);
+  cur().collect_spec_counts.SetAll(0);
+  cur().reaction_count.SetAll(0);
   first_reaction_cycles.SetAll(-1);
   first_reaction_execs.SetAll(-1);
   cur_stolen_reaction_count.SetAll(0);
-  cur_reaction_add_reward.SetAll(0);
-  cur_inst_count.SetAll(0);
-  cur_from_sensor_count.SetAll(0);
-  cur_from_message_count.SetAll(0);
-  for (int r = 0; r < cur_group_attack_count.GetSize(); r++) {
-    cur_group_attack_count[r].SetAll(0);
-    cur_top_pred_group_attack_count[r].SetAll(0);
+  cur().reaction_add_reward.SetAll(0);
+  cur().inst_count.SetAll(0);
+  cur().from_sensor_count.SetAll(0);
+  cur().from_message_count.SetAll(0);
+  for (int r = 0; r < cur().group_attack_count.GetSize(); r++) {
+    cur().group_attack_count[r].SetAll(0);
+    cur().top_pred_group_attack_count[r].SetAll(0);
   }
-  cur_killed_targets.SetAll(0);
+  cur().killed_targets.SetAll(0);
   cur_attacks = 0;
   cur_kills = 0;
-  cur_sense_count.SetAll(0);
+  cur().sense_count.SetAll(0);
   cur_task_time.SetAll(0.0);  // Added for time tracking; WRE 03-18-07
   for (int j = 0; j < sensed_resources.GetSize(); j++) {
     sensed_resources[j] =  parent_phenotype.sensed_resources[j];
@@ -445,30 +406,11 @@ void cPhenotype::SetupOffspring(const cPhenotype& parent_phenotype, const Instru
   last_cpu_cycles_used      = parent_phenotype.last_cpu_cycles_used;
   last_num_errors           = parent_phenotype.last_num_errors;
   last_num_donates          = parent_phenotype.last_num_donates;
-  last_task_count           = parent_phenotype.last_task_count;
-  last_host_tasks           = parent_phenotype.last_host_tasks;
-  last_para_tasks           = parent_phenotype.last_para_tasks;
-  last_internal_task_count  = parent_phenotype.last_internal_task_count;
-  last_task_quality         = parent_phenotype.last_task_quality;
-  last_task_value           = parent_phenotype.last_task_value;
-  last_internal_task_quality= parent_phenotype.last_internal_task_quality;
-  last_rbins_total          = parent_phenotype.last_rbins_total;
-  last_rbins_avail          = parent_phenotype.last_rbins_avail;
-  last_collect_spec_counts  = parent_phenotype.last_collect_spec_counts;
-  last_reaction_count       = parent_phenotype.last_reaction_count;
-  last_reaction_add_reward  = parent_phenotype.last_reaction_add_reward;
-  last_inst_count           = parent_phenotype.last_inst_count;
-  last_from_sensor_count    = parent_phenotype.last_from_sensor_count;
-  last_group_attack_count    = parent_phenotype.last_group_attack_count;
-  last_top_pred_group_attack_count    = parent_phenotype.last_top_pred_group_attack_count;
-  last_killed_targets       = parent_phenotype.last_killed_targets;
+  last()                    = parent_phenotype.last();
   last_attacks              = parent_phenotype.last_attacks;
   last_kills                = parent_phenotype.last_kills;
-  last_sense_count          = parent_phenotype.last_sense_count;
   last_fitness              = CalcFitness(last_merit_base, last_bonus, gestation_time, last_cpu_cycles_used);
   last_child_germline_propensity = parent_phenotype.last_child_germline_propensity;   // chance of child being a germline cell; @JEB
-  
-  last_from_message_count    = parent_phenotype.last_from_message_count;
 
   // Setup other miscellaneous values...
   num_divides     = 0;
@@ -621,38 +563,38 @@ void cPhenotype::SetupInject(const InstructionSequence& _genome)
   cur_energy_bonus = 0.0;
   cur_num_errors  = 0;
   cur_num_donates  = 0;
-  cur_task_count.SetAll(0);
-  cur_para_tasks.SetAll(0);
-  cur_host_tasks.SetAll(0);
-  cur_internal_task_count.SetAll(0);
+  cur().task_count.SetAll(0);
+  cur().para_tasks.SetAll(0);
+  cur().host_tasks.SetAll(0);
+  cur().internal_task_count.SetAll(0);
   eff_task_count.SetAll(0);
-  cur_task_quality.SetAll(0);
-  cur_task_value.SetAll(0);
-  cur_internal_task_quality.SetAll(0);
-  cur_rbins_total.SetAll(0);
+  cur().task_quality.SetAll(0);
+  cur().task_value.SetAll(0);
+  cur().internal_task_quality.SetAll(0);
+  cur().rbins_total.SetAll(0);
   if (m_world->GetConfig().RESOURCE_GIVEN_ON_INJECT.Get() > 0.0) {   
     const int resource = m_world->GetConfig().COLLECT_SPECIFIC_RESOURCE.Get();
-    cur_rbins_avail[resource] = m_world->GetConfig().RESOURCE_GIVEN_ON_INJECT.Get();
+    cur().rbins_avail[resource] = m_world->GetConfig().RESOURCE_GIVEN_ON_INJECT.Get();
   }
-  else cur_rbins_avail.SetAll(0);
-  cur_collect_spec_counts.SetAll(0);
-  cur_reaction_count.SetAll(0);
+  else cur().rbins_avail.SetAll(0);
+  cur().collect_spec_counts.SetAll(0);
+  cur().reaction_count.SetAll(0);
   first_reaction_cycles.SetAll(-1);
   first_reaction_execs.SetAll(-1);
   cur_stolen_reaction_count.SetAll(0);
-  cur_reaction_add_reward.SetAll(0);
-  cur_inst_count.SetAll(0);
-  cur_from_sensor_count.SetAll(0);
-  cur_from_message_count.SetAll(0);
-  for (int r = 0; r < cur_group_attack_count.GetSize(); r++) {
-    cur_group_attack_count[r].SetAll(0);
-    cur_top_pred_group_attack_count[r].SetAll(0);
+  cur().reaction_add_reward.SetAll(0);
+  cur().inst_count.SetAll(0);
+  cur().from_sensor_count.SetAll(0);
+  cur().from_message_count.SetAll(0);
+  for (int r = 0; r < cur().group_attack_count.GetSize(); r++) {
+    cur().group_attack_count[r].SetAll(0);
+    cur().top_pred_group_attack_count[r].SetAll(0);
   }
-  cur_killed_targets.SetAll(0);
+  cur().killed_targets.SetAll(0);
   cur_attacks = 0;
   cur_kills = 0;
   sensed_resources.SetAll(0);
-  cur_sense_count.SetAll(0);
+  cur().sense_count.SetAll(0);
   cur_task_time.SetAll(0.0);
   cur_trial_fitnesses.Resize(0);
   cur_trial_bonuses.Resize(0); 
@@ -673,29 +615,29 @@ void cPhenotype::SetupInject(const InstructionSequence& _genome)
   last_cpu_cycles_used = 0;
   last_num_errors = 0;
   last_num_donates = 0;
-  last_task_count.SetAll(0);
-  last_host_tasks.SetAll(0);
-  last_para_tasks.SetAll(0);
-  last_internal_task_count.SetAll(0);
-  last_task_quality.SetAll(0);
-  last_task_value.SetAll(0);
-  last_internal_task_quality.SetAll(0);
-  last_rbins_total.SetAll(0);
-  last_rbins_avail.SetAll(0);
-  last_collect_spec_counts.SetAll(0);
-  last_reaction_count.SetAll(0);
-  last_reaction_add_reward.SetAll(0);
-  last_inst_count.SetAll(0);
-  last_from_sensor_count.SetAll(0);
-  last_from_message_count.SetAll(0);
-  for (int r = 0; r < last_group_attack_count.GetSize(); r++) {
-    last_group_attack_count[r].SetAll(0);
-    last_top_pred_group_attack_count[r].SetAll(0);
+  last().task_count.SetAll(0);
+  last().host_tasks.SetAll(0);
+  last().para_tasks.SetAll(0);
+  last().internal_task_count.SetAll(0);
+  last().task_quality.SetAll(0);
+  last().task_value.SetAll(0);
+  last().internal_task_quality.SetAll(0);
+  last().rbins_total.SetAll(0);
+  last().rbins_avail.SetAll(0);
+  last().collect_spec_counts.SetAll(0);
+  last().reaction_count.SetAll(0);
+  last().reaction_add_reward.SetAll(0);
+  last().inst_count.SetAll(0);
+  last().from_sensor_count.SetAll(0);
+  last().from_message_count.SetAll(0);
+  for (int r = 0; r < last().group_attack_count.GetSize(); r++) {
+    last().group_attack_count[r].SetAll(0);
+    last().top_pred_group_attack_count[r].SetAll(0);
   }
-  last_killed_targets.SetAll(0);
+  last().killed_targets.SetAll(0);
   last_attacks = 0;
   last_kills = 0;
-  last_sense_count.SetAll(0);
+  last().sense_count.SetAll(0);
   last_child_germline_propensity = m_world->GetConfig().DEMES_DEFAULT_GERMLINE_PROPENSITY.Get();
   
   // Setup other miscellaneous values...
@@ -865,27 +807,9 @@ void cPhenotype::DivideReset(const InstructionSequence& _genome)
   //TODO?  last_energy         = cur_energy_bonus;
   last_num_errors           = cur_num_errors;
   last_num_donates          = cur_num_donates;
-  last_task_count           = cur_task_count;
-  last_host_tasks           = cur_host_tasks;
-  last_para_tasks           = cur_para_tasks;
-  last_internal_task_count  = cur_internal_task_count;
-  last_task_quality         = cur_task_quality;
-  last_task_value           = cur_task_value;
-  last_internal_task_quality= cur_internal_task_quality;
-  last_rbins_total          = cur_rbins_total;
-  last_rbins_avail          = cur_rbins_avail;
-  last_collect_spec_counts  = cur_collect_spec_counts;
-  last_reaction_count       = cur_reaction_count;
-  last_reaction_add_reward  = cur_reaction_add_reward;
-  last_inst_count           = cur_inst_count;
-  last_from_sensor_count    = cur_from_sensor_count;
-  last_from_message_count    = cur_from_message_count;
-  last_group_attack_count   = cur_group_attack_count;
-  last_killed_targets       = cur_killed_targets;
+  lockInCounts();
   last_attacks              = cur_attacks;
   last_kills                = cur_kills;
-  last_top_pred_group_attack_count    = cur_top_pred_group_attack_count;
-  last_sense_count          = cur_sense_count;
   last_child_germline_propensity = cur_child_germline_propensity;
   
   last_mating_display_a = cur_mating_display_a; //@CHC
@@ -897,8 +821,8 @@ void cPhenotype::DivideReset(const InstructionSequence& _genome)
   cur_energy_bonus = 0.0;
   cur_num_errors  = 0;
   cur_num_donates  = 0;
-  cur_task_count.SetAll(0);
-  cur_host_tasks.SetAll(0);
+  cur().task_count.SetAll(0);
+  cur().host_tasks.SetAll(0);
   
   cur_mating_display_a = 0; //@CHC
   cur_mating_display_b = 0;
@@ -906,43 +830,48 @@ void cPhenotype::DivideReset(const InstructionSequence& _genome)
   // @LZ: figure out when and where to reset cur_para_tasks, depending on the divide method, and
   //      resonable assumptions
   if (m_world->GetConfig().DIVIDE_METHOD.Get() == DIVIDE_METHOD_SPLIT) {     
-    last_para_tasks = cur_para_tasks;
-    cur_para_tasks.SetAll(0);
+    cur().para_tasks.SetAll(0);
+  } else {
+    cur().para_tasks = last().para_tasks;
   }
-  cur_internal_task_count.SetAll(0);
+  cur().internal_task_count.SetAll(0);
   eff_task_count.SetAll(0);
-  cur_task_quality.SetAll(0);
-  cur_task_value.SetAll(0);
-  cur_internal_task_quality.SetAll(0);
+  cur().task_quality.SetAll(0);
+  cur().task_value.SetAll(0);
+  cur().internal_task_quality.SetAll(0);
   if (m_world->GetConfig().SPLIT_ON_DIVIDE.Get()) {
     // resources available are split in half -- the offspring gets the other half
-    for (int i = 0; i < cur_rbins_avail.GetSize(); i++) {cur_rbins_avail[i] /= 2.0;}
-  } else if (m_world->GetConfig().DIVIDE_METHOD.Get() != 0) {
-    cur_rbins_avail.SetAll(0);
-    cur_rbins_total.SetAll(0);  // total resources collected in lifetime
+    for (int i = 0; i < cur().rbins_avail.GetSize(); i++) {cur().rbins_avail[i] = last().rbins_avail[i] / 2.0;}
+    cur().rbins_total = last().rbins_total;
+  } else if (m_world->GetConfig().DIVIDE_METHOD.Get() == 0) {
+    cur().rbins_avail = last().rbins_avail;
+    cur().rbins_total = last().rbins_total;
+  } else {
+    cur().rbins_avail.SetAll(0);
+    cur().rbins_total.SetAll(0);  // total resources collected in lifetime
     
     if (m_world->GetConfig().RESOURCE_GIVEN_AT_BIRTH.Get() > 0.0) {
       const int resource = m_world->GetConfig().COLLECT_SPECIFIC_RESOURCE.Get();
-      cur_rbins_avail[resource] += m_world->GetConfig().RESOURCE_GIVEN_AT_BIRTH.Get();
+      cur().rbins_avail[resource] += m_world->GetConfig().RESOURCE_GIVEN_AT_BIRTH.Get();
     }
   }
-  cur_collect_spec_counts.SetAll(0);
-  cur_reaction_count.SetAll(0);
+  cur().collect_spec_counts.SetAll(0);
+  cur().reaction_count.SetAll(0);
   first_reaction_cycles.SetAll(-1);
   first_reaction_execs.SetAll(-1);
   cur_stolen_reaction_count.SetAll(0);
-  cur_reaction_add_reward.SetAll(0);
-  cur_inst_count.SetAll(0);
-  cur_from_sensor_count.SetAll(0);
-  cur_from_message_count.SetAll(0);
-  for (int r = 0; r < cur_group_attack_count.GetSize(); r++) {
-    cur_group_attack_count[r].SetAll(0);
-    cur_top_pred_group_attack_count[r].SetAll(0);
+  cur().reaction_add_reward.SetAll(0);
+  cur().inst_count.SetAll(0);
+  cur().from_sensor_count.SetAll(0);
+  cur().from_message_count.SetAll(0);
+  for (int r = 0; r < cur().group_attack_count.GetSize(); r++) {
+    cur().group_attack_count[r].SetAll(0);
+    cur().top_pred_group_attack_count[r].SetAll(0);
   }
-  cur_killed_targets.SetAll(0);
+  cur().killed_targets.SetAll(0);
   cur_attacks = 0;
   cur_kills = 0;
-  cur_sense_count.SetAll(0);
+  cur().sense_count.SetAll(0);
   cur_task_time.SetAll(0.0);
   cur_child_germline_propensity = m_world->GetConfig().DEMES_DEFAULT_GERMLINE_PROPENSITY.Get();
   
@@ -1099,27 +1028,9 @@ void cPhenotype::TestDivideReset(const InstructionSequence& _genome)
   last_cpu_cycles_used      = cpu_cycles_used;
   last_num_errors           = cur_num_errors;
   last_num_donates          = cur_num_donates;
-  last_task_count           = cur_task_count;
-  last_host_tasks           = cur_host_tasks;
-  last_para_tasks           = cur_para_tasks;
-  last_internal_task_count  = cur_internal_task_count;
-  last_task_quality         = cur_task_quality;
-  last_task_value			= cur_task_value;
-  last_internal_task_quality= cur_internal_task_quality;
-  last_rbins_total          = cur_rbins_total;
-  last_rbins_avail          = cur_rbins_avail;
-  last_collect_spec_counts  = cur_collect_spec_counts;
-  last_reaction_count       = cur_reaction_count;
-  last_reaction_add_reward  = cur_reaction_add_reward;
-  last_inst_count           = cur_inst_count;
-  last_from_sensor_count    = cur_from_sensor_count;
-  last_from_message_count    = cur_from_message_count;
-  last_group_attack_count   = cur_group_attack_count;
-  last_killed_targets       = cur_killed_targets;
+  lockInCounts();
   last_attacks              = cur_attacks;
   last_kills                = cur_kills;
-  last_top_pred_group_attack_count    = cur_top_pred_group_attack_count;
-  last_sense_count          = cur_sense_count;
   last_child_germline_propensity = cur_child_germline_propensity;
   
   // Reset cur values.
@@ -1127,42 +1038,44 @@ void cPhenotype::TestDivideReset(const InstructionSequence& _genome)
   cpu_cycles_used = 0;
   cur_num_errors  = 0;
   cur_num_donates  = 0;
-  cur_task_count.SetAll(0);
-  cur_host_tasks.SetAll(0);
+  cur().task_count.SetAll(0);
+  cur().host_tasks.SetAll(0);
   // @LZ: figure out when and where to reset cur_para_tasks, depending on the divide method, and
   //      resonable assumptions
   if (m_world->GetConfig().DIVIDE_METHOD.Get() == DIVIDE_METHOD_SPLIT) {
-    last_para_tasks = cur_para_tasks;
-    cur_para_tasks.SetAll(0);
+    cur().para_tasks.SetAll(0);
+  } else {
+    cur().para_tasks = last().para_tasks;
   }
-  cur_internal_task_count.SetAll(0);
+  cur().internal_task_count.SetAll(0);
   eff_task_count.SetAll(0);
-  cur_task_quality.SetAll(0);
-  cur_task_value.SetAll(0);
-  cur_internal_task_quality.SetAll(0);
-  cur_rbins_total.SetAll(0);  // total resources collected in lifetime
+  cur().task_quality.SetAll(0);
+  cur().task_value.SetAll(0);
+  cur().internal_task_quality.SetAll(0);
+  cur().rbins_total.SetAll(0);  // total resources collected in lifetime
   if (m_world->GetConfig().RESOURCE_GIVEN_ON_INJECT.Get() > 0.0) {   
     const int resource = m_world->GetConfig().COLLECT_SPECIFIC_RESOURCE.Get();
-    cur_rbins_avail[resource] = m_world->GetConfig().RESOURCE_GIVEN_ON_INJECT.Get();
+    cur().rbins_avail = last().rbins_avail;
+    cur().rbins_avail[resource] = m_world->GetConfig().RESOURCE_GIVEN_ON_INJECT.Get();
   }
-  else cur_rbins_avail.SetAll(0);
-  cur_collect_spec_counts.SetAll(0);
-  cur_reaction_count.SetAll(0);
+  else cur().rbins_avail.SetAll(0);
+  cur().collect_spec_counts.SetAll(0);
+  cur().reaction_count.SetAll(0);
   first_reaction_cycles.SetAll(-1);
   first_reaction_execs.SetAll(-1);
   cur_stolen_reaction_count.SetAll(0);
-  cur_reaction_add_reward.SetAll(0);
-  cur_inst_count.SetAll(0);
-  cur_from_sensor_count.SetAll(0);
-  cur_from_message_count.SetAll(0);
-  for (int r = 0; r < cur_group_attack_count.GetSize(); r++) {
-    cur_group_attack_count[r].SetAll(0);
-    cur_top_pred_group_attack_count[r].SetAll(0);
+  cur().reaction_add_reward.SetAll(0);
+  cur().inst_count.SetAll(0);
+  cur().from_sensor_count.SetAll(0);
+  cur().from_message_count.SetAll(0);
+  for (int r = 0; r < cur().group_attack_count.GetSize(); r++) {
+    cur().group_attack_count[r].SetAll(0);
+    cur().top_pred_group_attack_count[r].SetAll(0);
   }
-  cur_killed_targets.SetAll(0);
+  cur().killed_targets.SetAll(0);
   cur_attacks = 0;
   cur_kills = 0;
-  cur_sense_count.SetAll(0);
+  cur().sense_count.SetAll(0);
   cur_task_time.SetAll(0.0);
   sensed_resources.SetAll(-1.0);
   cur_trial_fitnesses.Resize(0); 
@@ -1311,30 +1224,30 @@ void cPhenotype::SetupClone(const cPhenotype& clone_phenotype)
   cpu_cycles_used = 0;
   cur_num_errors  = 0;
   cur_num_donates  = 0;
-  cur_task_count.SetAll(0);
-  cur_host_tasks.SetAll(0);
-  cur_para_tasks.SetAll(0);
-  cur_internal_task_count.SetAll(0);
+  cur().task_count.SetAll(0);
+  cur().host_tasks.SetAll(0);
+  cur().para_tasks.SetAll(0);
+  cur().internal_task_count.SetAll(0);
   eff_task_count.SetAll(0);
-  cur_rbins_total.SetAll(0);
-  cur_rbins_avail.SetAll(0);
-  cur_collect_spec_counts.SetAll(0);
-  cur_reaction_count.SetAll(0);
+  cur().rbins_total.SetAll(0);
+  cur().rbins_avail.SetAll(0);
+  cur().collect_spec_counts.SetAll(0);
+  cur().reaction_count.SetAll(0);
   first_reaction_cycles.SetAll(-1);
   first_reaction_execs.SetAll(-1);
   cur_stolen_reaction_count.SetAll(0);
-  cur_reaction_add_reward.SetAll(0);
-  cur_inst_count.SetAll(0);
-  cur_from_sensor_count.SetAll(0);
-  cur_from_message_count.SetAll(0);
-  for (int r = 0; r < cur_group_attack_count.GetSize(); r++) {
-    cur_group_attack_count[r].SetAll(0);
-    cur_top_pred_group_attack_count[r].SetAll(0);
+  cur().reaction_add_reward.SetAll(0);
+  cur().inst_count.SetAll(0);
+  cur().from_sensor_count.SetAll(0);
+  cur().from_message_count.SetAll(0);
+  for (int r = 0; r < cur().group_attack_count.GetSize(); r++) {
+    cur().group_attack_count[r].SetAll(0);
+    cur().top_pred_group_attack_count[r].SetAll(0);
   }
-  cur_killed_targets.SetAll(0);
+  cur().killed_targets.SetAll(0);
   cur_attacks = 0;
   cur_kills = 0;
-  cur_sense_count.SetAll(0);
+  cur().sense_count.SetAll(0);
   cur_task_time.SetAll(0.0);
   for (int j = 0; j < sensed_resources.GetSize(); j++) {
     sensed_resources[j] = clone_phenotype.sensed_resources[j];
@@ -1358,24 +1271,24 @@ void cPhenotype::SetupClone(const cPhenotype& clone_phenotype)
   last_cpu_cycles_used     = clone_phenotype.last_cpu_cycles_used;
   last_num_errors          = clone_phenotype.last_num_errors;
   last_num_donates         = clone_phenotype.last_num_donates;
-  last_task_count          = clone_phenotype.last_task_count;
-  last_host_tasks          = clone_phenotype.last_host_tasks;
-  last_para_tasks          = clone_phenotype.last_para_tasks;
-  last_internal_task_count = clone_phenotype.last_internal_task_count;
-  last_rbins_total         = clone_phenotype.last_rbins_total;
-  last_rbins_avail         = clone_phenotype.last_rbins_avail;
-  last_collect_spec_counts = clone_phenotype.last_collect_spec_counts;
-  last_reaction_count      = clone_phenotype.last_reaction_count;
-  last_reaction_add_reward = clone_phenotype.last_reaction_add_reward;
-  last_inst_count          = clone_phenotype.last_inst_count;
-  last_from_sensor_count   = clone_phenotype.last_from_sensor_count;
-  last_from_message_count   = clone_phenotype.last_from_message_count;
-  last_group_attack_count   = clone_phenotype.last_group_attack_count;
-  last_top_pred_group_attack_count   = clone_phenotype.last_top_pred_group_attack_count;
-  last_killed_targets      = clone_phenotype.last_killed_targets;
+  last().task_count        = clone_phenotype.last().task_count;
+  last().host_tasks        = clone_phenotype.last().host_tasks;
+  last().para_tasks        = clone_phenotype.last().para_tasks;
+  last().internal_task_count = clone_phenotype.last().internal_task_count;
+  last().rbins_total       = clone_phenotype.last().rbins_total;
+  last().rbins_avail       = clone_phenotype.last().rbins_avail;
+  last().collect_spec_counts = clone_phenotype.last().collect_spec_counts;
+  last().reaction_count    = clone_phenotype.last().reaction_count;
+  last().reaction_add_reward = clone_phenotype.last().reaction_add_reward;
+  last().inst_count        = clone_phenotype.last().inst_count;
+  last().from_sensor_count = clone_phenotype.last().from_sensor_count;
+  last().from_message_count = clone_phenotype.last().from_message_count;
+  last().group_attack_count = clone_phenotype.last().group_attack_count;
+  last().top_pred_group_attack_count = clone_phenotype.last().top_pred_group_attack_count;
+  last().killed_targets    = clone_phenotype.last().killed_targets;
   last_attacks             = clone_phenotype.last_attacks;
   last_kills                = clone_phenotype.last_kills;
-  last_sense_count         = clone_phenotype.last_sense_count;
+  last().sense_count       = clone_phenotype.last().sense_count;
   last_fitness             = CalcFitness(last_merit_base, last_bonus, gestation_time, last_cpu_cycles_used);
   last_child_germline_propensity = clone_phenotype.last_child_germline_propensity;
   
@@ -1519,7 +1432,7 @@ bool cPhenotype::TestOutput(cAvidaContext& ctx, cTaskContext& taskctx,
   cReactionResult& result = *m_reaction_result;
   
   // Run everything through the environment.
-  bool found = env.TestOutput(ctx, result, taskctx, eff_task_count, cur_reaction_count, res_in, rbins_in, 
+  bool found = env.TestOutput(ctx, result, taskctx, eff_task_count, cur().reaction_count, res_in, rbins_in, 
                               is_parasite, context_phenotype); //NEED different eff_task_count and cur_reaction_count for deme resource
   
   // If nothing was found, stop here.
@@ -1544,21 +1457,21 @@ bool cPhenotype::TestOutput(cAvidaContext& ctx, cTaskContext& taskctx,
     }
 
     if (result.TaskDone(i) == true) {
-      cur_task_count[i]++;
+      cur().task_count[i]++;
       eff_task_count[i]++;
       
       // Update parasite/host task tracking appropriately
       if (is_parasite) {
-        cur_para_tasks[i]++;
+        cur().para_tasks[i]++;
       }
       else {
-        cur_host_tasks[i]++;
+        cur().host_tasks[i]++;
       }
       
       if (context_phenotype != 0) {
         context_phenotype->GetTaskCounts()[i]++;
       }
-      if (result.UsedEnvResource() == false) { cur_internal_task_count[i]++; }
+      if (result.UsedEnvResource() == false) { cur().internal_task_count[i]++; }
       
       // if we want to generate an age-task histogram
       if (m_world->GetConfig().AGE_POLY_TRACKING.Get()) {
@@ -1567,32 +1480,32 @@ bool cPhenotype::TestOutput(cAvidaContext& ctx, cTaskContext& taskctx,
     }
     
     if (result.TaskQuality(i) > 0) {
-      cur_task_quality[i] += result.TaskQuality(i) * refract_factor;
+      cur().task_quality[i] += result.TaskQuality(i) * refract_factor;
       if (result.UsedEnvResource() == false) {
-        cur_internal_task_quality[i] += result.TaskQuality(i) * refract_factor;
+        cur().internal_task_quality[i] += result.TaskQuality(i) * refract_factor;
       }
     }
 
-    cur_task_value[i] = result.TaskValue(i);
+    cur().task_value[i] = result.TaskValue(i);
     cur_task_time[i] = cur_update_time; // Find out time from context
   }
 
   for (int i = 0; i < num_tasks; i++) {
-    if (result.TaskDone(i) && !last_task_count[i]) {
+    if (result.TaskDone(i) && !last().task_count[i]) {
       m_world->GetStats().AddNewTaskCount(i);
       int prev_num_tasks = 0;
       int cur_num_tasks = 0;
       for (int j=0; j< num_tasks; j++) {
-        if (last_task_count[j]>0) prev_num_tasks++;
-        if (cur_task_count[j]>0) cur_num_tasks++;
+        if (last().task_count[j]>0) prev_num_tasks++;
+        if (cur().task_count[j]>0) cur_num_tasks++;
       }
       m_world->GetStats().AddOtherTaskCounts(i, prev_num_tasks, cur_num_tasks);
     }
   }
   
   for (int i = 0; i < num_reactions; i++) {
-    cur_reaction_add_reward[i] += result.GetReactionAddBonus(i);
-    if (result.ReactionTriggered(i) && last_reaction_count[i]==0) {
+    cur().reaction_add_reward[i] += result.GetReactionAddBonus(i);
+    if (result.ReactionTriggered(i) && last().reaction_count[i]==0) {
       m_world->GetStats().AddNewReactionCount(i);
     }
     if (result.ReactionTriggered(i) == true) {
@@ -1607,7 +1520,7 @@ bool cPhenotype::TestOutput(cAvidaContext& ctx, cTaskContext& taskctx,
           break;
         }
         case 1: { // "learning" cost
-          int n_react = cur_reaction_count[i] -1;
+          int n_react = cur().reaction_count[i] -1;
           if (n_react < m_world->GetConfig().LEARNING_COUNT.Get()) {
             num_new_unique_reactions += ( m_world->GetConfig().LEARNING_COUNT.Get() - n_react);
           }
@@ -1690,8 +1603,8 @@ bool cPhenotype::TestOutput(cAvidaContext& ctx, cTaskContext& taskctx,
     double rbin_diff;
     for (int i = 0; i < num_resources; i++) {
       rbin_diff = result.GetInternalConsumed(i) - result.GetInternalProduced(i); ;
-      cur_rbins_avail[i] -= rbin_diff;
-      if(rbin_diff != 0) { cur_rbins_total[i] += rbin_diff; }
+      cur().rbins_avail[i] -= rbin_diff;
+      if(rbin_diff != 0) { cur().rbins_total[i] += rbin_diff; }
     }
   }
   
@@ -1743,22 +1656,22 @@ void cPhenotype::PrintStatus(ostream& fp) const
   << '\n';
   
   fp << "  Task Count (Quality):";
-  for (int i = 0; i < cur_task_count.GetSize(); i++) {
-    fp << " " << cur_task_count[i] << " (" << cur_task_quality[i] << ")";
+  for (int i = 0; i < cur().task_count.GetSize(); i++) {
+    fp << " " << cur().task_count[i] << " (" << cur().task_quality[i] << ")";
   }
   fp << '\n';
   
   // if using resoruce bins, print the relevant stats
   if (m_world->GetConfig().USE_RESOURCE_BINS.Get()) {
     fp << "  Used-Internal-Resources Task Count (Quality):";
-    for (int i = 0; i < cur_internal_task_count.GetSize(); i++) {
-      fp << " " << cur_internal_task_count[i] << " (" << cur_internal_task_quality[i] << ")";
+    for (int i = 0; i < cur().internal_task_count.GetSize(); i++) {
+      fp << " " << cur().internal_task_count[i] << " (" << cur().internal_task_quality[i] << ")";
     }
     fp << endl;
  		
     fp << "  Available Internal Resource Bin Contents (Total Ever Collected):";
-    for(int i = 0; i < cur_rbins_avail.GetSize(); i++) {
-      fp << " " << cur_rbins_avail[i] << " (" << cur_rbins_total[i] << ")";
+    for(int i = 0; i < cur().rbins_avail.GetSize(); i++) {
+      fp << " " << cur().rbins_avail[i] << " (" << cur().rbins_total[i] << ")";
     }
     fp << endl;
   }
@@ -1960,9 +1873,9 @@ int cPhenotype::CalcToleranceOffspringOthers()
 
 void cPhenotype::IncAttackedPreyFTData(int target_ft) {
   Apto::Array<int> target_list = m_world->GetEnvironment().GetAttackPreyFTList();
-  if (!cur_killed_targets.GetSize()) {
-    cur_killed_targets.Resize(target_list.GetSize());
-    cur_killed_targets.SetAll(0);
+  if (!cur().killed_targets.GetSize()) {
+    cur().killed_targets.Resize(target_list.GetSize());
+    cur().killed_targets.SetAll(0);
   }
   if (target_ft < -3) target_ft = -3;
   int this_index = target_ft;
@@ -1973,8 +1886,8 @@ void cPhenotype::IncAttackedPreyFTData(int target_ft) {
     }
   }
   assert(this_index >= 0);
-  assert(cur_killed_targets.GetSize() == target_list.GetSize());
-  cur_killed_targets[this_index]++;
+  assert(cur().killed_targets.GetSize() == target_list.GetSize());
+  cur().killed_targets[this_index]++;
 }
 
 void cPhenotype::ReduceEnergy(const double cost) {
@@ -2152,27 +2065,9 @@ void cPhenotype::NewTrial()
   //TODO?  last_energy         = cur_energy_bonus;
   last_num_errors           = cur_num_errors;
   last_num_donates          = cur_num_donates;
-  last_task_count           = cur_task_count;
-  last_host_tasks           = cur_host_tasks;
-  last_para_tasks           = cur_para_tasks;
-  last_internal_task_count  = cur_internal_task_count;
-  last_task_quality         = cur_task_quality;
-  last_internal_task_quality= cur_internal_task_quality;
-  last_task_value			      = cur_task_value;
-  last_rbins_total          = cur_rbins_total;
-  last_rbins_avail          = cur_rbins_avail;
-  last_collect_spec_counts  = cur_collect_spec_counts;
-  last_reaction_count       = cur_reaction_count;
-  last_reaction_add_reward  = cur_reaction_add_reward;
-  last_inst_count           = cur_inst_count;
-  last_from_sensor_count    = cur_from_sensor_count;
-  last_from_message_count    = cur_from_message_count;
-  last_group_attack_count   = cur_group_attack_count;
-  last_killed_targets       = cur_killed_targets;
+  lockInCounts();
   last_attacks              = cur_attacks;
   last_kills                = cur_kills;
-  last_top_pred_group_attack_count    = cur_top_pred_group_attack_count;
-  last_sense_count          = cur_sense_count;
   
   // Reset cur values.
   cur_bonus       = m_world->GetConfig().DEFAULT_BONUS.Get();
@@ -2180,33 +2075,33 @@ void cPhenotype::NewTrial()
   cur_energy_bonus = 0.0;
   cur_num_errors  = 0;
   cur_num_donates  = 0;
-  cur_task_count.SetAll(0);
-  cur_host_tasks.SetAll(0);
-  cur_para_tasks.SetAll(0);
-  cur_internal_task_count.SetAll(0);
+  cur().task_count.SetAll(0);
+  cur().host_tasks.SetAll(0);
+  cur().para_tasks.SetAll(0);
+  cur().internal_task_count.SetAll(0);
   eff_task_count.SetAll(0);
-  cur_task_quality.SetAll(0);
-  cur_internal_task_quality.SetAll(0);
-  cur_task_value.SetAll(0);
-  cur_rbins_total.SetAll(0);
-  cur_rbins_avail.SetAll(0);
-  cur_collect_spec_counts.SetAll(0);
-  cur_reaction_count.SetAll(0);
+  cur().task_quality.SetAll(0);
+  cur().internal_task_quality.SetAll(0);
+  cur().task_value.SetAll(0);
+  cur().rbins_total.SetAll(0);
+  cur().rbins_avail.SetAll(0);
+  cur().collect_spec_counts.SetAll(0);
+  cur().reaction_count.SetAll(0);
   first_reaction_cycles.SetAll(-1);
   first_reaction_execs.SetAll(-1);
   cur_stolen_reaction_count.SetAll(0);
-  cur_reaction_add_reward.SetAll(0);
-  cur_inst_count.SetAll(0);
-  cur_from_sensor_count.SetAll(0);
-  cur_from_message_count.SetAll(0);
-  for (int r = 0; r < cur_group_attack_count.GetSize(); r++) {
-    cur_group_attack_count[r].SetAll(0);
-    cur_top_pred_group_attack_count[r].SetAll(0);
+  cur().reaction_add_reward.SetAll(0);
+  cur().inst_count.SetAll(0);
+  cur().from_sensor_count.SetAll(0);
+  cur().from_message_count.SetAll(0);
+  for (int r = 0; r < cur().group_attack_count.GetSize(); r++) {
+    cur().group_attack_count[r].SetAll(0);
+    cur().top_pred_group_attack_count[r].SetAll(0);
   }
-  cur_killed_targets.SetAll(0);
+  cur().killed_targets.SetAll(0);
   cur_attacks = 0;
   cur_kills = 0;
-  cur_sense_count.SetAll(0);
+  cur().sense_count.SetAll(0);
   //cur_trial_fitnesses.Resize(0); Don't throw out the trial fitnesses! @JEB
   trial_time_used = 0;
   trial_cpu_cycles_used = 0;
@@ -2434,7 +2329,7 @@ void cPhenotype::SetLastParasiteTaskCount(Apto::Array<int> oldParaPhenotype)
   
   for(int i=0;i<oldParaPhenotype.GetSize();i++)
   {
-    last_para_tasks[i] = oldParaPhenotype[i];
+    last().para_tasks[i] = oldParaPhenotype[i];
   }
 }
 
@@ -2443,13 +2338,13 @@ Apto::Array<int> cPhenotype::GetCumulativeReactionCount()
 { 
   if (m_world->GetConfig().DIVIDE_METHOD.Get() == 0) { 
     Apto::Array<int> cum_react;
-    for (int i=0; i<cur_reaction_count.GetSize(); ++i) 
+    for (int i=0; i<cur().reaction_count.GetSize(); ++i) 
     {
-      cum_react.Push(cur_reaction_count[i] + last_reaction_count[i]);
+      cum_react.Push(cur().reaction_count[i] + last().reaction_count[i]);
     }
 //    return (cur_reaction_count + last_reaction_count); 
     return cum_react;
   } else {
-    return cur_reaction_count;
+    return cur().reaction_count;
   }
 }
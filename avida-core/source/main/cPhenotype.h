@@ -109,38 +109,47 @@ private:
   int cur_num_errors;                         // Total instructions executed illeagally.
   int cur_num_donates;                        // Number of donations so far
 
-  Apto::Array<int> cur_task_count;                 // Total times each task was performed
-  Apto::Array<int> cur_para_tasks;                 // Total times each task was performed by the parasite @LZ
-  Apto::Array<int> cur_host_tasks;                 // Total times each task was done by JUST the host @LZ
-  Apto::Array<int> cur_internal_task_count;        // Total times each task was performed using internal resources
+  // Counters of the gestation in progress and as of the last divide.  There are two sets, sized together when the
+  // phenotype is set up, and m_cur_counts selects the current one; locking in the current counts at a divide just
+  // flips m_cur_counts, so that the last set is recycled as the new current set rather than copied into.
+  struct sGestationCounts
+  {
+    Apto::Array<int> task_count;                    // Total times each task was performed
+    Apto::Array<int> para_tasks;                    // Total times each task was performed by the parasite @LZ
+    Apto::Array<int> host_tasks;                    // Total times each task was done by JUST the host @LZ
+    Apto::Array<int> internal_task_count;           // Total times each task was performed using internal resources
+    Apto::Array<double> task_quality;               // Average (total?) quality with which each task was performed
+    Apto::Array<double> task_value;                 // Value with which this phenotype performs task
+    Apto::Array<double> internal_task_quality;      // Average (total?) quaility with which each task using internal resources was performed
+    Apto::Array<double> rbins_total;                // Total amount of resources collected over the organism's life
+    Apto::Array<double> rbins_avail;                // Amount of internal resources available
+    Apto::Array<int> collect_spec_counts;           // How many times each nop-specification was used in a collect-type instruction
+    Apto::Array<int> reaction_count;                // Total times each reaction was triggered.
+    Apto::Array<double> reaction_add_reward;        // Bonus change from triggering each reaction.
+    Apto::Array<int> inst_count;                    // Instruction exection counter
+    Apto::Array<int> from_sensor_count;             // Use of inputs that originated from sensory data were used in execution of this instruction.
+    Apto::Array<int> from_message_count;            // Use of inputs that originated from messages were used in execution of this instruction.
+    Apto::Array< Apto::Array<int> > group_attack_count;
+    Apto::Array< Apto::Array<int> > top_pred_group_attack_count;
+    Apto::Array<int> killed_targets;
+    Apto::Array<int> sense_count;                   // Total times resource combinations have been sensed; @JEB
+  };
+  sGestationCounts m_counts[2];
+  int m_cur_counts;
+
   Apto::Array<int> eff_task_count;                 // Total times each task was performed (resetable during the life of the organism)
-  Apto::Array<double> cur_task_quality;            // Average (total?) quality with which each task was performed
-  Apto::Array<double> cur_task_value;              // Value with which this phenotype performs task
-  Apto::Array<double> cur_internal_task_quality;   // Average (total?) quaility with which each task using internal resources was performed
-  Apto::Array<double> cur_rbins_total;             // Total amount of resources collected over the organism's life
-  Apto::Array<double> cur_rbins_avail;             // Amount of internal resources available
-  Apto::Array<int> cur_collect_spec_counts;        // How many times each nop-specification was used in a collect-type instruction
-  Apto::Array<int> cur_reaction_count;             // Total times each reaction was triggered.
   Apto::Array<int> first_reaction_cycles;          // CPU cycles of first time reaction was triggered.
   Apto::Array<int> first_reaction_execs;            // Execution count at first time reaction was triggered (will be > cycles in parallel exec multithreaded orgs).
   Apto::Array<int> cur_stolen_reaction_count;      // Total counts of reactions stolen by predators.
-  Apto::Array<double> cur_reaction_add_reward;     // Bonus change from triggering each reaction.
-  Apto::Array<int> cur_inst_count;                 // Instruction exection counter
-  Apto::Array<int> cur_from_sensor_count;           // Use of inputs that originated from sensory data were used in execution of this instruction.
-  Apto::Array< Apto::Array<int> > cur_group_attack_count;
-  Apto::Array< Apto::Array<int> > cur_top_pred_group_attack_count;
-  Apto::Array<int> cur_killed_targets;
   int cur_attacks;
   int cur_kills;
   
-  Apto::Array<int> cur_sense_count;                // Total times resource combinations have been sensed; @JEB
   Apto::Array<double> sensed_resources;            // Resources which the organism has sensed; @JEB
   Apto::Array<double> cur_task_time;               // Time at which each task was last performed; WRE 03-18-07
   Apto::Map<void*, cTaskState*> m_task_states;
   Apto::Array<double> cur_trial_fitnesses;         // Fitnesses of various trials.; @JEB
   Apto::Array<double> cur_trial_bonuses;           // Bonuses of various trials.; @JEB
   Apto::Array<int> cur_trial_times_used;           // Time used in of various trials.; @JEB
-  Apto::Array<int> cur_from_message_count;           // Use of inputs that originated from messages were used in execution of this instruction.
 
   int trial_time_used;                        // like time_used, but reset every trial; @JEB
   int trial_cpu_cycles_used;                  // like cpu_cycles_used, but reset every trial; @JEB
@@ -166,30 +175,9 @@ private:
   double last_energy_bonus;
   int last_num_errors;
   int last_num_donates;
-
-  Apto::Array<int> last_task_count;
-  Apto::Array<int> last_para_tasks;
-  Apto::Array<int> last_host_tasks;                // Last task counts from hosts only, before last divide @LZ
-  Apto::Array<int> last_internal_task_count;
-  Apto::Array<double> last_task_quality;
-  Apto::Array<double> last_task_value;
-  Apto::Array<double> last_internal_task_quality;
-  Apto::Array<double> last_rbins_total;
-  Apto::Array<double> last_rbins_avail;
-  Apto::Array<int> last_collect_spec_counts;
-  Apto::Array<int> last_reaction_count;
-  Apto::Array<double> last_reaction_add_reward;
-  Apto::Array<int> last_inst_count;	  // Instruction exection counter
-  Apto::Array<int> last_from_sensor_count;
-  Apto::Array<int> last_sense_count;   // Total times resource combinations have been sensed; @JEB
-  Apto::Array< Apto::Array<int> > last_group_attack_count;
-  Apto::Array< Apto::Array<int> > last_top_pred_group_attack_count;
-  Apto::Array<int> last_killed_targets;
   int last_attacks;
   int last_kills;
 
-  Apto::Array<int> last_from_message_count;
-
   double last_fitness;            // Used to determine sterilization.
   int last_cpu_cycles_used;
   double cur_child_germline_propensity;   // chance of child being a germline cell; @JEB
@@ -314,9 +302,15 @@ private:
 
   inline void SetInstSetSize(int inst_set_size);
   inline void SetGroupAttackInstSetSize(int num_group_attack_inst);
+
+  inline sGestationCounts& cur() { return m_counts[m_cur_counts]; }
+  inline const sGestationCounts& cur() const { return m_counts[m_cur_counts]; }
+  inline sGestationCounts& last() { return m_counts[1 - m_cur_counts]; }
+  inline const sGestationCounts& last() const { return m_counts[1 - m_cur_counts]; }
+  inline void lockInCounts() { m_cur_counts = 1 - m_cur_counts; }
   
 public:
-  cPhenotype() : m_world(NULL), m_reaction_result(NULL) { ; } // Will not construct a valid cPhenotype! Only exists to support incorrect cDeme Apto::Array usage.
+  cPhenotype() : m_world(NULL), m_cur_counts(0), m_reaction_result(NULL) { ; } // Will not construct a valid cPhenotype! Only exists to support incorrect cDeme Apto::Array usage.
   cPhenotype(cWorld* world, int parent_generation, int num_nops);
 
 
@@ -366,8 +360,8 @@ public:
   }
   int CalcID() const {
     int phen_id = 0;
-    for (int i = 0; i < last_task_count.GetSize(); i++) {
-      if (last_task_count[i] > 0) phen_id += (1 << i);
+    for (int i = 0; i < last().task_count.GetSize(); i++) {
+      if (last().task_count[i] > 0) phen_id += (1 << i);
     }
     return phen_id;
   }
@@ -421,34 +415,34 @@ public:
   bool GetToDelete() const { assert(initialized == true); return to_delete; }
   int GetCurNumErrors() const { assert(initialized == true); return cur_num_errors; }
   int GetCurNumDonates() const { assert(initialized == true); return cur_num_donates; }
-  int GetCurCountForTask(int idx) const { assert(initialized == true); return cur_task_count[idx]; }
-  const Apto::Array<int>& GetCurTaskCount() const { assert(initialized == true); return cur_task_count; }
-  const Apto::Array<int>& GetCurHostTaskCount() const { assert(initialized == true); return cur_host_tasks; }
-  const Apto::Array<int>& GetCurParasiteTaskCount() const { assert(initialized == true); return cur_para_tasks; }
-  const Apto::Array<int>& GetCurInternalTaskCount() const { assert(initialized == true); return cur_internal_task_count; }
+  int GetCurCountForTask(int idx) const { assert(initialized == true); return cur().task_count[idx]; }
+  const Apto::Array<int>& GetCurTaskCount() const { assert(initialized == true); return cur().task_count; }
+  const Apto::Array<int>& GetCurHostTaskCount() const { assert(initialized == true); return cur().host_tasks; }
+  const Apto::Array<int>& GetCurParasiteTaskCount() const { assert(initialized == true); return cur().para_tasks; }
+  const Apto::Array<int>& GetCurInternalTaskCount() const { assert(initialized == true); return cur().internal_task_count; }
   void ClearEffTaskCount() { assert(initialized == true); eff_task_count.SetAll(0); }
-  const Apto::Array<double> & GetCurTaskQuality() const { assert(initialized == true); return cur_task_quality; }
-  const Apto::Array<double> & GetCurTaskValue() const { assert(initialized == true); return cur_task_value; }
-  const Apto::Array<double> & GetCurInternalTaskQuality() const { assert(initialized == true); return cur_internal_task_quality; }
-  const Apto::Array<double>& GetCurRBinsTotal() const { assert(initialized == true); return cur_rbins_total; }
-  double GetCurRBinTotal(int index) const { assert(initialized == true); return cur_rbins_total[index]; }
-  const Apto::Array<double>& GetCurRBinsAvail() const { assert(initialized == true); return cur_rbins_avail; }
-  double GetCurRBinAvail(int index) const { assert(initialized == true); return cur_rbins_avail[index]; }
-
-  const Apto::Array<int>& GetCurReactionCount() const { assert(initialized == true); return cur_reaction_count;}
+  const Apto::Array<double> & GetCurTaskQuality() const { assert(initialized == true); return cur().task_quality; }
+  const Apto::Array<double> & GetCurTaskValue() const { assert(initialized == true); return cur().task_value; }
+  const Apto::Array<double> & GetCurInternalTaskQuality() const { assert(initialized == true); return cur().internal_task_quality; }
+  const Apto::Array<double>& GetCurRBinsTotal() const { assert(initialized == true); return cur().rbins_total; }
+  double GetCurRBinTotal(int index) const { assert(initialized == true); return cur().rbins_total[index]; }
+  const Apto::Array<double>& GetCurRBinsAvail() const { assert(initialized == true); return cur().rbins_avail; }
+  double GetCurRBinAvail(int index) const { assert(initialized == true); return cur().rbins_avail[index]; }
+
+  const Apto::Array<int>& GetCurReactionCount() const { assert(initialized == true); return cur().reaction_count;}
   const Apto::Array<int>& GetFirstReactionCycles() const { assert(initialized == true); return first_reaction_cycles;}
   void SetFirstReactionCycle(int idx) { if (first_reaction_cycles[idx] < 0) first_reaction_cycles[idx] = time_used; }
   const Apto::Array<int>& GetFirstReactionExecs() const { assert(initialized == true); return first_reaction_execs;}
   void SetFirstReactionExec(int idx) { if (first_reaction_execs[idx] < 0) first_reaction_execs[idx] = num_execs; }
 
   const Apto::Array<int>& GetStolenReactionCount() const { assert(initialized == true); return cur_stolen_reaction_count;}
-  const Apto::Array<double>& GetCurReactionAddReward() const { assert(initialized == true); return cur_reaction_add_reward;}
-  const Apto::Array<int>& GetCurInstCount() const { assert(initialized == true); return cur_inst_count; }
-  const Apto::Array<int>& GetCurSenseCount() const { assert(initialized == true); return cur_sense_count; }
+  const Apto::Array<double>& GetCurReactionAddReward() const { assert(initialized == true); return cur().reaction_add_reward;}
+  const Apto::Array<int>& GetCurInstCount() const { assert(initialized == true); return cur().inst_count; }
+  const Apto::Array<int>& GetCurSenseCount() const { assert(initialized == true); return cur().sense_count; }
 
   double GetSensedResource(int _in) { assert(initialized == true); return sensed_resources[_in]; }
-  const Apto::Array<int>& GetCurCollectSpecCounts() const { assert(initialized == true); return cur_collect_spec_counts; }
-  int GetCurCollectSpecCount(int spec_id) const { assert(initialized == true); return cur_collect_spec_counts[spec_id]; }
+  const Apto::Array<int>& GetCurCollectSpecCounts() const { assert(initialized == true); return cur().collect_spec_counts; }
+  int GetCurCollectSpecCount(int spec_id) const { assert(initialized == true); return cur().collect_spec_counts[spec_id]; }
   const Apto::Array<int>& GetTestCPUInstCount() const { assert(initialized == true); return testCPU_inst_count; }
 
   void  NewTrial(); //Save the current fitness, and reset the bonus. @JEB
@@ -472,32 +466,32 @@ public:
   int GetLastNumErrors() const { assert(initialized == true); return last_num_errors; }
   int GetLastNumDonates() const { assert(initialized == true); return last_num_donates; }
 
-  int GetLastCountForTask(int idx) const { assert(initialized == true); return last_task_count[idx]; }
-  const Apto::Array<int>& GetLastTaskCount() const { assert(initialized == true); return last_task_count; }
-  void SetLastTaskCount(Apto::Array<int> tasks) { assert(initialized == true); last_task_count = tasks; }
-  const Apto::Array<int>& GetLastHostTaskCount() const { assert(initialized == true); return last_host_tasks; }
-  const Apto::Array<int>& GetLastParasiteTaskCount() const { assert(initialized == true); return last_para_tasks; }
+  int GetLastCountForTask(int idx) const { assert(initialized == true); return last().task_count[idx]; }
+  const Apto::Array<int>& GetLastTaskCount() const { assert(initialized == true); return last().task_count; }
+  void SetLastTaskCount(Apto::Array<int> tasks) { assert(initialized == true); last().task_count = tasks; }
+  const Apto::Array<int>& GetLastHostTaskCount() const { assert(initialized == true); return last().host_tasks; }
+  const Apto::Array<int>& GetLastParasiteTaskCount() const { assert(initialized == true); return last().para_tasks; }
   void  SetLastParasiteTaskCount(Apto::Array<int>  oldParaPhenotype);
-  const Apto::Array<int>& GetLastInternalTaskCount() const { assert(initialized == true); return last_internal_task_count; }
-  const Apto::Array<double>& GetLastTaskQuality() const { assert(initialized == true); return last_task_quality; }
-  const Apto::Array<double>& GetLastTaskValue() const { assert(initialized == true); return last_task_value; }
-  const Apto::Array<double>& GetLastInternalTaskQuality() const { assert(initialized == true); return last_internal_task_quality; }
-  const Apto::Array<double>& GetLastRBinsTotal() const { assert(initialized == true); return last_rbins_total; }
-  const Apto::Array<double>& GetLastRBinsAvail() const { assert(initialized == true); return last_rbins_avail; }
-  const Apto::Array<int>& GetLastReactionCount() const { assert(initialized == true); return last_reaction_count; }
-  const Apto::Array<double>& GetLastReactionAddReward() const { assert(initialized == true); return last_reaction_add_reward; }
-  const Apto::Array<int>& GetLastInstCount() const { assert(initialized == true); return last_inst_count; }
-  const Apto::Array<int>& GetLastFromSensorInstCount() const { assert(initialized == true); return last_from_sensor_count; }
-  const Apto::Array<int>& GetLastSenseCount() const { assert(initialized == true); return last_sense_count; }
-  const Apto::Array< Apto::Array<int> >& GetLastGroupAttackInstCount() const { assert(initialized == true); return last_group_attack_count; }
-  const Apto::Array< Apto::Array<int> >& GetLastTopPredGroupAttackInstCount() const { assert(initialized == true); return last_top_pred_group_attack_count; }
-
-  const Apto::Array<int>& GetLastFromMessageInstCount() const { assert(initialized == true); return last_from_message_count; }
+  const Apto::Array<int>& GetLastInternalTaskCount() const { assert(initialized == true); return last().internal_task_count; }
+  const Apto::Array<double>& GetLastTaskQuality() const { assert(initialized == true); return last().task_quality; }
+  const Apto::Array<double>& GetLastTaskValue() const { assert(initialized == true); return last().task_value; }
+  const Apto::Array<double>& GetLastInternalTaskQuality() const { assert(initialized == true); return last().internal_task_quality; }
+  const Apto::Array<double>& GetLastRBinsTotal() const { assert(initialized == true); return last().rbins_total; }
+  const Apto::Array<double>& GetLastRBinsAvail() const { assert(initialized == true); return last().rbins_avail; }
+  const Apto::Array<int>& GetLastReactionCount() const { assert(initialized == true); return last().reaction_count; }
+  const Apto::Array<double>& GetLastReactionAddReward() const { assert(initialized == true); return last().reaction_add_reward; }
+  const Apto::Array<int>& GetLastInstCount() const { assert(initialized == true); return last().inst_count; }
+  const Apto::Array<int>& GetLastFromSensorInstCount() const { assert(initialized == true); return last().from_sensor_count; }
+  const Apto::Array<int>& GetLastSenseCount() const { assert(initialized == true); return last().sense_count; }
+  const Apto::Array< Apto::Array<int> >& GetLastGroupAttackInstCount() const { assert(initialized == true); return last().group_attack_count; }
+  const Apto::Array< Apto::Array<int> >& GetLastTopPredGroupAttackInstCount() const { assert(initialized == true); return last().top_pred_group_attack_count; }
+
+  const Apto::Array<int>& GetLastFromMessageInstCount() const { assert(initialized == true); return last().from_message_count; }
 
   double GetLastFitness() const { assert(initialized == true); return last_fitness; }
   double GetPermanentGermlinePropensity() const { assert(initialized == true); return permanent_germline_propensity; }
-  const Apto::Array<int>& GetLastCollectSpecCounts() const { assert(initialized == true); return last_collect_spec_counts; }
-  int GetLastCollectSpecCount(int spec_id) const { assert(initialized == true); return last_collect_spec_counts[spec_id]; }
+  const Apto::Array<int>& GetLastCollectSpecCounts() const { assert(initialized == true); return last().collect_spec_counts; }
+  int GetLastCollectSpecCount(int spec_id) const { assert(initialized == true); return last().collect_spec_counts[spec_id]; }
 
   int GetNumDivides() const { assert(initialized == true); return num_divides;}
   int GetNumDivideFailed() const { assert(initialized == true); return num_divides_failed;}
@@ -621,7 +615,7 @@ public:
   int GetNumEnergyReceptions() { return num_energy_receptions; }
   int GetNumEnergyApplications() { return num_energy_applications; }
   
-  void SetReactionCount(int index, int val) { cur_reaction_count[index] = val; }
+  void SetReactionCount(int index, int val) { cur().reaction_count[index] = val; }
   void SetStolenReactionCount(int index, int val) { cur_stolen_reaction_count[index] = val; }
   
   bool GetKaboomExecuted() {return kaboom_executed;} //@AEJ
@@ -634,13 +628,13 @@ public:
   void SetHGTUptakeBonusExecuted(bool value) { hgt_uptake_bonus_executed = value; } //@RCK
 
 
-  void SetCurRBinsAvail(const Apto::Array<double>& in_avail) { cur_rbins_avail = in_avail; }
-  void SetCurRbinsTotal(const Apto::Array<double>& in_total) { cur_rbins_total = in_total; }
-  void SetCurRBinAvail(int index, double val) { cur_rbins_avail[index] = val; }
-  void SetCurRBinTotal(int index, double val) { cur_rbins_total[index] = val; }
-  void AddToCurRBinAvail(int index, double val) { cur_rbins_avail[index] += val; }
-  void AddToCurRBinTotal(int index, double val) { cur_rbins_total[index] += val; }
-  void SetCurCollectSpecCount(int spec_id, int val) { cur_collect_spec_counts[spec_id] = val; }
+  void SetCurRBinsAvail(const Apto::Array<double>& in_avail) { cur().rbins_avail = in_avail; }
+  void SetCurRbinsTotal(const Apto::Array<double>& in_total) { cur().rbins_total = in_total; }
+  void SetCurRBinAvail(int index, double val) { cur().rbins_avail[index] = val; }
+  void SetCurRBinTotal(int index, double val) { cur().rbins_total[index] = val; }
+  void AddToCurRBinAvail(int index, double val) { cur().rbins_avail[index] += val; }
+  void AddToCurRBinTotal(int index, double val) { cur().rbins_total[index] += val; }
+  void SetCurCollectSpecCount(int spec_id, int val) { cur().collect_spec_counts[spec_id] = val; }
 
   void SetMatingType(int _mating_type) { mating_type = _mating_type; } //@CHC
   void SetMatePreference(int _mate_preference) { mate_preference = _mate_preference; } //@CHC
@@ -679,13 +673,12 @@ public:
   void SetCurBonus(double _bonus) { cur_bonus = _bonus; }
   void SetCurBonusInstCount(int _num_bonus_inst) {bonus_instruction_count = _num_bonus_inst;}
 
-  void IncCurInstCount(int _inst_num)  { assert(initialized == true); cur_inst_count[_inst_num]++; } 
-  void DecCurInstCount(int _inst_num)  { assert(initialized == true); cur_inst_count[_inst_num]--; }
-  void IncCurFromSensorInstCount(int _inst_num)  { assert(initialized == true); cur_from_sensor_count[_inst_num]++; }
-  void IncCurGroupAttackInstCount(int _inst_num, int pack_size_idx)  { assert(initialized == true); cur_group_attack_count[_inst_num][pack_size_idx]++; }
-  void IncCurTopPredGroupAttackInstCount(int _inst_num, int pack_size_idx)  { assert(initialized == true); cur_top_pred_group_attack_count[_inst_num][pack_size_idx]++; }
+  void IncCurInstCount(int _inst_num)  { assert(initialized == true); cur().inst_count[_inst_num]++; } 
+  void DecCurInstCount(int _inst_num)  { assert(initialized == true); cur().inst_count[_inst_num]--; }
+  void IncCurFromSensorInstCount(int _inst_num)  { assert(initialized == true); cur().from_sensor_count[_inst_num]++; }
+  void IncCurGroupAttackInstCount(int _inst_num, int pack_size_idx)  { assert(initialized == true); cur().group_attack_count[_inst_num][pack_size_idx]++; }
+  void IncCurTopPredGroupAttackInstCount(int _inst_num, int pack_size_idx)  { assert(initialized == true); cur().top_pred_group_attack_count[_inst_num][pack_size_idx]++; }
   void IncAttackedPreyFTData(int target_ft);
-  Apto::Array<int> GetKilledPreyFTData() { return cur_killed_targets; }
   void IncAttacks() { cur_attacks++; }
   void IncKills() { cur_kills++; }
   int GetLastAttacks() const { return last_attacks; }
@@ -735,12 +728,12 @@ public:
   void  ResetNumNewUniqueReactions()  {num_new_unique_reactions =0; }
   double GetResourcesConsumed(); 
   Apto::Array<int> GetCumulativeReactionCount();
-  void IncCurFromMessageInstCount(int _inst_num)  { assert(initialized == true); cur_from_message_count[_inst_num]++; }
+  void IncCurFromMessageInstCount(int _inst_num)  { assert(initialized == true); cur().from_message_count[_inst_num]++; }
  
 
   // @LZ - Parasite Etc. Helpers
   void DivideFailed();
-  void UpdateParasiteTasks() { last_para_tasks = cur_para_tasks; cur_para_tasks.SetAll(0); return; }
+  void UpdateParasiteTasks() { last().para_tasks = cur().para_tasks; cur().para_tasks.SetAll(0); return; }
   
 
   void RefreshEnergy();
@@ -762,25 +755,22 @@ public:
 
 inline void cPhenotype::SetInstSetSize(int inst_set_size)
 {
-  cur_inst_count.Resize(inst_set_size, 0);
-  cur_from_sensor_count.Resize(inst_set_size, 0);
-  cur_from_message_count.Resize(inst_set_size, 0);
-  last_inst_count.Resize(inst_set_size, 0);
-  last_from_sensor_count.Resize(inst_set_size, 0);
-  last_from_message_count.Resize(inst_set_size, 0);
+  for (int i = 0; i < 2; i++) {
+    m_counts[i].inst_count.Resize(inst_set_size, 0);
+    m_counts[i].from_sensor_count.Resize(inst_set_size, 0);
+    m_counts[i].from_message_count.Resize(inst_set_size, 0);
+  }
 }
 
 inline void cPhenotype::SetGroupAttackInstSetSize(int num_group_attack_inst)
 {
-  last_group_attack_count.Resize(num_group_attack_inst);
-  last_top_pred_group_attack_count.Resize(num_group_attack_inst);
-  cur_group_attack_count.Resize(num_group_attack_inst);
-  cur_top_pred_group_attack_count.Resize(num_group_attack_inst);
-  for (int i = 0; i < last_group_attack_count.GetSize(); i++) {
-    last_group_attack_count[i].Resize(20, 0);
-    last_top_pred_group_attack_count[i].Resize(20, 0);
-    cur_group_attack_count[i].Resize(20, 0);
-    cur_top_pred_group_attack_count[i].Resize(20, 0);
+  for (int i = 0; i < 2; i++) {
+    m_counts[i].group_attack_count.Resize(num_group_attack_inst);
+    m_counts[i].top_pred_group_attack_count.Resize(num_group_attack_inst);
+    for (int j = 0; j < num_group_attack_inst; j++) {
+      m_counts[i].group_attack_count[j].Resize(20, 0);
+      m_counts[i].top_pred_group_attack_count[j].Resize(20, 0);
+    }
   }
 }
 
@@ -29,6 +29,7 @@
 #include "avida/data/Package.h"
 #include "avida/data/Util.h"
 #include "avida/output/File.h"
+#include "avida/output/Manager.h"
 #include "avida/systematics/Arbiter.h"
 #include "avida/systematics/Group.h"
 #include "avida/systematics/Manager.h"
@@ -36,6 +37,7 @@
 #include "avida/private/systematics/GenomeTestMetrics.h"
 #include "avida/private/systematics/Genotype.h"
 
+#include "apto/core/FileSystem.h"
 #include "apto/rng.h"
 #include "apto/scheduler.h"
 #include "apto/stat/Accumulator.h"
@@ -53,12 +55,14 @@
 #include "cInstSet.h"
 #include "cMigrationMatrix.h"   
 #include "cOrganism.h"
+#include "cOrganismStatsReducer.h"
 #include "cParasite.h"
 #include "cPhenotype.h"
 #include "cPopulationCell.h"
 #include "cResource.h"
 #include "cResourceCount.h"
 #include "cStats.h"
+#include "cSumTreeScheduler.h"
 #include "cTestCPU.h"
 #include "cTopology.h"
 #include "cWorld.h"
@@ -73,6 +77,7 @@
 #include <cfloat>
 #include <cmath>
 #include <climits>
+#include <cstring>
 #include <limits>
 
 using namespace std;
@@ -265,7 +270,9 @@ public:
 cPopulation::cPopulation(cWorld* world)  
 : m_world(world)
 , m_scheduler(NULL)
+, m_schedule_changes(0)
 , birth_chamber(world)
+, m_stats_reducer(NULL)
 , print_mini_trace_genomes(false)
 , use_micro_traces(false)
 , m_next_prey_q(0)
@@ -281,6 +288,8 @@ cPopulation::cPopulation(cWorld* world)
   world_x = world->GetConfig().WORLD_X.Get();
   world_y = world->GetConfig().WORLD_Y.Get();
   
+  m_stats_reducer = new cOrganismStatsReducer(world, world->GetConfig().STATS_THREADS.Get());
+  
   
   // Validate settings
   if (m_world->GetConfig().ENERGY_CAP.Get() == -1) m_world->GetConfig().ENERGY_CAP.Set(std::numeric_limits<double>::max());
@@ -400,6 +409,7 @@ void cPopulation::SetupCellGrid()
         assert(false);
     }
   }
+  m_neighborhoods.Setup(cell_array, deme_size_x, deme_size);
   
   BuildTimeSlicer();
   
@@ -604,6 +614,7 @@ cPopulation::~cPopulation()
 {
   for (int i = 0; i < cell_array.GetSize(); i++) delete cell_array[i].GetOrganism(); 
   delete m_scheduler;
+  delete m_stats_reducer;
 }
 
 
@@ -611,7 +622,10 @@ inline void cPopulation::AdjustSchedule(const cPopulationCell& cell, const cMeri
 {
   const int deme_id = cell.GetDemeID();
   const cDeme& deme = deme_array[deme_id];
-  m_scheduler->AdjustPriority(cell.GetID(), deme.HasDemeMerit() ? (merit.GetDouble() * deme.GetDemeMerit().GetDouble()) : merit.GetDouble());
+  const double priority = deme.HasDemeMerit() ? (merit.GetDouble() * deme.GetDemeMerit().GetDouble()) : merit.GetDouble();
+  m_scheduler->AdjustPriority(cell.GetID(), priority);
+  if (priority != m_schedule_priority[cell.GetID()]) m_schedule_changes++;
+  m_schedule_priority[cell.GetID()] = priority;
 }
 
 
@@ -5761,6 +5775,94 @@ void cPopulation::ProcessStepSpeculative(cAvidaContext& ctx, double step_size, i
   resource_count.Update(step_size);
 }
 
+// Execute up to num_steps consecutive CPU cycles of the organism in cell_id, performing the resource, deme and stats
+// bookkeeping once for the whole slice.  The slice ends early when the schedule changes; returns the cycles executed.
+int cPopulation::ProcessSlice(cAvidaContext& ctx, double step_size, int cell_id, int num_steps)
+{
+  assert(step_size > 0.0);
+  assert(cell_id < cell_array.GetSize());
+  assert(num_steps > 0);
+  
+  if (cell_id < 0) return 0;
+  
+  cPopulationCell& cell = GetCell(cell_id);
+  if (!cell.IsOccupied()) return 0;
+  
+  cOrganism* cur_org = cell.GetOrganism();
+  const int executed = cell.GetHardware()->ProcessSlice(ctx, num_steps);
+  
+  double merit = cur_org->GetPhenotype().GetMerit().GetDouble();
+  if (cur_org->GetPhenotype().GetToDelete() == true) {
+    cur_org->GetHardware().DeleteMiniTrace(print_mini_trace_reacs);
+    delete cur_org;
+  }
+  
+  m_world->GetStats().IncExecuted(executed);
+  GetDeme(cell.GetDemeID()).IncTimeUsed(merit, executed);
+  
+  const double slice_time = step_size * executed;
+  resource_count.Update(slice_time);
+  for (int i = 0; i < GetNumDemes(); i++) GetDeme(i).Update(slice_time);
+  
+  if (GetNumDemes() >= 1) CheckImplicitDemeRepro(GetDeme(cell.GetDemeID()), ctx);
+  
+  return executed;
+}
+
+
+// Draw the schedule for an update, then hand each scheduled organism all of its cycles at once, in the order of first
+// selection.  The number of cycles awarded to each organism follows the same distribution as scheduling one cycle at
+// a time.  Any birth, death or merit change ends the running slice, and the cycles that were drawn for organisms that
+// have since been replaced or changed merit (including the rest of that slice) are drawn again from the schedule as it
+// stands once the round is done.  Organisms born during an update therefore only share in those redrawn cycles.
+void cPopulation::ProcessUpdateSlices(cAvidaContext& ctx, int update_size)
+{
+  if (update_size <= 0) return;
+  const double step_size = 1.0 / (double)update_size;
+  
+  if (m_slice_counts.GetSize() != cell_array.GetSize()) {
+    m_slice_counts.ResizeClear(cell_array.GetSize());
+    m_slice_counts.SetAll(0);
+    m_slice_org_ids.ResizeClear(cell_array.GetSize());
+    m_slice_priority.ResizeClear(cell_array.GetSize());
+  }
+  
+  int num_cycles = update_size;
+  while (num_cycles > 0 && num_organisms > 0) {
+    m_slice_order.Resize(0);
+    for (int i = 0; i < num_cycles; i++) {
+      const int cell_id = ScheduleOrganism();
+      if (cell_id < 0) break;
+      if (m_slice_counts[cell_id]++ == 0) {
+        m_slice_order.Push(cell_id);
+        m_slice_org_ids[cell_id] = cell_array[cell_id].IsOccupied() ? cell_array[cell_id].GetOrganism()->GetID() : -1;
+        m_slice_priority[cell_id] = m_schedule_priority[cell_id];
+      }
+    }
+    if (m_slice_order.GetSize() == 0) break;
+    
+    int unused = 0;
+    for (int i = 0; i < m_slice_order.GetSize(); i++) {
+      const int cell_id = m_slice_order[i];
+      const int num_steps = m_slice_counts[cell_id];
+      m_slice_counts[cell_id] = 0;
+      
+      cPopulationCell& cell = cell_array[cell_id];
+      if (num_organisms == 0 || !cell.IsOccupied() || cell.GetOrganism()->GetID() != m_slice_org_ids[cell_id] ||
+          m_schedule_priority[cell_id] != m_slice_priority[cell_id]) {
+        unused += num_steps;
+        continue;
+      }
+      unused += num_steps - ProcessSlice(ctx, step_size, cell_id, num_steps);
+    }
+    
+    // The first slice of a round always runs, unless the schedule handed out empty cells
+    if (unused == num_cycles) break;
+    num_cycles = unused;
+  }
+}
+
+
 // Loop through all the demes getting stats and doing calculations
 // which must be done on a deme by deme basis.
 void cPopulation::UpdateDemeStats(cAvidaContext& ctx) { 
@@ -5844,176 +5946,36 @@ void cPopulation::UpdateOrganismStats(cAvidaContext& ctx)
   stats.ZeroReactions();
   
   for (int osp_idx = 0; osp_idx < m_org_stat_providers.GetSize(); osp_idx++) m_org_stat_providers[osp_idx]->UpdateReset();
-
-  // Counts...
-  int num_breed_true = 0;
-  int num_parasites = 0;
-  int num_no_birth = 0;
-  int num_multi_thread = 0;
-  int num_single_thread = 0;
-  int num_threads = 0;
-  int num_modified = 0;
-  
-  // Maximums...
-  cMerit max_merit(0);
-  double max_fitness = 0;
-  int max_gestation_time = 0;
-  int max_genome_length = 0;
-  
-  // Minimums...
-  cMerit min_merit(FLT_MAX);
-  double min_fitness = FLT_MAX;
-  int min_gestation_time = INT_MAX;
-  int min_genome_length = INT_MAX;
   
-  for (int i = 0; i < live_org_list.GetSize(); i++) {  
-    cOrganism* organism = live_org_list[i];
-    
-    for (int osp_idx = 0; osp_idx < m_org_stat_providers.GetSize(); osp_idx++) {
-      m_org_stat_providers[osp_idx]->HandleOrganism(organism);
-    }
-    
-    const cPhenotype& phenotype = organism->GetPhenotype();
-    const cMerit cur_merit = phenotype.GetMerit();
-    const double cur_fitness = phenotype.GetFitness();
-    const int cur_gestation_time = phenotype.GetGestationTime();
-    const int cur_genome_length = phenotype.GetGenomeLength();
-    
-    Apto::Array<Apto::Stat::Accumulator<int> >& from_message_exec_counts = stats.InstFromMessageExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue());
-    for (int j = 0; j < phenotype.GetLastFromMessageInstCount().GetSize(); j++) {
-      from_message_exec_counts[j].Add(organism->GetPhenotype().GetLastFromMessageInstCount()[j]);
-    }
-
-    stats.SumFitness().Add(cur_fitness);
-    stats.SumLogFitness().Add(log(cur_fitness));
-    stats.SumMerit().Add(cur_merit.GetDouble());
-    stats.SumGestation().Add(phenotype.GetGestationTime());
-    stats.SumCreatureAge().Add(phenotype.GetAge());
-    stats.SumGeneration().Add(phenotype.GetGeneration());
-    stats.SumNeutralMetric().Add(phenotype.GetNeutralMetric());
-    stats.SumLineageLabel().Add(organism->GetLineageLabel());
-    stats.SumCopyMutRate().Push(organism->MutationRates().GetCopyMutProb());
-    stats.SumLogCopyMutRate().Push(log(organism->MutationRates().GetCopyMutProb()));
-    stats.SumDivMutRate().Push(organism->MutationRates().GetDivMutProb() / organism->GetPhenotype().GetDivType());
-    stats.SumLogDivMutRate().Push(log(organism->MutationRates().GetDivMutProb() / organism->GetPhenotype().GetDivType()));
-    stats.SumCopySize().Add(phenotype.GetCopiedSize());
-    stats.SumExeSize().Add(phenotype.GetExecutedSize());
-    
-    if (cur_merit > max_merit) max_merit = cur_merit;
-    if (cur_fitness > max_fitness) max_fitness = cur_fitness;
-    if (cur_gestation_time > max_gestation_time) max_gestation_time = cur_gestation_time;
-    if (cur_genome_length > max_genome_length) max_genome_length = cur_genome_length;
-    
-    if (cur_merit < min_merit) min_merit = cur_merit;
-    if (cur_fitness < min_fitness) min_fitness = cur_fitness;
-    if (cur_gestation_time < min_gestation_time) min_gestation_time = cur_gestation_time;
-    if (cur_genome_length < min_genome_length) min_genome_length = cur_genome_length;
-    
-    // Test what tasks this creatures has completed.
-    for (int j = 0; j < m_world->GetEnvironment().GetNumTasks(); j++) {
-      if (phenotype.GetCurTaskCount()[j] > 0) {
-        stats.AddCurTask(j);
-        stats.AddCurTaskQuality(j, phenotype.GetCurTaskQuality()[j]);
-      }
+  // Stats that call out of the organism are gathered serially, and only when something asks for them...
+  const bool collect_message_inst = m_world->GetConfig().STATS_MESSAGE_INST.Get();
+  const bool collect_env_test = stats.ShouldCollectEnvTestStats();
+  if (m_org_stat_providers.GetSize() || collect_message_inst || collect_env_test) {
+    for (int i = 0; i < live_org_list.GetSize(); i++) {  
+      cOrganism* organism = live_org_list[i];
       
-      if (phenotype.GetLastTaskCount()[j] > 0) {
-        stats.AddLastTask(j);
-        stats.AddLastTaskQuality(j, phenotype.GetLastTaskQuality()[j]);
-        stats.IncTaskExeCount(j, phenotype.GetLastTaskCount()[j]);
+      for (int osp_idx = 0; osp_idx < m_org_stat_providers.GetSize(); osp_idx++) {
+        m_org_stat_providers[osp_idx]->HandleOrganism(organism);
       }
       
-      if (phenotype.GetCurHostTaskCount()[j] > 0) {
-        stats.AddCurHostTask(j);
+      if (collect_message_inst) {
+        const Apto::Array<int>& from_message_counts = organism->GetPhenotype().GetLastFromMessageInstCount();
+        Apto::Array<Apto::Stat::Accumulator<int> >& from_message_exec_counts = stats.InstFromMessageExeCountsForInstSet((const char*)organism->GetGenome().Properties().Get(s_prop_id_instset).StringValue());
+        for (int j = 0; j < from_message_counts.GetSize(); j++) from_message_exec_counts[j].Add(from_message_counts[j]);
       }
       
-      if (phenotype.GetLastHostTaskCount()[j] > 0) {
-        stats.AddLastHostTask(j);
-      }
-      
-      if (phenotype.GetCurParasiteTaskCount()[j] > 0) {
-        stats.AddCurParasiteTask(j);
-      }
-      
-      if (phenotype.GetLastParasiteTaskCount()[j] > 0) {
-        stats.AddLastParasiteTask(j);
-      }
-      
-      if (phenotype.GetCurInternalTaskCount()[j] > 0) {
-        stats.AddCurInternalTask(j);
-        stats.AddCurInternalTaskQuality(j, phenotype.GetCurInternalTaskQuality()[j]);
-      }
-      
-      if (phenotype.GetLastInternalTaskCount()[j] > 0) {
-        stats.AddLastInternalTask(j);
-        stats.AddLastInternalTaskQuality(j, phenotype.GetLastInternalTaskQuality()[j]);
-      }
-    }
-
-    if (stats.ShouldCollectEnvTestStats()) {
-      Systematics::GroupPtr genotype = organism->SystematicsGroup("genotype");
-      Systematics::GenomeTestMetricsPtr metrics(Systematics::GenomeTestMetrics::GetMetrics(m_world, ctx, genotype));
-      const Apto::Array<int>& test_task_counts = metrics->GetTaskCounts();
-      
-      for (int j = 0; j < m_world->GetEnvironment().GetNumTasks(); j++) if (test_task_counts[j] > 0) stats.AddTestTask(j);
-    }
-    
-    
-    // Record what add bonuses this organism garnered for different reactions
-    for (int j = 0; j < m_world->GetEnvironment().GetNumReactions(); j++) {
-      if (phenotype.GetCurReactionCount()[j] > 0) {
-        stats.AddCurReaction(j);
-        stats.AddCurReactionAddReward(j, phenotype.GetCurReactionAddReward()[j]);
-      }
-      
-      if (phenotype.GetLastReactionCount()[j] > 0) {
-        stats.AddLastReaction(j);
-        stats.IncReactionExeCount(j, phenotype.GetLastReactionCount()[j]);
-        stats.AddLastReactionAddReward(j, phenotype.GetLastReactionAddReward()[j]);
-      }
-    }
-    
-    // Test what resource combinations this creature has sensed
-    for (int j = 0; j < stats.GetSenseSize(); j++) {
-      if (phenotype.GetLastSenseCount()[j] > 0) {
-        stats.AddLastSense(j);
-        stats.IncLastSenseExeCount(j, phenotype.GetLastSenseCount()[j]);
+      if (collect_env_test) {
+        Systematics::GroupPtr genotype = organism->SystematicsGroup("genotype");
+        Systematics::GenomeTestMetricsPtr metrics(Systematics::GenomeTestMetrics::GetMetrics(m_world, ctx, genotype));
+        const Apto::Array<int>& test_task_counts = metrics->GetTaskCounts();
+        
+        for (int j = 0; j < m_world->GetEnvironment().GetNumTasks(); j++) if (test_task_counts[j] > 0) stats.AddTestTask(j);
       }
     }
-    
-    // Increment the counts for all qualities the organism has...
-    num_parasites += organism->GetNumParasites();
-    if (phenotype.ParentTrue()) num_breed_true++;
-    if (phenotype.GetNumDivides() == 0) num_no_birth++;
-    if (phenotype.IsMultiThread()) num_multi_thread++;
-    else num_single_thread++;
-    
-    if (phenotype.IsModified()) num_modified++;
-    
-    cHardwareBase& hardware = organism->GetHardware();
-    stats.SumMemSize().Add(hardware.GetMemory().GetSize());
-    num_threads += hardware.GetNumThreads();
-    
-    // Increment the age of this organism.
-    organism->GetPhenotype().IncAge();
   }
   
-  stats.SetBreedTrueCreatures(num_breed_true);
-  stats.SetNumNoBirthCreatures(num_no_birth);
-  stats.SetNumParasites(num_parasites);
-  stats.SetNumSingleThreadCreatures(num_single_thread);
-  stats.SetNumMultiThreadCreatures(num_multi_thread);
-  stats.SetNumThreads(num_threads);
-  stats.SetNumModified(num_modified);
-  
-  stats.SetMaxMerit(max_merit.GetDouble());
-  stats.SetMaxFitness(max_fitness);
-  stats.SetMaxGestationTime(max_gestation_time);
-  stats.SetMaxGenomeLength(max_genome_length);
-  
-  stats.SetMinMerit(min_merit.GetDouble());
-  stats.SetMinFitness(min_fitness);
-  stats.SetMinGestationTime(min_gestation_time);
-  stats.SetMinGenomeLength(min_genome_length);
+  // ...everything else is read from the organisms alone, and may be spread across threads
+  m_stats_reducer->Reduce(live_org_list);
   
   resource_count.UpdateGlobalResources(ctx);   
 }
@@ -6305,13 +6267,141 @@ bool cPopulation::SaveHGTFragments(const cString& filename) {
 
 
 
-bool cPopulation::SavePopulation(const cString& filename, bool save_historic, bool save_groupings, bool save_avatars, bool save_rebirth)
+// Binary population checkpoints
+//
+// Layout (all values in native byte order, verified on load by the byte order marker):
+//   header   - magic "AVIDAPOP", int version, int byte order marker, int flags, int world x, int world y,
+//              int genotype count
+//   genotype - int property count, followed by (string key, string value) pairs as written by LegacySaveProperties,
+//              int organism count, int parasite flag, followed by one contiguous array (organism count long) for
+//              each of the per-organism columns selected by flags, in the order written by writeBinaryPopulation
+//   string   - int length followed by the raw characters (no terminator)
+//
+// Historic genotypes are stored as genotype records with an organism count of zero.
+
+static const char BINARY_POP_MAGIC[8] = { 'A', 'V', 'I', 'D', 'A', 'P', 'O', 'P' };
+static const int BINARY_POP_VERSION = 1;
+static const int BINARY_POP_BYTE_ORDER = 0x01020304;
+
+enum {
+  BINARY_POP_GROUPS = 1 << 0,   // group id, forager type, birth cell
+  BINARY_POP_AVATARS = 1 << 1,  // avatar cell, avatar birth cell
+  BINARY_POP_REBIRTH = 1 << 2   // all of the above, plus parent forager type, parent teacher and parent merit
+};
+
+class cBinaryPopWriter
 {
-  Apto::String file_path((const char*)filename);
-  Avida::Output::FilePtr df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), file_path);
-  df->SetFileType("genotype_data");
-  df->WriteComment("Structured Population Save");
-  df->WriteTimeStamp();
+private:
+  std::ofstream m_fp;
+  
+public:
+  cBinaryPopWriter(const char* path) : m_fp(path, std::ios::out | std::ios::binary | std::ios::trunc) { ; }
+  
+  bool Good() const { return m_fp.good(); }
+  
+  void WriteRaw(const char* data, int size) { m_fp.write(data, size); }
+  void WriteInt(int value) { m_fp.write(reinterpret_cast<const char*>(&value), sizeof(int)); }
+  void WriteString(const Apto::String& str)
+  {
+    WriteInt(str.GetSize());
+    if (str.GetSize()) m_fp.write((const char*)str, str.GetSize());
+  }
+  void WriteProperties(const Apto::Map<Apto::String, Apto::String>& props)
+  {
+    WriteInt(props.GetSize());
+    for (Apto::Map<Apto::String, Apto::String>::ConstIterator it = props.Begin(); it.Next();) {
+      WriteString(it.Get()->Value1());
+      WriteString(*it.Get()->Value2());
+    }
+  }
+  
+  template <typename T> void WriteColumn(const Apto::Array<sOrgInfo>& orgs, T sOrgInfo::* field)
+  {
+    // Gather the column into a contiguous block so that it is written (and later read) with a single call
+    Apto::Array<T> column(orgs.GetSize());
+    for (int i = 0; i < orgs.GetSize(); i++) column[i] = orgs[i].*field;
+    if (column.GetSize()) m_fp.write(reinterpret_cast<const char*>(&column[0]), sizeof(T) * column.GetSize());
+  }
+};
+
+
+static bool writeBinaryPopulation(cWorld* world, const cString& filename, Apto::Map<int, sGroupInfo*>& genotype_map,
+                                  bool save_historic, int flags)
+{
+  Apto::String file_path = Avida::Output::Manager::Of(world->GetNewWorld())->OutputIDFromPath(Apto::String((const char*)filename));
+  if (file_path.GetSize() == 0) return false;
+  cBinaryPopWriter fp((const char*)file_path);
+  if (!fp.Good()) {
+    world->GetDriver().Feedback().Error("unable to open file '%s' for writing", (const char*)filename);
+    return false;
+  }
+  
+  Apto::Array<Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > > historic;
+  if (save_historic) {
+    Systematics::Manager::Of(world->GetNewWorld())->ArbiterForRole("genotype")->LegacySaveProperties(&historic);
+  }
+  
+  fp.WriteRaw(BINARY_POP_MAGIC, sizeof(BINARY_POP_MAGIC));
+  fp.WriteInt(BINARY_POP_VERSION);
+  fp.WriteInt(BINARY_POP_BYTE_ORDER);
+  fp.WriteInt(flags);
+  fp.WriteInt(world->GetConfig().WORLD_X.Get());
+  fp.WriteInt(world->GetConfig().WORLD_Y.Get());
+  fp.WriteInt(genotype_map.GetSize() + historic.GetSize());
+  
+  const bool has_groups = (flags & (BINARY_POP_GROUPS | BINARY_POP_REBIRTH));
+  const bool has_avatars = (flags & (BINARY_POP_AVATARS | BINARY_POP_REBIRTH));
+  const bool has_rebirth = (flags & BINARY_POP_REBIRTH);
+  
+  for (Apto::Map<int, sGroupInfo*>::ValueIterator it = genotype_map.Values(); it.Next();) {
+    sGroupInfo* group_info = *it.Get();
+    Apto::Map<Apto::String, Apto::String> props;
+    group_info->bg->LegacySaveProperties(&props);
+    fp.WriteProperties(props);
+    
+    const Apto::Array<sOrgInfo>& orgs = group_info->orgs;
+    fp.WriteInt(orgs.GetSize());
+    fp.WriteInt(group_info->parasite);
+    fp.WriteColumn(orgs, &sOrgInfo::cell_id);
+    fp.WriteColumn(orgs, &sOrgInfo::offset);
+    fp.WriteColumn(orgs, &sOrgInfo::lineage_label);
+    if (has_groups) {
+      fp.WriteColumn(orgs, &sOrgInfo::curr_group);
+      fp.WriteColumn(orgs, &sOrgInfo::curr_forage);
+      fp.WriteColumn(orgs, &sOrgInfo::birth_cell);
+    }
+    if (has_avatars) {
+      fp.WriteColumn(orgs, &sOrgInfo::avatar_cell);
+      fp.WriteColumn(orgs, &sOrgInfo::av_bcell);
+    }
+    if (has_rebirth) {
+      fp.WriteColumn(orgs, &sOrgInfo::parent_ft);
+      fp.WriteColumn(orgs, &sOrgInfo::parent_is_teacher);
+      fp.WriteColumn(orgs, &sOrgInfo::parent_merit);
+    }
+  }
+  
+  for (int i = 0; i < historic.GetSize(); i++) {
+    fp.WriteProperties(*historic[i]);
+    fp.WriteInt(0);
+    fp.WriteInt(0);
+  }
+  
+  return fp.Good();
+}
+
+
+bool cPopulation::SavePopulation(const cString& filename, bool save_historic, bool save_groupings, bool save_avatars, bool save_rebirth,
+                                 bool save_binary)
+{
+  Avida::Output::FilePtr df;
+  if (!save_binary) {
+    Apto::String file_path((const char*)filename);
+    df = Avida::Output::File::CreateWithPath(m_world->GetNewWorld(), file_path);
+    df->SetFileType("genotype_data");
+    df->WriteComment("Structured Population Save");
+    df->WriteTimeStamp();
+  }
   
   // Build up hash table of all current genotypes and the cells in which the organisms reside
   Apto::Map<int, sGroupInfo*> genotype_map;
@@ -6408,6 +6498,18 @@ bool cPopulation::SavePopulation(const cString& filename, bool save_historic, bo
     }
   }
   
+  if (save_binary) {
+    int flags = 0;
+    if (save_rebirth) flags |= BINARY_POP_REBIRTH;
+    else {
+      if (save_groupings) flags |= BINARY_POP_GROUPS;
+      if (save_avatars) flags |= BINARY_POP_AVATARS;
+    }
+    bool success = writeBinaryPopulation(m_world, filename, genotype_map, save_historic, flags);
+    for (Apto::Map<int, sGroupInfo*>::ValueIterator it = genotype_map.Values(); it.Next();) delete *it.Get();
+    return success;
+  }
+  
   // Output all current genotypes
   for (Apto::Map<int, sGroupInfo*>::ValueIterator it = genotype_map.Values(); it.Next();) {
     sGroupInfo* group_info = *it.Get();
@@ -6760,139 +6862,401 @@ bool cPopulation::LoadHGTDonorList(const cString& filename, cAvidaContext& ctx)
   return true;
 }
 
-bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, int cellid_offset, int lineage_offset, bool load_groups, bool load_birth_cells, bool load_avatars, bool load_rebirth, bool load_parent_dat, int traceq)
+static bool isBinaryPopulation(const cString& path)
 {
-  // @TODO - build in support for verifying population dimensions
+  std::ifstream fp((const char*)path, std::ios::in | std::ios::binary);
+  char magic[sizeof(BINARY_POP_MAGIC)];
+  if (!fp.read(magic, sizeof(magic))) return false;
+  return (memcmp(magic, BINARY_POP_MAGIC, sizeof(magic)) == 0);
+}
+
+class cBinaryPopReader
+{
+private:
+  static const int CHUNK_SIZE = 1 << 20;
+  
+  std::ifstream m_fp;
+  long long m_size;       // of the whole file
+  long long m_pos;        // file offset of the next byte to be read
+  Apto::Array<char> m_chunk;
+  int m_chunk_pos;
+  int m_chunk_end;
+  bool m_ok;
+  bool m_truncated;
+  
+  // Copies the next size bytes into dest, or skips over them when dest is NULL.  Reads never run past the size the
+  // file had when it was opened; asking for more marks the file as truncated.
+  bool read(char* dest, long long size)
+  {
+    if (!m_ok) return false;
+    if (size < 0 || size > m_size - m_pos) {
+      m_ok = false;
+      m_truncated = true;
+      return false;
+    }
+    while (size > 0) {
+      if (m_chunk_pos == m_chunk_end) {
+        if (dest == NULL && size >= CHUNK_SIZE) {
+          m_fp.seekg(size, std::ios::cur);
+          m_pos += size;
+          m_ok = !m_fp.fail();
+          return m_ok;
+        }
+        m_fp.read(&m_chunk[0], CHUNK_SIZE);
+        m_chunk_pos = 0;
+        m_chunk_end = static_cast<int>(m_fp.gcount());
+        if (m_fp.bad() || m_chunk_end == 0) {
+          m_ok = false;
+          m_truncated = !m_fp.bad();  // the file shrank since it was opened
+          return false;
+        }
+        m_fp.clear();  // a short final chunk sets eof, which would fail any later seek
+      }
+      const int count = (size < m_chunk_end - m_chunk_pos) ? static_cast<int>(size) : (m_chunk_end - m_chunk_pos);
+      if (dest) {
+        memcpy(dest, &m_chunk[m_chunk_pos], count);
+        dest += count;
+      }
+      m_chunk_pos += count;
+      m_pos += count;
+      size -= count;
+    }
+    return true;
+  }
   
-  cInitFile input_file(filename, m_world->GetWorkingDir(), ctx.Driver().Feedback());
-  if (!input_file.WasOpened()) return false;
+public:
+  cBinaryPopReader() : m_size(0), m_pos(0), m_chunk_pos(0), m_chunk_end(0), m_ok(false), m_truncated(false) { ; }
   
-  // Clear out the population, unless an offset is being used
-  if (cellid_offset == 0) {
-    for (int i = 0; i < cell_array.GetSize(); i++) KillOrganism(cell_array[i], ctx); 
+  // Checkpoints may be many gigabytes, so they are read in fixed size chunks rather than held in memory
+  bool Open(const char* path)
+  {
+    m_fp.open(path, std::ios::in | std::ios::binary);
+    if (!m_fp.is_open()) return false;
+    m_fp.seekg(0, std::ios::end);
+    const std::streamoff size = m_fp.tellg();
+    m_fp.seekg(0, std::ios::beg);
+    if (size < 0 || m_fp.fail()) return false;
+    m_size = size;
+    m_pos = 0;
+    m_chunk.Resize(CHUNK_SIZE);
+    m_chunk_pos = 0;
+    m_chunk_end = 0;
+    m_ok = true;
+    m_truncated = false;
+    return true;
   }
   
-  // First, we read in all the genotypes and store them in an array
-  Apto::Array<sTmpGenotype, Apto::ManagedPointer> genotypes(input_file.GetNumLines());
+  bool Good() const { return m_ok; }
+  bool Truncated() const { return m_truncated; }
+  long long GetSize() const { return m_size; }
+  long long GetPos() const { return m_pos; }
+  
+  bool ReadMagic()
+  {
+    char magic[sizeof(BINARY_POP_MAGIC)];
+    return (read(magic, sizeof(magic)) && memcmp(magic, BINARY_POP_MAGIC, sizeof(BINARY_POP_MAGIC)) == 0);
+  }
+  int ReadInt()
+  {
+    int value = 0;
+    if (!read(reinterpret_cast<char*>(&value), sizeof(int))) return 0;
+    return value;
+  }
+  Apto::String ReadString()
+  {
+    const int size = ReadInt();
+    if (size <= 0) {
+      if (size < 0) read(NULL, -1);
+      return Apto::String();
+    }
+    Apto::Array<char> data(size);
+    if (!read(&data[0], size)) return Apto::String();
+    return Apto::String((const char*)cString(&data[0], size));
+  }
+  void ReadProperties(Apto::Map<Apto::String, Apto::String>& props)
+  {
+    const int num_props = ReadInt();
+    for (int i = 0; i < num_props && m_ok; i++) {
+      Apto::String key = ReadString();
+      props.Set(key, ReadString());
+    }
+  }
+  
+  template <typename T> void ReadColumn(Apto::Array<T>& column, int count)
+  {
+    // Check the size against the file before allocating, so that a corrupt count cannot request a huge column
+    const long long size = static_cast<long long>(sizeof(T)) * count;
+    if (count < 0 || size > m_size - m_pos) {
+      read(NULL, -1);
+      return;
+    }
+    column.Resize(count);
+    if (count) read(reinterpret_cast<char*>(&column[0]), size);
+  }
+  template <typename T> void SkipColumn(int count) { read(NULL, static_cast<long long>(sizeof(T)) * count); }
+};
+
+static bool readBinaryPopulation(cWorld* world, const cString& path, Apto::Array<sTmpGenotype, Apto::ManagedPointer>& genotypes,
+                                 bool load_groups, bool load_birth_cells, bool load_avatars, bool load_rebirth,
+                                 bool load_parent_dat)
+{
+  Feedback& feedback = world->GetDriver().Feedback();
   
+  cBinaryPopReader fp;
+  if (!fp.Open((const char*)path)) {
+    feedback.Error("unable to open binary population file '%s'", (const char*)path);
+    return false;
+  }
+  if (!fp.ReadMagic()) {
+    feedback.Error("unable to read binary population file '%s'", (const char*)path);
+    return false;
+  }
+  const int version = fp.ReadInt();
+  if (version != BINARY_POP_VERSION || fp.ReadInt() != BINARY_POP_BYTE_ORDER) {
+    feedback.Error("unsupported binary population file version or byte order in '%s'", (const char*)path);
+    return false;
+  }
+  const int flags = fp.ReadInt();
+  fp.ReadInt(); // world x
+  fp.ReadInt(); // world y
+  const int num_genotypes = fp.ReadInt();
+  // Every genotype record holds at least its property count, organism count and parasite flag
+  if (!fp.Good() || num_genotypes < 0 || num_genotypes > (fp.GetSize() - fp.GetPos()) / (3 * (long long)sizeof(int))) {
+    feedback.Error("invalid binary population file header in '%s'", (const char*)path);
+    return false;
+  }
+  
+  const bool has_groups = (flags & (BINARY_POP_GROUPS | BINARY_POP_REBIRTH));
+  const bool has_avatars = (flags & (BINARY_POP_AVATARS | BINARY_POP_REBIRTH));
+  const bool has_rebirth = (flags & BINARY_POP_REBIRTH);
+  const bool use_avatars = world->GetConfig().USE_AVATARS.Get();
+  
+  // Select the columns that the text loader would have processed for the same set of load options
+  bool want_groups = false;
+  bool want_birth_cells = false;
+  bool want_av_bcells = false;
+  bool want_avatar_cells = false;
+  bool want_parent = false;
+  if (load_rebirth) {
+    want_birth_cells = true;
+    want_av_bcells = use_avatars;
+    want_parent = true;
+  } else {
+    want_groups = load_groups;
+    if (load_birth_cells) {
+      want_birth_cells = true;
+      want_av_bcells = use_avatars;
+    } else {
+      want_avatar_cells = load_avatars;
+    }
+    want_parent = load_parent_dat;
+  }
+  
+  genotypes.Resize(num_genotypes);
+  for (int gen_i = 0; gen_i < num_genotypes && fp.Good(); gen_i++) {
+    sTmpGenotype& tmp = genotypes[gen_i];
+    tmp.props = Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> >(new Apto::Map<Apto::String, Apto::String>);
+    fp.ReadProperties(*tmp.props);
+    tmp.id_num = Apto::StrAs(tmp.props->Get("id"));
+    
+    tmp.num_cpus = fp.ReadInt();
+    const bool parasite = fp.ReadInt();
+    const int num_orgs = tmp.num_cpus;
+    
+    fp.ReadColumn(tmp.cells, num_orgs);
+    if (!load_rebirth && !parasite) fp.ReadColumn(tmp.offsets, num_orgs);
+    else fp.SkipColumn<int>(num_orgs);
+    fp.ReadColumn(tmp.lineage_labels, num_orgs);
+    
+    if (has_groups) {
+      if (want_groups) {
+        fp.ReadColumn(tmp.group_ids, num_orgs);
+        fp.ReadColumn(tmp.forager_types, num_orgs);
+      } else {
+        fp.SkipColumn<int>(num_orgs * 2);
+      }
+      if (want_birth_cells) fp.ReadColumn(tmp.birth_cells, num_orgs);
+      else fp.SkipColumn<int>(num_orgs);
+    }
+    if (has_avatars) {
+      Apto::Array<int> avatar_cells;
+      fp.ReadColumn(avatar_cells, num_orgs);
+      if (want_avatar_cells) tmp.avatar_cells = avatar_cells;
+      if (want_av_bcells) fp.ReadColumn(tmp.avatar_cells, num_orgs);
+      else fp.SkipColumn<int>(num_orgs);
+      if (use_avatars && !tmp.avatar_cells.GetSize()) tmp.avatar_cells = avatar_cells;
+    }
+    if (has_rebirth) {
+      if (want_parent) {
+        Apto::Array<int> parent_teacher;
+        fp.ReadColumn(tmp.parent_ft, num_orgs);
+        fp.ReadColumn(parent_teacher, num_orgs);
+        fp.ReadColumn(tmp.parent_merit, num_orgs);
+        tmp.parent_teacher.Resize(parent_teacher.GetSize());
+        for (int i = 0; i < parent_teacher.GetSize(); i++) tmp.parent_teacher[i] = parent_teacher[i];
+      } else {
+        fp.SkipColumn<int>(num_orgs * 2);
+        fp.SkipColumn<double>(num_orgs);
+      }
+    }
+  }
+  
+  if (fp.Truncated()) {
+    feedback.Error("binary population file '%s' is truncated or corrupt (a record extends past its %lld bytes)",
+                   (const char*)path, fp.GetSize());
+    return false;
+  }
+  if (!fp.Good()) {
+    feedback.Error("error reading binary population file '%s' at byte %lld of %lld", (const char*)path, fp.GetPos(),
+                   fp.GetSize());
+    return false;
+  }
+  return true;
+}
+
+bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, int cellid_offset, int lineage_offset, bool load_groups, bool load_birth_cells, bool load_avatars, bool load_rebirth, bool load_parent_dat, int traceq)
+{
+  // @TODO - build in support for verifying population dimensions
+  
+  // First, we read in all the genotypes and store them in an array
+  Apto::Array<sTmpGenotype, Apto::ManagedPointer> genotypes;
   bool structured = false;
-  for (int line_id = 0; line_id < input_file.GetNumLines(); line_id++) {
-    cString cur_line = input_file.GetLine(line_id);
+  
+  cString path(Apto::FileSystem::GetAbsolutePath(Apto::String(filename), Apto::String(m_world->GetWorkingDir())));
+  if (isBinaryPopulation(path)) {
+    // Binary checkpoints always record cell ids
+    if (!readBinaryPopulation(m_world, path, genotypes, load_groups, load_birth_cells, load_avatars, load_rebirth, load_parent_dat)) {
+      return false;
+    }
+    structured = true;
+  } else {
+    cInitFile input_file(filename, m_world->GetWorkingDir(), ctx.Driver().Feedback());
+    if (!input_file.WasOpened()) return false;
     
-    // Setup the genotype for this line...
-    sTmpGenotype& tmp = genotypes[line_id];
-    tmp.props = input_file.GetLineAsDict(line_id);
-    tmp.id_num = Apto::StrAs(tmp.props->Get("id"));
+    genotypes.Resize(input_file.GetNumLines());
+    for (int line_id = 0; line_id < input_file.GetNumLines(); line_id++) {
+      cString cur_line = input_file.GetLine(line_id);
+    
+      // Setup the genotype for this line...
+      sTmpGenotype& tmp = genotypes[line_id];
+      tmp.props = input_file.GetLineAsDict(line_id);
+      tmp.id_num = Apto::StrAs(tmp.props->Get("id"));
 
-    // Loads "num_units" preferrentially, but will fall back to "num_cpus" if present
-    assert(tmp.props->Has("num_cpus") || tmp.props->Has("num_units"));
-    tmp.num_cpus = (tmp.props->Has("num_units")) ? Apto::StrAs(tmp.props->Get("num_units")) : Apto::StrAs(tmp.props->Get("num_cpus"));
+      // Loads "num_units" preferrentially, but will fall back to "num_cpus" if present
+      assert(tmp.props->Has("num_cpus") || tmp.props->Has("num_units"));
+      tmp.num_cpus = (tmp.props->Has("num_units")) ? Apto::StrAs(tmp.props->Get("num_units")) : Apto::StrAs(tmp.props->Get("num_cpus"));
     
-    // Process resident cell ids
-    cString cellstr(tmp.props->Get("cells"));
-    if (structured || cellstr.GetSize()) {
-      structured = true;
-      while (cellstr.GetSize()) tmp.cells.Push(cellstr.Pop(',').AsInt());
-      assert(tmp.cells.GetSize() == tmp.num_cpus);
-    }
-    
-    // Process gestation time offsets
-    if (!load_rebirth) {
-      cString offsetstr(tmp.props->Get("gest_offset"));
-      if (offsetstr.GetSize()) {
-        while (offsetstr.GetSize()) tmp.offsets.Push(offsetstr.Pop(',').AsInt());
-        assert(tmp.offsets.GetSize() == tmp.num_cpus);
-      }
-    }
-    // Lineage label (only set if given in file)
-    cString lineagestr(tmp.props->Get("lineage"));
-    while (lineagestr.GetSize()) tmp.lineage_labels.Push(lineagestr.Pop(',').AsInt());
-    // @blw preserve compatability with older .spop files that don't have lineage labels
-    assert(tmp.lineage_labels.GetSize() == 0 || tmp.lineage_labels.GetSize() == tmp.num_cpus);
-    
-    // Other org specs (if given in file)
-    if (load_rebirth) {
-      if (tmp.props->Has("birth_cell")) {
-        cString birthstr(tmp.props->Get("birth_cell"));
-        while (birthstr.GetSize()) tmp.birth_cells.Push(birthstr.Pop(',').AsInt());
-        assert(tmp.birth_cells.GetSize() == 0 || tmp.birth_cells.GetSize() == tmp.num_cpus);      
-      }
-      if (tmp.props->Has("av_bcell") && m_world->GetConfig().USE_AVATARS.Get()) {
-        cString avatarstr(tmp.props->Get("av_bcell"));
-        while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
-        assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_is_teach")) {
-        cString teachstr(tmp.props->Get("parent_is_teach"));
-        while (teachstr.GetSize()) tmp.parent_teacher.Push((bool)(teachstr.Pop(',').AsInt()));
-        assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_ft")) {
-        cString parentftstr(tmp.props->Get("parent_ft"));
-        while (parentftstr.GetSize()) tmp.parent_ft.Push(parentftstr.Pop(',').AsInt());
-        assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
+      // Process resident cell ids
+      cString cellstr(tmp.props->Get("cells"));
+      if (structured || cellstr.GetSize()) {
+        structured = true;
+        while (cellstr.GetSize()) tmp.cells.Push(cellstr.Pop(',').AsInt());
+        assert(tmp.cells.GetSize() == tmp.num_cpus);
       }
-      if (tmp.props->Has("parent_merit")) {
-        cString meritstr(tmp.props->Get("parent_merit"));
-        while (meritstr.GetSize()) tmp.parent_merit.Push(meritstr.Pop(',').AsDouble());
-        assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);
-      }
-    }
-    else {
-      if (load_groups) {
-        if (tmp.props->Has("group_id")) {
-          cString groupstr(tmp.props->Get("group_id"));
-          while (groupstr.GetSize()) tmp.group_ids.Push(groupstr.Pop(',').AsInt());
-          assert(tmp.group_ids.GetSize() == 0 || tmp.group_ids.GetSize() == tmp.num_cpus);
-        }
-        if (tmp.props->Has("forager_type")) {
-          cString foragestr(tmp.props->Get("forager_type"));
-          while (foragestr.GetSize()) tmp.forager_types.Push(foragestr.Pop(',').AsInt());
-          assert(tmp.forager_types.GetSize() == 0 || tmp.forager_types.GetSize() == tmp.num_cpus);
+    
+      // Process gestation time offsets
+      if (!load_rebirth) {
+        cString offsetstr(tmp.props->Get("gest_offset"));
+        if (offsetstr.GetSize()) {
+          while (offsetstr.GetSize()) tmp.offsets.Push(offsetstr.Pop(',').AsInt());
+          assert(tmp.offsets.GetSize() == tmp.num_cpus);
         }
       }
-      if (load_birth_cells) {   
+      // Lineage label (only set if given in file)
+      cString lineagestr(tmp.props->Get("lineage"));
+      while (lineagestr.GetSize()) tmp.lineage_labels.Push(lineagestr.Pop(',').AsInt());
+      // @blw preserve compatability with older .spop files that don't have lineage labels
+      assert(tmp.lineage_labels.GetSize() == 0 || tmp.lineage_labels.GetSize() == tmp.num_cpus);
+    
+      // Other org specs (if given in file)
+      if (load_rebirth) {
         if (tmp.props->Has("birth_cell")) {
           cString birthstr(tmp.props->Get("birth_cell"));
           while (birthstr.GetSize()) tmp.birth_cells.Push(birthstr.Pop(',').AsInt());
-          assert(tmp.birth_cells.GetSize() == 0 || tmp.birth_cells.GetSize() == tmp.num_cpus);
+          assert(tmp.birth_cells.GetSize() == 0 || tmp.birth_cells.GetSize() == tmp.num_cpus);      
         }
         if (tmp.props->Has("av_bcell") && m_world->GetConfig().USE_AVATARS.Get()) {
           cString avatarstr(tmp.props->Get("av_bcell"));
           while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
           assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
         }
+        if (tmp.props->Has("parent_is_teach")) {
+          cString teachstr(tmp.props->Get("parent_is_teach"));
+          while (teachstr.GetSize()) tmp.parent_teacher.Push((bool)(teachstr.Pop(',').AsInt()));
+          assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
+        }
+        if (tmp.props->Has("parent_ft")) {
+          cString parentftstr(tmp.props->Get("parent_ft"));
+          while (parentftstr.GetSize()) tmp.parent_ft.Push(parentftstr.Pop(',').AsInt());
+          assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
+        }
+        if (tmp.props->Has("parent_merit")) {
+          cString meritstr(tmp.props->Get("parent_merit"));
+          while (meritstr.GetSize()) tmp.parent_merit.Push(meritstr.Pop(',').AsDouble());
+          assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);
+        }
       }
-      else if (!load_birth_cells && load_avatars && tmp.props->Has("avatar_cell")) {
+      else {
+        if (load_groups) {
+          if (tmp.props->Has("group_id")) {
+            cString groupstr(tmp.props->Get("group_id"));
+            while (groupstr.GetSize()) tmp.group_ids.Push(groupstr.Pop(',').AsInt());
+            assert(tmp.group_ids.GetSize() == 0 || tmp.group_ids.GetSize() == tmp.num_cpus);
+          }
+          if (tmp.props->Has("forager_type")) {
+            cString foragestr(tmp.props->Get("forager_type"));
+            while (foragestr.GetSize()) tmp.forager_types.Push(foragestr.Pop(',').AsInt());
+            assert(tmp.forager_types.GetSize() == 0 || tmp.forager_types.GetSize() == tmp.num_cpus);
+          }
+        }
+        if (load_birth_cells) {   
+          if (tmp.props->Has("birth_cell")) {
+            cString birthstr(tmp.props->Get("birth_cell"));
+            while (birthstr.GetSize()) tmp.birth_cells.Push(birthstr.Pop(',').AsInt());
+            assert(tmp.birth_cells.GetSize() == 0 || tmp.birth_cells.GetSize() == tmp.num_cpus);
+          }
+          if (tmp.props->Has("av_bcell") && m_world->GetConfig().USE_AVATARS.Get()) {
+            cString avatarstr(tmp.props->Get("av_bcell"));
+            while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
+            assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
+          }
+        }
+        else if (!load_birth_cells && load_avatars && tmp.props->Has("avatar_cell")) {
+          cString avatarstr(tmp.props->Get("avatar_cell"));
+          while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
+          assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
+        }
+      if (load_parent_dat) {
+        if (tmp.props->Has("parent_is_teach")) {
+          cString teachstr(tmp.props->Get("parent_is_teach"));
+          while (teachstr.GetSize()) tmp.parent_teacher.Push((bool)(teachstr.Pop(',').AsInt()));
+          assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
+        }
+        if (tmp.props->Has("parent_ft")) {
+          cString parentftstr(tmp.props->Get("parent_ft"));
+          while (parentftstr.GetSize()) tmp.parent_ft.Push(parentftstr.Pop(',').AsInt());
+          assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
+        }
+        if (tmp.props->Has("parent_merit")) {
+          cString meritstr(tmp.props->Get("parent_merit"));
+          while (meritstr.GetSize()) tmp.parent_merit.Push(meritstr.Pop(',').AsDouble());
+          assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);      
+        }
+      }
+      }
+      if (m_world->GetConfig().USE_AVATARS.Get() && !tmp.avatar_cells.GetSize()) {
         cString avatarstr(tmp.props->Get("avatar_cell"));
         while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
         assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
       }
-    if (load_parent_dat) {
-      if (tmp.props->Has("parent_is_teach")) {
-        cString teachstr(tmp.props->Get("parent_is_teach"));
-        while (teachstr.GetSize()) tmp.parent_teacher.Push((bool)(teachstr.Pop(',').AsInt()));
-        assert(tmp.parent_teacher.GetSize() == 0 || tmp.parent_teacher.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_ft")) {
-        cString parentftstr(tmp.props->Get("parent_ft"));
-        while (parentftstr.GetSize()) tmp.parent_ft.Push(parentftstr.Pop(',').AsInt());
-        assert(tmp.parent_ft.GetSize() == 0 || tmp.parent_ft.GetSize() == tmp.num_cpus);
-      }
-      if (tmp.props->Has("parent_merit")) {
-        cString meritstr(tmp.props->Get("parent_merit"));
-        while (meritstr.GetSize()) tmp.parent_merit.Push(meritstr.Pop(',').AsDouble());
-        assert(tmp.parent_merit.GetSize() == 0 || tmp.parent_merit.GetSize() == tmp.num_cpus);      
-      }
-    }
-    }
-    if (m_world->GetConfig().USE_AVATARS.Get() && !tmp.avatar_cells.GetSize()) {
-      cString avatarstr(tmp.props->Get("avatar_cell"));
-      while (avatarstr.GetSize()) tmp.avatar_cells.Push(avatarstr.Pop(',').AsInt());
-      assert(tmp.avatar_cells.GetSize() == 0 || tmp.avatar_cells.GetSize() == tmp.num_cpus);
     }
   }
   
+  // Clear out the population, unless an offset is being used
+  if (cellid_offset == 0) {
+    for (int i = 0; i < cell_array.GetSize(); i++) KillOrganism(cell_array[i], ctx); 
+  }
+  
   // Sort genotypes in descending order according to their id_num
   Apto::QSort(genotypes);
   
@@ -6973,7 +7337,7 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
         // Set the phenotype merit from the save file
         assert(tmp.props->Has("merit"));
         double merit = Apto::StrAs(tmp.props->Get("merit"));
-        if ((load_rebirth || load_parent_dat) && m_world->GetConfig().INHERIT_MERIT.Get() && tmp.props->Has("parent_merit")) {
+        if ((load_rebirth || load_parent_dat) && m_world->GetConfig().INHERIT_MERIT.Get() && tmp.parent_merit.GetSize()) {
           merit = tmp.parent_merit[cell_i]; 
         }
         
@@ -7034,7 +7398,7 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
         if (load_parent_dat) {
           new_organism->SetParentFT(tmp.parent_ft[cell_i]);
           new_organism->SetParentTeacher(tmp.parent_teacher[cell_i]);
-          if (tmp.props->Has("parent_merit")) new_organism->SetParentMerit(tmp.parent_merit[cell_i]);        
+          if (tmp.parent_merit.GetSize()) new_organism->SetParentMerit(tmp.parent_merit[cell_i]);
         }
       }
       else if (load_rebirth) {
@@ -7067,6 +7431,107 @@ bool cPopulation::LoadPopulation(const cString& filename, cAvidaContext& ctx, in
   return true;
 }
 
+// Snapshots
+//
+// A snapshot is written as two files: <filename>.bpop, a binary population checkpoint, and <filename>, a text state
+// file holding the update, resource levels, and the merit of the organism in each occupied cell.  Taking a snapshot
+// does not alter the running world.
+//
+// A snapshot is a population checkpoint, not a resume of a running world.  Restored organisms start over from their
+// genomes, with fresh hardware and phenotypes (keeping only their merit), just as organisms loaded by LoadPopulation
+// do.  The random number generator and the scheduler keep their state inside Apto, which offers no way to serialize
+// it, and cStats accumulators and gradient resource internals are not saved either.
+static const int SNAPSHOT_VERSION = 3;
+
+bool cPopulation::SaveSnapshot(const cString& filename)
+{
+  const bool save_groups = (m_world->GetConfig().USE_FORM_GROUPS.Get() > 0);
+  const bool save_avatars = (m_world->GetConfig().USE_AVATARS.Get() > 0);
+  if (!SavePopulation(cStringUtil::Stringf("%s.bpop", (const char*)filename), true, save_groups, save_avatars, false, true)) return false;
+  
+  Apto::String file_path = Avida::Output::Manager::Of(m_world->GetNewWorld())->OutputIDFromPath(Apto::String((const char*)filename));
+  std::ofstream fp((const char*)file_path);
+  if (file_path.GetSize() == 0 || !fp.good()) {
+    m_world->GetDriver().Feedback().Error("unable to open snapshot file '%s' for writing", (const char*)filename);
+    return false;
+  }
+  
+  fp << "cPopulationSnapshot" << " " << SNAPSHOT_VERSION << " " << world_x << " " << world_y << endl;
+  fp << m_world->GetStats().GetUpdate() << endl;
+  
+  resource_count.SaveState(fp);
+  
+  fp.precision(17);
+  fp << GetNumOrganisms() << endl;
+  for (int cell_id = 0; cell_id < cell_array.GetSize(); cell_id++) {
+    if (!cell_array[cell_id].IsOccupied()) continue;
+    fp << cell_id << " " << cell_array[cell_id].GetOrganism()->GetPhenotype().GetMerit().GetDouble() << endl;
+  }
+  
+  return fp.good();
+}
+
+bool cPopulation::LoadSnapshot(const cString& filename, cAvidaContext& ctx)
+{
+  Feedback& feedback = m_world->GetDriver().Feedback();
+  
+  cString path(Apto::FileSystem::GetAbsolutePath(Apto::String(filename), Apto::String(m_world->GetWorkingDir())));
+  std::ifstream fp((const char*)path);
+  if (!fp.is_open()) {
+    feedback.Error("unable to open snapshot file '%s'", (const char*)filename);
+    return false;
+  }
+  
+  cString tag;
+  int version = 0;
+  int snap_x = 0;
+  int snap_y = 0;
+  fp >> tag >> version >> snap_x >> snap_y;
+  if (tag != "cPopulationSnapshot" || version != SNAPSHOT_VERSION) {
+    feedback.Error("'%s' is not a supported snapshot file", (const char*)filename);
+    return false;
+  }
+  if (snap_x != world_x || snap_y != world_y) {
+    feedback.Error("snapshot '%s' was saved from a %dx%d world", (const char*)filename, snap_x, snap_y);
+    return false;
+  }
+  
+  int update = 0;
+  fp >> update;
+  
+  const bool load_groups = (m_world->GetConfig().USE_FORM_GROUPS.Get() > 0);
+  const bool load_avatars = (m_world->GetConfig().USE_AVATARS.Get() > 0);
+  if (!LoadPopulation(cStringUtil::Stringf("%s.bpop", (const char*)filename), ctx, 0, 0, load_groups, false, load_avatars)) return false;
+  
+  m_world->GetStats().SetCurrentUpdate(update);
+  
+  if (!resource_count.LoadState(fp)) {
+    feedback.Error("snapshot '%s' does not match the configured resources", (const char*)filename);
+    return false;
+  }
+  
+  int num_orgs = 0;
+  fp >> num_orgs;
+  for (int i = 0; i < num_orgs && !fp.fail(); i++) {
+    int cell_id = -1;
+    double merit = 0.0;
+    fp >> cell_id >> merit;
+    if (fp.fail() || cell_id < 0 || cell_id >= cell_array.GetSize()) break;
+    
+    cPopulationCell& cell = cell_array[cell_id];
+    if (!cell.IsOccupied()) continue;
+    cell.GetOrganism()->GetPhenotype().SetMerit(cMerit(merit));
+    AdjustSchedule(cell, cell.GetOrganism()->GetPhenotype().GetMerit());
+  }
+  if (fp.fail()) {
+    feedback.Error("snapshot file '%s' is truncated", (const char*)filename);
+    return false;
+  }
+  
+  sync_events = true;
+  return true;
+}
+
 /**
  * This function loads a genome from a given file, and initializes
  * a cpu with it.
@@ -7385,11 +7850,20 @@ void cPopulation::BuildTimeSlicer()
       m_scheduler = new Apto::Scheduler::ProbabilisticIntegrated(cell_array.GetSize(), rng);
     }
       break;
+    case SLICE_SUM_TREE_MERIT:
+    {
+      Apto::SmartPtr<Apto::Random> rng(new Apto::RNG::AvidaRNG(m_world->GetRandom().GetInt(m_world->GetRandom().MaxSeed())));
+      m_scheduler = new cSumTreeScheduler(cell_array.GetSize(), rng);
+    }
+      break;
     default:
       cout << "error: requested time slicer not found." << endl;
       m_world->GetDriver().Abort(Avida::INVALID_CONFIG);
       break;
   }
+  
+  m_schedule_priority.Resize(cell_array.GetSize());
+  m_schedule_priority.SetAll(0.0);
 }
 
 
@@ -27,6 +27,7 @@
 
 #include "cBirthChamber.h"
 #include "cDeme.h"
+#include "cNeighborhoodTable.h"
 #include "cOrgInterface.h"
 #include "cPopulationInterface.h"
 #include "cResourceCount.h"
@@ -43,6 +44,7 @@ class cCodeLabel;
 class cEnvironment;
 class cLineage;
 class cOrganism;
+class cOrganismStatsReducer;
 class cPopulationCell;
 
 using namespace Avida;
@@ -66,7 +68,10 @@ private:
   // Components...
   cWorld* m_world;
   Apto::PriorityScheduler* m_scheduler;                // Handles allocation of CPU cycles
+  Apto::Array<double> m_schedule_priority;            // Priority last given to the scheduler for each cell
+  int m_schedule_changes;                             // Count of changes to any cell's schedule priority
   Apto::Array<cPopulationCell> cell_array;  // Local cells composing the population
+  cNeighborhoodTable m_neighborhoods;       // Flattened connections and neighborhoods of cell_array
   Apto::Array<int> empty_cell_id_array;     // Used for PREFER_EMPTY birth methods
   cResourceCount resource_count;       // Global resources available
   cBirthChamber birth_chamber;         // Global birth chamber.
@@ -81,6 +86,13 @@ private:
   Apto::Array<cOrganism*, Apto::Smart> live_org_list;
   
   Apto::Array<cPopulationOrgStatProviderPtr> m_org_stat_providers;
+  cOrganismStatsReducer* m_stats_reducer;   // Gathers the per-organism stats of each update
+  
+  // Per-update CPU cycle tallies used by batched time slice execution
+  Apto::Array<int> m_slice_counts;
+  Apto::Array<int, Apto::Smart> m_slice_order;
+  Apto::Array<int> m_slice_org_ids;       // Organism each cell's cycles were drawn for
+  Apto::Array<double> m_slice_priority;   // Schedule priority of the cell when its cycles were drawn
   
   
   Apto::Array<pair<int,int>, Apto::Smart>* sleep_log;
@@ -262,6 +274,8 @@ public:
   int ScheduleOrganism();          // Determine next organism to be processed.
   void ProcessStep(cAvidaContext& ctx, double step_size, int cell_id);
   void ProcessStepSpeculative(cAvidaContext& ctx, double step_size, int cell_id);
+  int ProcessSlice(cAvidaContext& ctx, double step_size, int cell_id, int num_steps);
+  void ProcessUpdateSlices(cAvidaContext& ctx, int update_size);
 
   // Calculate the statistics from the most recent update.
   void ProcessPostUpdate(cAvidaContext& ctx);
@@ -279,13 +293,18 @@ public:
   bool SaveHGTFragments(const cString& filename);
 
   bool SavePopulation(const cString& filename, bool save_historic, bool save_group_info = false, bool save_avatars = false,
-                      bool save_rebirth = false);
+                      bool save_rebirth = false, bool save_binary = false);
   bool SaveStructuredSystematicsGroup(const Systematics::RoleID& role, const cString& filename);
   bool LoadStructuredSystematicsGroup(cAvidaContext& ctx, const Systematics::RoleID& role, const cString& filename);
   bool LoadPopulation(const cString& filename, cAvidaContext& ctx, int cellid_offset=0, int lineage_offset=0,
                       bool load_groups = false, bool load_birth_cells = false, bool load_avatars = false, bool load_rebirth = false, bool load_parent_dat = false, int traceq = 0);
   bool SaveFlameData(const cString& filename);
   
+  // Snapshots pair a binary population checkpoint with organism merits, resources and the update.  Restored organisms
+  // start over from their genomes; see SaveSnapshot in cPopulation.cc for what is and isn't kept.
+  bool SaveSnapshot(const cString& filename);
+  bool LoadSnapshot(const cString& filename, cAvidaContext& ctx);
+  
   void SetMiniTraceQueue(Apto::Array<int, Apto::Smart> new_queue, const bool print_genomes, const bool print_reacs, const bool use_micro = false);
   void AppendMiniTraces(Apto::Array<int, Apto::Smart> new_queue, const bool print_genomes, const bool print_reacs, const bool use_micro = false);
   void LoadMiniTraceQ(const cString& filename, int orgs_per, bool print_genomes, bool print_reacs);
@@ -307,6 +326,7 @@ public:
   cDeme& GetDeme(int i) { return deme_array[i]; }
 
   cPopulationCell& GetCell(int in_num) { assert(in_num >=0); assert(in_num < cell_array.GetSize()); return cell_array[in_num]; }
+  cNeighborhoodTable& GetNeighborhoods() { return m_neighborhoods; }
   const Apto::Array<double>& GetResources(cAvidaContext& ctx) const { return resource_count.GetResources(ctx); }
   const Apto::Array<double>& GetCellResources(int cell_id, cAvidaContext& ctx) const { return resource_count.GetCellResources(cell_id, ctx); } 
   const Apto::Array<double>& GetFrozenResources(cAvidaContext& ctx, int cell_id) const { return resource_count.GetFrozenResources(ctx, cell_id); }
@@ -348,6 +368,7 @@ public:
 
   cEnvironment& GetEnvironment() { return environment; }
   int GetNumOrganisms() { return num_organisms; }
+  int GetScheduleChanges() const { return m_schedule_changes; }
   int GetNumPreyOrganisms() { return num_prey_organisms; }
   int GetNumPredOrganisms() { return num_pred_organisms; }
   int GetNumTopPredOrganisms() { return num_top_pred_organisms; }
@@ -264,15 +264,36 @@ int cPopulationInterface::GetNumNeighbors()
   return cell.ConnectionList().GetSize();
 }
 
+// The ids of the cells connected to cell, in the order of its connection list
+static void getNeighborhoodCellIDs(cPopulation& pop, cPopulationCell& cell, Apto::Array<int>& list)
+{
+  cNeighborhoodTable& neighborhoods = pop.GetNeighborhoods();
+  const int num_neighbors = neighborhoods.GetNumNeighbors(cell.GetID());
+  list.Resize(num_neighbors);
+  if (num_neighbors == 0) return;
+  
+  if (neighborhoods.HasRepeatedNeighbors(cell.GetID())) {
+    // The faced cell does not tell where the list has been rotated to
+    tConstListIterator<cPopulationCell> it(cell.ConnectionList());
+    int i = 0;
+    while (it.Next() != NULL) list[i++] = it.Get()->GetID();
+    return;
+  }
+  
+  // Connection lists are only ever rotated, so that they start at the faced cell
+  cNeighborhoodTable::cCellRange neighbors = neighborhoods.GetNeighbors(cell.GetID());
+  const int faced_id = cell.GetCellFaced().GetID();
+  int first = 0;
+  while (neighbors[first] != faced_id) first++;
+  for (int i = 0; i < num_neighbors; i++) list[i] = neighbors[(first + i) % num_neighbors];
+}
+
 void cPopulationInterface::GetNeighborhoodCellIDs(Apto::Array<int>& list)
 {
   cPopulationCell& cell = m_world->GetPopulation().GetCell(m_cell_id);
   assert(cell.IsOccupied());
   
-  list.Resize(cell.ConnectionList().GetSize());
-  tConstListIterator<cPopulationCell> it(cell.ConnectionList());
-  int i = 0;
-  while (it.Next() != NULL) list[i++] = it.Get()->GetID();
+  getNeighborhoodCellIDs(m_world->GetPopulation(), cell, list);
 }
 
 void cPopulationInterface::GetAVNeighborhoodCellIDs(Apto::Array<int>& list, int av_num)
@@ -280,10 +301,7 @@ void cPopulationInterface::GetAVNeighborhoodCellIDs(Apto::Array<int>& list, int
   cPopulationCell& cell = m_world->GetPopulation().GetCell(m_avatars[av_num].av_cell_id);
   assert(cell.HasAV());
   
-  list.Resize(cell.ConnectionList().GetSize());
-  tConstListIterator<cPopulationCell> it(cell.ConnectionList());
-  int i = 0;
-  while (it.Next() != NULL) list[i++] = it.Get()->GetID();
+  getNeighborhoodCellIDs(m_world->GetPopulation(), cell, list);
 }
 
 int cPopulationInterface::GetFacing()
@@ -615,10 +633,25 @@ bool cPopulationInterface::SendMessage(cOrgMessage& msg) {
 /*! Send a message to the faced organism, failing if this cell does not have 
  neighbors or if the cell currently faced is not occupied. */
 bool cPopulationInterface::BroadcastMessage(cOrgMessage& msg, int depth) {
-  cPopulationCell& cell = m_world->GetPopulation().GetCell(m_cell_id);
+  cPopulation& pop = m_world->GetPopulation();
+  cPopulationCell& cell = pop.GetCell(m_cell_id);
   assert(cell.IsOccupied()); // This organism; sanity.
 	
-	// Get the set of cells that are within range.
+	if (depth <= 1 || m_world->GetConfig().BCAST_MESSAGE_ALL_IN_RANGE.Get()) {
+		// Get the cells that are within range (never including this one).
+		cNeighborhoodTable::cCellRange cells = pop.GetNeighborhoods().GetCellsWithin(m_cell_id, depth);
+		
+		// Now, send a message towards each cell:
+		for (int i = 0; i < cells.GetSize(); i++) {
+			SendMessage(msg, pop.GetCell(cells[i]));
+		}
+		return true;
+	}
+	
+	// Get the set of cells that are within range.  The walk does not revisit cells first reached by a longer path, so
+	// deeper broadcasts miss some of the cells in range (as they always have, unless BCAST_MESSAGE_ALL_IN_RANGE is set).
+	// Which cells it misses depends on the current rotation of each cell's connections, so its reach can't be taken
+	// from the neighborhood table, and these broadcasts cost what they always have.
 	std::set<cPopulationCell*> cell_set;
 	cell.GetNeighboringCells(cell_set, depth);
 	
@@ -641,30 +674,23 @@ bool cPopulationInterface::BcastAlarm(int jump_label, int bcast_range) {
   const int ALARM_SELF = m_world->GetConfig().ALARM_SELF.Get(); // does an alarm affect the sender; 0=no  non-0=yes
   
   if(bcast_range > 1) { // multi-hop messaging
-    cDeme& deme = m_world->GetPopulation().GetDeme(GetDemeID());
-    for(int i = 0; i < deme.GetSize(); i++) {
-      int possible_receiver_id = deme.GetCellID(i);
-      cPopulationCell& rcell = m_world->GetPopulation().GetCell(possible_receiver_id);
+    // Cells of the deme no more than bcast_range cells away along either axis, other than this one
+    cNeighborhoodTable::cCellRange cells = m_world->GetPopulation().GetNeighborhoods().GetDemeCellsWithin(m_cell_id, bcast_range);
+    for(int i = 0; i < cells.GetSize(); i++) {
+      cPopulationCell& rcell = m_world->GetPopulation().GetCell(cells[i]);
 			
-      if(rcell.IsOccupied() && possible_receiver_id != GetCellID()) {
-        //check distance
-        pair<int, int> sender_pos = deme.GetCellPosition(GetCellID());
-        pair<int, int> possible_receiver_pos = deme.GetCellPosition(possible_receiver_id);
-        int hop_distance = max( abs(sender_pos.first  - possible_receiver_pos.first),
-															 abs(sender_pos.second - possible_receiver_pos.second));
-        if(hop_distance <= bcast_range) {
-          // send alarm to organisms
-          cOrganism* recvr = rcell.GetOrganism();
-          assert(recvr != NULL);
-          recvr->moveIPtoAlarmLabel(jump_label);
-          successfully_sent = true;
-        }
+      if(rcell.IsOccupied()) {
+        // send alarm to organisms
+        cOrganism* recvr = rcell.GetOrganism();
+        assert(recvr != NULL);
+        recvr->moveIPtoAlarmLabel(jump_label);
+        successfully_sent = true;
       }
     }
   } else { // single hop messaging
-    for(int i = 0; i < scell.ConnectionList().GetSize(); i++) {
-      cPopulationCell* rcell = scell.ConnectionList().GetPos(i);
-      assert(rcell != NULL); // Cells should never be null.
+    cNeighborhoodTable::cCellRange neighbors = m_world->GetPopulation().GetNeighborhoods().GetNeighbors(m_cell_id);
+    for(int i = 0; i < neighbors.GetSize(); i++) {
+      cPopulationCell* rcell = &m_world->GetPopulation().GetCell(neighbors[i]);
 			
       // Fail if the cell we're facing is not occupied.
       if(!rcell->IsOccupied())
@@ -37,66 +37,6 @@ const double cResourceCount::EPSILON (1.0e-15);
 const int cResourceCount::PRECALC_DISTANCE(100);
 
 
-void FlowMatter(cSpatialCountElem &elem1, cSpatialCountElem &elem2, 
-                double inxdiffuse, 
-                double inydiffuse, double inxgravity, double inygravity,
-                int xdist, int ydist, double dist) {
-
-  /* Routine to calculate the amount of flow from one Element to another.
-     Amount of flow is a function of:
-
-       1) Amount of material in each cell (will try to equalize)
-       2) Distance between each cell
-       3) x and y "gravity"
-
-     This method only effect the delta amount of each element.  The State
-     method will need to be called at the end of each time step to complete
-     the movement of material.
-  */
-
-  double  diff, flowamt, xgravity, xdiffuse, ygravity,  ydiffuse;
-
-  if (((elem1.amount == 0.0) && (elem2.amount == 0.0)) && (dist < 0.0)) return;
-  diff = (elem1.amount - elem2.amount);
-  if (xdist != 0) {
-
-    /* if there is material to be effected by x gravity */
-
-    if (((xdist>0) && (inxgravity>0.0)) || ((xdist<0) && (inxgravity<0.0))) {
-      xgravity = elem1.amount * fabs(inxgravity)/3.0;
-    } else {
-      xgravity = -elem2.amount * fabs(inxgravity)/3.0;
-    }
-    
-    /* Diffusion uses the diffusion constant x half the difference (as the 
-       elements attempt to equalize) / the number of possible neighbors (8) */
-
-    xdiffuse = inxdiffuse * diff / 16.0;
-  } else {
-    xdiffuse = 0.0;
-    xgravity = 0.0;
-  }  
-  if (ydist != 0) {
-
-    /* if there is material to be effected by y gravity */
-
-    if (((ydist>0) && (inygravity>0.0)) || ((ydist<0) && (inygravity<0.0))) {
-      ygravity = elem1.amount * fabs(inygravity)/3.0;
-    } else {
-      ygravity = -elem2.amount * fabs(inygravity)/3.0;
-    }
-    ydiffuse = inydiffuse * diff / 16.0;
-  } else {
-    ydiffuse = 0.0;
-    ygravity = 0.0;
-  }  
-
-  flowamt = ((xdiffuse + ydiffuse + xgravity + ygravity)/
-             (fabs(xdist*1.0) + fabs(ydist*1.0)))/dist;
-  elem1.delta -= flowamt;
-  elem2.delta += flowamt;
-}
-
 cResourceCount::cResourceCount(int num_resources)
   : update_time(0.0)
   , spatial_update_time(0.0)
@@ -330,7 +270,6 @@ void cResourceCount::Setup(cWorld* world, const int& res_index, const cString& n
   inflow_rate[res_index] = inflow;
   geometry[res_index] = in_geometry;
   spatial_resource_count[res_index]->SetGeometry(in_geometry);
-  spatial_resource_count[res_index]->SetPointers();
   spatial_resource_count[res_index]->SetCellList(in_cell_list_ptr);
 
   double step_decay = pow(decay, UPDATE_STEP);
@@ -703,6 +642,50 @@ void cResourceCount::ResizeSpatialGrids(int in_x, int in_y)
   }
 }
 
+// Saves the current resource levels (global amounts and spatial grids) along with the lazy update bookkeeping.
+// Resource definitions themselves come from the environment and are not saved.
+void cResourceCount::SaveState(ostream& fp) const
+{
+  assert(fp.good());
+  const streamsize old_precision = fp.precision(17);
+  
+  fp << "cResourceCount" << " " << resource_count.GetSize() << " ";
+  fp << update_time << " " << spatial_update_time << " " << m_last_updated << " " << m_spatial_update << endl;
+  for (int i = 0; i < resource_count.GetSize(); i++) {
+    fp << resource_count[i] << " " << geometry[i] << " ";
+    const int grid_size = (IsSpatial(i)) ? spatial_resource_count[i]->GetSize() : 0;
+    fp << grid_size << " ";
+    for (int c = 0; c < grid_size; c++) fp << spatial_resource_count[i]->GetAmount(c) << " ";
+    fp << endl;
+  }
+  
+  fp.precision(old_precision);
+}
+
+bool cResourceCount::LoadState(istream& fp)
+{
+  cString tag;
+  int num_resources = 0;
+  fp >> tag >> num_resources;
+  if (tag != "cResourceCount" || num_resources != resource_count.GetSize()) return false;
+  
+  fp >> update_time >> spatial_update_time >> m_last_updated >> m_spatial_update;
+  for (int i = 0; i < num_resources; i++) {
+    int res_geometry = 0;
+    int grid_size = 0;
+    fp >> resource_count[i] >> res_geometry >> grid_size;
+    if (fp.fail() || res_geometry != geometry[i]) return false;
+    if (grid_size && grid_size != spatial_resource_count[i]->GetSize()) return false;
+    for (int c = 0; c < grid_size; c++) {
+      double amount = 0.0;
+      fp >> amount;
+      spatial_resource_count[i]->SetCellAmount(c, amount);
+    }
+  }
+  
+  return !fp.fail();
+}
+
 int cResourceCount::GetCurrPeakX(cAvidaContext& ctx, int res_id) const
 { 
   DoUpdates(ctx);
@@ -145,6 +145,8 @@ public:
   void Set(cAvidaContext& ctx, int id, double new_level);
   double Get(cAvidaContext& ctx, int id) const;
   void ResizeSpatialGrids(int in_x, int in_y);
+  void SaveState(std::ostream& fp) const;
+  bool LoadState(std::istream& fp);
   cSpatialResCount GetSpatialResource(int id) { return *(spatial_resource_count[id]); }
   const cSpatialResCount& GetSpatialResource(int id) const { return *(spatial_resource_count[id]); }
   void ReinitializeResources(cAvidaContext& ctx, double additional_resource);
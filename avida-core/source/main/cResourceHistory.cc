@@ -25,6 +25,8 @@
 #include "cResourceCount.h"
 #include "cStringList.h"
 
+#include <cstring>
+
 
 int cResourceHistory::getEntryForUpdate(int update, bool exact) const
 {
@@ -87,6 +89,7 @@ void cResourceHistory::AddEntry(int update, const Apto::Array<double>& values)
   m_entries.Resize(new_entry + 1);
   m_entries[new_entry].update = update;
   m_entries[new_entry].values = values;
+  addToDigest(m_entries[new_entry]);
 }
 
 bool cResourceHistory::LoadFile(const cString& filename, const cString& working_dir)
@@ -113,6 +116,37 @@ bool cResourceHistory::LoadFile(const cString& filename, const cString& working_
     for (int i = 0; i < num_values; i++) m_entries[line].values[i] = cur_line.Pop().AsDouble();
   }
   
+  m_digest[0] = 2166136261u;
+  m_digest[1] = 84696351u;
+  for (int i = 0; i < m_entries.GetSize(); i++) addToDigest(m_entries[i]);
+  
   return true;
 }
 
+
+Apto::String cResourceHistory::GetFingerprint() const
+{
+  return Apto::FormatStr("%d:%08x%08x", m_entries.GetSize(), m_digest[0], m_digest[1]);
+}
+
+
+// FNV-1a style hashes over the update, number of values and the bit patterns of the values; the second uses a
+// different offset basis and multiplier so that the two are independent
+void cResourceHistory::addToDigest(const sResourceHistoryEntry& entry)
+{
+  static const unsigned int multiplier[2] = { 16777619u, 2654435761u };
+  
+  unsigned char bytes[sizeof(double)];
+  for (int d = 0; d < 2; d++) {
+    const unsigned int mult = multiplier[d];
+    unsigned int total = m_digest[d];
+    total = (total ^ static_cast<unsigned int>(entry.update)) * mult;
+    total = (total ^ static_cast<unsigned int>(entry.values.GetSize())) * mult;
+    for (int i = 0; i < entry.values.GetSize(); i++) {
+      std::memcpy(bytes, &entry.values[i], sizeof(double));
+      for (unsigned int b = 0; b < sizeof(double); b++) total = (total ^ bytes[b]) * mult;
+    }
+    m_digest[d] = total;
+  }
+}
+
@@ -38,22 +38,27 @@ private:
   };
   
   Apto::Array<sResourceHistoryEntry> m_entries;
+  unsigned int m_digest[2];   // Two independent hashes of all entries, kept current as entries are added
   
   
   int getEntryForUpdate(int update, bool exact) const;
+  void addToDigest(const sResourceHistoryEntry& entry);
   
   
   cResourceHistory(const cResourceHistory&); // @not_implemented
   cResourceHistory& operator=(const cResourceHistory&); // @not_implemented
   
 public:
-  cResourceHistory() { ; }
+  cResourceHistory() { m_digest[0] = 2166136261u; m_digest[1] = 84696351u; }
   
   bool GetResourceCountForUpdate(cAvidaContext& ctx, int update, cResourceCount& rc, bool exact = false) const;
   bool GetResourceLevelsForUpdate(int update, Apto::Array<double>& levels, bool exact = false) const;
   void AddEntry(int update, const Apto::Array<double>& values);
   
   bool LoadFile(const cString& filename, const cString& working_dir);
+  
+  // Identifies the contents of the history, so that results derived from it can be cached
+  Apto::String GetFingerprint() const;
 };
 
 #endif
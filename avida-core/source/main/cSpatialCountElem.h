@@ -28,26 +28,19 @@
 
 class cSpatialCountElem
 {
+  friend class cSpatialResCount;
+  
 private:
   mutable double amount, delta, initial;
-  Apto::Array<int> elempt, xdist, ydist;
-  Apto::Array<double> dist;
   
 public:
-  cSpatialCountElem();
-  cSpatialCountElem(double initamount);
+  cSpatialCountElem() : amount(0.0), delta(0.0), initial(0.0) { ; }
+  cSpatialCountElem(double initamount) : amount(initamount), delta(0.0), initial(initamount) { ; }
   
   void Rate(double ratein) const { delta += ratein; }
   void State() { amount += delta; delta = 0.0; }
   double GetAmount() const { return amount; }
   void SetAmount(double res) const { amount = res; }
-  void SetPtr(int innum, int inelempt, int inxdist, int  inydist, double indist);
-  int GetElemPtr(int innum) { return elempt[innum]; }
-  int GetPtrXdist(int innum) { return xdist[innum]; }
-  int GetPtrYdist(int innum) { return ydist[innum]; }
-  double GetPtrDist(int innum) { return dist[innum]; }
-  friend void FlowMatter(cSpatialCountElem&, cSpatialCountElem&, double, double, double, double,
-                         int, int, double);
   void SetInitial(double init) { initial = init; }
   double GetInitial() { return initial; }
   
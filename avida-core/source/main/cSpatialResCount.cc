@@ -49,7 +49,6 @@ cSpatialResCount::cSpatialResCount(int inworld_x, int inworld_y, int ingeometry,
     cSpatialCountElem tmpelem;
     grid[i] = tmpelem;
   } 
-  SetPointers();
 }
 
 /* Setup a single spatial resource using default flow amounts  */
@@ -71,7 +70,6 @@ cSpatialResCount::cSpatialResCount(int inworld_x, int inworld_y, int ingeometry)
     cSpatialCountElem tmpelem;
     grid[i] = tmpelem;
    } 
-   SetPointers();
 }
 
 cSpatialResCount::cSpatialResCount() : m_initial(0.0), xdiffuse(1.0), ydiffuse(1.0), xgravity(0.0), ygravity(0.0), m_modified(false)
@@ -95,61 +93,8 @@ void cSpatialResCount::ResizeClear(int inworld_x, int inworld_y, int ingeometry)
     cSpatialCountElem tmpelem;
     grid[i] = tmpelem;
    } 
-   SetPointers();
 }
 
-void cSpatialResCount::SetPointers()
-{
-  /* Pointer 0 will point to the cell above and to the left the current cell
-     and will go clockwise around the cell.                               */
-
-  int     i,ii;
-  double  SQRT2 = sqrt(2.0);
-
-  /* First treat all cells like they are in a torus */
-
-  for (i = 0; i < GetSize(); i++) {
-    grid[i].SetPtr(0 ,GridNeighbor(i, world_x, world_y, -1, -1), -1, -1, SQRT2);
-    grid[i].SetPtr(1 ,GridNeighbor(i, world_x, world_y,  0, -1),  0, -1, 1.0);
-    grid[i].SetPtr(2 ,GridNeighbor(i, world_x, world_y, +1, -1), +1, -1, SQRT2);
-    grid[i].SetPtr(3 ,GridNeighbor(i, world_x, world_y, +1,  0), +1,  0, 1.0);
-    grid[i].SetPtr(4 ,GridNeighbor(i, world_x, world_y, +1, +1), +1, +1, SQRT2);
-    grid[i].SetPtr(5 ,GridNeighbor(i, world_x, world_y,  0, +1),  0, +1, 1.0);
-    grid[i].SetPtr(6 ,GridNeighbor(i, world_x, world_y, -1, +1), -1, +1, SQRT2);
-    grid[i].SetPtr(7 ,GridNeighbor(i, world_x, world_y, -1,  0), -1,  0, 1.0);
-  }
- 
-  /* Fix links for top, bottom and sides for non-torus */
-  
-  if (geometry == nGeometry::GRID) {
-    /* Top and bottom */
-
-    for (i = 0; i < world_x; i++) {
-      grid[i].SetPtr(0, -99, -99, -99, -99.0);
-      grid[i].SetPtr(1, -99, -99, -99, -99.0);
-      grid[i].SetPtr(2, -99, -99, -99, -99.0);
-      ii = num_cells-1-i;
-      grid[ii].SetPtr(4, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(5, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(6, -99, -99, -99, -99.0);
-    }
-
-    /* fix links for right and left sides */
-
-    for (i = 0; i < world_y; i++) {
-      ii = i * world_x;    
-      grid[ii].SetPtr(0, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(7, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(6, -99, -99, -99, -99.0);
-      ii = ((i + 1) * world_x) - 1;
-      grid[ii].SetPtr(2, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(3, -99, -99, -99, -99.0);
-      grid[ii].SetPtr(4, -99, -99, -99, -99.0);
-    }
-  }
-}
-
-
 void cSpatialResCount::CheckRanges()
 {
 
@@ -313,28 +258,114 @@ void cSpatialResCount::StateAll() {
   } 
 }
 
+/* Routine to calculate the amount of flow from one element to another.
+   Amount of flow is a function of:
+
+     1) Amount of material in each cell (will try to equalize)
+     2) Distance between each cell
+     3) x and y "gravity"
+
+   This method only effect the delta amount of each element.  The State
+   method will need to be called at the end of each time step to complete
+   the movement of material.
+*/
+
+inline void cSpatialResCount::flowMatter(cSpatialCountElem& elem1, cSpatialCountElem& elem2, int xdist, int ydist,
+                                         double dist) const
+{
+  double  diff, flowamt, x_gravity, x_diffuse, y_gravity, y_diffuse;
+
+  diff = (elem1.amount - elem2.amount);
+  if (xdist != 0) {
+
+    /* if there is material to be effected by x gravity */
+
+    if (((xdist>0) && (xgravity>0.0)) || ((xdist<0) && (xgravity<0.0))) {
+      x_gravity = elem1.amount * fabs(xgravity)/3.0;
+    } else {
+      x_gravity = -elem2.amount * fabs(xgravity)/3.0;
+    }
+    
+    /* Diffusion uses the diffusion constant x half the difference (as the 
+       elements attempt to equalize) / the number of possible neighbors (8) */
+
+    x_diffuse = xdiffuse * diff / 16.0;
+  } else {
+    x_diffuse = 0.0;
+    x_gravity = 0.0;
+  }  
+  if (ydist != 0) {
+
+    /* if there is material to be effected by y gravity */
+
+    if (((ydist>0) && (ygravity>0.0)) || ((ydist<0) && (ygravity<0.0))) {
+      y_gravity = elem1.amount * fabs(ygravity)/3.0;
+    } else {
+      y_gravity = -elem2.amount * fabs(ygravity)/3.0;
+    }
+    y_diffuse = ydiffuse * diff / 16.0;
+  } else {
+    y_diffuse = 0.0;
+    y_gravity = 0.0;
+  }  
+
+  flowamt = ((x_diffuse + y_diffuse + x_gravity + y_gravity)/
+             (fabs(xdist*1.0) + fabs(ydist*1.0)))/dist;
+  elem1.delta -= flowamt;
+  elem2.delta += flowamt;
+}
+
 void cSpatialResCount::FlowAll() {
 
   // @JEB save time if diffusion and gravity off...
   if ((xdiffuse == 0.0) && (ydiffuse == 0.0) && (xgravity == 0.0) && (ygravity == 0.0)) return;
+  if (num_cells == 0) return;
 
-  int     i,k,ii,xdist,ydist;
-  double  dist;
- 
-  for (i = 0; i < num_cells; i++) {
-      
-    /* because flow is two way we must check only half the neighbors to 
-       prevent double flow calculations */
-
-    for (k = 3; k <= 6; k++) {
-      ii = grid[i].GetElemPtr(k);
-      xdist = grid[i].GetPtrXdist(k);
-      ydist = grid[i].GetPtrYdist(k);
-      dist = grid[i].GetPtrDist(k);
-      if (ii >= 0) {
-        FlowMatter(grid[i],grid[ii],xdiffuse,ydiffuse,xgravity,ygravity,
-                   xdist, ydist, dist);
-      }
+  /* Neighbors are computed directly from the grid coordinates.  Every geometry other than a bounded grid is treated
+     as a torus.  Because flow is two way only the east, south-east, south and south-west neighbors are visited, in
+     that order, to prevent double flow calculations.  Cells are visited in index order, so that the sequence of
+     updates to each delta is identical to walking a per-cell neighbor table. */
+
+  const bool bounded = (geometry == nGeometry::GRID);
+  const double SQRT2 = sqrt(2.0);
+
+  cSpatialCountElem* cells = &grid[0];
+  
+  for (int y = 0; y < world_y; y++) {
+    const bool last_row = (y == world_y - 1);
+    cSpatialCountElem* row = cells + y * world_x;
+    cSpatialCountElem* south_row = cells + (last_row ? 0 : (y + 1) * world_x);
+    
+    // Bounded grids have no southern neighbors along the bottom row
+    if (bounded && last_row) {
+      for (int x = 0; x < world_x - 1; x++) flowMatter(row[x], row[x + 1], +1, 0, 1.0);
+      continue;
+    }
+    
+    // West edge (wraps to the east edge on a torus)
+    {
+      const int east = (world_x > 1) ? 1 : 0;
+      if (!bounded || world_x > 1) flowMatter(row[0], row[east], +1, 0, 1.0);
+      if (!bounded || world_x > 1) flowMatter(row[0], south_row[east], +1, +1, SQRT2);
+      flowMatter(row[0], south_row[0], 0, +1, 1.0);
+      if (!bounded) flowMatter(row[0], south_row[world_x - 1], -1, +1, SQRT2);
+    }
+    
+    // Interior cells, no wrapping required
+    for (int x = 1; x < world_x - 1; x++) {
+      flowMatter(row[x], row[x + 1], +1, 0, 1.0);
+      flowMatter(row[x], south_row[x + 1], +1, +1, SQRT2);
+      flowMatter(row[x], south_row[x], 0, +1, 1.0);
+      flowMatter(row[x], south_row[x - 1], -1, +1, SQRT2);
+    }
+    
+    // East edge (wraps to the west edge on a torus)
+    if (world_x > 1) {
+      const int x = world_x - 1;
+      if (!bounded) flowMatter(row[x], row[0], +1, 0, 1.0);
+      if (!bounded) flowMatter(row[x], south_row[0], +1, +1, SQRT2);
+      flowMatter(row[x], south_row[x], 0, +1, 1.0);
+      flowMatter(row[x], south_row[x - 1], -1, +1, SQRT2);
     }
   }
 }
@@ -46,6 +46,8 @@ private:
   Apto::Array<cCellResource> *cell_list_ptr;
   bool m_modified;
   
+  inline void flowMatter(cSpatialCountElem& elem1, cSpatialCountElem& elem2, int xdist, int ydist, double dist) const;
+  
 public:
   cSpatialResCount();
   cSpatialResCount(int inworld_x, int inworld_y, int ingeometry);
@@ -55,7 +57,6 @@ public:
   virtual ~cSpatialResCount();
   
   void ResizeClear(int inworld_x, int inworld_y, int ingeometry);
-  void SetPointers();
   void CheckRanges();
   void SetCellList(Apto::Array<cCellResource> *in_cell_list_ptr);
   int GetSize() const { return grid.GetSize(); }
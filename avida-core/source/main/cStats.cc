@@ -81,6 +81,8 @@ cStats::cStats(cWorld* world)
 , num_breed_true_creatures(0)
 , num_creatures(0)
 , num_executed(0)
+, num_output_tests(0)
+, num_output_allocs(0)
 , num_parasites(0)
 , num_no_birth_creatures(0)
 , num_single_thread_creatures(0)
@@ -511,6 +513,109 @@ void cStats::ZeroReactions()
   m_reaction_last_add_reward.SetAll(0);
 }
 
+
+template <class T> static void resetTally(Apto::Array<T>& tally, int size)
+{
+  tally.ResizeClear(size);
+  tally.SetAll(0);
+}
+
+template <class T> static void mergeTally(Apto::Array<T>& into, const Apto::Array<T>& tally)
+{
+  for (int i = 0; i < tally.GetSize(); i++) into[i] += tally[i];
+}
+
+static void mergeMaxTally(Apto::Array<double>& into, const Apto::Array<double>& tally)
+{
+  for (int i = 0; i < tally.GetSize(); i++) if (tally[i] > into[i]) into[i] = tally[i];
+}
+
+void cOrganismTallies::Reset(int num_tasks, int num_reactions)
+{
+  m_fitness.Clear();
+  m_log_fitness.Clear();
+  m_merit.Clear();
+  m_gestation.Clear();
+  m_creature_age.Clear();
+  m_generation.Clear();
+  m_neutral_metric.Clear();
+  m_lineage_label.Clear();
+  m_copy_size.Clear();
+  m_exe_size.Clear();
+  m_mem_size.Clear();
+  m_copy_mut_rate.Clear();
+  m_log_copy_mut_rate.Clear();
+  m_div_mut_rate.Clear();
+  m_log_div_mut_rate.Clear();
+
+  resetTally(m_task_cur_count, num_tasks);
+  resetTally(m_task_last_count, num_tasks);
+  resetTally(m_task_cur_quality, num_tasks);
+  resetTally(m_task_last_quality, num_tasks);
+  resetTally(m_task_cur_max_quality, num_tasks);
+  resetTally(m_task_last_max_quality, num_tasks);
+  resetTally(m_task_exe_count, num_tasks);
+  resetTally(m_tasks_host_current, num_tasks);
+  resetTally(m_tasks_host_last, num_tasks);
+  resetTally(m_tasks_parasite_current, num_tasks);
+  resetTally(m_tasks_parasite_last, num_tasks);
+  resetTally(m_task_internal_cur_count, num_tasks);
+  resetTally(m_task_internal_last_count, num_tasks);
+  resetTally(m_task_internal_cur_quality, num_tasks);
+  resetTally(m_task_internal_last_quality, num_tasks);
+  resetTally(m_task_internal_cur_max_quality, num_tasks);
+  resetTally(m_task_internal_last_max_quality, num_tasks);
+
+  resetTally(m_reaction_cur_count, num_reactions);
+  resetTally(m_reaction_last_count, num_reactions);
+  resetTally(m_reaction_cur_add_reward, num_reactions);
+  resetTally(m_reaction_last_add_reward, num_reactions);
+  resetTally(m_reaction_exe_count, num_reactions);
+}
+
+void cStats::MergeOrganismTallies(const cOrganismTallies& tallies)
+{
+  sum_fitness.Merge(tallies.m_fitness);
+  sum_log_fitness.Merge(tallies.m_log_fitness);
+  sum_merit.Merge(tallies.m_merit);
+  sum_gestation.Merge(tallies.m_gestation);
+  sum_creature_age.Merge(tallies.m_creature_age);
+  sum_generation.Merge(tallies.m_generation);
+  sum_neutral_metric.Merge(tallies.m_neutral_metric);
+  sum_lineage_label.Merge(tallies.m_lineage_label);
+  sum_copy_size.Merge(tallies.m_copy_size);
+  sum_exe_size.Merge(tallies.m_exe_size);
+  sum_mem_size.Merge(tallies.m_mem_size);
+  sum_copy_mut_rate.Merge(tallies.m_copy_mut_rate);
+  sum_log_copy_mut_rate.Merge(tallies.m_log_copy_mut_rate);
+  sum_div_mut_rate.Merge(tallies.m_div_mut_rate);
+  sum_log_div_mut_rate.Merge(tallies.m_log_div_mut_rate);
+
+  mergeTally(task_cur_count, tallies.m_task_cur_count);
+  mergeTally(task_last_count, tallies.m_task_last_count);
+  mergeTally(task_cur_quality, tallies.m_task_cur_quality);
+  mergeTally(task_last_quality, tallies.m_task_last_quality);
+  mergeMaxTally(task_cur_max_quality, tallies.m_task_cur_max_quality);
+  mergeMaxTally(task_last_max_quality, tallies.m_task_last_max_quality);
+  mergeTally(task_exe_count, tallies.m_task_exe_count);
+  mergeTally(tasks_host_current, tallies.m_tasks_host_current);
+  mergeTally(tasks_host_last, tallies.m_tasks_host_last);
+  mergeTally(tasks_parasite_current, tallies.m_tasks_parasite_current);
+  mergeTally(tasks_parasite_last, tallies.m_tasks_parasite_last);
+  mergeTally(task_internal_cur_count, tallies.m_task_internal_cur_count);
+  mergeTally(task_internal_last_count, tallies.m_task_internal_last_count);
+  mergeTally(task_internal_cur_quality, tallies.m_task_internal_cur_quality);
+  mergeTally(task_internal_last_quality, tallies.m_task_internal_last_quality);
+  mergeMaxTally(task_internal_cur_max_quality, tallies.m_task_internal_cur_max_quality);
+  mergeMaxTally(task_internal_last_max_quality, tallies.m_task_internal_last_max_quality);
+
+  mergeTally(m_reaction_cur_count, tallies.m_reaction_cur_count);
+  mergeTally(m_reaction_last_count, tallies.m_reaction_last_count);
+  mergeTally(m_reaction_cur_add_reward, tallies.m_reaction_cur_add_reward);
+  mergeTally(m_reaction_last_add_reward, tallies.m_reaction_last_add_reward);
+  mergeTally(m_reaction_exe_count, tallies.m_reaction_exe_count);
+}
+
 void cStats::ZeroMessageInst()
 {
 
@@ -600,6 +705,8 @@ void cStats::ProcessUpdate()
   
   tot_executed += num_executed;
   num_executed = 0;
+  num_output_tests = 0;
+  num_output_allocs = 0;
   
   task_cur_count.SetAll(0);
   task_last_count.SetAll(0);
@@ -1726,6 +1833,8 @@ void cStats::PrintExtendedTimeData(const cString& filename)
 	df->Write(avida_time, "avida time");
 	df->Write(num_executed, "num_executed");
 	df->Write(tot_organisms, "num_organisms");
+	df->Write(num_output_tests, "num_output_tests");
+	df->Write(num_output_allocs, "num_output_allocs");
 	df->Endl();
 }
 
@@ -86,6 +86,113 @@ struct s_inst_circumstances {
   int tol_max;
 };
 
+
+// The per-organism sums and task/reaction tallies of one update, for a chunk of the organisms gathered apart from
+// cStats (see cOrganismStatsReducer).  The accessors mirror those of cStats; chunks are combined into the cStats by
+// MergeOrganismTallies, always in the same order.
+class cOrganismTallies
+{
+  friend class cStats;
+private:
+  cDoubleSum m_fitness;
+  cDoubleSum m_log_fitness;
+  cDoubleSum m_merit;
+  cDoubleSum m_gestation;
+  cDoubleSum m_creature_age;
+  cDoubleSum m_generation;
+  cDoubleSum m_neutral_metric;
+  cDoubleSum m_lineage_label;
+  cDoubleSum m_copy_size;
+  cDoubleSum m_exe_size;
+  cDoubleSum m_mem_size;
+  cRunningStats m_copy_mut_rate;
+  cRunningStats m_log_copy_mut_rate;
+  cRunningStats m_div_mut_rate;
+  cRunningStats m_log_div_mut_rate;
+
+  Apto::Array<int> m_task_cur_count;
+  Apto::Array<int> m_task_last_count;
+  Apto::Array<double> m_task_cur_quality;
+  Apto::Array<double> m_task_last_quality;
+  Apto::Array<double> m_task_cur_max_quality;
+  Apto::Array<double> m_task_last_max_quality;
+  Apto::Array<int> m_task_exe_count;
+  Apto::Array<int> m_tasks_host_current;
+  Apto::Array<int> m_tasks_host_last;
+  Apto::Array<int> m_tasks_parasite_current;
+  Apto::Array<int> m_tasks_parasite_last;
+  Apto::Array<int> m_task_internal_cur_count;
+  Apto::Array<int> m_task_internal_last_count;
+  Apto::Array<double> m_task_internal_cur_quality;
+  Apto::Array<double> m_task_internal_last_quality;
+  Apto::Array<double> m_task_internal_cur_max_quality;
+  Apto::Array<double> m_task_internal_last_max_quality;
+
+  Apto::Array<int> m_reaction_cur_count;
+  Apto::Array<int> m_reaction_last_count;
+  Apto::Array<double> m_reaction_cur_add_reward;
+  Apto::Array<double> m_reaction_last_add_reward;
+  Apto::Array<int> m_reaction_exe_count;
+
+public:
+  cOrganismTallies() { ; }
+
+  void Reset(int num_tasks, int num_reactions);
+
+  cDoubleSum& SumFitness()       { return m_fitness; }
+  cDoubleSum& SumLogFitness()    { return m_log_fitness; }
+  cDoubleSum& SumMerit()         { return m_merit; }
+  cDoubleSum& SumGestation()     { return m_gestation; }
+  cDoubleSum& SumCreatureAge()   { return m_creature_age; }
+  cDoubleSum& SumGeneration()    { return m_generation; }
+  cDoubleSum& SumNeutralMetric() { return m_neutral_metric; }
+  cDoubleSum& SumLineageLabel()  { return m_lineage_label; }
+  cDoubleSum& SumCopySize()      { return m_copy_size; }
+  cDoubleSum& SumExeSize()       { return m_exe_size; }
+  cDoubleSum& SumMemSize()       { return m_mem_size; }
+  cRunningStats& SumCopyMutRate()    { return m_copy_mut_rate; }
+  cRunningStats& SumLogCopyMutRate() { return m_log_copy_mut_rate; }
+  cRunningStats& SumDivMutRate()     { return m_div_mut_rate; }
+  cRunningStats& SumLogDivMutRate()  { return m_log_div_mut_rate; }
+
+  void AddCurTask(int task_num) { m_task_cur_count[task_num]++; }
+  void AddLastTask(int task_num) { m_task_last_count[task_num]++; }
+  void AddCurTaskQuality(int task_num, double quality)
+  {
+    m_task_cur_quality[task_num] += quality;
+    if (quality > m_task_cur_max_quality[task_num]) m_task_cur_max_quality[task_num] = quality;
+  }
+  void AddLastTaskQuality(int task_num, double quality)
+  {
+    m_task_last_quality[task_num] += quality;
+    if (quality > m_task_last_max_quality[task_num]) m_task_last_max_quality[task_num] = quality;
+  }
+  void IncTaskExeCount(int task_num, int task_count) { m_task_exe_count[task_num] += task_count; }
+  void AddCurHostTask(int task_num) { m_tasks_host_current[task_num]++; }
+  void AddLastHostTask(int task_num) { m_tasks_host_last[task_num]++; }
+  void AddCurParasiteTask(int task_num) { m_tasks_parasite_current[task_num]++; }
+  void AddLastParasiteTask(int task_num) { m_tasks_parasite_last[task_num]++; }
+  void AddCurInternalTask(int task_num) { m_task_internal_cur_count[task_num]++; }
+  void AddLastInternalTask(int task_num) { m_task_internal_last_count[task_num]++; }
+  void AddCurInternalTaskQuality(int task_num, double quality)
+  {
+    m_task_internal_cur_quality[task_num] += quality;
+    if (quality > m_task_internal_cur_max_quality[task_num]) m_task_internal_cur_max_quality[task_num] = quality;
+  }
+  void AddLastInternalTaskQuality(int task_num, double quality)
+  {
+    m_task_internal_last_quality[task_num] += quality;
+    if (quality > m_task_internal_last_max_quality[task_num]) m_task_internal_last_max_quality[task_num] = quality;
+  }
+
+  void AddCurReaction(int reaction) { m_reaction_cur_count[reaction]++; }
+  void AddLastReaction(int reaction) { m_reaction_last_count[reaction]++; }
+  void AddCurReactionAddReward(int reaction, double reward) { m_reaction_cur_add_reward[reaction] += reward; }
+  void AddLastReactionAddReward(int reaction, double reward) { m_reaction_last_add_reward[reaction] += reward; }
+  void IncReactionExeCount(int reaction, int count) { m_reaction_exe_count[reaction] += count; }
+};
+
+
 class cStats : public Data::ArgumentedProvider, public Data::Recorder
 {
 private:
@@ -199,6 +306,8 @@ private:
   int num_breed_true_creatures;
   int num_creatures;
   int num_executed;
+  int num_output_tests;     // organism outputs checked for tasks this update
+  int num_output_allocs;    // allocations made while checking them (zero in steady state)
   int num_parasites;
   int num_no_birth_creatures;
   int num_single_thread_creatures;
@@ -653,6 +762,9 @@ public:
   void RecordDeath() { num_deaths++; }
 
   void IncExecuted() { num_executed++; }
+  void IncExecuted(int num) { num_executed += num; }
+  void IncOutputTests() { num_output_tests++; }
+  void AddOutputAllocs(int num) { num_output_allocs += num; }
 
   void AddNumOrgsKilled(long num) { sum_orgs_killed.Add(num); }
 	void AddNumUnoccupiedCellAttemptedToKill(long num) { sum_unoccupied_cell_kill_attempts.Add(num); }
@@ -713,6 +825,8 @@ public:
   void IncReactionExeCount(int reaction, int count) { m_reaction_exe_count[reaction] += count; }
   void ZeroReactions();
 
+  void MergeOrganismTallies(const cOrganismTallies& tallies);
+
   void SetResources(const Apto::Array<double> &_in) { resource_count = _in; }
   void SetResourcesGeometry(const Apto::Array<int> &_in) { resource_geometry = _in;}
   void SetSpatialRes(const Apto::Array< Apto::Array<double> > &_in) { spatial_res_count = _in; }
@@ -728,6 +842,7 @@ public:
   void SetCompetitionOrgsReplicated(int _in) { num_orgs_replicated = _in; }
 
   void AddSpeculative(int spec) { m_spec_total += spec; m_spec_num++; }
+  void AddSpeculative(int spec, int num) { m_spec_total += spec; m_spec_num += num; }
   void AddSpeculativeWaste(int waste) { m_spec_waste += waste; }
 
   // Sexual selection recording
@@ -742,6 +857,8 @@ public:
   int GetBreedTrue() const          { return num_breed_true; }
   int GetBreedTrueCreatures() const { return num_breed_true_creatures; }
   int GetNumCreatures() const       { return num_creatures; }
+  int GetNumOutputTests() const     { return num_output_tests; }
+  int GetNumOutputAllocs() const    { return num_output_allocs; }
   int GetNumParasites() const       { return num_parasites; }
   int GetNumNoBirthCreatures() const{ return num_no_birth_creatures; }
   int GetNumSingleThreadCreatures() const { return num_single_thread_creatures; }
@@ -42,12 +42,13 @@ private:
   int m_id;
   tTaskTest m_test_fun;
   cArgContainer* m_args;
+  bool m_is_logic;
   Apto::String m_prop_id_ave;
   Apto::String m_prop_id_count;
 
 public:
   cTaskEntry(const cString& name, const cString& desc, int in_id, tTaskTest fun, cArgContainer* args)
-    : m_name(name), m_desc(desc), m_id(in_id), m_test_fun(fun), m_args(args)
+    : m_name(name), m_desc(desc), m_id(in_id), m_test_fun(fun), m_args(args), m_is_logic(false)
   {
     m_prop_id_ave = Apto::FormatStr("environment.triggers.%s.average", (const char*)name);
     m_prop_id_count = Apto::FormatStr("environment.triggers.%s.count", (const char*)name);
@@ -62,6 +63,10 @@ public:
   int GetID() const { return m_id; }
   tTaskTest GetTestFun() const { return m_test_fun; }
   
+  // Logic tasks are determined entirely by the logic id, see cTaskLib::TestLogicTask()
+  bool IsLogic() const { return m_is_logic; }
+  void SetIsLogic(bool is_logic) { m_is_logic = is_logic; }
+  
   const Apto::String& AveragePropertyID() const { return m_prop_id_ave; }
   const Apto::String& CountPropertyID() const { return m_prop_id_count; }
   
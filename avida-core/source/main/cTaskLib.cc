@@ -366,6 +366,74 @@ void cTaskLib::NewTask(const cString& name, const cString& desc, tTaskTest task_
   const int id = task_array.GetSize();
   task_array.Resize(id + 1);
   task_array[id] = new cTaskEntry(name, desc, id, task_fun, args);
+  
+  if (IsLogicTest(task_fun)) AddLogicTask(id);
+}
+
+
+bool cTaskLib::IsLogicTest(tTaskTest task_fun)
+{
+  // The 1-, 2- and 3-input logic tests, which only examine the logic id of the task context
+  static const tTaskTest logic_tests[] = {
+    &cTaskLib::Task_Not, &cTaskLib::Task_Nand, &cTaskLib::Task_And, &cTaskLib::Task_OrNot, &cTaskLib::Task_Or,
+    &cTaskLib::Task_AndNot, &cTaskLib::Task_Nor, &cTaskLib::Task_Xor, &cTaskLib::Task_Equ,
+    &cTaskLib::Task_Logic3in_AA, &cTaskLib::Task_Logic3in_AB, &cTaskLib::Task_Logic3in_AC,
+    &cTaskLib::Task_Logic3in_AD, &cTaskLib::Task_Logic3in_AE, &cTaskLib::Task_Logic3in_AF,
+    &cTaskLib::Task_Logic3in_AG, &cTaskLib::Task_Logic3in_AH, &cTaskLib::Task_Logic3in_AI,
+    &cTaskLib::Task_Logic3in_AJ, &cTaskLib::Task_Logic3in_AK, &cTaskLib::Task_Logic3in_AL,
+    &cTaskLib::Task_Logic3in_AM, &cTaskLib::Task_Logic3in_AN, &cTaskLib::Task_Logic3in_AO,
+    &cTaskLib::Task_Logic3in_AP, &cTaskLib::Task_Logic3in_AQ, &cTaskLib::Task_Logic3in_AR,
+    &cTaskLib::Task_Logic3in_AS, &cTaskLib::Task_Logic3in_AT, &cTaskLib::Task_Logic3in_AU,
+    &cTaskLib::Task_Logic3in_AV, &cTaskLib::Task_Logic3in_AW, &cTaskLib::Task_Logic3in_AX,
+    &cTaskLib::Task_Logic3in_AY, &cTaskLib::Task_Logic3in_AZ, &cTaskLib::Task_Logic3in_BA,
+    &cTaskLib::Task_Logic3in_BB, &cTaskLib::Task_Logic3in_BC, &cTaskLib::Task_Logic3in_BD,
+    &cTaskLib::Task_Logic3in_BE, &cTaskLib::Task_Logic3in_BF, &cTaskLib::Task_Logic3in_BG,
+    &cTaskLib::Task_Logic3in_BH, &cTaskLib::Task_Logic3in_BI, &cTaskLib::Task_Logic3in_BJ,
+    &cTaskLib::Task_Logic3in_BK, &cTaskLib::Task_Logic3in_BL, &cTaskLib::Task_Logic3in_BM,
+    &cTaskLib::Task_Logic3in_BN, &cTaskLib::Task_Logic3in_BO, &cTaskLib::Task_Logic3in_BP,
+    &cTaskLib::Task_Logic3in_BQ, &cTaskLib::Task_Logic3in_BR, &cTaskLib::Task_Logic3in_BS,
+    &cTaskLib::Task_Logic3in_BT, &cTaskLib::Task_Logic3in_BU, &cTaskLib::Task_Logic3in_BV,
+    &cTaskLib::Task_Logic3in_BW, &cTaskLib::Task_Logic3in_BX, &cTaskLib::Task_Logic3in_BY,
+    &cTaskLib::Task_Logic3in_BZ, &cTaskLib::Task_Logic3in_CA, &cTaskLib::Task_Logic3in_CB,
+    &cTaskLib::Task_Logic3in_CC, &cTaskLib::Task_Logic3in_CD, &cTaskLib::Task_Logic3in_CE,
+    &cTaskLib::Task_Logic3in_CF, &cTaskLib::Task_Logic3in_CG, &cTaskLib::Task_Logic3in_CH,
+    &cTaskLib::Task_Logic3in_CI, &cTaskLib::Task_Logic3in_CJ, &cTaskLib::Task_Logic3in_CK,
+    &cTaskLib::Task_Logic3in_CL, &cTaskLib::Task_Logic3in_CM, &cTaskLib::Task_Logic3in_CN,
+    &cTaskLib::Task_Logic3in_CO, &cTaskLib::Task_Logic3in_CP
+  };
+  
+  const int num_tests = sizeof(logic_tests) / sizeof(logic_tests[0]);
+  for (int i = 0; i < num_tests; i++) if (logic_tests[i] == task_fun) return true;
+  return false;
+}
+
+
+void cTaskLib::AddLogicTask(int task_id)
+{
+  // Widen the table if this task id does not fit in the current row size
+  const int words = (task_id >> 5) + 1;
+  if (words > m_logic_words) {
+    Apto::Array<unsigned int> table(256 * words);
+    table.SetAll(0);
+    for (int logic_id = 0; logic_id < 256; logic_id++) {
+      for (int w = 0; w < m_logic_words; w++) table[logic_id * words + w] = m_logic_table[logic_id * m_logic_words + w];
+    }
+    m_logic_table = table;
+    m_logic_words = words;
+  }
+  
+  // Evaluate the task once for every possible logic id
+  tBuffer<int> empty_buffer(1);
+  tList<tBuffer<int> > empty_list;
+  Apto::Array<int, Apto::Smart> empty_mem;
+  cTaskContext ctx(NULL, empty_buffer, empty_buffer, empty_list, empty_list, empty_mem);
+  ctx.SetTaskEntry(task_array[task_id]);
+  for (int logic_id = 0; logic_id < 256; logic_id++) {
+    ctx.SetLogicId(logic_id);
+    if (TestOutput(ctx) > 0.0) m_logic_table[logic_id * m_logic_words + (task_id >> 5)] |= 1u << (task_id & 31);
+  }
+  
+  task_array[task_id]->SetIsLogic(true);
 }
 
 
@@ -39,6 +39,11 @@ private:
   cWorld* m_world;
   Apto::Array<cTaskEntry*> task_array;
 
+  // Logic tasks succeed or fail based solely on the logic id computed by SetupTests, so their outcomes are
+  // precomputed as tasks are added.  Row logic_id holds m_logic_words words, with bit task_id set on success.
+  Apto::Array<unsigned int> m_logic_table;
+  int m_logic_words;
+
   // What extra information should be sent along when we are evaluating
   // which tasks have been performed?
   bool use_neighbor_input;
@@ -57,7 +62,7 @@ private:
   cTaskLib& operator=(const cTaskLib&); // @not_implemented
 
 public:
-  cTaskLib(cWorld* world) : m_world(world), use_neighbor_input(false), use_neighbor_output(false) { ; }
+  cTaskLib(cWorld* world) : m_world(world), m_logic_words(0), use_neighbor_input(false), use_neighbor_output(false) { ; }
   ~cTaskLib();
 
   int GetSize() const { return task_array.GetSize(); }
@@ -68,6 +73,12 @@ public:
 
   void SetupTests(cTaskContext& ctx) const;
   inline double TestOutput(cTaskContext& ctx) const { return (this->*(ctx.GetTaskEntry()->GetTestFun()))(ctx); }
+  inline double TestLogicTask(int logic_id, int task_id) const
+  {
+    assert(task_array[task_id]->IsLogic());
+    if (logic_id < 0) return 0.0;
+    return ((m_logic_table[logic_id * m_logic_words + (task_id >> 5)] >> (task_id & 31)) & 1) ? 1.0 : 0.0;
+  }
 
   bool UseNeighborInput() const { return use_neighbor_input; }
   bool UseNeighborOutput() const { return use_neighbor_output; }
@@ -88,6 +99,9 @@ private:
 
   inline double FractionalReward(unsigned int supplied, unsigned int correct);  
 
+  static bool IsLogicTest(tTaskTest task_fun);
+  void AddLogicTask(int task_id);
+
   // All tasks must be declared here, taking a cTaskContext reference as the sole input and
   // returning a double between 0.0 and 1.0 indicating the quality of how well the task was
   // performed.
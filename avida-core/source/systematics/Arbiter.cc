@@ -49,6 +49,11 @@ bool Avida::Systematics::Arbiter::LegacySave(void*) const
   return false;
 }
 
+bool Avida::Systematics::Arbiter::LegacySaveProperties(void*) const
+{
+  return false;
+}
+
 Avida::Systematics::GroupPtr Avida::Systematics::Arbiter::LegacyLoad(void*)
 {
   return GroupPtr();
@@ -171,6 +171,13 @@ void Avida::Systematics::CladeArbiter::UpdateProvidedValues(Update current_updat
 }
 
 
+bool Avida::Systematics::CladeArbiter::SupportsParallelUpdate() const
+{
+  // UpdateProvidedValues only reads the clades and writes the arbiter's own statistics
+  return true;
+}
+
+
 Avida::Data::PackagePtr Avida::Systematics::CladeArbiter::GetProvidedValue(const Data::DataID& data_id) const
 {
   Data::PackagePtr rtn;
@@ -136,6 +136,7 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, Un
   , m_name("001-no_name")
   , m_threshold(false)
   , m_active(true)
+  , m_genome_hash(0)
   , m_generation_born(founder->Properties().Get("generation").IntValue())
   , m_update_born(update)
   , m_update_deactivated(-1)
@@ -192,6 +193,7 @@ Avida::Systematics::Genotype::Genotype(GenotypeArbiterPtr mgr, GroupID in_id, vo
 , m_name("001-no_name")
 , m_threshold(false)
 , m_active(false)
+, m_genome_hash(0)
 , m_update_born(-1)
 , m_update_deactivated(-1)
 , m_depth(0)
@@ -382,6 +384,41 @@ bool Avida::Systematics::Genotype::LegacySave(void* dfp) const
   return false;
 }
 
+bool Avida::Systematics::Genotype::LegacySaveProperties(void* prop_p) const
+{
+  // Mirrors the columns written by LegacySave, as consumed by the legacy load constructor
+  Apto::Map<Apto::String, Apto::String>& props = *static_cast<Apto::Map<Apto::String, Apto::String>*>(prop_p);
+  props.Set("id", Apto::AsStr(m_id));
+  props.Set("src", m_src.AsString());
+  props.Set("src_args", m_src.arguments.GetSize() ? m_src.arguments : Apto::String("(none)"));
+  
+  Apto::String str;
+  for (int i = 0; i < m_parents.GetSize(); i++) {
+    if (i > 0) str += ",";
+    str += Apto::AsStr(m_parents[i]->ID());
+  }
+  props.Set("parents", (str.GetSize()) ? str : Apto::String("(none)"));
+  
+  props.Set("num_units", Apto::AsStr(m_num_organisms));
+  props.Set("total_units", Apto::AsStr(m_total_organisms));
+  
+  ConstInstructionSequencePtr seq;
+  seq.DynamicCastFrom(m_genome.Representation());
+  props.Set("length", Apto::AsStr(seq->GetSize()));
+  
+  props.Set("merit", Apto::FormatStr("%.17g", m_merit.Average()));
+  props.Set("gest_time", Apto::FormatStr("%.17g", m_gestation_time.Average()));
+  props.Set("fitness", Apto::FormatStr("%.17g", m_fitness.Average()));
+  
+  props.Set("gen_born", Apto::AsStr(m_generation_born));
+  props.Set("update_born", Apto::AsStr(m_update_born));
+  props.Set("update_deactivated", Apto::AsStr(m_update_deactivated));
+  props.Set("depth", Apto::AsStr(m_depth));
+  m_genome.LegacySaveProperties(prop_p);
+  
+  return true;
+}
+
 
 void Avida::Systematics::Genotype::RemoveActiveReference() const
 {
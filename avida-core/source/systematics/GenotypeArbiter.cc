@@ -40,6 +40,8 @@ Avida::Systematics::GenotypeArbiter::GenotypeArbiter(World* world, const RoleID&
   : Arbiter(role)
   , m_threshold(threshold)
   , m_disable_class(disable_class)
+  , m_active_hash(INITIAL_HASH_SIZE)
+  , m_active_hash_count(0)
   , m_active_sz(1)
   , m_coalescent(NULL)
   , m_best(0)
@@ -86,13 +88,13 @@ void Avida::Systematics::GenotypeArbiter::PerformUpdate(Context&, Update current
 {
   m_cur_update = current_update + 1; // +1 since PerformUpdate happens at end of updates, but m_cur_update is used during
   
-  if (m_active_sz.GetSize() < HASH_SIZE) {
+  if (m_active_sz.GetSize() < m_active_hash.GetSize()) {
     for (int i = 0; i < m_active_sz.GetSize(); i++) {
       Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_sz[i].Begin());
       while (list_it.Next() != NULL) if ((*list_it.Get())->IsThreshold()) (*list_it.Get())->UpdateReset();
     }
   } else {
-    for (int i = 0; i < HASH_SIZE; i++) {
+    for (int i = 0; i < m_active_hash.GetSize(); i++) {
       Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_hash[i].Begin());
       while (list_it.Next() != NULL) if ((*list_it.Get())->IsThreshold()) (*list_it.Get())->UpdateReset();
     }    
@@ -130,10 +132,24 @@ bool Avida::Systematics::GenotypeArbiter::LegacySave(void* dfp) const
   return true;
 }
 
+bool Avida::Systematics::GenotypeArbiter::LegacySaveProperties(void* props_list) const
+{
+  Apto::Array<Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > >& list =
+    *static_cast<Apto::Array<Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > >*>(props_list);
+  Apto::List<GenotypePtr, Apto::SparseVector>::ConstIterator list_it(m_historic.Begin());
+  while (list_it.Next() != NULL) {
+    Apto::SmartPtr<Apto::Map<Apto::String, Apto::String> > props(new Apto::Map<Apto::String, Apto::String>);
+    (*list_it.Get())->LegacySaveProperties(Apto::GetInternalPtr(props));
+    list.Push(props);
+  }
+  return true;
+}
+
 Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::LegacyLoad(void* props)
 {
   GenotypePtr g(new Genotype(thisPtr(), m_next_id++, props));
   m_historic.Push(g, &g->m_handle);
+  m_id_map.Set(g->ID(), g);
   return g;
 }
 
@@ -141,15 +157,7 @@ Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::LegacyLoad(voi
 
 Avida::Systematics::GroupPtr Avida::Systematics::GenotypeArbiter::Group(GroupID g_id)
 {
-  for (int i = m_best; i >= 0; i--) {
-    Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_sz[i].Begin());
-    while (list_it.Next() != NULL) if ((*list_it.Get())->ID() == g_id) return *list_it.Get();
-  }
-  
-  Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
-  while (list_it.Next() != NULL) if ((*list_it.Get())->ID() == g_id) return *list_it.Get();
-  
-  return GroupPtr(NULL);
+  return m_id_map.GetWithDefault(g_id, GenotypePtr(NULL));
 }
 
 
@@ -249,6 +257,13 @@ void Avida::Systematics::GenotypeArbiter::UpdateProvidedValues(Update current_up
 }
 
 
+bool Avida::Systematics::GenotypeArbiter::SupportsParallelUpdate() const
+{
+  // UpdateProvidedValues only reads the genotypes and writes the arbiter's own statistics
+  return true;
+}
+
+
 Avida::Data::PackagePtr Avida::Systematics::GenotypeArbiter::GetProvidedValue(const Data::DataID& data_id) const
 {
   Data::PackagePtr rtn;
@@ -283,7 +298,7 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
   ConstInstructionSequencePtr seq;
   seq.DynamicCastFrom(u->UnitGenome().Representation());
   assert(seq);
-  int list_num = hashGenome(*seq);
+  unsigned int genome_hash = hashGenome(*seq);
   
   GenotypePtr found;
 
@@ -291,41 +306,29 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
   if (hints && hints->Get("id", gid_str)) {
     int gid = Apto::StrAs(gid_str);
     
-    // Search all lists attempting to locate the referenced genotype by ID
-    for (int i = 0; i < m_active_sz.GetSize() && !found; i++) {
-      Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_sz[i].Begin());
-      while (list_it.Next() != NULL) {
-        if ((*list_it.Get())->ID() == gid) {
-          found = *list_it.Get();
-          found->NotifyNewUnit(u);
-          break;
-        }
-      }
-    }
-    
-    if (!found) {
-      Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_historic.Begin());
-      while (list_it.Next() != NULL) {
-        if ((*list_it.Get())->ID() == gid) {
-          found = *list_it.Get();
-          seq.DynamicCastFrom(found->GroupGenome().Representation());
-          assert(seq);
-          
-          m_active_hash[hashGenome(*seq)].Push(found);
-          found->m_handle->Remove(); // Remove from historic list
-          resizeActiveList(found->NumUnits());
-          m_active_sz[found->NumUnits()].PushRear(found, &found->m_handle);
-          found->Reactivate();
-          found->NotifyNewUnit(u);
-          m_tot_genotypes++;
-          if (found->NumUnits() > m_best) {
-            m_best = found->NumUnits();
-            found->SetThreshold();
-            found->SetName(nameGenotype(seq->GetSize()));
-            m_num_threshold++;
-            m_tot_threshold++;
-            notifyListeners(found, EVENT_ADD_THRESHOLD);
-          }          
+    // Locate the referenced genotype by ID
+    if (m_id_map.Get(gid, found)) {
+      if (found->IsActive()) {
+        found->NotifyNewUnit(u);
+      } else {
+        seq.DynamicCastFrom(found->GroupGenome().Representation());
+        assert(seq);
+        
+        found->m_genome_hash = hashGenome(*seq);
+        addActiveHash(found);
+        found->m_handle->Remove(); // Remove from historic list
+        resizeActiveList(found->NumUnits());
+        m_active_sz[found->NumUnits()].PushRear(found, &found->m_handle);
+        found->Reactivate();
+        found->NotifyNewUnit(u);
+        m_tot_genotypes++;
+        if (found->NumUnits() > m_best) {
+          m_best = found->NumUnits();
+          found->SetThreshold();
+          found->SetName(nameGenotype(seq->GetSize()));
+          m_num_threshold++;
+          m_tot_threshold++;
+          notifyListeners(found, EVENT_ADD_THRESHOLD);
         }
       }
     }
@@ -333,9 +336,11 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
   
   // No hints or unable to locate hinted genome, search for a matching genotype
   if (!found) {
+    const int list_num = genome_hash & (m_active_hash.GetSize() - 1);
     Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_hash[list_num].Begin());
     while (list_it.Next() != NULL) {
-      if ((*list_it.Get())->Matches(u)) {
+      // Compare digests first, only falling back to a full comparison when they agree
+      if ((*list_it.Get())->m_genome_hash == genome_hash && (*list_it.Get())->Matches(u)) {
         found = *list_it.Get();
         found->NotifyNewUnit(u);
         break;
@@ -350,7 +355,9 @@ Avida::Systematics::GenotypePtr Avida::Systematics::GenotypeArbiter::ClassifyNew
     } else {
       found = GenotypePtr(new Genotype(thisPtr(), m_next_id++, u, m_cur_update, ConstGroupMembershipPtr(NULL)));
     }
-    m_active_hash[list_num].Push(found);
+    found->m_genome_hash = genome_hash;
+    addActiveHash(found);
+    m_id_map.Set(found->ID(), found);
     resizeActiveList(found->NumUnits());
     m_active_sz[found->NumUnits()].PushRear(found, &found->m_handle);
     m_tot_genotypes++;
@@ -470,13 +477,46 @@ void Avida::Systematics::GenotypeArbiter::setupProvidedData(World* world)
 
 unsigned int Avida::Systematics::GenotypeArbiter::hashGenome(const InstructionSequence& genome) const
 {
-  unsigned int total = 0;
+  // FNV-1a over the genome length and instruction ops
+  unsigned int total = 2166136261u;
   
+  total = (total ^ static_cast<unsigned int>(genome.GetSize())) * 16777619u;
   for (int i = 0; i < genome.GetSize(); i++) {
-    total += (genome[i].GetOp() + 3) * i;
+    total = (total ^ static_cast<unsigned int>(genome[i].GetOp())) * 16777619u;
+  }
+  
+  return total;
+}
+
+void Avida::Systematics::GenotypeArbiter::addActiveHash(GenotypePtr genotype)
+{
+  // Keep the load factor at or below one so that bucket lists stay short
+  if (m_active_hash_count >= m_active_hash.GetSize()) resizeActiveHash(m_active_hash.GetSize() * 2);
+  
+  m_active_hash[genotype->m_genome_hash & (m_active_hash.GetSize() - 1)].Push(genotype);
+  m_active_hash_count++;
+}
+
+void Avida::Systematics::GenotypeArbiter::removeActiveHash(GenotypePtr genotype)
+{
+  m_active_hash[genotype->m_genome_hash & (m_active_hash.GetSize() - 1)].Remove(genotype);
+  m_active_hash_count--;
+}
+
+void Avida::Systematics::GenotypeArbiter::resizeActiveHash(int size)
+{
+  // Collect bucket contents in order, so that the relative order of matching genotypes is preserved when relinked
+  Apto::Array<GenotypePtr, Apto::Smart> genotypes;
+  for (int i = 0; i < m_active_hash.GetSize(); i++) {
+    Apto::List<GenotypePtr, Apto::SparseVector>::Iterator list_it(m_active_hash[i].Begin());
+    while (list_it.Next() != NULL) genotypes.Push(*list_it.Get());
+    m_active_hash[i].Clear();
   }
   
-  return total % HASH_SIZE;
+  m_active_hash.Resize(size);
+  for (int i = 0; i < genotypes.GetSize(); i++) {
+    m_active_hash[genotypes[i]->m_genome_hash & (size - 1)].PushRear(genotypes[i]);
+  }
 }
 
 Apto::String Avida::Systematics::GenotypeArbiter::nameGenotype(int size)
@@ -500,10 +540,7 @@ void Avida::Systematics::GenotypeArbiter::removeGenotype(GenotypePtr genotype)
   if (genotype->ActiveReferenceCount()) return;    
   
   if (genotype->IsActive()) {
-    ConstInstructionSequencePtr seq;
-    seq.DynamicCastFrom(genotype->GroupGenome().Representation());
-    int list_num = hashGenome(*seq);
-    m_active_hash[list_num].Remove(genotype);
+    removeActiveHash(genotype);
     genotype->Deactivate(m_cur_update);
     m_historic.Push(genotype, &genotype->m_handle);
   }
@@ -530,6 +567,8 @@ void Avida::Systematics::GenotypeArbiter::removeGenotype(GenotypePtr genotype)
   
   delete genotype->m_handle;
   genotype->m_handle = NULL;
+  
+  m_id_map.Remove(genotype->ID());
 }
 
 void Avida::Systematics::GenotypeArbiter::updateCoalescent()
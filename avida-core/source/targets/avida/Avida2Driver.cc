@@ -33,6 +33,7 @@
 #include "cHardwareBase.h"
 #include "cHardwareManager.h"
 #include "cOrganism.h"
+#include "cParallelUpdate.h"
 #include "cPopulation.h"
 #include "cPopulationCell.h"
 #include "cStats.h"
@@ -85,6 +86,23 @@ void Avida2Driver::Run()
     ActiveProcessStep = &cPopulation::ProcessStepSpeculative;
   }
   
+  // Batched time slices hand each organism all of its cycles for the update at once
+  const bool batch_slices = m_world->GetConfig().BATCH_TIME_SLICES.Get();
+  if (batch_slices) ActiveProcessStep = &cPopulation::ProcessStep;
+  
+  // Parallel update pre-execution relies upon the speculative execution guarantees.  Implicit reproduction is checked
+  // at the end of every executed instruction, and would divide organisms from the worker threads.
+  cParallelUpdate* parallel_update = NULL;
+  const bool implicit_repro = (m_world->GetConfig().IMPLICIT_REPRO_TIME.Get() ||
+                               m_world->GetConfig().IMPLICIT_REPRO_CPU_CYCLES.Get() ||
+                               m_world->GetConfig().IMPLICIT_REPRO_BONUS.Get() ||
+                               m_world->GetConfig().IMPLICIT_REPRO_END.Get() ||
+                               m_world->GetConfig().IMPLICIT_REPRO_ENERGY.Get());
+  if (ActiveProcessStep == &cPopulation::ProcessStepSpeculative && m_world->GetConfig().PARALLEL_UPDATE_THREADS.Get() != 0 &&
+      !implicit_repro) {
+    parallel_update = new cParallelUpdate(m_world, m_world->GetConfig().PARALLEL_UPDATE_THREADS.Get());
+  }
+  
   cAvidaContext& ctx = m_world->GetDefaultContext();
   Avida::Context new_ctx(this, &m_world->GetRandom());
   
@@ -108,11 +126,17 @@ void Avida2Driver::Run()
     const int UD_size = m_world->CalculateUpdateSize();
     const double step_size = 1.0 / (double) UD_size;
     
-    for (int i = 0; i < UD_size; i++) {
-      if(population.GetNumOrganisms() == 0) {
-        break;
+    if (parallel_update && population.GetNumOrganisms() > 0) parallel_update->PreExecute(ctx);
+    
+    if (batch_slices) {
+      if (population.GetNumOrganisms() > 0) population.ProcessUpdateSlices(ctx, UD_size);
+    } else {
+      for (int i = 0; i < UD_size; i++) {
+        if(population.GetNumOrganisms() == 0) {
+          break;
+        }
+        (population.*ActiveProcessStep)(ctx, step_size, population.ScheduleOrganism());
       }
-      (population.*ActiveProcessStep)(ctx, step_size, population.ScheduleOrganism());
     }
     
     // end of update stats...
@@ -167,6 +191,8 @@ void Avida2Driver::Run()
 			m_done = true;
 		}
   }
+  
+  delete parallel_update;
 }
 
 void Avida2Driver::Abort(Avida::AbortCondition condition)
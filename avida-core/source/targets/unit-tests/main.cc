@@ -311,6 +311,82 @@ protected:
   }
 };
 
+#include "cEditDistance.h"
+class cEditDistanceTests : public cUnitTest
+{
+public:
+  const char* GetUnitName() { return "cEditDistance"; }
+protected:
+  // Reference dynamic program, one row at a time
+  int naiveDistance(const unsigned char* seq1, int size1, const unsigned char* seq2, int size2)
+  {
+    int* prev_row = new int[size2 + 1];
+    int* cur_row = new int[size2 + 1];
+    for (int j = 0; j <= size2; j++) prev_row[j] = j;
+    for (int i = 1; i <= size1; i++) {
+      cur_row[0] = i;
+      for (int j = 1; j <= size2; j++) {
+        int best = prev_row[j - 1] + ((seq1[i - 1] == seq2[j - 1]) ? 0 : 1);
+        if (prev_row[j] + 1 < best) best = prev_row[j] + 1;
+        if (cur_row[j - 1] + 1 < best) best = cur_row[j - 1] + 1;
+        cur_row[j] = best;
+      }
+      int* temp_row = cur_row;
+      cur_row = prev_row;
+      prev_row = temp_row;
+    }
+    const int value = prev_row[size2];
+    delete [] cur_row;
+    delete [] prev_row;
+    return value;
+  }
+
+  void RunTests()
+  {
+    cEditDistance ed;
+
+    const unsigned char* kitten = reinterpret_cast<const unsigned char*>("kitten");
+    const unsigned char* sitting = reinterpret_cast<const unsigned char*>("sitting");
+    ReportTestResult("Short Strings", (ed.Distance(kitten, 6, sitting, 7) == 3));
+    ReportTestResult("Empty Sequence", (ed.Distance(kitten, 0, sitting, 7) == 7));
+    ReportTestResult("Bounded (within)", (ed.Distance(kitten, 6, sitting, 7, 3) == 3));
+    ReportTestResult("Bounded (exceeded)", (ed.Distance(kitten, 6, sitting, 7, 2) == 3));
+
+    // Random sequences spanning several words, both unrelated and derived from one another by a few edits
+    unsigned int seed = 1;
+    unsigned char seq1[400];
+    unsigned char seq2[410];
+    int exact_failures = 0;
+    int bounded_failures = 0;
+    for (int trial = 0; trial < 200; trial++) {
+      const int alphabet = (trial % 3 == 0) ? 4 : 26;
+      seed = seed * 1103515245 + 12345;
+      const int size1 = 1 + (seed >> 16) % 399;
+      for (int i = 0; i < size1; i++) {
+        seed = seed * 1103515245 + 12345;
+        seq1[i] = (seed >> 16) % alphabet;
+      }
+      int size2 = 0;
+      for (int i = 0; i < size1; i++) {
+        seed = seed * 1103515245 + 12345;
+        const int roll = (trial % 2) ? ((seed >> 16) % 1000) : 0;
+        if (roll == 1) continue;                                      // deletion
+        if (roll == 2 && size2 < 409) seq2[size2++] = (seed >> 8) % alphabet;  // insertion
+        seq2[size2++] = (roll == 3) ? ((seed >> 8) % alphabet) : seq1[i];      // point mutation
+      }
+
+      const int expected = naiveDistance(seq1, size1, seq2, size2);
+      if (ed.Distance(seq1, size1, seq2, size2) != expected) exact_failures++;
+      for (int max_dist = 0; max_dist < 12; max_dist += 3) {
+        const int bounded = (expected > max_dist) ? (max_dist + 1) : expected;
+        if (ed.Distance(seq2, size2, seq1, size1, max_dist) != bounded) bounded_failures++;
+      }
+    }
+    ReportTestResult("Multi-Word Sequences", (exact_failures == 0));
+    ReportTestResult("Banded Early Cutoff", (bounded_failures == 0));
+  }
+};
+
 
 
 
@@ -333,6 +409,7 @@ int main(int argc, const char* argv[])
   
   TEST(cRawBitArray);
   TEST(cBitArray);
+  TEST(cEditDistance);
   
   if (failed == 0)
     cout << "All unit tests passed." << endl;
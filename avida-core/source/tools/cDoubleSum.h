@@ -69,6 +69,15 @@ public:
     s1 -= w_val;
     s2 -= w_val * w_val;
   }
+
+  // Combine with a sum gathered separately, as if its values had been added here
+  void Merge(const cDoubleSum& other)
+  {
+    n += other.n;
+    s1 += other.s1;
+    s2 += other.s2;
+    if (other.max > max) max = other.max;
+  }
 };
 
 #endif
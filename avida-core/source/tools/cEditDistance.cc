@@ -0,0 +1,152 @@
+/*
+ *  cEditDistance.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cEditDistance.h"
+
+#include <cassert>
+
+
+int cEditDistance::Distance(const unsigned char* seq1, int size1, const unsigned char* seq2, int size2, int max_dist)
+{
+  // Matching prefixes and suffixes never change the distance, strip them before doing any real work
+  int min_size = (size1 < size2) ? size1 : size2;
+  int front = 0;
+  while (front < min_size && seq1[front] == seq2[front]) front++;
+  seq1 += front; size1 -= front;
+  seq2 += front; size2 -= front;
+  min_size -= front;
+  while (min_size > 0 && seq1[size1 - 1] == seq2[size2 - 1]) {
+    size1--; size2--; min_size--;
+  }
+
+  const int size_diff = (size1 > size2) ? (size1 - size2) : (size2 - size1);
+  if (max_dist >= 0 && size_diff > max_dist) return max_dist + 1;
+  if (min_size == 0) return size_diff;
+
+  // The shorter sequence is the pattern, so that it spans as few words as possible
+  if (size1 < size2) return distance(seq2, size2, seq1, size1, max_dist);
+  return distance(seq1, size1, seq2, size2, max_dist);
+}
+
+
+unsigned char* cEditDistance::GetBuffer(int which, int size)
+{
+  assert(which == 0 || which == 1);
+  if (size < 1) size = 1;
+  if (m_buf[which].GetSize() < size) m_buf[which].Resize(size);
+  return &m_buf[which][0];
+}
+
+
+int cEditDistance::distance(const unsigned char* text, int n, const unsigned char* pattern, int m, int max_dist)
+{
+  assert(m > 0 && n >= m);
+
+  const tWord high_bit = tWord(1) << (WORD_BITS - 1);
+  const tWord last_bit = tWord(1) << ((m - 1) % WORD_BITS);
+  const int num_blocks = (m + WORD_BITS - 1) / WORD_BITS;
+  const bool bounded = (max_dist >= 0);
+  const int k = bounded ? max_dist : n;  // no distance exceeds n, so the band then covers every row
+
+  // Build the match masks for the symbols that occur in the pattern
+  for (int i = 0; i < 256; i++) m_slot[i] = 0;
+  int num_symbols = 0;
+  for (int i = 0; i < m; i++) if (m_slot[pattern[i]] == 0) m_slot[pattern[i]] = ++num_symbols;
+  m_peq.ResizeClear((num_symbols + 1) * num_blocks);
+  m_peq.SetAll(0);
+  for (int i = 0; i < m; i++) {
+    m_peq[m_slot[pattern[i]] * num_blocks + i / WORD_BITS] |= tWord(1) << (i % WORD_BITS);
+  }
+
+  m_pv.ResizeClear(num_blocks);
+  m_mv.ResizeClear(num_blocks);
+  m_score.ResizeClear(num_blocks);
+
+  // Column zero is the distance from the empty text, D[i][0] = i.  Blocks below the band are brought in as needed.
+  int first_block = 0;
+  int last_block = (((m < k) ? m : k) - 1) / WORD_BITS;
+  if (last_block < 0) last_block = 0;
+  for (int b = 0; b <= last_block; b++) {
+    m_pv[b] = ~tWord(0);
+    m_mv[b] = 0;
+    m_score[b] = ((b + 1) * WORD_BITS < m) ? (b + 1) * WORD_BITS : m;
+  }
+
+  for (int col = 1; col <= n; col++) {
+    // Rows beyond col + k cannot be reached within the bound.  A new block starts out as if every cell were one more
+    // than the one above it, which never underestimates the true values, so paths within the bound are unaffected.
+    const int needed_row = (m < col + k) ? m : (col + k);
+    while (last_block < (needed_row - 1) / WORD_BITS) {
+      last_block++;
+      m_pv[last_block] = ~tWord(0);
+      m_mv[last_block] = 0;
+      const int bottom_row = ((last_block + 1) * WORD_BITS < m) ? (last_block + 1) * WORD_BITS : m;
+      m_score[last_block] = m_score[last_block - 1] + bottom_row - last_block * WORD_BITS;
+    }
+
+    const tWord* eq_row = &m_peq[m_slot[text[col - 1]] * num_blocks];
+    int hin = 1;  // the top row is D[0][j] = j, and dropped blocks above are likewise assumed to grow by one
+    for (int b = first_block; b <= last_block; b++) {
+      const tWord bottom = (b == num_blocks - 1) ? last_bit : high_bit;
+      const tWord pv = m_pv[b];
+      const tWord mv = m_mv[b];
+      tWord eq = eq_row[b];
+
+      const tWord xv = eq | mv;
+      if (hin < 0) eq |= 1;
+      const tWord xh = (((eq & pv) + pv) ^ pv) | eq;
+      tWord ph = mv | ~(xh | pv);
+      tWord mh = pv & xh;
+
+      int hout = 0;
+      if (ph & bottom) hout = 1;
+      else if (mh & bottom) hout = -1;
+
+      ph <<= 1;
+      mh <<= 1;
+      if (hin < 0) mh |= 1;
+      else if (hin > 0) ph |= 1;
+
+      m_pv[b] = mh | ~(xv | ph);
+      m_mv[b] = ph & xv;
+      m_score[b] += hout;
+      hin = hout;
+    }
+
+    if (bounded) {
+      // Every cell of a block whose last row lies more than k rows above the current column exceeds the bound
+      while (first_block < last_block && col - (first_block + 1) * WORD_BITS > k) first_block++;
+
+      // Scores change by at most one per row, so the best cell of a block is at least its last row score less the
+      // number of rows above it.  Costs never decrease along a path; once every cell exceeds k, so does the result.
+      bool reachable = false;
+      for (int b = first_block; b <= last_block && !reachable; b++) {
+        const int rows = (b == num_blocks - 1) ? (m - b * WORD_BITS) : WORD_BITS;
+        if (m_score[b] - (rows - 1) <= k) reachable = true;
+      }
+      if (!reachable) return k + 1;
+    }
+  }
+
+  assert(last_block == num_blocks - 1);
+  const int dist = m_score[num_blocks - 1];
+  return (bounded && dist > k) ? (k + 1) : dist;
+}
@@ -0,0 +1,65 @@
+/*
+ *  cEditDistance.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cEditDistance_h
+#define cEditDistance_h
+
+#include "apto/core.h"
+
+
+// cEditDistance computes the Levenshtein distance between two byte sequences with the bit-parallel algorithm of Myers,
+// in the multi-word formulation of Hyyrö, so that each text symbol costs one pass over ceil(m / 64) machine words.
+// A maximum distance may be supplied, in which case only the diagonal band that can hold a path of that cost is
+// computed and the search stops as soon as no such path remains; any distance above the bound is reported as
+// max_dist + 1.  An instance holds its working storage between calls and is not safe to share between threads.
+
+class cEditDistance
+{
+private:
+  typedef unsigned long long tWord;
+  static const int WORD_BITS = 64;
+
+  int m_slot[256];                      // symbol -> row of m_peq, 0 is the all-zero row for symbols not in the pattern
+  Apto::Array<tWord> m_peq;             // match masks, one row of num_blocks words per distinct pattern symbol
+  Apto::Array<tWord> m_pv;              // positive vertical deltas, per block
+  Apto::Array<tWord> m_mv;              // negative vertical deltas, per block
+  Apto::Array<int> m_score;             // score of the last row of each block
+  Apto::Array<unsigned char> m_buf[2];  // scratch copies of sequences handed out by GetBuffer
+
+
+  cEditDistance(const cEditDistance&); // @not_implemented
+  cEditDistance& operator=(const cEditDistance&); // @not_implemented
+
+public:
+  cEditDistance() { ; }
+  ~cEditDistance() { ; }
+
+  // Returns the edit distance, or max_dist + 1 if it exceeds a non-negative max_dist
+  int Distance(const unsigned char* seq1, int size1, const unsigned char* seq2, int size2, int max_dist = -1);
+
+  // Scratch space that callers may use to convert their sequences to bytes without allocating on every call
+  unsigned char* GetBuffer(int which, int size);
+
+private:
+  int distance(const unsigned char* text, int n, const unsigned char* pattern, int m, int max_dist);
+};
+
+#endif
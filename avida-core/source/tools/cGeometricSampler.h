@@ -0,0 +1,88 @@
+/*
+ *  cGeometricSampler.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cGeometricSampler_h
+#define cGeometricSampler_h
+
+#include "apto/rng.h"
+
+#include <climits>
+#include <cmath>
+
+
+// cGeometricSampler stands in for a long run of independent trials that each succeed with the same probability, such
+// as the mutation test of every copied instruction.  Instead of a random number per trial, it draws the number of
+// failures before the next success from the geometric distribution, so that the random number generator is only
+// consulted once per success.  The successes have exactly the distribution of the individual trials, except that a run
+// of failures is capped at INT_MAX trials.  The run of failures may span any number of calls; when the probability
+// changes a new one is drawn, which is equally exact as the trials have no memory.
+
+class cGeometricSampler
+{
+private:
+  double m_prob;
+  double m_failures;  // trials left to fail before the next success
+
+public:
+  cGeometricSampler() : m_prob(0.0), m_failures(0.0) { ; }
+
+  // Run the trials from through end - 1, returning the first that succeeds (the trials after it are not run), or -1
+  inline int NextSuccess(Apto::Random& rng, double prob, int from, int end);
+
+  // Run a single trial
+  inline bool Test(Apto::Random& rng, double prob) { return NextSuccess(rng, prob, 0, 1) == 0; }
+
+private:
+  inline double drawFailures(Apto::Random& rng) const;
+};
+
+
+inline int cGeometricSampler::NextSuccess(Apto::Random& rng, double prob, int from, int end)
+{
+  if (prob <= 0.0 || from >= end) return -1;
+  if (prob != m_prob) {
+    m_prob = prob;
+    m_failures = drawFailures(rng);
+  }
+
+  const double trials = end - from;
+  if (m_failures >= trials) {
+    m_failures -= trials;
+    return -1;
+  }
+
+  const int success = from + (int)m_failures;
+  m_failures = drawFailures(rng);
+  return success;
+}
+
+inline double cGeometricSampler::drawFailures(Apto::Random& rng) const
+{
+  if (m_prob >= 1.0) return 0.0;
+
+  // Inversion of the geometric distribution, 1 - GetDouble() is never zero.  log1p keeps the denominator nonzero for
+  // probabilities too small to change 1.0 - m_prob, and the count is capped so that it always converts to an int.
+  const double failures = std::floor(std::log(1.0 - rng.GetDouble()) / log1p(-m_prob));
+  if (!(failures < (double)INT_MAX)) return (double)INT_MAX;
+  return failures;
+}
+
+#endif
@@ -0,0 +1,556 @@
+/*
+ *  cGridStream.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cGridStream.h"
+
+#include <cstring>
+
+#ifdef AVD_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+
+static const char HEADER_MAGIC[8] = { 'A', 'V', 'G', 'R', 'I', 'D', 'S', 0 };
+static const char INDEX_MAGIC[8] = { 'A', 'V', 'G', 'S', 'I', 'N', 'D', 'X' };
+
+
+static inline void putU32(unsigned char* out, unsigned int value)
+{
+  for (int i = 0; i < 4; i++) out[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+static inline void putU64(unsigned char* out, unsigned long long value)
+{
+  for (int i = 0; i < 8; i++) out[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+static inline unsigned int getU32(const unsigned char* in)
+{
+  unsigned int value = 0;
+  for (int i = 3; i >= 0; i--) value = (value << 8) | in[i];
+  return value;
+}
+
+static inline unsigned long long getU64(const unsigned char* in)
+{
+  unsigned long long value = 0;
+  for (int i = 7; i >= 0; i--) value = (value << 8) | in[i];
+  return value;
+}
+
+static inline int putVarint(unsigned char* out, int pos, unsigned long long value)
+{
+  while (value >= 0x80) {
+    out[pos++] = static_cast<unsigned char>(value | 0x80);
+    value >>= 7;
+  }
+  out[pos++] = static_cast<unsigned char>(value);
+  return pos;
+}
+
+static inline bool getVarint(const unsigned char* in, int size, int& pos, unsigned long long& value)
+{
+  value = 0;
+  for (int shift = 0; pos < size && shift < 64; shift += 7) {
+    const unsigned char byte = in[pos++];
+    value |= static_cast<unsigned long long>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) return true;
+  }
+  return false;
+}
+
+static inline unsigned long long doubleBits(double value)
+{
+  unsigned long long bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+static inline double bitsDouble(unsigned long long bits)
+{
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+static bool seekTo(FILE* fp, long long offset)
+{
+#if APTO_PLATFORM(WINDOWS)
+  return _fseeki64(fp, offset, SEEK_SET) == 0;
+#else
+  return fseeko(fp, offset, SEEK_SET) == 0;
+#endif
+}
+
+static long long fileSize(FILE* fp)
+{
+#if APTO_PLATFORM(WINDOWS)
+  if (_fseeki64(fp, 0, SEEK_END) != 0) return -1;
+  return _ftelli64(fp);
+#else
+  if (fseeko(fp, 0, SEEK_END) != 0) return -1;
+  return ftello(fp);
+#endif
+}
+
+
+cGridStreamWriter::cGridStreamWriter()
+  : m_fp(NULL), m_width(0), m_height(0), m_type(cGridStream::CELL_INT), m_keyframe_interval(1), m_deflate(false)
+  , m_offset(0), m_num_frames(0)
+{
+}
+
+
+bool cGridStreamWriter::Open(const cString& path, int width, int height, cGridStream::eCellType type,
+                             int keyframe_interval, bool deflate, cString* error)
+{
+  Close();
+
+  if (width <= 0 || height <= 0) {
+    if (error) error->Set("invalid grid size %dx%d", width, height);
+    return false;
+  }
+
+  m_fp = fopen(path, "wb");
+  if (m_fp == NULL) {
+    if (error) error->Set("unable to open '%s' for writing", (const char*)path);
+    return false;
+  }
+
+  m_width = width;
+  m_height = height;
+  m_type = type;
+  m_keyframe_interval = (keyframe_interval > 0) ? keyframe_interval : 1;
+  m_deflate = deflate;
+#ifndef AVD_HAVE_ZLIB
+  m_deflate = false;
+#endif
+  m_num_frames = 0;
+  m_index.Resize(0);
+
+  const int num_cells = width * height;
+  if (type == cGridStream::CELL_INT) m_prev_int.Resize(num_cells);
+  else m_prev_double.Resize(num_cells);
+
+  // Worst case per cell is a run token followed by a value token and its eight raw bytes
+  m_raw.Resize(num_cells * 20 + 16);
+#ifdef AVD_HAVE_ZLIB
+  if (m_deflate) m_packed.Resize(compressBound(m_raw.GetSize()));
+#endif
+
+  unsigned char header[cGridStream::HEADER_SIZE];
+  memcpy(header, HEADER_MAGIC, 8);
+  putU32(header + 8, cGridStream::VERSION);
+  putU32(header + 12, width);
+  putU32(header + 16, height);
+  putU32(header + 20, type);
+  putU32(header + 24, m_keyframe_interval);
+  putU32(header + 28, (m_deflate) ? cGridStream::FLAG_DEFLATE : 0);
+  if (fwrite(header, cGridStream::HEADER_SIZE, 1, m_fp) != 1) {
+    if (error) error->Set("unable to write to '%s'", (const char*)path);
+    fclose(m_fp);
+    m_fp = NULL;
+    return false;
+  }
+  m_offset = cGridStream::HEADER_SIZE;
+
+  return true;
+}
+
+
+void cGridStreamWriter::Close()
+{
+  if (m_fp == NULL) return;
+
+  // Append the frame index, followed by a fixed size footer that locates it
+  Apto::Array<unsigned char> index(m_num_frames * cGridStream::INDEX_ENTRY_SIZE + cGridStream::FOOTER_SIZE);
+  unsigned char* out = &index[0];
+  for (int i = 0; i < m_num_frames; i++) {
+    putU32(out, m_index[i].update);
+    putU64(out + 4, m_index[i].offset);
+    out[12] = (m_index[i].keyframe) ? 1 : 0;
+    out += cGridStream::INDEX_ENTRY_SIZE;
+  }
+  putU64(out, m_offset);
+  putU32(out + 8, m_num_frames);
+  memcpy(out + 12, INDEX_MAGIC, 8);
+  fwrite(&index[0], index.GetSize(), 1, m_fp);
+
+  fclose(m_fp);
+  m_fp = NULL;
+}
+
+
+bool cGridStreamWriter::WriteFrame(int update, const int* values)
+{
+  if (m_fp == NULL || m_type != cGridStream::CELL_INT) return false;
+
+  const bool keyframe = (m_num_frames % m_keyframe_interval == 0);
+  const int num_cells = m_width * m_height;
+  unsigned char* out = &m_raw[0];
+  int pos = 0;
+  unsigned long long run = 0;
+
+  // Unchanged cells collapse into runs (odd tokens), others store the zigzag encoded change (even tokens)
+  for (int i = 0; i < num_cells; i++) {
+    const unsigned int delta = (keyframe) ? static_cast<unsigned int>(values[i]) :
+                                            (static_cast<unsigned int>(values[i]) - static_cast<unsigned int>(m_prev_int[i]));
+    m_prev_int[i] = values[i];
+    if (delta == 0) {
+      run++;
+      continue;
+    }
+    if (run) {
+      pos = putVarint(out, pos, (run << 1) | 1);
+      run = 0;
+    }
+    const unsigned int zigzag = (delta << 1) ^ (0u - (delta >> 31));
+    pos = putVarint(out, pos, static_cast<unsigned long long>(zigzag) << 1);
+  }
+  if (run) pos = putVarint(out, pos, (run << 1) | 1);
+
+  return writeFrame(update, keyframe, pos);
+}
+
+
+bool cGridStreamWriter::WriteFrame(int update, const double* values)
+{
+  if (m_fp == NULL || m_type != cGridStream::CELL_DOUBLE) return false;
+
+  const bool keyframe = (m_num_frames % m_keyframe_interval == 0);
+  const int num_cells = m_width * m_height;
+  unsigned char* out = &m_raw[0];
+  int pos = 0;
+  unsigned long long run = 0;
+
+  // Changes are the exclusive or of the bit patterns; unchanged cells collapse into runs, others follow a zero token
+  for (int i = 0; i < num_cells; i++) {
+    const unsigned long long bits = doubleBits(values[i]);
+    const unsigned long long change = (keyframe) ? bits : (bits ^ doubleBits(m_prev_double[i]));
+    m_prev_double[i] = values[i];
+    if (change == 0) {
+      run++;
+      continue;
+    }
+    if (run) {
+      pos = putVarint(out, pos, (run << 1) | 1);
+      run = 0;
+    }
+    out[pos++] = 0;
+    putU64(out + pos, change);
+    pos += 8;
+  }
+  if (run) pos = putVarint(out, pos, (run << 1) | 1);
+
+  return writeFrame(update, keyframe, pos);
+}
+
+
+bool cGridStreamWriter::writeFrame(int update, bool keyframe, int raw_size)
+{
+  const unsigned char* data = &m_raw[0];
+  int stored_size = raw_size;
+  bool deflated = false;
+
+#ifdef AVD_HAVE_ZLIB
+  if (m_deflate) {
+    uLongf packed_size = m_packed.GetSize();
+    if (compress2(&m_packed[0], &packed_size, data, raw_size, Z_BEST_SPEED) == Z_OK &&
+        packed_size < static_cast<uLongf>(raw_size)) {
+      data = &m_packed[0];
+      stored_size = static_cast<int>(packed_size);
+      deflated = true;
+    }
+  }
+#endif
+
+  unsigned char header[cGridStream::FRAME_HEADER_SIZE];
+  putU32(header, cGridStream::FRAME_MAGIC);
+  putU32(header + 4, update);
+  header[8] = (keyframe) ? 1 : 0;
+  header[9] = (deflated) ? 1 : 0;
+  header[10] = 0;
+  header[11] = 0;
+  putU32(header + 12, stored_size);
+  putU32(header + 16, raw_size);
+
+  if (fwrite(header, cGridStream::FRAME_HEADER_SIZE, 1, m_fp) != 1) return false;
+  if (stored_size > 0 && fwrite(data, stored_size, 1, m_fp) != 1) return false;
+
+  // Hand each completed frame to the operating system, so that a stream cut short by a crash stays readable
+  fflush(m_fp);
+
+  cGridStream::sFrameInfo info;
+  info.update = update;
+  info.offset = m_offset;
+  info.keyframe = keyframe;
+  m_index.Push(info);
+
+  m_offset += cGridStream::FRAME_HEADER_SIZE + stored_size;
+  m_num_frames++;
+  return true;
+}
+
+
+
+cGridStreamReader::cGridStreamReader()
+  : m_fp(NULL), m_width(0), m_height(0), m_type(cGridStream::CELL_INT), m_keyframe_interval(1), m_flags(0)
+  , m_cur_frame(-1)
+{
+}
+
+
+bool cGridStreamReader::Open(const cString& path, cString* error)
+{
+  Close();
+
+  m_fp = fopen(path, "rb");
+  if (m_fp == NULL) {
+    if (error) error->Set("unable to open '%s'", (const char*)path);
+    return false;
+  }
+
+  unsigned char header[cGridStream::HEADER_SIZE];
+  if (fread(header, cGridStream::HEADER_SIZE, 1, m_fp) != 1 || memcmp(header, HEADER_MAGIC, 8) != 0) {
+    if (error) error->Set("'%s' is not a grid stream", (const char*)path);
+    Close();
+    return false;
+  }
+  if (getU32(header + 8) != static_cast<unsigned int>(cGridStream::VERSION)) {
+    if (error) error->Set("'%s' has unsupported grid stream version %u", (const char*)path, getU32(header + 8));
+    Close();
+    return false;
+  }
+
+  m_width = getU32(header + 12);
+  m_height = getU32(header + 16);
+  const unsigned int type = getU32(header + 20);
+  m_keyframe_interval = getU32(header + 24);
+  m_flags = getU32(header + 28);
+  if (m_width <= 0 || m_height <= 0 || type > cGridStream::CELL_DOUBLE) {
+    if (error) error->Set("'%s' has a corrupt grid stream header", (const char*)path);
+    Close();
+    return false;
+  }
+  m_type = static_cast<cGridStream::eCellType>(type);
+
+  const int num_cells = m_width * m_height;
+  if (m_type == cGridStream::CELL_INT) m_int_values.Resize(num_cells);
+  else m_double_values.Resize(num_cells);
+  m_cur_frame = -1;
+
+  const long long file_size = fileSize(m_fp);
+  if (!readIndex(file_size)) scanFrames(file_size);
+
+  return true;
+}
+
+
+void cGridStreamReader::Close()
+{
+  if (m_fp) fclose(m_fp);
+  m_fp = NULL;
+  m_index.Resize(0);
+  m_cur_frame = -1;
+}
+
+
+int cGridStreamReader::FindFrame(int update) const
+{
+  int low = 0;
+  int high = m_index.GetSize() - 1;
+  int found = -1;
+  while (low <= high) {
+    const int mid = (low + high) / 2;
+    if (m_index[mid].update <= update) {
+      found = mid;
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
+  }
+  return found;
+}
+
+
+bool cGridStreamReader::ReadFrame(int frame, Apto::Array<int>& values)
+{
+  if (m_type != cGridStream::CELL_INT || !decodeTo(frame)) return false;
+  values = m_int_values;
+  return true;
+}
+
+
+bool cGridStreamReader::ReadFrame(int frame, Apto::Array<double>& values)
+{
+  if (!decodeTo(frame)) return false;
+  if (m_type == cGridStream::CELL_DOUBLE) {
+    values = m_double_values;
+  } else {
+    values.Resize(m_int_values.GetSize());
+    for (int i = 0; i < m_int_values.GetSize(); i++) values[i] = m_int_values[i];
+  }
+  return true;
+}
+
+
+bool cGridStreamReader::readIndex(long long file_size)
+{
+  if (file_size < cGridStream::HEADER_SIZE + cGridStream::FOOTER_SIZE) return false;
+
+  unsigned char footer[cGridStream::FOOTER_SIZE];
+  if (!seekTo(m_fp, file_size - cGridStream::FOOTER_SIZE) || fread(footer, cGridStream::FOOTER_SIZE, 1, m_fp) != 1) return false;
+  if (memcmp(footer + 12, INDEX_MAGIC, 8) != 0) return false;
+
+  const long long index_offset = getU64(footer);
+  const int num_frames = getU32(footer + 8);
+  if (index_offset + static_cast<long long>(num_frames) * cGridStream::INDEX_ENTRY_SIZE + cGridStream::FOOTER_SIZE != file_size) {
+    return false;
+  }
+
+  Apto::Array<unsigned char> entries(num_frames * cGridStream::INDEX_ENTRY_SIZE + 1);
+  if (!seekTo(m_fp, index_offset)) return false;
+  if (num_frames > 0 && fread(&entries[0], num_frames * cGridStream::INDEX_ENTRY_SIZE, 1, m_fp) != 1) return false;
+
+  m_index.Resize(num_frames);
+  const unsigned char* in = &entries[0];
+  for (int i = 0; i < num_frames; i++) {
+    m_index[i].update = static_cast<int>(getU32(in));
+    m_index[i].offset = getU64(in + 4);
+    m_index[i].keyframe = (in[12] != 0);
+    if (m_index[i].offset < cGridStream::HEADER_SIZE || m_index[i].offset >= index_offset) {
+      m_index.Resize(0);
+      return false;
+    }
+    in += cGridStream::INDEX_ENTRY_SIZE;
+  }
+  return true;
+}
+
+
+void cGridStreamReader::scanFrames(long long file_size)
+{
+  // Without an index (the writer did not finish), walk the frame headers up to the last complete frame
+  m_index.Resize(0);
+  long long offset = cGridStream::HEADER_SIZE;
+  unsigned char header[cGridStream::FRAME_HEADER_SIZE];
+  while (offset + cGridStream::FRAME_HEADER_SIZE <= file_size) {
+    if (!seekTo(m_fp, offset) || fread(header, cGridStream::FRAME_HEADER_SIZE, 1, m_fp) != 1) break;
+    if (getU32(header) != cGridStream::FRAME_MAGIC) break;
+    const long long stored_size = getU32(header + 12);
+    if (offset + cGridStream::FRAME_HEADER_SIZE + stored_size > file_size) break;
+
+    cGridStream::sFrameInfo info;
+    info.update = static_cast<int>(getU32(header + 4));
+    info.offset = offset;
+    info.keyframe = (header[8] != 0);
+    m_index.Push(info);
+
+    offset += cGridStream::FRAME_HEADER_SIZE + stored_size;
+  }
+}
+
+
+bool cGridStreamReader::decodeTo(int frame)
+{
+  if (m_fp == NULL || frame < 0 || frame >= m_index.GetSize()) return false;
+
+  // Decode forward from the closest keyframe, or from the current frame if that is closer
+  int start = frame;
+  while (start > 0 && !m_index[start].keyframe) start--;
+  if (m_cur_frame >= start && m_cur_frame <= frame) start = m_cur_frame + 1;
+
+  for (int f = start; f <= frame; f++) {
+    if (!decodeFrame(f)) {
+      m_cur_frame = -1;
+      return false;
+    }
+  }
+  m_cur_frame = frame;
+  return true;
+}
+
+
+bool cGridStreamReader::decodeFrame(int frame)
+{
+  unsigned char header[cGridStream::FRAME_HEADER_SIZE];
+  if (!seekTo(m_fp, m_index[frame].offset) || fread(header, cGridStream::FRAME_HEADER_SIZE, 1, m_fp) != 1) return false;
+  if (getU32(header) != cGridStream::FRAME_MAGIC) return false;
+
+  const bool keyframe = (header[8] != 0);
+  const bool deflated = (header[9] != 0);
+  const int stored_size = getU32(header + 12);
+  const int raw_size = getU32(header + 16);
+
+  if (m_stored.GetSize() < stored_size + 1) m_stored.Resize(stored_size + 1);
+  if (stored_size > 0 && fread(&m_stored[0], stored_size, 1, m_fp) != 1) return false;
+
+  const unsigned char* data = &m_stored[0];
+  if (deflated) {
+#ifdef AVD_HAVE_ZLIB
+    if (m_raw.GetSize() < raw_size + 1) m_raw.Resize(raw_size + 1);
+    uLongf unpacked_size = raw_size;
+    if (uncompress(&m_raw[0], &unpacked_size, &m_stored[0], stored_size) != Z_OK ||
+        unpacked_size != static_cast<uLongf>(raw_size)) {
+      return false;
+    }
+    data = &m_raw[0];
+#else
+    return false;  // deflated frames need zlib
+#endif
+  } else if (raw_size != stored_size) {
+    return false;
+  }
+
+  const int num_cells = m_width * m_height;
+  int cell = 0;
+  int pos = 0;
+  while (cell < num_cells) {
+    unsigned long long token;
+    if (!getVarint(data, raw_size, pos, token)) return false;
+
+    if (token & 1) {
+      const unsigned long long run = token >> 1;
+      if (run > static_cast<unsigned long long>(num_cells - cell)) return false;
+      if (keyframe) {
+        for (int i = 0; i < static_cast<int>(run); i++) {
+          if (m_type == cGridStream::CELL_INT) m_int_values[cell + i] = 0;
+          else m_double_values[cell + i] = bitsDouble(0);
+        }
+      }
+      cell += static_cast<int>(run);
+    } else if (m_type == cGridStream::CELL_INT) {
+      const unsigned int zigzag = static_cast<unsigned int>(token >> 1);
+      const unsigned int delta = (zigzag >> 1) ^ (0u - (zigzag & 1));
+      m_int_values[cell] = (keyframe) ? static_cast<int>(delta) :
+                                        static_cast<int>(static_cast<unsigned int>(m_int_values[cell]) + delta);
+      cell++;
+    } else {
+      if (token != 0 || pos + 8 > raw_size) return false;
+      const unsigned long long change = getU64(data + pos);
+      pos += 8;
+      m_double_values[cell] = bitsDouble((keyframe) ? change : (change ^ doubleBits(m_double_values[cell])));
+      cell++;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,168 @@
+/*
+ *  cGridStream.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cGridStream_h
+#define cGridStream_h
+
+#include "apto/core.h"
+
+#include "cString.h"
+
+#include <cstdio>
+
+
+// A grid stream is a single binary file holding a time series of world grids (one value per cell), written one frame
+// per dump rather than one text file per dump.  All values of a stream share a type, integer or double.  Every
+// keyframe_interval frames a keyframe stores the values themselves; the frames between store only the change from
+// the previous frame, in which runs of unchanged cells collapse to a single token.  Frames are deflated individually
+// when Avida is built with zlib (AVD_HAVE_ZLIB).  Closing the writer appends an index of frame offsets, so that
+// readers can seek to any frame by decoding forward from its keyframe; streams that were not closed cleanly are
+// indexed by scanning the frame headers instead.
+//
+// Layout (all fields little endian):
+//   header:  "AVGRIDS" 0, version, width, height, cell type, keyframe interval, flags           (8 + 6 x u32)
+//   frame:   u32 'FRME', i32 update, u8 keyframe, u8 deflated, u16 0, u32 stored size, u32 raw size, data
+//   index:   per frame i32 update, u64 offset, u8 keyframe; then u64 index offset, u32 frame count, "AVGSINDX"
+
+class cGridStream
+{
+public:
+  enum eCellType { CELL_INT = 0, CELL_DOUBLE = 1 };
+
+  static const int VERSION = 1;
+  static const int HEADER_SIZE = 32;
+  static const int FRAME_HEADER_SIZE = 20;
+  static const int INDEX_ENTRY_SIZE = 13;
+  static const int FOOTER_SIZE = 20;
+  static const unsigned int FRAME_MAGIC = 0x454D5246;  // "FRME"
+  static const unsigned int FLAG_DEFLATE = 1;
+
+  struct sFrameInfo
+  {
+    int update;
+    long long offset;
+    bool keyframe;
+  };
+
+private:
+  cGridStream(); // @not_implemented
+};
+
+
+class cGridStreamWriter
+{
+private:
+  FILE* m_fp;
+  int m_width;
+  int m_height;
+  cGridStream::eCellType m_type;
+  int m_keyframe_interval;
+  bool m_deflate;
+  long long m_offset;
+
+  Apto::Array<int> m_prev_int;
+  Apto::Array<double> m_prev_double;
+  Apto::Array<unsigned char> m_raw;
+  Apto::Array<unsigned char> m_packed;
+  Apto::Array<cGridStream::sFrameInfo> m_index;
+  int m_num_frames;
+
+
+  cGridStreamWriter(const cGridStreamWriter&); // @not_implemented
+  cGridStreamWriter& operator=(const cGridStreamWriter&); // @not_implemented
+
+public:
+  cGridStreamWriter();
+  ~cGridStreamWriter() { Close(); }
+
+  // Creates (replacing) the stream file; deflate is ignored when zlib is unavailable
+  bool Open(const cString& path, int width, int height, cGridStream::eCellType type, int keyframe_interval = 32,
+            bool deflate = true, cString* error = NULL);
+  void Close();
+
+  bool IsOpen() const { return m_fp != NULL; }
+  cGridStream::eCellType GetCellType() const { return m_type; }
+  int GetNumFrames() const { return m_num_frames; }
+  long long GetSize() const { return m_offset; }
+
+  // Values are given row by row, width * height of them, and must match the type of the stream
+  bool WriteFrame(int update, const int* values);
+  bool WriteFrame(int update, const double* values);
+
+  void Flush() { if (m_fp) fflush(m_fp); }
+
+private:
+  bool writeFrame(int update, bool keyframe, int raw_size);
+};
+
+
+class cGridStreamReader
+{
+private:
+  FILE* m_fp;
+  int m_width;
+  int m_height;
+  cGridStream::eCellType m_type;
+  int m_keyframe_interval;
+  unsigned int m_flags;
+  Apto::Array<cGridStream::sFrameInfo> m_index;
+
+  // The most recently decoded frame, so that reading frames in order decodes each only once
+  int m_cur_frame;
+  Apto::Array<int> m_int_values;
+  Apto::Array<double> m_double_values;
+  Apto::Array<unsigned char> m_stored;
+  Apto::Array<unsigned char> m_raw;
+
+
+  cGridStreamReader(const cGridStreamReader&); // @not_implemented
+  cGridStreamReader& operator=(const cGridStreamReader&); // @not_implemented
+
+public:
+  cGridStreamReader();
+  ~cGridStreamReader() { Close(); }
+
+  bool Open(const cString& path, cString* error = NULL);
+  void Close();
+
+  bool IsOpen() const { return m_fp != NULL; }
+  int GetWidth() const { return m_width; }
+  int GetHeight() const { return m_height; }
+  cGridStream::eCellType GetCellType() const { return m_type; }
+  int GetKeyframeInterval() const { return m_keyframe_interval; }
+  bool IsDeflated() const { return (m_flags & cGridStream::FLAG_DEFLATE) != 0; }
+
+  int GetNumFrames() const { return m_index.GetSize(); }
+  const cGridStream::sFrameInfo& GetFrameInfo(int frame) const { return m_index[frame]; }
+  int FindFrame(int update) const;  // the last frame at or before update, or -1
+
+  // Decodes a frame, returning width * height values row by row (integer streams are widened for ReadFrame(double))
+  bool ReadFrame(int frame, Apto::Array<int>& values);
+  bool ReadFrame(int frame, Apto::Array<double>& values);
+
+private:
+  bool readIndex(long long file_size);
+  void scanFrames(long long file_size);
+  bool decodeTo(int frame);
+  bool decodeFrame(int frame);
+};
+
+#endif
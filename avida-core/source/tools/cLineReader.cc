@@ -0,0 +1,268 @@
+/*
+ *  cLineReader.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cLineReader.h"
+
+#include <cstring>
+
+#if !APTO_PLATFORM(WINDOWS)
+extern "C" {
+#include <sys/mman.h>
+#include <sys/stat.h>
+}
+#endif
+
+#ifdef AVD_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+
+cLineReader::cLineReader()
+  : m_is_open(false), m_is_compressed(false), m_line_num(0), m_map(NULL), m_map_size(0), m_pos(NULL)
+  , m_fp(NULL), m_gz(NULL), m_buf_start(0), m_buf_end(0), m_eof(false), m_line(NULL), m_line_end(NULL)
+{
+}
+
+
+bool cLineReader::Open(const cString& filename, cString* error)
+{
+  Close();
+  m_filename = filename;
+
+  FILE* fp = fopen(filename, "rb");
+  if (fp == NULL) {
+    if (error) error->Set("unable to open file '%s'", (const char*)filename);
+    return false;
+  }
+
+  // Compressed files are recognized by the gzip magic number rather than by name
+  unsigned char magic[2] = { 0, 0 };
+  const int magic_size = static_cast<int>(fread(magic, 1, 2, fp));
+  m_is_compressed = (magic_size == 2 && magic[0] == 0x1f && magic[1] == 0x8b);
+
+  if (m_is_compressed) {
+    fclose(fp);
+#ifdef AVD_HAVE_ZLIB
+    gzFile gz = gzopen(filename, "rb");
+    if (gz == NULL) {
+      if (error) error->Set("unable to open compressed file '%s'", (const char*)filename);
+      return false;
+    }
+    m_gz = gz;
+#else
+    if (error) error->Set("'%s' is gzip compressed, but this build does not include zlib support", (const char*)filename);
+    return false;
+#endif
+  } else {
+#if !APTO_PLATFORM(WINDOWS)
+    struct stat file_stat;
+    if (fstat(fileno(fp), &file_stat) == 0 && file_stat.st_size > 0) {
+      void* map = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+      if (map != MAP_FAILED) {
+#ifdef MADV_SEQUENTIAL
+        madvise(map, file_stat.st_size, MADV_SEQUENTIAL);
+#endif
+        m_map = static_cast<const char*>(map);
+        m_map_size = file_stat.st_size;
+        m_pos = m_map;
+      }
+    }
+#endif
+    // The mapping remains valid once the file is closed
+    if (m_map) fclose(fp);
+    else m_fp = fp;
+  }
+
+  if (m_map == NULL) {
+    m_buf.Resize(BLOCK_SIZE);
+    m_buf_start = 0;
+    m_buf_end = 0;
+    m_eof = false;
+
+    // The input may be a pipe that cannot be rewound, keep the bytes already consumed
+    if (m_fp) {
+      for (int i = 0; i < magic_size; i++) m_buf[i] = magic[i];
+      m_buf_end = magic_size;
+    }
+  }
+
+  m_is_open = true;
+  m_line_num = 0;
+  return true;
+}
+
+
+void cLineReader::Close()
+{
+#if !APTO_PLATFORM(WINDOWS)
+  if (m_map) munmap(const_cast<char*>(m_map), m_map_size);
+#endif
+#ifdef AVD_HAVE_ZLIB
+  if (m_gz) gzclose(static_cast<gzFile>(m_gz));
+#endif
+  if (m_fp) fclose(m_fp);
+
+  m_map = NULL;
+  m_map_size = 0;
+  m_pos = NULL;
+  m_gz = NULL;
+  m_fp = NULL;
+  m_buf.Resize(0);
+  m_buf_start = 0;
+  m_buf_end = 0;
+  m_eof = false;
+  m_error = "";
+  m_line = NULL;
+  m_line_end = NULL;
+  m_is_open = false;
+  m_is_compressed = false;
+}
+
+
+bool cLineReader::ReadLine()
+{
+  if (!m_is_open) return false;
+
+  if (m_map) {
+    const char* map_end = m_map + m_map_size;
+    if (m_pos >= map_end) return false;
+
+    const char* newline = static_cast<const char*>(memchr(m_pos, '\n', map_end - m_pos));
+    m_line = m_pos;
+    m_line_end = (newline) ? newline : map_end;
+    m_pos = (newline) ? (newline + 1) : map_end;
+  } else {
+    const char* newline = NULL;
+    while (true) {
+      const char* buf = &m_buf[0];
+      newline = static_cast<const char*>(memchr(buf + m_buf_start, '\n', m_buf_end - m_buf_start));
+      if (newline || m_eof) break;
+      fillBuffer();
+    }
+    // A partial line before a failed read is not handed out as if it were the last line
+    if (m_error.GetSize() > 0 && newline == NULL) return false;
+    if (newline == NULL && m_buf_start == m_buf_end) return false;
+
+    const char* buf = &m_buf[0];
+    m_line = buf + m_buf_start;
+    m_line_end = (newline) ? newline : (buf + m_buf_end);
+    m_buf_start = (newline) ? static_cast<int>(newline - buf + 1) : m_buf_end;
+  }
+
+  // Tolerate DOS line endings
+  if (m_line_end > m_line && m_line_end[-1] == '\r') m_line_end--;
+
+  m_line_num++;
+  return true;
+}
+
+
+int cLineReader::SplitLine(Apto::Array<sWord>& words) const
+{
+  int num_words = 0;
+  const char* pos = m_line;
+  while (pos < m_line_end) {
+    while (pos < m_line_end && (*pos == ' ' || *pos == '\t' || *pos == '\r')) pos++;
+    if (pos == m_line_end || *pos == '#') break;
+
+    const char* start = pos;
+    while (pos < m_line_end && *pos != ' ' && *pos != '\t' && *pos != '\r' && *pos != '#') pos++;
+
+    if (num_words == words.GetSize()) words.Resize(num_words * 2 + 16);
+    words[num_words].start = start;
+    words[num_words].size = static_cast<int>(pos - start);
+    num_words++;
+  }
+  return num_words;
+}
+
+
+bool cLineReader::ParseInt(const sWord& word, int& value)
+{
+  // Words are not null terminated (they may end the mapped file), so parse within the word only
+  int pos = 0;
+  bool negative = false;
+  if (pos < word.size && (word.start[pos] == '-' || word.start[pos] == '+')) negative = (word.start[pos++] == '-');
+  if (pos == word.size) return false;
+
+  int result = 0;
+  for (; pos < word.size; pos++) {
+    const char digit = word.start[pos];
+    if (digit < '0' || digit > '9') return false;
+    result = result * 10 + (digit - '0');
+  }
+  value = (negative) ? -result : result;
+  return true;
+}
+
+
+bool cLineReader::fillBuffer()
+{
+  char* buf = &m_buf[0];
+
+  // Move the partial line to the front, growing the buffer if a single line has filled it
+  if (m_buf_start > 0) {
+    memmove(buf, buf + m_buf_start, m_buf_end - m_buf_start);
+    m_buf_end -= m_buf_start;
+    m_buf_start = 0;
+  }
+  if (m_buf_end == m_buf.GetSize()) {
+    m_buf.Resize(m_buf.GetSize() * 2);
+    buf = &m_buf[0];
+  }
+
+  const int count = readBlock(buf + m_buf_end, m_buf.GetSize() - m_buf_end);
+  if (count <= 0) {
+    m_eof = true;
+    return false;
+  }
+  m_buf_end += count;
+  return true;
+}
+
+
+int cLineReader::readBlock(char* dest, int size)
+{
+#ifdef AVD_HAVE_ZLIB
+  if (m_gz) {
+    // A truncated file reads as the end of the input, with the error only reported through gzerror
+    const int count = gzread(static_cast<gzFile>(m_gz), dest, size);
+    if (count <= 0) {
+      int errnum = Z_OK;
+      const char* message = gzerror(static_cast<gzFile>(m_gz), &errnum);
+      if (errnum != Z_OK) {
+        m_error.Set("error reading compressed file %s", message);  // zlib's message starts with the path
+        return -1;
+      }
+    }
+    return count;
+  }
+#endif
+  if (m_fp) {
+    const int count = static_cast<int>(fread(dest, 1, size, m_fp));
+    if (count < size && ferror(m_fp)) {
+      m_error.Set("error reading file '%s'", (const char*)m_filename);
+      return -1;
+    }
+    return count;
+  }
+  return 0;
+}
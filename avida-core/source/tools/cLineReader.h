@@ -0,0 +1,107 @@
+/*
+ *  cLineReader.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cLineReader_h
+#define cLineReader_h
+
+#include "apto/core.h"
+
+#include "cString.h"
+
+#include <cstdio>
+
+
+// cLineReader streams the lines of a (possibly very large) text file without holding the file in memory as strings.
+// Plain files are memory mapped where the platform allows it and read in large blocks otherwise.  Files compressed
+// with gzip are detected by their header and decompressed on the fly, when Avida is built with zlib (AVD_HAVE_ZLIB).
+// Lines are handed out as character ranges that remain valid only until the next call to ReadLine; SplitLine breaks
+// the current line into words in place, so that callers can decide which columns are worth converting.
+
+class cLineReader
+{
+public:
+  struct sWord
+  {
+    const char* start;
+    int size;
+  };
+
+private:
+  static const int BLOCK_SIZE = 1 << 20;
+
+  cString m_filename;
+  bool m_is_open;
+  bool m_is_compressed;
+  int m_line_num;
+
+  // Memory mapped input
+  const char* m_map;
+  long long m_map_size;
+  const char* m_pos;
+
+  // Block input (compressed files, or where mapping is unavailable)
+  FILE* m_fp;
+  void* m_gz;
+  Apto::Array<char> m_buf;
+  int m_buf_start;
+  int m_buf_end;
+  bool m_eof;
+  cString m_error;    // set when a read fails, which also ends the input
+
+  // Current line
+  const char* m_line;
+  const char* m_line_end;
+
+
+  cLineReader(const cLineReader&); // @not_implemented
+  cLineReader& operator=(const cLineReader&); // @not_implemented
+
+public:
+  cLineReader();
+  ~cLineReader() { Close(); }
+
+  // Opens the file, reporting any problem through error when given
+  bool Open(const cString& filename, cString* error = NULL);
+  void Close();
+
+  bool IsOpen() const { return m_is_open; }
+  bool IsCompressed() const { return m_is_compressed; }
+  const cString& GetFilename() const { return m_filename; }
+  int GetLineNum() const { return m_line_num; }
+
+  // Advances to the next line, without its terminator; returns false at the end of the file, or if reading failed
+  bool ReadLine();
+  bool HasError() const { return m_error.GetSize() > 0; }
+  const cString& GetError() const { return m_error; }
+  const char* GetLine() const { return m_line; }
+  int GetLineSize() const { return static_cast<int>(m_line_end - m_line); }
+
+  // Splits the current line into whitespace separated words, stopping at a comment mark; returns the word count
+  int SplitLine(Apto::Array<sWord>& words) const;
+
+  static bool ParseInt(const sWord& word, int& value);
+
+private:
+  bool fillBuffer();
+  int readBlock(char* dest, int size);
+};
+
+#endif
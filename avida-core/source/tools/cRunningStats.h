@@ -40,6 +40,7 @@ public:
   inline void Clear() { m_n = 0.0; m_m1 = 0.0; m_m2 = 0.0; m_m3 = 0.0; m_m4 = 0.0; }
   
   inline void Push(double x);
+  inline void Merge(const cRunningStats& other);  // as if the values pushed onto other had been pushed here
 
   inline double N() const { return m_n; }
   inline double Mean() const { return m_m1; }
@@ -64,4 +65,33 @@ inline void cRunningStats::Push(double x)
   m_m1 += d_n;
 }
 
+inline void cRunningStats::Merge(const cRunningStats& other)
+{
+  if (other.m_n == 0.0) return;
+  if (m_n == 0.0) {
+    *this = other;
+    return;
+  }
+
+  // Pairwise combination of the central moments (Chan et al.; Pebay 2008)
+  const double n_a = m_n;
+  const double n_b = other.m_n;
+  const double n = n_a + n_b;
+  const double d = other.m_m1 - m_m1;
+  const double d_n = d / n;
+  const double d_n2 = d_n * d_n;
+  const double prod = n_a * n_b;
+
+  const double m2 = m_m2 + other.m_m2 + d * d_n * prod;
+  const double m3 = m_m3 + other.m_m3 + d * d_n2 * prod * (n_a - n_b) + 3.0 * d_n * (n_a * other.m_m2 - n_b * m_m2);
+  const double m4 = m_m4 + other.m_m4 + d * d_n2 * d_n * prod * (n_a * n_a - prod + n_b * n_b)
+                    + 6.0 * d_n2 * (n_a * n_a * other.m_m2 + n_b * n_b * m_m2) + 4.0 * d_n * (n_a * other.m_m3 - n_b * m_m3);
+
+  m_n = n;
+  m_m1 += d_n * n_b;
+  m_m2 = m2;
+  m_m3 = m3;
+  m_m4 = m4;
+}
+
 #endif
@@ -22,7 +22,7 @@
 
 #include "cStringUtil.h"
 
-#include "tMatrix.h"
+#include "cEditDistance.h"
 
 #include "AvidaTools.h"
 
@@ -219,56 +219,9 @@ int cStringUtil::Distance(const cString & string1, const cString & string2,
 
 int cStringUtil::EditDistance(const cString & string1, const cString & string2)
 {
-  const int size1 = string1.GetSize();
-  const int size2 = string2.GetSize();
-
-  if (size1 == 0) return size2;
-  if (size2 == 0) return size1;
-
-  int * cur_row  = new int[size1];  // The row we are calculating
-  int * prev_row = new int[size1];  // The last row we calculated
-
-  // Initialize the previous row to record the differece from nothing.
-  for (int i = 0; i < size1; i++) prev_row[i] = i + 1;
-
-  // Loop through all of the other rows
-  for (int i = 0; i < size2; i++) {
-    // Initialize the first entry in the current row.
-    if (string1[0] == string2[i]) cur_row[0] = i;
-    else cur_row[0] = (i < prev_row[0]) ? (i+1) : (prev_row[0] + 1);
-
-    // Move down the cur_row and fill it in.
-    for (int j = 1; j < size1; j++) {
-      // If the values are equal, keep the value in the upper left.
-      if (string1[j] == string2[i]) {
-        cur_row[j] = prev_row[j-1];
-      }
-
-      // Otherwise, set the current position the the minimal of the three
-      // numbers to the upper right in the chart plus one.
-      else {
-        cur_row[j] = (prev_row[j] < prev_row[j-1]) ? prev_row[j] : prev_row[j-1];
-        if (cur_row[j-1] < cur_row[j]) cur_row[j] = cur_row[j-1];
-        cur_row[j]++;
-      }
-    }
-
-    // Swap cur_row and prev_row. (we only really need to move the cur row
-    // over to prev, but this saves us from having to keep re-allocating
-    // new rows.  We recycle!
-    int * temp_row = cur_row;
-    cur_row = prev_row;
-    prev_row = temp_row;
-  }
-
-  // Now that we are done, return the bottom-right corner of the chart.
-
-  const int value = prev_row[size1 - 1];
-
-  delete [] cur_row;
-  delete [] prev_row;
-
-  return value;
+  cEditDistance edit_distance;
+  return edit_distance.Distance(reinterpret_cast<const unsigned char*>(string1.GetData()), string1.GetSize(),
+                                reinterpret_cast<const unsigned char*>(string2.GetData()), string2.GetSize());
 }
 
 int cStringUtil::EditDistance(const cString & string1, const cString & string2,
@@ -280,89 +233,109 @@ int cStringUtil::EditDistance(const cString & string1, const cString & string2,
   if (!size1) return size2;
   if (!size2) return size1;
 
-  tMatrix<double> dist_matrix(size2+1, size1+1);
+  // Costs are kept in whole units so that rows can be filled without floating point; a mutation involving a gap
+  // is one part in UNIT cheaper than any other change, so that gaps are preferentially aligned with each other.
+  const int UNIT = 10000;
+  const int cols = size1 + 1;
+  const char* seq1 = string1.GetData();
+  const char* seq2 = string2.GetData();
 
-  // Keep track of changes in a mut_matrix.
+  // Only two rows of distances are needed, but every change is kept for the traceback, one row after another.
   //  N=None, M=Mutations, I=Insertion, D=Deletion
-  tMatrix<char> mut_matrix(size2+1, size1+1);
+  Apto::Array<char> mut_matrix((size2 + 1) * cols);
+  Apto::Array<int> row_a(cols);
+  Apto::Array<int> row_b(cols);
+  int* prev_row = &row_a[0];
+  int* cur_row = &row_b[0];
 
   // Initialize the first row and col to record the differece from nothing.
-  for (int i = 0; i < size1+1; i++) {
-    dist_matrix(0,i) = (double) i;
-    mut_matrix(0,i) = 'I';
+  for (int j = 0; j < cols; j++) {
+    prev_row[j] = j * UNIT;
+    mut_matrix[j] = 'I';
   }
-  for (int i = 0; i < size2+1; i++) {
-    dist_matrix(i,0) = (double) i;
-    mut_matrix(i,0) = 'D';
-  }
-  mut_matrix(0,0) = 'N';
+  mut_matrix[0] = 'N';
 
   for (int i = 0; i < size2; i++) {
+    const char cur_char = seq2[i];
+    const int del_cost = (cur_char != gap) ? UNIT : 0;
+    char* mut_row = &mut_matrix[(i + 1) * cols];
+    cur_row[0] = (i + 1) * UNIT;
+    mut_row[0] = 'D';
+
     // Move down the cur_row and fill it out.
     for (int j = 0; j < size1; j++) {
       // If the values are equal, keep the value in the upper left.
-      if (string1[j] == string2[i]) {
-        dist_matrix(i+1,j+1) = dist_matrix(i,j);
-        mut_matrix(i+1,j+1) = 'N';
+      if (seq1[j] == cur_char) {
+        cur_row[j + 1] = prev_row[j];
+        mut_row[j + 1] = 'N';
         continue; // Move on to next entry...
       }
 
       // Otherwise, set the current position to the minimal of the three
       // numbers above (insertion), to the left (deletion), or upper left
       // (mutation) in the chart, plus one.
-      double mut_dist = dist_matrix(i,j) + 1;
-      if ((string1[j] == gap) || (string2[i] == gap)) mut_dist -= 0.0001;
-      const double ins_dist = dist_matrix(i+1,j) + (string1[j] != gap);
-      const double del_dist = dist_matrix(i,j+1) + (string2[i] != gap);
+      const int mut_dist = prev_row[j] + UNIT - ((seq1[j] == gap || cur_char == gap) ? 1 : 0);
+      const int ins_dist = cur_row[j] + ((seq1[j] != gap) ? UNIT : 0);
+      const int del_dist = prev_row[j + 1] + del_cost;
 
       if (mut_dist < ins_dist && mut_dist < del_dist) {  // Mutation!
-        dist_matrix(i+1,j+1) = mut_dist;
-        mut_matrix(i+1,j+1) = 'M';
+        cur_row[j + 1] = mut_dist;
+        mut_row[j + 1] = 'M';
       } else if (ins_dist < del_dist) {                  // Insertion!
-        dist_matrix(i+1,j+1) = ins_dist;
-        mut_matrix(i+1,j+1) = 'I';
+        cur_row[j + 1] = ins_dist;
+        mut_row[j + 1] = 'I';
       } else {                                           // Deletion!
-        dist_matrix(i+1,j+1) = del_dist;
-        mut_matrix(i+1,j+1) = 'D';
+        cur_row[j + 1] = del_dist;
+        mut_row[j + 1] = 'D';
       }
     }
+
+    int* temp_row = cur_row;
+    cur_row = prev_row;
+    prev_row = temp_row;
   }
 
-  // Construct the list of changes
+  // Construct the list of changes, last change first
   int pos1 = size1;
   int pos2 = size2;
-  info = "";
+  Apto::Array<cString> changes;
 
   cString mut_string;
   while (pos1 > 0 || pos2 > 0) {
-    if (mut_matrix(pos2, pos1) == 'N') {     
+    const char cur_mut = mut_matrix[pos2 * cols + pos1];
+    if (cur_mut == 'N') {
       pos1--; pos2--;
       continue;
     }
 
     // There is a mutation here; determine the type...
-    const char old_char = (pos2 > 0) ? string2[pos2-1] : '\0';
-    const char new_char = (pos1 > 0) ? string1[pos1-1] : '\0';
+    const char old_char = (pos2 > 0) ? seq2[pos2-1] : '\0';
+    const char new_char = (pos1 > 0) ? seq1[pos1-1] : '\0';
 
-    if (mut_matrix(pos2, pos1) == 'M') {
+    if (cur_mut == 'M') {
       mut_string.Set("M%d%c%c", pos2-1, old_char, new_char);
       pos1--; pos2--;
     }
-    else if (mut_matrix(pos2, pos1) == 'D') {
+    else if (cur_mut == 'D') {
       mut_string.Set("D%d%c", pos2-1, old_char);
       pos2--;
     }
-    else { // if (mut_matrix(pos2, pos1) == 'I') {
+    else { // if (cur_mut == 'I') {
       mut_string.Set("I%d%c", pos1-1, new_char);
       pos1--;
     }
 
-    if (info.GetSize() > 0) mut_string += ",";
-    info.Insert(mut_string);
+    changes.Push(mut_string);
   } 
 
+  info = "";
+  for (int i = changes.GetSize() - 1; i >= 0; i--) {
+    info += changes[i];
+    if (i > 0) info += ",";
+  }
+
   // Now that we are done, return the bottom-right corner of the chart.
-  return (int) dist_matrix(size2, size1);
+  return prev_row[size1] / UNIT;
 }
 
 
@@ -0,0 +1,111 @@
+/*
+ *  cSumTreeScheduler.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cSumTreeScheduler.h"
+
+#include <cassert>
+
+
+cSumTreeScheduler::cSumTreeScheduler(int num_entries, Apto::SmartPtr<Apto::Random> rng)
+  : m_rng(rng), m_num_entries(num_entries), m_leaf_base(1), m_num_dirty(0), m_rebuild(false)
+{
+  int depth = 0;
+  while (m_leaf_base < m_num_entries) {
+    m_leaf_base <<= 1;
+    depth++;
+  }
+
+  m_tree.Resize(2 * m_leaf_base);
+  m_tree.SetAll(0.0);
+  m_is_dirty.Resize(m_leaf_base);
+  m_is_dirty.SetAll(false);
+
+  // Walking up from each dirty leaf costs depth steps, rebuilding the whole tree costs m_leaf_base
+  m_max_dirty = (depth > 0) ? (m_leaf_base / depth) : 1;
+  m_dirty.Resize(m_max_dirty);
+}
+
+cSumTreeScheduler::~cSumTreeScheduler()
+{
+}
+
+
+void cSumTreeScheduler::AdjustPriority(int entry_id, double priority)
+{
+  assert(entry_id >= 0 && entry_id < m_num_entries);
+  assert(priority >= 0.0);
+
+  const int leaf = m_leaf_base + entry_id;
+  if (m_tree[leaf] == priority) return;
+  m_tree[leaf] = priority;
+
+  if (m_rebuild || m_is_dirty[entry_id]) return;
+  if (m_num_dirty == m_max_dirty) {
+    m_rebuild = true;
+    return;
+  }
+  m_is_dirty[entry_id] = true;
+  m_dirty[m_num_dirty++] = entry_id;
+}
+
+
+int cSumTreeScheduler::Next()
+{
+  if (m_num_dirty || m_rebuild) flush();
+
+  const double total = m_tree[1];
+  if (total <= 0.0) return -1;
+
+  double position = m_rng->GetDouble(total);
+  int node = 1;
+  while (node < m_leaf_base) {
+    const int left = node << 1;
+    // Rounding can leave position just past the left subtree, never descend into an empty right subtree
+    if (position < m_tree[left] || m_tree[left + 1] <= 0.0) {
+      node = left;
+    } else {
+      position -= m_tree[left];
+      node = left + 1;
+    }
+  }
+
+  return node - m_leaf_base;
+}
+
+
+void cSumTreeScheduler::flush()
+{
+  if (m_rebuild) {
+    for (int node = m_leaf_base - 1; node > 0; node--) m_tree[node] = m_tree[node << 1] + m_tree[(node << 1) + 1];
+  } else {
+    for (int i = 0; i < m_num_dirty; i++) {
+      int node = (m_leaf_base + m_dirty[i]) >> 1;
+      while (node > 0) {
+        m_tree[node] = m_tree[node << 1] + m_tree[(node << 1) + 1];
+        node >>= 1;
+      }
+    }
+  }
+
+  for (int i = 0; i < m_num_dirty; i++) m_is_dirty[m_dirty[i]] = false;
+  m_num_dirty = 0;
+  m_rebuild = false;
+}
@@ -0,0 +1,71 @@
+/*
+ *  cSumTreeScheduler.h
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef cSumTreeScheduler_h
+#define cSumTreeScheduler_h
+
+#include "apto/core.h"
+#include "apto/rng.h"
+#include "apto/scheduler.h"
+
+
+// cSumTreeScheduler hands out CPU cycles randomly, proportional to priority (merit), like
+// Apto::Scheduler::Probabilistic, but is intended for very large populations.  Priorities are stored in the leaves of
+// an implicit binary sum-tree laid out in a single flat array (root at index 1, children of node i at 2i and 2i + 1).
+// AdjustPriority only writes the leaf and records it as dirty; the interior sums are brought up to date lazily on the
+// next call to Next(), either by walking up from each dirty leaf or, when a large fraction of the population changed
+// (e.g. after an inject or a population load), by a single linear bottom-up rebuild.  Interior nodes are always
+// recomputed from their children rather than adjusted by deltas, so the sums do not accumulate rounding drift.
+
+class cSumTreeScheduler : public Apto::PriorityScheduler
+{
+private:
+  Apto::SmartPtr<Apto::Random> m_rng;
+
+  int m_num_entries;
+  int m_leaf_base;                // index of the first leaf in m_tree (a power of two)
+  Apto::Array<double> m_tree;     // implicit sum-tree, m_tree[0] is unused
+
+  Apto::Array<int> m_dirty;       // leaves changed since the last flush
+  Apto::Array<bool> m_is_dirty;
+  int m_num_dirty;
+  int m_max_dirty;                // beyond this many dirty leaves a full rebuild is cheaper
+  bool m_rebuild;
+
+
+  void flush();
+
+
+  cSumTreeScheduler(); // @not_implemented
+  cSumTreeScheduler(const cSumTreeScheduler&); // @not_implemented
+  cSumTreeScheduler& operator=(const cSumTreeScheduler&); // @not_implemented
+
+public:
+  cSumTreeScheduler(int num_entries, Apto::SmartPtr<Apto::Random> rng);
+  ~cSumTreeScheduler();
+
+  void AdjustPriority(int entry_id, double priority);
+  int Next();
+
+  double GetPriority(int entry_id) const { return m_tree[m_leaf_base + entry_id]; }
+};
+
+#endif
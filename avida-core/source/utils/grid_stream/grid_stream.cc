@@ -0,0 +1,127 @@
+/*
+ *  grid_stream.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Reads the grid streams written by the Dump*Grid actions (given a file name ending in .gstream): summarizes a
+// stream, prints the grid of a single update, or converts the whole stream back into the per update text files that
+// the actions write otherwise.
+
+#include "apto/core.h"
+
+#include "cGridStream.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+
+static void printGrid(ostream& out, const cGridStreamReader& stream, const Apto::Array<double>& double_values,
+                      const Apto::Array<int>& int_values)
+{
+  for (int j = 0; j < stream.GetHeight(); j++) {
+    for (int i = 0; i < stream.GetWidth(); i++) {
+      const int cell = j * stream.GetWidth() + i;
+      if (stream.GetCellType() == cGridStream::CELL_INT) out << int_values[cell] << " ";
+      else out << double_values[cell] << " ";
+    }
+    out << "\n";
+  }
+}
+
+static bool readFrame(cGridStreamReader& stream, int frame, Apto::Array<double>& double_values,
+                      Apto::Array<int>& int_values)
+{
+  const bool ok = (stream.GetCellType() == cGridStream::CELL_INT) ? stream.ReadFrame(frame, int_values) :
+                                                                    stream.ReadFrame(frame, double_values);
+  if (!ok) cerr << "error: unable to decode frame " << frame << " (update " << stream.GetFrameInfo(frame).update << ")" << endl;
+  return ok;
+}
+
+
+int main(int argc, char* argv[])
+{
+  const cString command = (argc > 2) ? argv[2] : "";
+  if (!((argc == 3 && command == "info") || (argc == 4 && (command == "update" || command == "export")))) {
+    cerr << "Usage: " << argv[0] << " [stream] info" << endl
+         << "       " << argv[0] << " [stream] update [update]" << endl
+         << "       " << argv[0] << " [stream] export [pattern]" << endl
+         << "  info prints the grid size, cell type and the updates held by the stream." << endl
+         << "  update prints the grid of the last frame at or before [update]." << endl
+         << "  export writes every frame as a text grid file, named by [pattern] with %d replaced by the update" << endl
+         << "  (e.g. grid_fitness-%d.dat)." << endl
+         << endl;
+    exit(1);
+  }
+
+  cGridStreamReader stream;
+  cString error;
+  if (!stream.Open(argv[1], &error)) {
+    cerr << "error: " << error << endl;
+    exit(1);
+  }
+
+  Apto::Array<double> double_values;
+  Apto::Array<int> int_values;
+
+  if (command == "info") {
+    cout << "grid:      " << stream.GetWidth() << " x " << stream.GetHeight() << endl
+         << "cells:     " << ((stream.GetCellType() == cGridStream::CELL_INT) ? "int" : "double") << endl
+         << "keyframes: every " << stream.GetKeyframeInterval() << " frames"
+         << ((stream.IsDeflated()) ? ", deflated" : "") << endl
+         << "frames:    " << stream.GetNumFrames() << endl;
+    if (stream.GetNumFrames() > 0) {
+      cout << "updates:   " << stream.GetFrameInfo(0).update << " to "
+           << stream.GetFrameInfo(stream.GetNumFrames() - 1).update << endl;
+    }
+  } else if (command == "update") {
+    const int frame = stream.FindFrame(atoi(argv[3]));
+    if (frame < 0) {
+      cerr << "error: no frame at or before update " << argv[3] << endl;
+      exit(1);
+    }
+    if (!readFrame(stream, frame, double_values, int_values)) exit(1);
+    printGrid(cout, stream, double_values, int_values);
+  } else {
+    const char* pattern = argv[3];
+    const char* field = strstr(pattern, "%d");
+    if (field == NULL || strchr(pattern, '%') != field || strchr(field + 1, '%') != NULL) {
+      cerr << "error: the export pattern must contain a single %d" << endl;
+      exit(1);
+    }
+    for (int frame = 0; frame < stream.GetNumFrames(); frame++) {
+      if (!readFrame(stream, frame, double_values, int_values)) exit(1);
+      cString filename;
+      filename.Set(pattern, stream.GetFrameInfo(frame).update);
+      ofstream out((const char*)filename);
+      if (!out.good()) {
+        cerr << "error: unable to write '" << filename << "'" << endl;
+        exit(1);
+      }
+      printGrid(out, stream, double_values, int_values);
+    }
+    cout << "exported " << stream.GetNumFrames() << " frames" << endl;
+  }
+
+  return 0;
+}
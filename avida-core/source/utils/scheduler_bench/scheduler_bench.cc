@@ -0,0 +1,121 @@
+/*
+ *  scheduler_bench.cc
+ *  Avida
+ *
+ *  Copyright 1999-2011 Michigan State University. All rights reserved.
+ *  http://avida.devosoft.org/
+ *
+ *
+ *  This file is part of Avida.
+ *
+ *  Avida is free software; you can redistribute it and/or modify it under the terms of the GNU Lesser General Public License
+ *  as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  Avida is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License along with Avida.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Microbenchmark comparing the time slicing schedulers on a synthetic workload: a fully occupied population whose
+// merits span several orders of magnitude, where every few CPU cycles one organism is replaced (a birth) and receives
+// a new merit.  A second phase measures the cost of assigning every merit at once, as happens on inject or load.
+
+#include "apto/core.h"
+#include "apto/rng.h"
+#include "apto/scheduler.h"
+
+#include "cSumTreeScheduler.h"
+
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+
+using namespace std;
+
+
+static double randomMerit(Apto::Random& rng)
+{
+  // Log-uniform merits between 1 and 2^20
+  double merit = 1.0;
+  for (int bits = rng.GetUInt(21); bits > 0; bits--) merit *= 2.0;
+  return merit * (1.0 + rng.GetDouble());
+}
+
+static double seconds(clock_t start) { return double(clock() - start) / CLOCKS_PER_SEC; }
+
+static void runBenchmark(const char* name, Apto::PriorityScheduler* scheduler, int num_entries, int num_cycles,
+                         int birth_interval, int seed)
+{
+  Apto::RNG::AvidaRNG rng(seed);
+
+  // Bulk assignment of every priority, then the first cycle (which pays for any deferred bookkeeping)
+  clock_t start = clock();
+  for (int i = 0; i < num_entries; i++) scheduler->AdjustPriority(i, randomMerit(rng));
+  scheduler->Next();
+  const double bulk_time = seconds(start);
+
+  // Steady state
+  int checksum = 0;
+  start = clock();
+  for (int cycle = 0; cycle < num_cycles; cycle++) {
+    checksum += scheduler->Next();
+    if (cycle % birth_interval == 0) scheduler->AdjustPriority(rng.GetUInt(num_entries), randomMerit(rng));
+  }
+  const double cycle_time = seconds(start);
+
+  cout << setw(26) << left << name << right
+       << setw(12) << setprecision(4) << bulk_time * 1000.0
+       << setw(14) << setprecision(4) << (cycle_time * 1.0e9 / num_cycles)
+       << setw(14) << checksum % 1000
+       << endl;
+
+  delete scheduler;
+}
+
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2 || argc > 5) {
+    cerr << "Usage: " << argv[0] << " [num_entries] ([num_cycles] [birth_interval] [seed])" << endl
+         << "  [num_entries] is the population size being scheduled." << endl
+         << "  [num_cycles] is the number of CPU cycles handed out (default 10 * num_entries)." << endl
+         << "  [birth_interval] is the number of cycles between merit changes (default 100)." << endl
+         << "  [seed] is the random number seed (default 1)." << endl
+         << endl;
+    exit(1);
+  }
+
+  const int num_entries = atoi(argv[1]);
+  const int num_cycles = (argc > 2) ? atoi(argv[2]) : 10 * num_entries;
+  const int birth_interval = (argc > 3) ? atoi(argv[3]) : 100;
+  const int seed = (argc > 4) ? atoi(argv[4]) : 1;
+
+  if (num_entries < 1 || num_cycles < 1 || birth_interval < 1) {
+    cerr << "error: all arguments must be positive" << endl;
+    exit(1);
+  }
+
+  cout << num_entries << " entries, " << num_cycles << " cycles, one merit change every " << birth_interval
+       << " cycles" << endl << endl;
+  cout << setw(26) << left << "scheduler" << right << setw(12) << "bulk (ms)" << setw(14) << "ns / cycle"
+       << setw(14) << "checksum" << endl;
+
+  typedef Apto::SmartPtr<Apto::Random> RandomPtr;
+  runBenchmark("RoundRobin", new Apto::Scheduler::RoundRobin(num_entries),
+               num_entries, num_cycles, birth_interval, seed);
+  runBenchmark("Integrated", new Apto::Scheduler::Integrated(num_entries),
+               num_entries, num_cycles, birth_interval, seed);
+  runBenchmark("Probabilistic", new Apto::Scheduler::Probabilistic(num_entries, RandomPtr(new Apto::RNG::AvidaRNG(seed))),
+               num_entries, num_cycles, birth_interval, seed);
+  runBenchmark("ProbabilisticIntegrated",
+               new Apto::Scheduler::ProbabilisticIntegrated(num_entries, RandomPtr(new Apto::RNG::AvidaRNG(seed))),
+               num_entries, num_cycles, birth_interval, seed);
+  runBenchmark("SumTree", new cSumTreeScheduler(num_entries, RandomPtr(new Apto::RNG::AvidaRNG(seed))),
+               num_entries, num_cycles, birth_interval, seed);
+
+  return 0;
+}